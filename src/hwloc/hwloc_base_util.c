@@ -48,6 +48,10 @@
 #if HAVE_FCNTL_H
 #    include <fcntl.h>
 #endif
+#ifdef HAVE_SYS_UTSNAME_H
+#    include <sys/utsname.h>
+#endif
+#include <stdio.h>
 
 #include "src/include/constants.h"
 #include "src/pmix/pmix-internal.h"
@@ -361,9 +365,146 @@ static void fill_cache_line_size(void)
     }
 }
 
+/* the cache key identifies the node, the booted kernel, the
+ * processors we can see, and the hwloc that generated the XML -
+ * a cached topology is only used if all of these still match */
+static char *topo_cache_key(void)
+{
+    char **items = NULL, *key, *line = NULL, tmp[128];
+    size_t len = 0;
+    FILE *fp;
+#ifdef HAVE_SYS_UTSNAME_H
+    struct utsname un;
+#endif
+
+    pmix_argv_append_nosize(&items, prte_process_info.nodename);
+#ifdef HAVE_SYS_UTSNAME_H
+    if (0 == uname(&un)) {
+        pmix_argv_append_nosize(&items, un.sysname);
+        pmix_argv_append_nosize(&items, un.release);
+        pmix_argv_append_nosize(&items, un.version);
+        pmix_argv_append_nosize(&items, un.machine);
+    }
+#endif
+    fp = fopen("/proc/sys/kernel/random/boot_id", "r");
+    if (NULL != fp) {
+        if (NULL != fgets(tmp, sizeof(tmp), fp)) {
+            tmp[strcspn(tmp, "\n")] = '\0';
+            pmix_argv_append_nosize(&items, tmp);
+        }
+        fclose(fp);
+    }
+    fp = fopen("/proc/self/status", "r");
+    if (NULL != fp) {
+        while (0 < getline(&line, &len, fp)) {
+            if (0 == strncmp(line, "Cpus_allowed_list:", strlen("Cpus_allowed_list:"))) {
+                line[strcspn(line, "\n")] = '\0';
+                pmix_argv_append_nosize(&items, line);
+                break;
+            }
+        }
+        free(line);
+        fclose(fp);
+    }
+    snprintf(tmp, sizeof(tmp), "ncpus=%ld hwloc=%x",
+             sysconf(_SC_NPROCESSORS_CONF), hwloc_get_api_version());
+    pmix_argv_append_nosize(&items, tmp);
+
+    key = pmix_argv_join(items, '|');
+    pmix_argv_free(items);
+    return key;
+}
+
+static char *topo_cache_path(const char *suffix)
+{
+    char *path;
+
+    pmix_asprintf(&path, "%s/prte-topo-%s.%s", prte_hwloc_base_topo_cache_dir,
+                  prte_process_info.nodename, suffix);
+    return path;
+}
+
+static bool topo_cache_load(const char *key)
+{
+    char *keyfile, *xmlfile, *line = NULL;
+    size_t len = 0;
+    bool match = false;
+    FILE *fp;
+    int rc;
+
+    keyfile = topo_cache_path("key");
+    fp = fopen(keyfile, "r");
+    free(keyfile);
+    if (NULL == fp) {
+        return false;
+    }
+    if (0 < getline(&line, &len, fp)) {
+        match = (0 == strcmp(line, key));
+    }
+    free(line);
+    fclose(fp);
+    if (!match) {
+        pmix_output_verbose(1, prte_hwloc_base_output,
+                            "hwloc:base topology cache is stale");
+        return false;
+    }
+
+    xmlfile = topo_cache_path("xml");
+    rc = prte_hwloc_base_set_topology(xmlfile);
+    free(xmlfile);
+    if (PRTE_SUCCESS != rc) {
+        /* set_topology destroyed the object on failure */
+        prte_hwloc_topology = NULL;
+        return false;
+    }
+    pmix_output_verbose(1, prte_hwloc_base_output,
+                        "hwloc:base loaded topology from cache");
+    return true;
+}
+
+/* write the file under a temporary name and rename it into
+ * place so concurrent daemons never see a partial file */
+static void topo_cache_store(const char *key)
+{
+    char *keyfile, *xmlfile, *tmp;
+    FILE *fp;
+
+    if (PMIX_SUCCESS != pmix_os_dirpath_create(prte_hwloc_base_topo_cache_dir, S_IRWXU)) {
+        return;
+    }
+
+    xmlfile = topo_cache_path("xml");
+    pmix_asprintf(&tmp, "%s.%lu", xmlfile, (unsigned long) getpid());
+    if (0 != hwloc_topology_export_xml(prte_hwloc_topology, tmp, 0) ||
+        0 != rename(tmp, xmlfile)) {
+        unlink(tmp);
+        free(tmp);
+        free(xmlfile);
+        return;
+    }
+    free(tmp);
+    free(xmlfile);
+
+    keyfile = topo_cache_path("key");
+    pmix_asprintf(&tmp, "%s.%lu", keyfile, (unsigned long) getpid());
+    fp = fopen(tmp, "w");
+    if (NULL != fp) {
+        fputs(key, fp);
+        if (0 != fclose(fp) || 0 != rename(tmp, keyfile)) {
+            unlink(tmp);
+        }
+    }
+    free(tmp);
+    free(keyfile);
+    pmix_output_verbose(1, prte_hwloc_base_output,
+                        "hwloc:base stored topology in cache %s",
+                        prte_hwloc_base_topo_cache_dir);
+}
+
 int prte_hwloc_base_get_topology(void)
 {
     int rc;
+    char *key = NULL;
 
     pmix_output_verbose(2, prte_hwloc_base_output,
                         "hwloc:base:get_topology");
@@ -374,14 +515,30 @@ int prte_hwloc_base_get_topology(void)
     }
 
     if (NULL == prte_hwloc_base_topo_file) {
+        /* see if an earlier daemon on this node left us a copy */
+        if (NULL != prte_hwloc_base_topo_cache_dir &&
+            NULL != prte_process_info.nodename) {
+            key = topo_cache_key();
+            if (topo_cache_load(key)) {
+                free(key);
+                goto done;
+            }
+        }
         pmix_output_verbose(1, prte_hwloc_base_output,
                             "hwloc:base discovering topology");
         if (0 != hwloc_topology_init(&prte_hwloc_topology) ||
             0 != prte_hwloc_base_topology_set_flags(prte_hwloc_topology, 0, true) ||
             0 != hwloc_topology_load(prte_hwloc_topology)) {
             PRTE_ERROR_LOG(PRTE_ERR_NOT_SUPPORTED);
+            if (NULL != key) {
+                free(key);
+            }
             return PRTE_ERR_NOT_SUPPORTED;
         }
+        if (NULL != key) {
+            topo_cache_store(key);
+            free(key);
+        }
     } else {
         pmix_output_verbose(1, prte_hwloc_base_output,
                             "hwloc:base loading topology from file %s",
@@ -392,6 +549,7 @@ int prte_hwloc_base_get_topology(void)
         prte_hwloc_synthetic_topo = true;
     }
 
+done:
     /* fill prte_cache_line_size global with the smallest L1 cache
        line size */
     fill_cache_line_size();
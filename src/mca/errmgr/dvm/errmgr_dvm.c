@@ -45,6 +45,7 @@
 #include "src/mca/rmaps/rmaps_types.h"
 #include "src/rml/rml.h"
 #include "src/mca/state/state.h"
+#include "src/prted/pmix/pmix_server_internal.h"
 
 #include "src/threads/pmix_threads.h"
 #include "src/util/error_strings.h"
@@ -269,6 +270,8 @@ static void proc_errors(int fd, short args, void *cbdata)
             pptr->state = state;
             /* adjust our num_procs */
             --prte_process_info.num_daemons;
+            /* don't leave resource usage rollups waiting on it */
+            pmix_server_rusage_route_lost(proc->rank);
             /* if we have ordered prteds to terminate or abort
              * is in progress, record it */
             if (prte_prteds_term_ordered || prte_abnormal_term_ordered) {
@@ -43,6 +43,7 @@
 #include "src/mca/plm/plm_types.h"
 #include "src/rml/rml.h"
 #include "src/mca/state/state.h"
+#include "src/prted/pmix/pmix_server_internal.h"
 
 #include "src/runtime/prte_globals.h"
 #include "src/runtime/prte_quit.h"
@@ -417,6 +418,8 @@ static void proc_errors(int fd, short args, void *cbdata)
         PMIX_OUTPUT_VERBOSE((2, prte_errmgr_base_framework.framework_output,
                              "%s errmgr:default:prted daemon %s exited",
                              PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_NAME_PRINT(proc)));
+        /* don't leave resource usage rollups waiting on it */
+        pmix_server_rusage_route_lost(proc->rank);
 
         if (prte_prteds_term_ordered) {
             /* are any of my children still alive */
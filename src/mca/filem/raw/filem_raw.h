@@ -30,6 +30,7 @@ PRTE_MODULE_EXPORT extern prte_filem_base_component_t prte_mca_filem_raw_compone
 PRTE_EXPORT extern prte_filem_base_module_t prte_filem_raw_module;
 
 extern bool prte_filem_raw_flatten_trees;
+extern bool prte_filem_raw_checksum;
 
 #define PRTE_FILEM_RAW_CHUNK_MAX 16384
 
@@ -64,6 +65,7 @@ typedef struct {
     prte_app_idx_t app_idx;
     prte_event_t ev;
     bool pending;
+    bool failed;
     int fd;
     char *file;
     char *top;
@@ -37,6 +37,7 @@ static int filem_raw_close(void);
 static int filem_raw_query(pmix_mca_base_module_t **module, int *priority);
 
 bool prte_filem_raw_flatten_trees = false;
+bool prte_filem_raw_checksum = false;
 
 prte_filem_base_component_t prte_mca_filem_raw_component = {
     PRTE_FILEM_BASE_VERSION_2_0_0,
@@ -66,6 +67,13 @@ static int filem_raw_register(void)
                                                 PMIX_MCA_BASE_VAR_TYPE_BOOL,
                                                 &prte_filem_raw_flatten_trees);
 
+    prte_filem_raw_checksum = false;
+    (void) pmix_mca_base_component_var_register(c, "checksum",
+                                                "Send a CRC32C with each chunk of a preloaded file "
+                                                "and verify it before writing the chunk out",
+                                                PMIX_MCA_BASE_VAR_TYPE_BOOL,
+                                                &prte_filem_raw_checksum);
+
     return PRTE_SUCCESS;
 }
 
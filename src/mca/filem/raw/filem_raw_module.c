@@ -52,6 +52,7 @@
 #include "src/mca/state/state.h"
 #include "src/runtime/prte_globals.h"
 #include "src/threads/pmix_threads.h"
+#include "src/util/crc.h"
 #include "src/util/name_fns.h"
 #include "src/util/proc_info.h"
 #include "src/util/session_dir.h"
@@ -714,6 +715,7 @@ static void send_chunk(int xxx, short argc, void *cbdata)
     int fd = rev->fd;
     unsigned char data[PRTE_FILEM_RAW_CHUNK_MAX];
     int32_t numbytes;
+    uint32_t crc;
     int rc;
     pmix_data_buffer_t chunk;
     PRTE_HIDE_UNUSED_PARAMS(xxx, argc);
@@ -780,6 +782,24 @@ static void send_chunk(int xxx, short argc, void *cbdata)
         PMIX_DATA_BUFFER_DESTRUCT(&chunk);
         return;
     }
+    /* flag whether or not the data is protected, followed by its crc */
+    rc = PMIx_Data_pack(NULL, &chunk, &prte_filem_raw_checksum, 1, PMIX_BOOL);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        close(fd);
+        PMIX_DATA_BUFFER_DESTRUCT(&chunk);
+        return;
+    }
+    if (prte_filem_raw_checksum) {
+        crc = prte_crc32c(data, numbytes);
+        rc = PMIx_Data_pack(NULL, &chunk, &crc, 1, PMIX_UINT32);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            close(fd);
+            PMIX_DATA_BUFFER_DESTRUCT(&chunk);
+            return;
+        }
+    }
     /* if it is the first chunk, then add file type and index of the app */
     if (0 == rev->nchunk) {
         rc = PMIx_Data_pack(NULL, &chunk, &rev->type, 1, PMIX_INT32);
@@ -898,12 +918,33 @@ static int link_archive(prte_filem_raw_incoming_t *inbnd)
     return PRTE_SUCCESS;
 }
 
+/* discard whatever has been received of a file that cannot be
+ * completed, so that nothing uses a partial copy of it */
+static void fail_incoming(prte_filem_raw_incoming_t *sink)
+{
+    pmix_list_item_t *item;
+
+    sink->failed = true;
+    if (0 <= sink->fd) {
+        close(sink->fd);
+        sink->fd = -1;
+    }
+    if (NULL != sink->fullpath) {
+        unlink(sink->fullpath);
+    }
+    while (NULL != (item = pmix_list_remove_first(&sink->outputs))) {
+        PMIX_RELEASE(item);
+    }
+}
+
 static void recv_files(int status, pmix_proc_t *sender, pmix_data_buffer_t *buffer,
                        prte_rml_tag_t tag, void *cbdata)
 {
     char *file, *session_dir;
     int32_t nchunk, n, nbytes;
     unsigned char data[PRTE_FILEM_RAW_CHUNK_MAX];
+    bool csum, corrupt = false;
+    uint32_t crc;
     int rc;
     prte_filem_raw_output_t *output;
     prte_filem_raw_incoming_t *ptr, *incoming;
@@ -941,6 +982,29 @@ static void recv_files(int status, pmix_proc_t *sender, pmix_data_buffer_t *buff
             free(file);
             return;
         }
+        n = 1;
+        rc = PMIx_Data_unpack(NULL, buffer, &csum, &n, PMIX_BOOL);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            send_complete(file, rc);
+            free(file);
+            return;
+        }
+        if (csum) {
+            n = 1;
+            rc = PMIx_Data_unpack(NULL, buffer, &crc, &n, PMIX_UINT32);
+            if (PMIX_SUCCESS != rc) {
+                PMIX_ERROR_LOG(rc);
+                send_complete(file, rc);
+                free(file);
+                return;
+            }
+            if (crc != prte_crc32c(data, nbytes)) {
+                pmix_output(0, "%s CHUNK %d OF FILE %s FAILED ITS CHECKSUM",
+                            PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), nchunk, file);
+                corrupt = true;
+            }
+        }
     }
     /* if the chunk is 0, then additional info should be present */
     if (0 == nchunk) {
@@ -979,6 +1043,23 @@ static void recv_files(int status, pmix_proc_t *sender, pmix_data_buffer_t *buff
         pmix_list_append(&incoming_files, &incoming->super);
     }
 
+    if (0 == nchunk) {
+        /* this starts a new transfer of the file */
+        incoming->failed = false;
+    }
+    if (incoming->failed) {
+        /* the failure was reported when an earlier chunk
+         * arrived corrupted - drop the rest of the file */
+        free(file);
+        return;
+    }
+    if (corrupt) {
+        fail_incoming(incoming);
+        send_complete(file, PRTE_ERR_COMM_FAILURE);
+        free(file);
+        return;
+    }
+
     /* if this is the first chunk, we need to open the file descriptor */
     if (0 == nchunk) {
         /* separate out the top-level directory of the target */
@@ -1079,6 +1160,11 @@ static void write_handler(int fd, short event, void *cbdata)
     /* note that the event is off */
     sink->pending = false;
 
+    if (sink->failed) {
+        /* the failure has already been reported */
+        return;
+    }
+
     while (NULL != (item = pmix_list_remove_first(&sink->outputs))) {
         output = (prte_filem_raw_output_t *) item;
         if (0 == output->numbytes) {
@@ -1236,6 +1322,7 @@ static void in_construct(prte_filem_raw_incoming_t *ptr)
 {
     ptr->app_idx = 0;
     ptr->pending = false;
+    ptr->failed = false;
     ptr->fd = -1;
     ptr->file = NULL;
     ptr->top = NULL;
@@ -58,6 +58,8 @@ static int init(void)
     /* setup the trackers */
     PMIX_CONSTRUCT(&prte_mca_grpcomm_direct_component.fence_ops, pmix_list_t);
     PMIX_CONSTRUCT(&prte_mca_grpcomm_direct_component.group_ops, pmix_list_t);
+    PMIX_CONSTRUCT(&prte_mca_grpcomm_direct_component.group_index, pmix_hash_table_t);
+    pmix_hash_table_init(&prte_mca_grpcomm_direct_component.group_index, 64);
 
     /* xcast receive */
     PRTE_RML_RECV(PRTE_NAME_WILDCARD, PRTE_RML_TAG_XCAST,
@@ -87,6 +89,7 @@ static void finalize(void)
 
     PMIX_LIST_DESTRUCT(&prte_mca_grpcomm_direct_component.fence_ops);
     PMIX_LIST_DESTRUCT(&prte_mca_grpcomm_direct_component.group_ops);
+    PMIX_DESTRUCT(&prte_mca_grpcomm_direct_component.group_index);
 
     PRTE_RML_CANCEL(PRTE_NAME_WILDCARD, PRTE_RML_TAG_XCAST);
     PRTE_RML_CANCEL(PRTE_NAME_WILDCARD, PRTE_RML_TAG_FENCE);
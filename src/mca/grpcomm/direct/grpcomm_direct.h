@@ -17,6 +17,7 @@
 
 #include "prte_config.h"
 
+#include "src/class/pmix_hash_table.h"
 #include "src/mca/grpcomm/grpcomm.h"
 
 BEGIN_C_DECLS
@@ -31,6 +32,8 @@ typedef struct {
 	pmix_list_t fence_ops;
 	// track ongoiong group operations - list of prte_grpcomm_group_t
 	pmix_list_t group_ops;
+	// index of group_ops keyed by op and groupID
+	pmix_hash_table_t group_index;
 } prte_grpcomm_direct_component_t;
 
 PRTE_MODULE_EXPORT extern prte_grpcomm_direct_component_t prte_mca_grpcomm_direct_component;
@@ -67,6 +70,17 @@ typedef struct {
 } prte_grpcomm_direct_group_signature_t;
 PRTE_MODULE_EXPORT PMIX_CLASS_DECLARATION(prte_grpcomm_direct_group_signature_t);
 
+/* Index of an array of procs so that contributions can
+ * be merged into it without rescanning the array */
+typedef struct {
+    pmix_object_t super;
+    pmix_hash_table_t procs;    // nspace+rank -> array position
+    pmix_hash_table_t nspaces;  // nspace -> position of first proc from it
+    size_t size;                // number of slots allocated in the array
+    bool active;
+} prte_grpcomm_direct_member_index_t;
+PMIX_CLASS_DECLARATION(prte_grpcomm_direct_member_index_t);
+
 
 /* Internal component object for tracking ongoing
  * allgather operations */
@@ -131,6 +145,10 @@ typedef struct {
     size_t nfollowers;  // number of add-member procs expected to participate
     size_t nfollowers_reported;  // number reported in
 
+    /* indexes of the members and addmembers arrays */
+    prte_grpcomm_direct_member_index_t mindex;
+    prte_grpcomm_direct_member_index_t aindex;
+
     /* controls values */
     bool assignID;
     int timeout;
@@ -101,6 +101,22 @@ PMIX_CLASS_INSTANCE(prte_grpcomm_direct_group_signature_t,
                     pmix_object_t,
                     sgcon, sgdes);
 
+static void micon(prte_grpcomm_direct_member_index_t *p)
+{
+    PMIX_CONSTRUCT(&p->procs, pmix_hash_table_t);
+    PMIX_CONSTRUCT(&p->nspaces, pmix_hash_table_t);
+    p->size = 0;
+    p->active = false;
+}
+static void mides(prte_grpcomm_direct_member_index_t *p)
+{
+    PMIX_DESTRUCT(&p->procs);
+    PMIX_DESTRUCT(&p->nspaces);
+}
+PMIX_CLASS_INSTANCE(prte_grpcomm_direct_member_index_t,
+                    pmix_object_t,
+                    micon, mides);
+
 static void ccon(prte_grpcomm_fence_t *p)
 {
     p->sig = NULL;
@@ -141,6 +157,8 @@ static void gccon(prte_grpcomm_group_t *p)
     p->nleaders_reported = 0;
     p->nfollowers = 0;
     p->nfollowers_reported = 0;
+    PMIX_CONSTRUCT(&p->mindex, prte_grpcomm_direct_member_index_t);
+    PMIX_CONSTRUCT(&p->aindex, prte_grpcomm_direct_member_index_t);
     p->assignID = false;
     p->timeout = 0;
     p->memsize = 0;
@@ -154,6 +172,8 @@ static void gcdes(prte_grpcomm_group_t *p)
     if (NULL != p->sig) {
         PMIX_RELEASE(p->sig);
     }
+    PMIX_DESTRUCT(&p->mindex);
+    PMIX_DESTRUCT(&p->aindex);
     PMIx_Info_list_release(p->grpinfo);
     PMIx_Info_list_release(p->endpts);
     if (NULL != p->dmns) {
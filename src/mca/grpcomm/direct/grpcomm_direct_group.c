@@ -42,6 +42,18 @@ static void group(int sd, short args, void *cbdata);
 
 static prte_grpcomm_group_t *get_tracker(prte_grpcomm_direct_group_signature_t *sig, bool create);
 
+static void remove_tracker(prte_grpcomm_group_t *coll);
+
+static void member_index_start(prte_grpcomm_direct_member_index_t *idx,
+                               pmix_proc_t *array, size_t narray);
+
+static bool member_find(prte_grpcomm_direct_member_index_t *idx,
+                        const pmix_proc_t *proc, size_t *pos);
+
+static size_t member_merge(prte_grpcomm_direct_member_index_t *idx,
+                           pmix_proc_t **array, size_t *narray,
+                           const pmix_proc_t *procs, size_t nprocs);
+
 static int create_dmns(prte_grpcomm_direct_group_signature_t *sig,
                        pmix_rank_t **dmns, size_t *ndmns);
 
@@ -309,9 +321,9 @@ void prte_grpcomm_direct_grp_recv(int status, pmix_proc_t *sender,
     int rc, timeout;
     size_t m, n, ninfo, nfinal = 0, nendpts, ngrpinfo;
     pmix_proc_t *finalmembership = NULL;
-    bool found;
     pmix_list_t nmlist;
     prte_namelist_t *nm;
+    prte_grpcomm_direct_member_index_t findex;
     pmix_data_array_t darray;
     pmix_status_t st;
     pmix_info_t *info = NULL, *endpts, *grpinfo = NULL;
@@ -475,57 +487,18 @@ void prte_grpcomm_direct_grp_recv(int status, pmix_proc_t *sender,
                     coll->sig->ctxid_assigned = true;
                 }
 
-                // construct the final membership
-                PMIX_CONSTRUCT(&nmlist, pmix_list_t);
-                // sadly, an exhaustive search
-                for (m=0; m < coll->sig->nmembers; m++) {
-                    found = false;
-                    PMIX_LIST_FOREACH(nm, &nmlist, prte_namelist_t) {
-                        if (PMIX_CHECK_PROCID(&coll->sig->members[m], &nm->name)) {
-                            // if the new one is rank=WILDCARD, then ensure
-                            // we keep it as wildcard
-                            if (PMIX_RANK_WILDCARD == coll->sig->members[m].rank) {
-                                nm->name.rank = PMIX_RANK_WILDCARD;
-                            }
-                            found = true;
-                            break;
-                        }
-                    }
-                    if (!found) {
-                        nm = PMIX_NEW(prte_namelist_t);
-                        memcpy(&nm->name, &coll->sig->members[m], sizeof(pmix_proc_t));
-                        pmix_list_append(&nmlist, &nm->super);
-                    }
-                }
-                // now check any added members
-                for (m=0; m < coll->sig->naddmembers; m++) {
-                    found = false;
-                    PMIX_LIST_FOREACH(nm, &nmlist, prte_namelist_t) {
-                        if (PMIX_CHECK_PROCID(&coll->sig->addmembers[m], &nm->name)) {
-                            // if the new one is rank=WILDCARD, then ensure
-                            // we keep it as wildcard
-                            if (PMIX_RANK_WILDCARD == coll->sig->addmembers[m].rank) {
-                                nm->name.rank = PMIX_RANK_WILDCARD;
-                            }
-                            found = true;
-                            break;
-                        }
-                    }
-                    if (!found) {
-                        nm = PMIX_NEW(prte_namelist_t);
-                        memcpy(&nm->name, &coll->sig->addmembers[m], sizeof(pmix_proc_t));
-                        pmix_list_append(&nmlist, &nm->super);
-                    }
-                }
-                // create the full membership array
-                nfinal = pmix_list_get_size(&nmlist);
-                PMIX_PROC_CREATE(finalmembership, nfinal);
-                m = 0;
-                PMIX_LIST_FOREACH(nm, &nmlist, prte_namelist_t) {
-                    memcpy(&finalmembership[m], &nm->name, sizeof(pmix_proc_t));
-                    ++m;
-                }
-                PMIX_LIST_DESTRUCT(&nmlist);
+                // construct the final membership - the members and
+                // addmembers are merged through an index. A proc given
+                // with rank=WILDCARD turns the first entry from its
+                // nspace into the wildcard, and specific ranks from that
+                // nspace merged after it are skipped. Any other specific
+                // ranks from the nspace already in the list are kept
+                PMIX_CONSTRUCT(&findex, prte_grpcomm_direct_member_index_t);
+                member_index_start(&findex, NULL, 0);
+                member_merge(&findex, &finalmembership, &nfinal,
+                             coll->sig->members, coll->sig->nmembers);
+                member_merge(&findex, &finalmembership, &nfinal,
+                             coll->sig->addmembers, coll->sig->naddmembers);
 
                 // if they gave us a final order, then sort the final membership
                 // accordingly. Note that order entries that consist of nspace,wildcard
@@ -535,22 +508,25 @@ void prte_grpcomm_direct_grp_recv(int status, pmix_proc_t *sender,
                 if (NULL != coll->sig->final_order) {
                     PMIX_CONSTRUCT(&nmlist, pmix_list_t);
                     for (m=0; m < coll->sig->nfinal; m++) {
-                        // search the array of final members to capture those that match
-                        for (n=0; n < nfinal; n++) {
-                            if (PMIX_CHECK_PROCID(&coll->sig->final_order[m], &finalmembership[n])) {
-                                // add this proc to the final list
-                                nm = PMIX_NEW(prte_namelist_t);
-                                memcpy(&nm->name, &finalmembership[n], sizeof(pmix_proc_t));
-                                pmix_list_append(&nmlist, &nm->super);
-                                // the final order may have included rank=wildcard - if so,
-                                // then we have to continue
-                                if (PMIX_RANK_WILDCARD != coll->sig->final_order[m].rank) {
-                                    // nope - can only match once
-                                    break;
+                        // the final order may have included rank=wildcard - if so,
+                        // then we have to capture every member from that nspace
+                        if (PMIX_RANK_WILDCARD == coll->sig->final_order[m].rank) {
+                            for (n=0; n < nfinal; n++) {
+                                if (PMIX_CHECK_NSPACE(coll->sig->final_order[m].nspace,
+                                                      finalmembership[n].nspace)) {
+                                    nm = PMIX_NEW(prte_namelist_t);
+                                    memcpy(&nm->name, &finalmembership[n], sizeof(pmix_proc_t));
+                                    pmix_list_append(&nmlist, &nm->super);
                                 }
                             }
+                        } else if (member_find(&findex, &coll->sig->final_order[m], &n)) {
+                            // can only match once
+                            nm = PMIX_NEW(prte_namelist_t);
+                            memcpy(&nm->name, &finalmembership[n], sizeof(pmix_proc_t));
+                            pmix_list_append(&nmlist, &nm->super);
                         }
                     }
+                    PMIX_DESTRUCT(&findex);
                     // did we lose anyone?
                     if (nfinal != pmix_list_get_size(&nmlist)) {
                         pmix_show_help("help-prte-runtime.txt", "bad-final-order", true);
@@ -571,6 +547,7 @@ void prte_grpcomm_direct_grp_recv(int status, pmix_proc_t *sender,
                     coll->sig->nfinal = 0;
 
                 } else {
+                    PMIX_DESTRUCT(&findex);
                      /* sort the procs so everyone gets the same order */
                     qsort(finalmembership, nfinal, sizeof(pmix_proc_t), pmix_util_compare_proc);
                 }
@@ -782,15 +759,14 @@ static void lkopcbfunc(int status, void *cbdata)
 static void find_delete_tracker(prte_grpcomm_direct_group_signature_t *sig)
 {
     prte_grpcomm_group_t *coll;
+    char *key;
 
-    PMIX_LIST_FOREACH(coll, &prte_mca_grpcomm_direct_component.group_ops, prte_grpcomm_group_t) {
-        // must match groupID's
-        if (0 == strcmp(sig->groupID, coll->sig->groupID)) {
-            pmix_list_remove_item(&prte_mca_grpcomm_direct_component.group_ops, &coll->super);
-            PMIX_RELEASE(coll);
-            return;
-        }
+    pmix_asprintf(&key, "%d:%s", (int) sig->op, sig->groupID);
+    if (PMIX_SUCCESS == pmix_hash_table_get_value_ptr(&prte_mca_grpcomm_direct_component.group_index,
+                                                      key, strlen(key), (void **) &coll)) {
+        remove_tracker(coll);
     }
+    free(key);
 }
 
 void prte_grpcomm_direct_grp_release(int status, pmix_proc_t *sender,
@@ -1037,166 +1013,217 @@ notify:
 }
 
 
+static void remove_tracker(prte_grpcomm_group_t *coll)
+{
+    char *key;
+
+    pmix_asprintf(&key, "%d:%s", (int) coll->sig->op, coll->sig->groupID);
+    pmix_hash_table_remove_value_ptr(&prte_mca_grpcomm_direct_component.group_index,
+                                     key, strlen(key));
+    free(key);
+    pmix_list_remove_item(&prte_mca_grpcomm_direct_component.group_ops, &coll->super);
+    PMIX_RELEASE(coll);
+}
+
+static size_t member_key(const pmix_proc_t *proc, pmix_rank_t rank, char *key)
+{
+    size_t len;
+
+    len = strnlen(proc->nspace, PMIX_MAX_NSLEN);
+    memcpy(key, proc->nspace, len);
+    memcpy(key + len, &rank, sizeof(pmix_rank_t));
+    return len + sizeof(pmix_rank_t);
+}
+
+static void member_insert(prte_grpcomm_direct_member_index_t *idx,
+                          pmix_proc_t *array, size_t pos)
+{
+    char key[PMIX_MAX_NSLEN + 1 + sizeof(pmix_rank_t)];
+    size_t len;
+    void *ptr;
+
+    len = member_key(&array[pos], array[pos].rank, key);
+    pmix_hash_table_set_value_ptr(&idx->procs, key, len, (void *) (uintptr_t) pos);
+    len = strnlen(array[pos].nspace, PMIX_MAX_NSLEN);
+    if (PMIX_SUCCESS != pmix_hash_table_get_value_ptr(&idx->nspaces, array[pos].nspace,
+                                                      len, &ptr)) {
+        pmix_hash_table_set_value_ptr(&idx->nspaces, array[pos].nspace, len,
+                                      (void *) (uintptr_t) pos);
+    }
+}
+
+/* index an existing array of procs - a no-op if the
+ * index has already been built */
+static void member_index_start(prte_grpcomm_direct_member_index_t *idx,
+                               pmix_proc_t *array, size_t narray)
+{
+    size_t n;
+
+    if (idx->active) {
+        return;
+    }
+    pmix_hash_table_init(&idx->procs, (64 < narray) ? narray : 64);
+    pmix_hash_table_init(&idx->nspaces, 16);
+    for (n=0; n < narray; n++) {
+        member_insert(idx, array, n);
+    }
+    idx->size = narray;
+    idx->active = true;
+}
+
+/* find the position of a proc in an indexed array using the
+ * same rules as PMIX_CHECK_PROCID - a wildcard rank on either
+ * side matches any proc from the same nspace */
+static bool member_find(prte_grpcomm_direct_member_index_t *idx,
+                        const pmix_proc_t *proc, size_t *pos)
+{
+    char key[PMIX_MAX_NSLEN + 1 + sizeof(pmix_rank_t)];
+    size_t len;
+    void *ptr;
+
+    if (PMIX_RANK_WILDCARD == proc->rank) {
+        len = strnlen(proc->nspace, PMIX_MAX_NSLEN);
+        if (PMIX_SUCCESS == pmix_hash_table_get_value_ptr(&idx->nspaces, proc->nspace, len, &ptr)) {
+            *pos = (size_t) (uintptr_t) ptr;
+            return true;
+        }
+        return false;
+    }
+    len = member_key(proc, proc->rank, key);
+    if (PMIX_SUCCESS == pmix_hash_table_get_value_ptr(&idx->procs, key, len, &ptr)) {
+        *pos = (size_t) (uintptr_t) ptr;
+        return true;
+    }
+    len = member_key(proc, PMIX_RANK_WILDCARD, key);
+    if (PMIX_SUCCESS == pmix_hash_table_get_value_ptr(&idx->procs, key, len, &ptr)) {
+        *pos = (size_t) (uintptr_t) ptr;
+        return true;
+    }
+    return false;
+}
+
+/* add any procs not already present to an indexed array, growing
+ * the array geometrically. A proc given with rank=WILDCARD converts
+ * the matching entry to wildcard. Returns the number of procs added */
+static size_t member_merge(prte_grpcomm_direct_member_index_t *idx,
+                           pmix_proc_t **array, size_t *narray,
+                           const pmix_proc_t *procs, size_t nprocs)
+{
+    char key[PMIX_MAX_NSLEN + 1 + sizeof(pmix_rank_t)];
+    size_t n, pos, len, added = 0;
+    pmix_proc_t *p;
+
+    for (n=0; n < nprocs; n++) {
+        if (member_find(idx, &procs[n], &pos)) {
+            // check for wildcard as that needs to be retained
+            if (PMIX_RANK_WILDCARD == procs[n].rank &&
+                PMIX_RANK_WILDCARD != (*array)[pos].rank) {
+                len = member_key(&(*array)[pos], (*array)[pos].rank, key);
+                pmix_hash_table_remove_value_ptr(&idx->procs, key, len);
+                (*array)[pos].rank = PMIX_RANK_WILDCARD;
+                len = member_key(&(*array)[pos], PMIX_RANK_WILDCARD, key);
+                pmix_hash_table_set_value_ptr(&idx->procs, key, len, (void *) (uintptr_t) pos);
+            }
+            continue;
+        }
+        if (*narray == idx->size) {
+            idx->size = (0 == idx->size) ? 16 : 2 * idx->size;
+            p = (pmix_proc_t *) realloc(*array, idx->size * sizeof(pmix_proc_t));
+            if (NULL == p) {
+                PMIX_ERROR_LOG(PMIX_ERR_NOMEM);
+                return added;
+            }
+            *array = p;
+        }
+        memcpy(&(*array)[*narray], &procs[n], sizeof(pmix_proc_t));
+        member_insert(idx, *array, *narray);
+        ++(*narray);
+        ++added;
+    }
+    return added;
+}
+
 static prte_grpcomm_group_t *get_tracker(prte_grpcomm_direct_group_signature_t *sig,
                                          bool create)
 {
     prte_grpcomm_group_t *coll;
     int rc;
-    pmix_proc_t *p;
-    size_t n, nmb;
-    pmix_list_t plist;
-    prte_namelist_t *nm;
-    bool found;
+    size_t n;
+    char *key;
 
     if (NULL == sig->groupID) {
         return NULL;
     }
 
-    /* search the existing tracker list to see if this already exists - we
-     * default to using the groupID if one is given, otherwise we fallback
-     * to the array of participating procs */
-    PMIX_LIST_FOREACH(coll, &prte_mca_grpcomm_direct_component.group_ops, prte_grpcomm_group_t) {
-        // must match groupID's and ops
-        if (0 == strcmp(sig->groupID, coll->sig->groupID) &&
-            sig->op == coll->sig->op) {
-            PMIX_OUTPUT_VERBOSE((1, prte_grpcomm_base_framework.framework_output,
-                                 "%s grpcomm:direct:group:returning existing collective %s",
-                                 PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
-                                 sig->groupID));
-            // if this is a bootstrap, then we have to track the number of leaders
-            if (0 < sig->bootstrap) {
-                if (0 < coll->nleaders) {
-                    if (coll->nleaders != sig->bootstrap) {
-                        // this is an error
-                        PMIX_ERROR_LOG(PMIX_ERR_BAD_PARAM);
-                        return NULL;
-                    }
-                } else {
-                    // collective tracker could have been created by a follower,
-                    // which means nleaders will not have been set
-                    coll->nleaders = sig->bootstrap;
-                }
-                coll->bootstrap = true;
-                // add this proc to the list of members
-                PMIX_CONSTRUCT(&plist, pmix_list_t);
-                for (n=0; n < sig->nmembers; n++) {
-                    // see if we already have this proc
-                    found = false;
-                    for (nmb=0; nmb < coll->sig->nmembers; nmb++) {
-                        if (PMIX_CHECK_PROCID(&sig->members[n], &coll->sig->members[nmb])) {
-                            // yes, we do
-                            found = true;
-                            // check for wildcard as that needs to be retained
-                            if (PMIX_RANK_WILDCARD == sig->members[n].rank) {
-                                coll->sig->members[n].rank = PMIX_RANK_WILDCARD;
-                            }
-                            break;
-                        }
-                    }
-                    if (!found) {
-                        // cache the proc
-                        nm = PMIX_NEW(prte_namelist_t);
-                        memcpy(&nm->name, &sig->members[n], sizeof(pmix_proc_t));
-                        pmix_list_append(&plist, &nm->super);
-                    }
-                }
-                // add any missing procs to the addmembers
-                if (0 < pmix_list_get_size(&plist)) {
-                    n = coll->sig->nmembers + pmix_list_get_size(&plist);
-                    PMIX_PROC_CREATE(p, n);
-                    if (NULL != coll->sig->members) {
-                        memcpy(p, coll->sig->members, coll->sig->nmembers * sizeof(pmix_proc_t));
-                    }
-                    n = coll->sig->nmembers;
-                    PMIX_LIST_FOREACH(nm, &plist, prte_namelist_t) {
-                        memcpy(&p[n], &nm->name, sizeof(pmix_proc_t));
-                        ++n;
-                    }
-                    PMIX_LIST_DESTRUCT(&plist);
-                    if (NULL != coll->sig->members) {
-                        PMIX_PROC_FREE(coll->sig->members, coll->sig->nmembers);
-                    }
-                    coll->sig->members = p;
-                    coll->sig->nmembers = n;
+    /* see if this collective already exists - trackers are
+     * indexed by their groupID and op */
+    pmix_asprintf(&key, "%d:%s", (int) sig->op, sig->groupID);
+    rc = pmix_hash_table_get_value_ptr(&prte_mca_grpcomm_direct_component.group_index,
+                                       key, strlen(key), (void **) &coll);
+    if (PMIX_SUCCESS == rc) {
+        free(key);
+        PMIX_OUTPUT_VERBOSE((1, prte_grpcomm_base_framework.framework_output,
+                             "%s grpcomm:direct:group:returning existing collective %s",
+                             PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
+                             sig->groupID));
+        // if this is a bootstrap, then we have to track the number of leaders
+        if (0 < sig->bootstrap) {
+            if (0 < coll->nleaders) {
+                if (coll->nleaders != sig->bootstrap) {
+                    // this is an error
+                    PMIX_ERROR_LOG(PMIX_ERR_BAD_PARAM);
+                    return NULL;
                 }
-
-            } else if (sig->follower) {
-                // just ensure the bootstrap flag is set
-                coll->bootstrap = true;
+            } else {
+                // collective tracker could have been created by a follower,
+                // which means nleaders will not have been set
+                coll->nleaders = sig->bootstrap;
             }
+            coll->bootstrap = true;
+            // add any procs we don't already have to the members
+            member_index_start(&coll->mindex, coll->sig->members, coll->sig->nmembers);
+            member_merge(&coll->mindex, &coll->sig->members, &coll->sig->nmembers,
+                         sig->members, sig->nmembers);
+
+        } else if (sig->follower) {
+            // just ensure the bootstrap flag is set
+            coll->bootstrap = true;
+        }
 
-            // if we are adding members, aggregate them
-            if (0 < sig->naddmembers) {
-                PMIX_CONSTRUCT(&plist, pmix_list_t);
-                for (n=0; n < sig->naddmembers; n++) {
-                    // see if we already have this proc
-                    found = false;
-                    for (nmb=0; nmb < coll->sig->naddmembers; nmb++) {
-                        if (PMIX_CHECK_PROCID(&sig->addmembers[n], &coll->sig->addmembers[nmb])) {
-                            // yes, we do
-                            found = true;
-                            // check for wildcard as that needs to be retained
-                            if (PMIX_RANK_WILDCARD == sig->addmembers[n].rank) {
-                                coll->sig->addmembers[n].rank = PMIX_RANK_WILDCARD;
-                            }
-                            break;
-                        }
-                    }
-                    if (!found) {
-                        // cache the proc
-                        nm = PMIX_NEW(prte_namelist_t);
-                        memcpy(&nm->name, &sig->addmembers[n], sizeof(pmix_proc_t));
-                        pmix_list_append(&plist, &nm->super);
-                    }
-                }
-                // add any missing procs to the addmembers
-                if (0 < pmix_list_get_size(&plist)) {
-                    n = coll->sig->naddmembers + pmix_list_get_size(&plist);
-                    PMIX_PROC_CREATE(p, n);
-                    if (NULL != coll->sig->addmembers) {
-                        memcpy(p, coll->sig->addmembers, coll->sig->naddmembers * sizeof(pmix_proc_t));
-                    }
-                    n = coll->sig->naddmembers;
-                    PMIX_LIST_FOREACH(nm, &plist, prte_namelist_t) {
-                        memcpy(&p[n], &nm->name, sizeof(pmix_proc_t));
-                        ++n;
-                    }
-                    PMIX_LIST_DESTRUCT(&plist);
-                    if (NULL != coll->sig->addmembers) {
-                        PMIX_PROC_FREE(coll->sig->addmembers, coll->sig->naddmembers);
-                    }
-                    coll->sig->addmembers = p;
-                    coll->sig->naddmembers = n;
-                    coll->nfollowers = n;
-                }
+        // if we are adding members, aggregate them
+        if (0 < sig->naddmembers) {
+            member_index_start(&coll->aindex, coll->sig->addmembers, coll->sig->naddmembers);
+            if (0 < member_merge(&coll->aindex, &coll->sig->addmembers, &coll->sig->naddmembers,
+                                 sig->addmembers, sig->naddmembers)) {
+                coll->nfollowers = coll->sig->naddmembers;
             }
-            // if they specified a final order, see if one was already given
-            if (NULL != sig->final_order) {
-                if (NULL == coll->sig->final_order) {
-                    // cache the directive
-                    PMIX_PROC_CREATE(coll->sig->final_order, sig->nfinal);
-                    memcpy(coll->sig->final_order, sig->final_order, sig->nfinal * sizeof(pmix_proc_t));
-                    coll->sig->nfinal = sig->nfinal;
-                } else {
-                    // see if they match - for now, do a direct match
-                    if (coll->sig->nfinal != sig->nfinal) {
-                        // this is an error
-                        PMIX_ERROR_LOG(PMIX_ERR_BAD_PARAM);
-                        return NULL;
-                    }
-                    if (0 != memcmp(coll->sig->final_order, sig->final_order, sig->nfinal * sizeof(pmix_proc_t))) {
-                        // this is an error
-                        PMIX_ERROR_LOG(PMIX_ERR_BAD_PARAM);
-                        return NULL;
-                    }
-                    // they are the same, so just ignore the new directive
+        }
+        // if they specified a final order, see if one was already given
+        if (NULL != sig->final_order) {
+            if (NULL == coll->sig->final_order) {
+                // cache the directive
+                PMIX_PROC_CREATE(coll->sig->final_order, sig->nfinal);
+                memcpy(coll->sig->final_order, sig->final_order, sig->nfinal * sizeof(pmix_proc_t));
+                coll->sig->nfinal = sig->nfinal;
+            } else {
+                // see if they match - for now, do a direct match
+                if (coll->sig->nfinal != sig->nfinal) {
+                    // this is an error
+                    PMIX_ERROR_LOG(PMIX_ERR_BAD_PARAM);
+                    return NULL;
                 }
+                if (0 != memcmp(coll->sig->final_order, sig->final_order, sig->nfinal * sizeof(pmix_proc_t))) {
+                    // this is an error
+                    PMIX_ERROR_LOG(PMIX_ERR_BAD_PARAM);
+                    return NULL;
+                }
+                // they are the same, so just ignore the new directive
             }
-            if (!coll->sig->assignID && sig->assignID) {
-                coll->sig->assignID = true;
-            }
-            return coll;
         }
+        if (!coll->sig->assignID && sig->assignID) {
+            coll->sig->assignID = true;
+        }
+        return coll;
     }
 
     /* if we get here, then this is a new collective - so create
@@ -1205,7 +1232,7 @@ static prte_grpcomm_group_t *get_tracker(prte_grpcomm_direct_group_signature_t *
         PMIX_OUTPUT_VERBOSE((1, prte_grpcomm_base_framework.framework_output,
                              "%s grpcomm:base: not creating new coll",
                              PRTE_NAME_PRINT(PRTE_PROC_MY_NAME)));
-
+        free(key);
         return NULL;
     }
 
@@ -1232,6 +1259,9 @@ static prte_grpcomm_group_t *get_tracker(prte_grpcomm_direct_group_signature_t *
         coll->bootstrap = true;
     }
     pmix_list_append(&prte_mca_grpcomm_direct_component.group_ops, &coll->super);
+    pmix_hash_table_set_value_ptr(&prte_mca_grpcomm_direct_component.group_index,
+                                  key, strlen(key), coll);
+    free(key);
 
     /* if this is a bootstrap operation, then there is no "rollup"
      * collective - each daemon reports directly to the DVM controller */
@@ -1242,8 +1272,7 @@ static prte_grpcomm_group_t *get_tracker(prte_grpcomm_direct_group_signature_t *
     /* now get the daemons involved */
     if (PRTE_SUCCESS != (rc = create_dmns(sig, &coll->dmns, &coll->ndmns))) {
         PRTE_ERROR_LOG(rc);
-        pmix_list_remove_item(&prte_mca_grpcomm_direct_component.group_ops, &coll->super);
-        PMIX_RELEASE(coll);
+        remove_tracker(coll);
         return NULL;
     }
 
@@ -219,9 +219,13 @@ void prte_grpcomm_direct_xcast_recv(int status, pmix_proc_t *sender,
                 return;
             }
 
+            /* if we were started by a launch tree, then we don't
+             * yet know how to reach our routing parent */
             if (!PMIX_CHECK_PROCID(&dmn, PRTE_PROC_MY_HNP) &&
                 !PMIX_CHECK_PROCID(&dmn, PRTE_PROC_MY_NAME) &&
-                !PMIX_CHECK_PROCID(&dmn, PRTE_PROC_MY_PARENT)) {
+                (!PMIX_CHECK_PROCID(&dmn, PRTE_PROC_MY_PARENT) ||
+                 PMIX_RANK_INVALID != prte_rml_base.launch_parent) &&
+                dmn.rank != prte_rml_base.launch_parent) {
                 /* store it locally */
                 ret = PMIx_Store_internal(&dmn, PMIX_PROC_URI, &val);
                 PMIX_VALUE_DESTRUCT(&val);
@@ -229,9 +229,9 @@ static inline bool prte_iof_base_fd_always_ready(int fd)
         rev->always_readable = prte_iof_base_fd_always_ready(fid);                            \
         *(rv) = rev;                                                                          \
         if (rev->always_readable) {                                                           \
-            prte_event_evtimer_set(prte_event_base, rev->ev, (cbfunc), rev);                  \
+            prte_event_evtimer_set(prte_iof_base_ev_base, rev->ev, (cbfunc), rev);            \
         } else {                                                                              \
-            prte_event_set(prte_event_base, rev->ev, (fid), PRTE_EV_READ, (cbfunc), rev);     \
+            prte_event_set(prte_iof_base_ev_base, rev->ev, (fid), PRTE_EV_READ, (cbfunc), rev); \
         }                                                                                     \
         if ((actv)) {                                                                         \
             PRTE_IOF_READ_ACTIVATE(rev)                                                       \
@@ -241,6 +241,10 @@ static inline bool prte_iof_base_fd_always_ready(int fd)
 PRTE_EXPORT int prte_iof_base_flush(void);
 
 PRTE_EXPORT extern int prte_iof_base_output_limit;
+PRTE_EXPORT extern bool prte_iof_base_progress_thread;
+/* event base on which child output is read - the main
+ * event base unless a component moved it to its own thread */
+PRTE_EXPORT extern prte_event_base_t *prte_iof_base_ev_base;
 
 /* base functions */
 PRTE_EXPORT int prte_iof_base_write_output(const pmix_proc_t *name, prte_iof_tag_t stream,
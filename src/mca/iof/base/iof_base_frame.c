@@ -60,6 +60,8 @@ prte_iof_base_module_t prte_iof = {0};
  */
 
 int prte_iof_base_output_limit = 0;
+bool prte_iof_base_progress_thread = false;
+prte_event_base_t *prte_iof_base_ev_base = NULL;
 
 static int prte_iof_base_register(pmix_mca_base_register_flag_t flags)
 {
@@ -72,6 +74,14 @@ static int prte_iof_base_register(pmix_mca_base_register_flag_t flags)
                                       PMIX_MCA_BASE_VAR_TYPE_INT,
                                       &prte_iof_base_output_limit);
 
+    /* see if child output should be read on its own thread */
+    prte_iof_base_progress_thread = false;
+    (void) pmix_mca_base_var_register("prte", "iof", "base", "progress_thread",
+                                      "Read the output of local procs on a dedicated progress thread "
+                                      "instead of the main event loop (daemons only) [default: false]",
+                                      PMIX_MCA_BASE_VAR_TYPE_BOOL,
+                                      &prte_iof_base_progress_thread);
+
     return PRTE_SUCCESS;
 }
 
@@ -90,6 +100,9 @@ static int prte_iof_base_close(void)
  */
 static int prte_iof_base_open(pmix_mca_base_open_flag_t flags)
 {
+    /* components may move this to a progress thread in their init */
+    prte_iof_base_ev_base = prte_event_base;
+
     /* Open up all available components */
     return pmix_mca_base_framework_components_open(&prte_iof_base_framework, flags);
 }
@@ -133,6 +133,29 @@ int prte_iof_base_setup_prefork(prte_iof_base_io_conf_t *opts)
     return PRTE_SUCCESS;
 }
 
+int prte_iof_base_setup_pty(int fd)
+{
+    struct termios term_attrs;
+
+    /* disable echo */
+    if (tcgetattr(fd, &term_attrs) < 0) {
+        return PMIX_ERR_PIPE_SETUP_FAILURE;
+    }
+    term_attrs.c_lflag &= ~(ECHO | ECHOE | ECHOK | ECHOCTL | ECHOKE | ECHONL);
+    term_attrs.c_iflag &= ~(ICRNL | INLCR | ISTRIP | INPCK | IXON);
+    term_attrs.c_oflag &= ~(
+#ifdef OCRNL
+        /* OS X 10.3 does not have this
+           value defined */
+        OCRNL |
+#endif
+        ONLCR);
+    if (tcsetattr(fd, TCSANOW, &term_attrs) == -1) {
+        return PMIX_ERR_PIPE_SETUP_FAILURE;
+    }
+    return PRTE_SUCCESS;
+}
+
 int prte_iof_base_setup_child(prte_iof_base_io_conf_t *opts,
                               char ***env)
 {
@@ -146,22 +169,8 @@ int prte_iof_base_setup_child(prte_iof_base_io_conf_t *opts,
     close(opts->p_stderr[0]);
 
     if (opts->usepty) {
-        /* disable echo */
-        struct termios term_attrs;
-        if (tcgetattr(opts->p_stdout[1], &term_attrs) < 0) {
-            return PMIX_ERR_PIPE_SETUP_FAILURE;
-        }
-        term_attrs.c_lflag &= ~(ECHO | ECHOE | ECHOK | ECHOCTL | ECHOKE | ECHONL);
-        term_attrs.c_iflag &= ~(ICRNL | INLCR | ISTRIP | INPCK | IXON);
-        term_attrs.c_oflag &= ~(
-#ifdef OCRNL
-            /* OS X 10.3 does not have this
-               value defined */
-            OCRNL |
-#endif
-            ONLCR);
-        if (tcsetattr(opts->p_stdout[1], TCSANOW, &term_attrs) == -1) {
-            return PMIX_ERR_PIPE_SETUP_FAILURE;
+        if (PRTE_SUCCESS != (ret = prte_iof_base_setup_pty(opts->p_stdout[1]))) {
+            return ret;
         }
 #ifdef HAVE_FILENO_UNLOCKED
         ret = dup2(opts->p_stdout[1], fileno_unlocked(stdout));
@@ -47,6 +47,12 @@ typedef struct prte_iof_base_io_conf_t prte_iof_base_io_conf_t;
  */
 PRTE_EXPORT int prte_iof_base_setup_prefork(prte_iof_base_io_conf_t *opts);
 
+/**
+ * Put the child end of a pty into the mode the child expects - no
+ * echo and no translation of line endings
+ */
+PRTE_EXPORT int prte_iof_base_setup_pty(int fd);
+
 PRTE_EXPORT int prte_iof_base_setup_child(prte_iof_base_io_conf_t *opts, char ***env);
 
 PRTE_EXPORT int prte_iof_base_setup_parent(const pmix_proc_t *name, prte_iof_base_io_conf_t *opts);
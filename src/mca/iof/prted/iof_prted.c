@@ -49,6 +49,7 @@
 #include "src/mca/odls/odls_types.h"
 #include "src/rml/rml.h"
 #include "src/runtime/prte_globals.h"
+#include "src/runtime/prte_progress_threads.h"
 #include "src/threads/pmix_threads.h"
 #include "src/util/name_fns.h"
 
@@ -101,6 +102,16 @@ static int init(void)
     PMIX_CONSTRUCT(&prte_mca_iof_prted_component.procs, pmix_list_t);
     prte_mca_iof_prted_component.xoff = false;
 
+    /* if requested, read the output of our children on
+     * a dedicated thread so a chatty job cannot starve
+     * the daemon's main event loop */
+    if (prte_iof_base_progress_thread) {
+        prte_iof_base_ev_base = prte_progress_thread_init("PRTE-IOF");
+        if (NULL == prte_iof_base_ev_base) {
+            prte_iof_base_ev_base = prte_event_base;
+        }
+    }
+
     return PRTE_SUCCESS;
 }
 
@@ -299,6 +310,10 @@ static void prted_complete(const prte_job_t *jdata)
 
 static int finalize(void)
 {
+    if (prte_iof_base_ev_base != prte_event_base) {
+        prte_progress_thread_finalize("PRTE-IOF");
+        prte_iof_base_ev_base = prte_event_base;
+    }
     PMIX_LIST_DESTRUCT(&prte_mca_iof_prted_component.procs);
 
     /* Cancel the RML receive */
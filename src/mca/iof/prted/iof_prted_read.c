@@ -57,72 +57,95 @@ static void lkcbfunc(pmix_status_t status, void *cbdata)
     PMIX_RELEASE(p);
 }
 
-void prte_iof_prted_read_handler(int fd, short event, void *cbdata)
-{
-    prte_iof_read_event_t *rev = (prte_iof_read_event_t *) cbdata;
-    unsigned char data[PRTE_IOF_BASE_MSG_MAX];
-    pmix_data_buffer_t *buf = NULL;
-    int rc;
+/* the read events may be serviced by the IOF progress
+ * thread, so hand what was read - and the teardown of a
+ * closed channel - back to the main event loop where the
+ * proc is tracked and messages are routed */
+typedef struct {
+    pmix_object_t super;
+    prte_event_t ev;
+    prte_iof_proc_t *proct;
+    prte_iof_tag_t tag;
     int32_t numbytes;
-    prte_iof_proc_t *proct = (prte_iof_proc_t *) rev->proc;
-    prte_iof_deliver_t *p;
-    pmix_iof_channel_t pchan;
-    pmix_status_t prc;
-    PRTE_HIDE_UNUSED_PARAMS(event);
-
-    PMIX_ACQUIRE_OBJECT(rev);
-
-    /* As we may use timer events, fd can be bogus (-1)
-     * use the right one here
-     */
-    fd = rev->fd;
-
-    /* read up to the fragment size */
-    numbytes = read(fd, data, sizeof(data));
+    unsigned char *data;
+} prte_iof_prted_caddy_t;
+static void ccon(prte_iof_prted_caddy_t *p)
+{
+    p->proct = NULL;
+    p->numbytes = 0;
+    p->data = NULL;
+}
+static void cdes(prte_iof_prted_caddy_t *p)
+{
+    if (NULL != p->proct) {
+        PMIX_RELEASE(p->proct);
+    }
+    if (NULL != p->data) {
+        free(p->data);
+    }
+}
+static PMIX_CLASS_INSTANCE(prte_iof_prted_caddy_t,
+                           pmix_object_t,
+                           ccon, cdes);
 
-    PMIX_OUTPUT_VERBOSE((1, prte_iof_base_framework.framework_output,
-                         "%s read %d bytes from %s of %s",
-                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), numbytes,
-                         (PRTE_IOF_STDOUT & rev->tag) ? "stdout"
-                         : ((PRTE_IOF_STDERR & rev->tag) ? "stderr" : "stddiag"),
-                         PRTE_NAME_PRINT(&proct->name)));
+static void channel_closed(int fd, short event, void *cbdata)
+{
+    prte_iof_prted_caddy_t *cd = (prte_iof_prted_caddy_t *) cbdata;
+    prte_iof_proc_t *proct = cd->proct;
+    PRTE_HIDE_UNUSED_PARAMS(fd, event);
 
-    if (NULL == proct) {
-        /* nothing we can do */
-        PRTE_ERROR_LOG(PRTE_ERR_ADDRESSEE_UNKNOWN);
-        return;
-    }
+    PMIX_ACQUIRE_OBJECT(cd);
 
-    if (numbytes <= 0) {
-        if (0 > numbytes) {
-            /* either we have a connection error or it was a non-blocking read */
-            if (EAGAIN == errno || EINTR == errno) {
-                /* non-blocking, retry */
-                PRTE_IOF_READ_ACTIVATE(rev);
-                return;
-            }
+    /* release the corresponding event. This deletes the
+     * read event and closes the file descriptor */
+    if (cd->tag & PRTE_IOF_STDOUT) {
+        if (NULL != proct->revstdout) {
+            PMIX_RELEASE(proct->revstdout);
+        }
+    } else if (cd->tag & PRTE_IOF_STDERR) {
+        if (NULL != proct->revstderr) {
+            PMIX_RELEASE(proct->revstderr);
         }
-        /* go down and close the fd etc */
-        goto CLEAN_RETURN;
     }
+    /* check to see if they are all done */
+    if (NULL == proct->revstdout && NULL == proct->revstderr) {
+        /* this proc's iof is complete */
+        PRTE_ACTIVATE_PROC_STATE(&proct->name, PRTE_PROC_STATE_IOF_COMPLETE);
+    }
+    PMIX_RELEASE(cd);
+}
+
+/* hand the output to the local PMIx server and forward it to the HNP */
+static void forward_output(int fd, short event, void *cbdata)
+{
+    prte_iof_prted_caddy_t *cd = (prte_iof_prted_caddy_t *) cbdata;
+    prte_iof_proc_t *proct = cd->proct;
+    pmix_data_buffer_t *buf;
+    prte_iof_deliver_t *p;
+    pmix_iof_channel_t pchan;
+    pmix_status_t prc;
+    int rc;
+    PRTE_HIDE_UNUSED_PARAMS(fd, event);
+
+    PMIX_ACQUIRE_OBJECT(cd);
 
     /* give the PMIx lib a chance to output it if requested */
     pchan = 0;
-    if (PRTE_IOF_STDOUT & rev->tag) {
+    if (PRTE_IOF_STDOUT & cd->tag) {
         pchan |= PMIX_FWD_STDOUT_CHANNEL;
     }
-    if (PRTE_IOF_STDERR & rev->tag) {
+    if (PRTE_IOF_STDERR & cd->tag) {
         pchan |= PMIX_FWD_STDERR_CHANNEL;
     }
-    if (PRTE_IOF_STDDIAG & rev->tag) {
+    if (PRTE_IOF_STDDIAG & cd->tag) {
         pchan |= PMIX_FWD_STDDIAG_CHANNEL;
     }
     /* setup the byte object */
     p = PMIX_NEW(prte_iof_deliver_t);
     PMIX_XFER_PROCID(&p->source, &proct->name);
-    p->bo.bytes = (char*)malloc(numbytes);
-    memcpy(p->bo.bytes, data, numbytes);
-    p->bo.size = numbytes;
+    p->bo.bytes = (char*)malloc(cd->numbytes);
+    memcpy(p->bo.bytes, cd->data, cd->numbytes);
+    p->bo.size = cd->numbytes;
     prc = PMIx_server_IOF_deliver(&p->source, pchan, &p->bo, NULL, 0, lkcbfunc, (void*)p);
     if (PMIX_SUCCESS != prc) {
         PMIX_ERROR_LOG(prc);
@@ -135,69 +158,124 @@ void prte_iof_prted_read_handler(int fd, short event, void *cbdata)
     /* pack the stream first - we do this so that flow control messages can
      * consist solely of the tag
      */
-    rc = PMIx_Data_pack(NULL, buf, &rev->tag, 1, PMIX_UINT16);
+    rc = PMIx_Data_pack(NULL, buf, &cd->tag, 1, PMIX_UINT16);
     if (PMIX_SUCCESS != rc) {
         PMIX_ERROR_LOG(rc);
-        goto CLEAN_RETURN;
+        goto done;
     }
 
     /* pack name of process that gave us this data */
     rc = PMIx_Data_pack(NULL, buf, &proct->name, 1, PMIX_PROC);
     if (PMIX_SUCCESS != rc) {
         PMIX_ERROR_LOG(rc);
-        goto CLEAN_RETURN;
+        goto done;
     }
 
     /* pack the #bytes we read */
-    rc = PMIx_Data_pack(NULL, buf, &numbytes, 1, PMIX_INT32);
+    rc = PMIx_Data_pack(NULL, buf, &cd->numbytes, 1, PMIX_INT32);
     if (PMIX_SUCCESS != rc) {
         PMIX_ERROR_LOG(rc);
-        goto CLEAN_RETURN;
+        goto done;
     }
 
     /* pack the data - only pack the #bytes we read! */
-    rc = PMIx_Data_pack(NULL, buf, data, numbytes, PMIX_BYTE);
+    rc = PMIx_Data_pack(NULL, buf, cd->data, cd->numbytes, PMIX_BYTE);
     if (PMIX_SUCCESS != rc) {
         PMIX_ERROR_LOG(rc);
-        goto CLEAN_RETURN;
+        goto done;
     }
 
     /* start non-blocking RML call to forward received data */
     PMIX_OUTPUT_VERBOSE((1, prte_iof_base_framework.framework_output,
                          "%s iof:prted:read handler sending %d bytes to HNP",
-                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), numbytes));
+                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), cd->numbytes));
 
     PRTE_RML_SEND(rc, PRTE_PROC_MY_HNP->rank, buf, PRTE_RML_TAG_IOF_HNP);
     if (PRTE_SUCCESS != rc) {
         PRTE_ERROR_LOG(rc);
+        goto done;
+    }
+    buf = NULL;
+
+done:
+    if (NULL != buf) {
         PMIX_DATA_BUFFER_RELEASE(buf);
     }
+    PMIX_RELEASE(cd);
+}
+
+void prte_iof_prted_read_handler(int fd, short event, void *cbdata)
+{
+    prte_iof_read_event_t *rev = (prte_iof_read_event_t *) cbdata;
+    unsigned char data[PRTE_IOF_BASE_MSG_MAX];
+    int32_t numbytes;
+    prte_iof_proc_t *proct = (prte_iof_proc_t *) rev->proc;
+    prte_iof_prted_caddy_t *cd;
+    PRTE_HIDE_UNUSED_PARAMS(event);
+
+    PMIX_ACQUIRE_OBJECT(rev);
+
+    /* As we may use timer events, fd can be bogus (-1)
+     * use the right one here
+     */
+    fd = rev->fd;
+
+    /* read up to the fragment size */
+    numbytes = read(fd, data, sizeof(data));
+
+    PMIX_OUTPUT_VERBOSE((1, prte_iof_base_framework.framework_output,
+                         "%s read %d bytes from %s",
+                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), numbytes,
+                         (PRTE_IOF_STDOUT & rev->tag) ? "stdout"
+                         : ((PRTE_IOF_STDERR & rev->tag) ? "stderr" : "stddiag")));
+
+    if (NULL == proct) {
+        /* nothing we can do */
+        PRTE_ERROR_LOG(PRTE_ERR_ADDRESSEE_UNKNOWN);
+        return;
+    }
+
+    if (numbytes <= 0) {
+        if (0 > numbytes) {
+            /* either we have a connection error or it was a non-blocking read */
+            if (EAGAIN == errno || EINTR == errno) {
+                /* non-blocking, retry */
+                PRTE_IOF_READ_ACTIVATE(rev);
+                return;
+            }
+        }
+        /* go down and close the fd etc */
+        goto CLEAN_RETURN;
+    }
+
+    /* the read event holds the proc, so it is safe to
+     * take our own reference here and use it over there */
+    cd = PMIX_NEW(prte_iof_prted_caddy_t);
+    PMIX_RETAIN(proct);
+    cd->proct = proct;
+    cd->tag = rev->tag;
+    cd->data = (unsigned char *) malloc(numbytes);
+    if (NULL == cd->data) {
+        PRTE_ERROR_LOG(PRTE_ERR_OUT_OF_RESOURCE);
+        PMIX_RELEASE(cd);
+        goto CLEAN_RETURN;
+    }
+    memcpy(cd->data, data, numbytes);
+    cd->numbytes = numbytes;
+    PRTE_PMIX_THREADSHIFT(cd, prte_event_base, forward_output);
+
     /* re-add the event */
     PRTE_IOF_READ_ACTIVATE(rev);
-
     return;
 
 CLEAN_RETURN:
     /* must be an error, or zero bytes were read indicating that the
      * proc terminated this IOF channel - either way, release the
-     * corresponding event. This deletes the read event and closes
-     * the file descriptor */
-    if (rev->tag & PRTE_IOF_STDOUT) {
-        if (NULL != proct->revstdout) {
-            PMIX_RELEASE(proct->revstdout);
-        }
-    } else if (rev->tag & PRTE_IOF_STDERR) {
-        if (NULL != proct->revstderr) {
-            PMIX_RELEASE(proct->revstderr);
-        }
-    }
-    /* check to see if they are all done */
-    if (NULL == proct->revstdout && NULL == proct->revstderr) {
-        /* this proc's iof is complete */
-        PRTE_ACTIVATE_PROC_STATE(&proct->name, PRTE_PROC_STATE_IOF_COMPLETE);
-    }
-    if (NULL != buf) {
-        PMIX_DATA_BUFFER_RELEASE(buf);
-    }
+     * corresponding event from the main event loop */
+    cd = PMIX_NEW(prte_iof_prted_caddy_t);
+    PMIX_RETAIN(proct);
+    cd->proct = proct;
+    cd->tag = rev->tag;
+    PRTE_PMIX_THREADSHIFT(cd, prte_event_base, channel_closed);
     return;
 }
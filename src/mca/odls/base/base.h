@@ -30,6 +30,7 @@
  */
 #include "prte_config.h"
 
+#include "src/class/pmix_hash_table.h"
 #include "src/mca/mca.h"
 #include "src/mca/base/pmix_mca_base_framework.h"
 #include "src/mca/iof/base/iof_base_setup.h"
@@ -57,6 +58,19 @@ typedef struct {
     int next_base;                // counter to load-level thread use
     bool signal_direct_children_only;
     char *exec_agent;
+    bool scoped_launch;
+    /* DVM state sync */
+    bool dvm_sync;
+    bool dvm_synced;
+    bool dvm_sync_pending;         // requested, awaiting the response
+    int dvm_sync_rc;               // outcome of the sync
+    uint32_t dvm_version;
+    pmix_list_t sync_reqs;
+    pmix_list_t deferred_launches; // held until the sync completes
+    /* signal escalations in progress */
+    int kill_delay;                // msec between SIGCONT, SIGTERM and SIGKILL
+    pmix_list_t kill_ops;
+    pmix_hash_table_t kill_index;  // children being killed, keyed by object
 } prte_odls_globals_t;
 
 PRTE_EXPORT extern prte_odls_globals_t prte_odls_globals;
@@ -70,6 +84,16 @@ PRTE_EXPORT extern pmix_mca_base_framework_t prte_odls_base_framework;
  */
 PRTE_EXPORT int prte_odls_base_select(void);
 
+/*
+ * DVM state sync for daemons that join an existing DVM
+ */
+PRTE_EXPORT void prte_odls_base_dvm_sync_recv(int status, pmix_proc_t *sender,
+                                              pmix_data_buffer_t *buffer,
+                                              prte_rml_tag_t tag, void *cbdata);
+PRTE_EXPORT void prte_odls_base_dvm_sync_resp(int status, pmix_proc_t *sender,
+                                              pmix_data_buffer_t *buffer,
+                                              prte_rml_tag_t tag, void *cbdata);
+
 /*
  * Default functions that are common to most environments - can
  * be overridden by specific environments if they need something
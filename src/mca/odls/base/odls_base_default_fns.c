@@ -70,6 +70,7 @@
 #include "src/rml/rml_contact.h"
 #include "src/rml/rml.h"
 #include "src/mca/schizo/base/base.h"
+#include "src/mca/state/base/base.h"
 #include "src/mca/state/state.h"
 
 #include "src/prted/pmix/pmix_server.h"
@@ -148,6 +149,748 @@ done:
     PRTE_PMIX_WAKEUP_THREAD(&cd->lock);
 }
 
+/* pack the procs of a job as a rank-ordered table of the fields every
+ * daemon needs, followed by a slice for each daemon holding the full
+ * description of the procs it hosts. The entire section is wrapped in
+ * a byte object so it can be skipped without being decoded */
+static int pack_scoped_procs(pmix_data_buffer_t *buffer, prte_job_t *jdata)
+{
+    pmix_data_buffer_t pbuf, slice;
+    pmix_byte_object_t bo;
+    prte_job_map_t *map = jdata->map;
+    prte_node_t *node;
+    prte_proc_t *pptr;
+    pmix_rank_t v, nprocs = jdata->num_procs;
+    pmix_rank_t *parents = NULL, *appranks = NULL;
+    uint32_t *appidx = NULL, *states = NULL;
+    uint16_t *lranks = NULL, *nranks = NULL;
+    int32_t nslices;
+    int i, k, rc = PRTE_SUCCESS;
+    pmix_status_t ret;
+
+    PMIX_DATA_BUFFER_CONSTRUCT(&pbuf);
+    ret = PMIx_Data_pack(NULL, &pbuf, &nprocs, 1, PMIX_PROC_RANK);
+    if (PMIX_SUCCESS != ret) {
+        PMIX_ERROR_LOG(ret);
+        rc = prte_pmix_convert_status(ret);
+        goto cleanup;
+    }
+    if (0 < nprocs) {
+        parents = (pmix_rank_t *) malloc(nprocs * sizeof(pmix_rank_t));
+        appranks = (pmix_rank_t *) malloc(nprocs * sizeof(pmix_rank_t));
+        appidx = (uint32_t *) malloc(nprocs * sizeof(uint32_t));
+        states = (uint32_t *) malloc(nprocs * sizeof(uint32_t));
+        lranks = (uint16_t *) malloc(nprocs * sizeof(uint16_t));
+        nranks = (uint16_t *) malloc(nprocs * sizeof(uint16_t));
+        if (NULL == parents || NULL == appranks || NULL == appidx ||
+            NULL == states || NULL == lranks || NULL == nranks) {
+            rc = PRTE_ERR_OUT_OF_RESOURCE;
+            PRTE_ERROR_LOG(rc);
+            goto cleanup;
+        }
+        for (v = 0; v < nprocs; v++) {
+            pptr = (prte_proc_t *) pmix_pointer_array_get_item(jdata->procs, v);
+            if (NULL == pptr) {
+                parents[v] = PMIX_RANK_INVALID;
+                appranks[v] = PMIX_RANK_INVALID;
+                appidx[v] = 0;
+                states[v] = PRTE_PROC_STATE_UNDEF;
+                lranks[v] = PRTE_LOCAL_RANK_INVALID;
+                nranks[v] = PRTE_NODE_RANK_INVALID;
+                continue;
+            }
+            parents[v] = pptr->parent;
+            appranks[v] = pptr->app_rank;
+            appidx[v] = pptr->app_idx;
+            states[v] = pptr->state;
+            lranks[v] = pptr->local_rank;
+            nranks[v] = pptr->node_rank;
+        }
+        ret = PMIx_Data_pack(NULL, &pbuf, parents, nprocs, PMIX_PROC_RANK);
+        if (PMIX_SUCCESS == ret) {
+            ret = PMIx_Data_pack(NULL, &pbuf, appidx, nprocs, PMIX_UINT32);
+        }
+        if (PMIX_SUCCESS == ret) {
+            ret = PMIx_Data_pack(NULL, &pbuf, appranks, nprocs, PMIX_PROC_RANK);
+        }
+        if (PMIX_SUCCESS == ret) {
+            ret = PMIx_Data_pack(NULL, &pbuf, lranks, nprocs, PMIX_UINT16);
+        }
+        if (PMIX_SUCCESS == ret) {
+            ret = PMIx_Data_pack(NULL, &pbuf, nranks, nprocs, PMIX_UINT16);
+        }
+        if (PMIX_SUCCESS == ret) {
+            ret = PMIx_Data_pack(NULL, &pbuf, states, nprocs, PMIX_UINT32);
+        }
+        if (PMIX_SUCCESS != ret) {
+            PMIX_ERROR_LOG(ret);
+            rc = prte_pmix_convert_status(ret);
+            goto cleanup;
+        }
+    }
+
+    /* now the per-daemon slices */
+    nslices = 0;
+    for (i = 0; i < map->nodes->size; i++) {
+        node = (prte_node_t *) pmix_pointer_array_get_item(map->nodes, i);
+        if (NULL != node && NULL != node->daemon) {
+            ++nslices;
+        }
+    }
+    ret = PMIx_Data_pack(NULL, &pbuf, &nslices, 1, PMIX_INT32);
+    if (PMIX_SUCCESS != ret) {
+        PMIX_ERROR_LOG(ret);
+        rc = prte_pmix_convert_status(ret);
+        goto cleanup;
+    }
+    for (i = 0; i < map->nodes->size; i++) {
+        node = (prte_node_t *) pmix_pointer_array_get_item(map->nodes, i);
+        if (NULL == node || NULL == node->daemon) {
+            continue;
+        }
+        PMIX_DATA_BUFFER_CONSTRUCT(&slice);
+        for (k = 0; k < node->procs->size; k++) {
+            pptr = (prte_proc_t *) pmix_pointer_array_get_item(node->procs, k);
+            if (NULL == pptr || !PMIX_CHECK_NSPACE(jdata->nspace, pptr->name.nspace)) {
+                continue;
+            }
+            rc = prte_proc_pack(&slice, pptr);
+            if (PRTE_SUCCESS != rc) {
+                PRTE_ERROR_LOG(rc);
+                PMIX_DATA_BUFFER_DESTRUCT(&slice);
+                goto cleanup;
+            }
+        }
+        ret = PMIx_Data_pack(NULL, &pbuf, &node->daemon->name.rank, 1, PMIX_PROC_RANK);
+        if (PMIX_SUCCESS == ret) {
+            ret = PMIx_Data_unload(&slice, &bo);
+        }
+        if (PMIX_SUCCESS == ret) {
+            ret = PMIx_Data_pack(NULL, &pbuf, &bo, 1, PMIX_BYTE_OBJECT);
+            PMIX_BYTE_OBJECT_DESTRUCT(&bo);
+        }
+        PMIX_DATA_BUFFER_DESTRUCT(&slice);
+        if (PMIX_SUCCESS != ret) {
+            PMIX_ERROR_LOG(ret);
+            rc = prte_pmix_convert_status(ret);
+            goto cleanup;
+        }
+    }
+
+    ret = PMIx_Data_unload(&pbuf, &bo);
+    if (PMIX_SUCCESS == ret) {
+        ret = PMIx_Data_pack(NULL, buffer, &bo, 1, PMIX_BYTE_OBJECT);
+        PMIX_BYTE_OBJECT_DESTRUCT(&bo);
+    }
+    if (PMIX_SUCCESS != ret) {
+        PMIX_ERROR_LOG(ret);
+        rc = prte_pmix_convert_status(ret);
+    }
+
+cleanup:
+    PMIX_DATA_BUFFER_DESTRUCT(&pbuf);
+    if (NULL != parents) {
+        free(parents);
+    }
+    if (NULL != appranks) {
+        free(appranks);
+    }
+    if (NULL != appidx) {
+        free(appidx);
+    }
+    if (NULL != states) {
+        free(states);
+    }
+    if (NULL != lranks) {
+        free(lranks);
+    }
+    if (NULL != nranks) {
+        free(nranks);
+    }
+    return rc;
+}
+
+/* rebuild the procs of a job from the output of pack_scoped_procs -
+ * procs hosted elsewhere are reconstructed from the location table,
+ * while our own are unpacked in full from our slice */
+static int unpack_scoped_procs(pmix_data_buffer_t *buffer, prte_job_t *jdata)
+{
+    pmix_data_buffer_t pbuf, slice;
+    pmix_byte_object_t bo;
+    prte_proc_t *pptr, *old;
+    pmix_rank_t v, nprocs, dmn;
+    pmix_rank_t *parents = NULL, *appranks = NULL;
+    uint32_t *appidx = NULL, *states = NULL;
+    uint16_t *lranks = NULL, *nranks = NULL;
+    int32_t cnt, n, nslices;
+    int rc = PRTE_SUCCESS;
+    pmix_status_t ret;
+
+    cnt = 1;
+    ret = PMIx_Data_unpack(NULL, buffer, &bo, &cnt, PMIX_BYTE_OBJECT);
+    if (PMIX_SUCCESS != ret) {
+        PMIX_ERROR_LOG(ret);
+        return prte_pmix_convert_status(ret);
+    }
+    if (PRTE_PROC_IS_MASTER) {
+        /* we already have the complete procs */
+        PMIX_BYTE_OBJECT_DESTRUCT(&bo);
+        return PRTE_SUCCESS;
+    }
+    PMIX_DATA_BUFFER_CONSTRUCT(&pbuf);
+    ret = PMIx_Data_load(&pbuf, &bo);
+    if (PMIX_SUCCESS != ret) {
+        PMIX_ERROR_LOG(ret);
+        PMIX_BYTE_OBJECT_DESTRUCT(&bo);
+        return prte_pmix_convert_status(ret);
+    }
+
+    cnt = 1;
+    ret = PMIx_Data_unpack(NULL, &pbuf, &nprocs, &cnt, PMIX_PROC_RANK);
+    if (PMIX_SUCCESS != ret) {
+        PMIX_ERROR_LOG(ret);
+        rc = prte_pmix_convert_status(ret);
+        goto cleanup;
+    }
+    if (0 < nprocs) {
+        parents = (pmix_rank_t *) malloc(nprocs * sizeof(pmix_rank_t));
+        appranks = (pmix_rank_t *) malloc(nprocs * sizeof(pmix_rank_t));
+        appidx = (uint32_t *) malloc(nprocs * sizeof(uint32_t));
+        states = (uint32_t *) malloc(nprocs * sizeof(uint32_t));
+        lranks = (uint16_t *) malloc(nprocs * sizeof(uint16_t));
+        nranks = (uint16_t *) malloc(nprocs * sizeof(uint16_t));
+        if (NULL == parents || NULL == appranks || NULL == appidx ||
+            NULL == states || NULL == lranks || NULL == nranks) {
+            rc = PRTE_ERR_OUT_OF_RESOURCE;
+            PRTE_ERROR_LOG(rc);
+            goto cleanup;
+        }
+        cnt = nprocs;
+        ret = PMIx_Data_unpack(NULL, &pbuf, parents, &cnt, PMIX_PROC_RANK);
+        if (PMIX_SUCCESS == ret) {
+            cnt = nprocs;
+            ret = PMIx_Data_unpack(NULL, &pbuf, appidx, &cnt, PMIX_UINT32);
+        }
+        if (PMIX_SUCCESS == ret) {
+            cnt = nprocs;
+            ret = PMIx_Data_unpack(NULL, &pbuf, appranks, &cnt, PMIX_PROC_RANK);
+        }
+        if (PMIX_SUCCESS == ret) {
+            cnt = nprocs;
+            ret = PMIx_Data_unpack(NULL, &pbuf, lranks, &cnt, PMIX_UINT16);
+        }
+        if (PMIX_SUCCESS == ret) {
+            cnt = nprocs;
+            ret = PMIx_Data_unpack(NULL, &pbuf, nranks, &cnt, PMIX_UINT16);
+        }
+        if (PMIX_SUCCESS == ret) {
+            cnt = nprocs;
+            ret = PMIx_Data_unpack(NULL, &pbuf, states, &cnt, PMIX_UINT32);
+        }
+        if (PMIX_SUCCESS != ret) {
+            PMIX_ERROR_LOG(ret);
+            rc = prte_pmix_convert_status(ret);
+            goto cleanup;
+        }
+        for (v = 0; v < nprocs; v++) {
+            if (PMIX_RANK_INVALID == parents[v]) {
+                continue;
+            }
+            pptr = PMIX_NEW(prte_proc_t);
+            PMIX_LOAD_PROCID(&pptr->name, jdata->nspace, v);
+            pptr->parent = parents[v];
+            pptr->app_idx = appidx[v];
+            pptr->app_rank = appranks[v];
+            pptr->local_rank = lranks[v];
+            pptr->node_rank = nranks[v];
+            pptr->state = states[v];
+            pmix_pointer_array_set_item(jdata->procs, v, pptr);
+        }
+    }
+
+    /* find our slice */
+    cnt = 1;
+    ret = PMIx_Data_unpack(NULL, &pbuf, &nslices, &cnt, PMIX_INT32);
+    if (PMIX_SUCCESS != ret) {
+        PMIX_ERROR_LOG(ret);
+        rc = prte_pmix_convert_status(ret);
+        goto cleanup;
+    }
+    for (n = 0; n < nslices; n++) {
+        cnt = 1;
+        ret = PMIx_Data_unpack(NULL, &pbuf, &dmn, &cnt, PMIX_PROC_RANK);
+        if (PMIX_SUCCESS == ret) {
+            cnt = 1;
+            ret = PMIx_Data_unpack(NULL, &pbuf, &bo, &cnt, PMIX_BYTE_OBJECT);
+        }
+        if (PMIX_SUCCESS != ret) {
+            PMIX_ERROR_LOG(ret);
+            rc = prte_pmix_convert_status(ret);
+            goto cleanup;
+        }
+        if (dmn != PRTE_PROC_MY_NAME->rank) {
+            PMIX_BYTE_OBJECT_DESTRUCT(&bo);
+            continue;
+        }
+        PMIX_DATA_BUFFER_CONSTRUCT(&slice);
+        ret = PMIx_Data_load(&slice, &bo);
+        if (PMIX_SUCCESS != ret) {
+            PMIX_ERROR_LOG(ret);
+            PMIX_BYTE_OBJECT_DESTRUCT(&bo);
+            rc = prte_pmix_convert_status(ret);
+            goto cleanup;
+        }
+        while (0 < slice.bytes_used - (slice.unpack_ptr - slice.base_ptr)) {
+            rc = prte_proc_unpack(&slice, &pptr);
+            if (PRTE_SUCCESS != rc) {
+                PRTE_ERROR_LOG(rc);
+                PMIX_DATA_BUFFER_DESTRUCT(&slice);
+                goto cleanup;
+            }
+            old = (prte_proc_t *) pmix_pointer_array_get_item(jdata->procs, pptr->name.rank);
+            pmix_pointer_array_set_item(jdata->procs, pptr->name.rank, pptr);
+            if (NULL != old) {
+                PMIX_RELEASE(old);
+            }
+        }
+        PMIX_DATA_BUFFER_DESTRUCT(&slice);
+        break;
+    }
+
+cleanup:
+    PMIX_DATA_BUFFER_DESTRUCT(&pbuf);
+    if (NULL != parents) {
+        free(parents);
+    }
+    if (NULL != appranks) {
+        free(appranks);
+    }
+    if (NULL != appidx) {
+        free(appidx);
+    }
+    if (NULL != states) {
+        free(states);
+    }
+    if (NULL != lranks) {
+        free(lranks);
+    }
+    if (NULL != nranks) {
+        free(nranks);
+    }
+    return rc;
+}
+
+/* connect a proc of a job received from elsewhere to the node
+ * of the daemon hosting it */
+static int wire_proc(prte_job_t *jdata, prte_job_t *daemons, pmix_rank_t v, pmix_rank_t dmnvpid)
+{
+    prte_proc_t *pptr, *dmn;
+
+    pptr = (prte_proc_t *) pmix_pointer_array_get_item(jdata->procs, v);
+    if (NULL == pptr) {
+        pptr = PMIX_NEW(prte_proc_t);
+        PMIX_LOAD_PROCID(&pptr->name, jdata->nspace, v);
+        pmix_pointer_array_set_item(jdata->procs, v, pptr);
+    }
+    /* lookup the daemon */
+    dmn = (prte_proc_t *) pmix_pointer_array_get_item(daemons->procs, dmnvpid);
+    if (NULL == dmn) {
+        PRTE_ERROR_LOG(PRTE_ERR_NOT_FOUND);
+        return PRTE_ERR_NOT_FOUND;
+    }
+    /* connect the two */
+    pptr->parent = dmnvpid;
+    PMIX_RETAIN(dmn->node);
+    pptr->node = dmn->node;
+
+    /* add the node to the job map, if needed */
+    if (!PRTE_FLAG_TEST(pptr->node, PRTE_NODE_FLAG_MAPPED)) {
+        PMIX_RETAIN(pptr->node);
+        pmix_pointer_array_add(jdata->map->nodes, pptr->node);
+        jdata->map->num_nodes++;
+        PRTE_FLAG_SET(pptr->node, PRTE_NODE_FLAG_MAPPED);
+    }
+    /* add this proc to that node */
+    PMIX_RETAIN(pptr);
+    pmix_pointer_array_add(pptr->node->procs, pptr);
+    pptr->node->num_procs++;
+    return PRTE_SUCCESS;
+}
+
+static void reset_mapped(prte_job_t *jdata)
+{
+    prte_node_t *node;
+    int n;
+
+    for (n = 0; n < jdata->map->nodes->size; n++) {
+        node = (prte_node_t *) pmix_pointer_array_get_item(jdata->map->nodes, n);
+        if (NULL != node) {
+            PRTE_FLAG_UNSET(node, PRTE_NODE_FLAG_MAPPED);
+        }
+    }
+}
+
+/* undo wire_proc for each proc of a job we could not fully
+ * wire, and forget the job */
+static void unwire_job(prte_job_t *jdata)
+{
+    prte_node_t *node;
+    prte_proc_t *pptr;
+    int n, m;
+
+    for (n = 0; n < jdata->map->nodes->size; n++) {
+        node = (prte_node_t *) pmix_pointer_array_get_item(jdata->map->nodes, n);
+        if (NULL == node) {
+            continue;
+        }
+        for (m = 0; m < node->procs->size; m++) {
+            pptr = (prte_proc_t *) pmix_pointer_array_get_item(node->procs, m);
+            if (NULL != pptr && PMIX_CHECK_NSPACE(pptr->name.nspace, jdata->nspace)) {
+                pmix_pointer_array_set_item(node->procs, m, NULL);
+                node->num_procs--;
+                PMIX_RELEASE(pptr);
+            }
+        }
+    }
+    /* releasing it also removes it from the job data array */
+    PMIX_RELEASE(jdata);
+}
+
+/****    DVM STATE SYNC    ****/
+
+typedef struct {
+    pmix_list_item_t super;
+    pmix_rank_t requestor;
+    uint32_t version;
+} prte_odls_sync_req_t;
+static PMIX_CLASS_INSTANCE(prte_odls_sync_req_t,
+                           pmix_list_item_t,
+                           NULL, NULL);
+
+static int request_sync(uint32_t version)
+{
+    pmix_data_buffer_t *buf;
+    pmix_status_t ret;
+    int rc;
+
+    PMIX_OUTPUT_VERBOSE((5, prte_odls_base_framework.framework_output,
+                         "%s odls:dvm_sync requesting state version %u from %s",
+                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), version,
+                         PRTE_VPID_PRINT(PRTE_PROC_MY_PARENT->rank)));
+
+    PMIX_DATA_BUFFER_CREATE(buf);
+    ret = PMIx_Data_pack(NULL, buf, &version, 1, PMIX_UINT32);
+    if (PMIX_SUCCESS != ret) {
+        PMIX_ERROR_LOG(ret);
+        PMIX_DATA_BUFFER_RELEASE(buf);
+        return prte_pmix_convert_status(ret);
+    }
+    PRTE_RML_SEND(rc, PRTE_PROC_MY_PARENT->rank, buf, PRTE_RML_TAG_DVM_SYNC);
+    if (PRTE_SUCCESS != rc) {
+        PRTE_ERROR_LOG(rc);
+        PMIX_DATA_BUFFER_RELEASE(buf);
+    }
+    return rc;
+}
+
+/* a launch message held until the DVM state sync completes */
+typedef struct {
+    pmix_list_item_t super;
+    pmix_data_buffer_t *buf;
+} prte_odls_deferred_t;
+static void dcon(prte_odls_deferred_t *p)
+{
+    p->buf = NULL;
+}
+static void ddes(prte_odls_deferred_t *p)
+{
+    if (NULL != p->buf) {
+        PMIX_DATA_BUFFER_RELEASE(p->buf);
+    }
+}
+static PMIX_CLASS_INSTANCE(prte_odls_deferred_t,
+                           pmix_list_item_t,
+                           dcon, ddes);
+
+/* save the rest of a launch message, restoring the fields
+ * already taken from it, so it can be replayed in full */
+static int defer_launch(pmix_data_buffer_t *buffer, int8_t flag, uint32_t stamp)
+{
+    prte_odls_deferred_t *d;
+    pmix_status_t ret;
+
+    d = PMIX_NEW(prte_odls_deferred_t);
+    PMIX_DATA_BUFFER_CREATE(d->buf);
+    ret = PMIx_Data_pack(NULL, d->buf, &flag, 1, PMIX_INT8);
+    if (PMIX_SUCCESS == ret) {
+        ret = PMIx_Data_pack(NULL, d->buf, &stamp, 1, PMIX_UINT32);
+    }
+    if (PMIX_SUCCESS == ret) {
+        ret = PMIx_Data_copy_payload(d->buf, buffer);
+    }
+    if (PMIX_SUCCESS != ret) {
+        PMIX_ERROR_LOG(ret);
+        PMIX_RELEASE(d);
+        return prte_pmix_convert_status(ret);
+    }
+    PMIX_OUTPUT_VERBOSE((5, prte_odls_base_framework.framework_output,
+                         "%s odls:dvm_sync deferring launch until synced",
+                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME)));
+    pmix_list_append(&prte_odls_globals.deferred_launches, &d->super);
+    return PRTE_SUCCESS;
+}
+
+/* send the live jobs that precede the given version - each job
+ * is packed without its procs, followed by the daemon hosting
+ * each proc */
+static void send_snapshot(pmix_rank_t requestor, uint32_t version)
+{
+    pmix_data_buffer_t *buf, jbuf;
+    pmix_byte_object_t bo;
+    prte_job_t *jptr;
+    prte_proc_t *pptr;
+    pmix_rank_t v, *parents;
+    uint32_t stamp, *sptr = &stamp;
+    pmix_status_t ret;
+    int i, rc, njobs = 0;
+
+    PMIX_DATA_BUFFER_CREATE(buf);
+    for (i = 1; i < prte_job_data->size; i++) {
+        jptr = (prte_job_t *) pmix_pointer_array_get_item(prte_job_data, i);
+        if (NULL == jptr || PRTE_JOB_STATE_TERMINATED <= jptr->state) {
+            continue;
+        }
+        if (!prte_get_attribute(&jptr->attributes, PRTE_JOB_DVM_VERSION, (void **) &sptr, PMIX_UINT32)) {
+            stamp = UINT32_MAX;
+        } else if (version <= stamp) {
+            /* the requestor will learn of this one directly */
+            continue;
+        }
+        PMIX_DATA_BUFFER_CONSTRUCT(&jbuf);
+        ret = PMIx_Data_pack(NULL, &jbuf, &stamp, 1, PMIX_UINT32);
+        if (PMIX_SUCCESS != ret) {
+            PMIX_ERROR_LOG(ret);
+            PMIX_DATA_BUFFER_DESTRUCT(&jbuf);
+            continue;
+        }
+        rc = prte_job_pack_noprocs(&jbuf, jptr);
+        if (PRTE_SUCCESS != rc) {
+            PRTE_ERROR_LOG(rc);
+            PMIX_DATA_BUFFER_DESTRUCT(&jbuf);
+            continue;
+        }
+        if (0 < jptr->num_procs) {
+            parents = (pmix_rank_t *) malloc(jptr->num_procs * sizeof(pmix_rank_t));
+            for (v = 0; v < jptr->num_procs; v++) {
+                pptr = (prte_proc_t *) pmix_pointer_array_get_item(jptr->procs, v);
+                parents[v] = (NULL == pptr) ? PMIX_RANK_INVALID : pptr->parent;
+            }
+            ret = PMIx_Data_pack(NULL, &jbuf, parents, jptr->num_procs, PMIX_PROC_RANK);
+            free(parents);
+            if (PMIX_SUCCESS != ret) {
+                PMIX_ERROR_LOG(ret);
+                PMIX_DATA_BUFFER_DESTRUCT(&jbuf);
+                continue;
+            }
+        }
+        ret = PMIx_Data_unload(&jbuf, &bo);
+        if (PMIX_SUCCESS == ret) {
+            ret = PMIx_Data_pack(NULL, buf, &bo, 1, PMIX_BYTE_OBJECT);
+            PMIX_BYTE_OBJECT_DESTRUCT(&bo);
+        }
+        PMIX_DATA_BUFFER_DESTRUCT(&jbuf);
+        if (PMIX_SUCCESS != ret) {
+            PMIX_ERROR_LOG(ret);
+            continue;
+        }
+        ++njobs;
+    }
+
+    PMIX_OUTPUT_VERBOSE((5, prte_odls_base_framework.framework_output,
+                         "%s odls:dvm_sync sending %d jobs to %s",
+                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), njobs,
+                         PRTE_VPID_PRINT(requestor)));
+
+    PRTE_RML_SEND(rc, requestor, buf, PRTE_RML_TAG_DVM_SYNC_RESP);
+    if (PRTE_SUCCESS != rc) {
+        PRTE_ERROR_LOG(rc);
+        PMIX_DATA_BUFFER_RELEASE(buf);
+    }
+}
+
+/* answer any requests we now have the state to fill */
+static void serve_sync_reqs(void)
+{
+    prte_odls_sync_req_t *req, *next;
+
+    if (!prte_odls_globals.dvm_synced) {
+        return;
+    }
+    PMIX_LIST_FOREACH_SAFE(req, next, &prte_odls_globals.sync_reqs, prte_odls_sync_req_t) {
+        if (req->version <= prte_odls_globals.dvm_version) {
+            pmix_list_remove_item(&prte_odls_globals.sync_reqs, &req->super);
+            send_snapshot(req->requestor, req->version);
+            PMIX_RELEASE(req);
+        }
+    }
+}
+
+void prte_odls_base_dvm_sync_recv(int status, pmix_proc_t *sender,
+                                  pmix_data_buffer_t *buffer,
+                                  prte_rml_tag_t tag, void *cbdata)
+{
+    prte_odls_sync_req_t *req;
+    uint32_t version;
+    int32_t cnt;
+    pmix_status_t ret;
+    PRTE_HIDE_UNUSED_PARAMS(status, tag, cbdata);
+
+    cnt = 1;
+    ret = PMIx_Data_unpack(NULL, buffer, &version, &cnt, PMIX_UINT32);
+    if (PMIX_SUCCESS != ret) {
+        PMIX_ERROR_LOG(ret);
+        return;
+    }
+    PMIX_OUTPUT_VERBOSE((5, prte_odls_base_framework.framework_output,
+                         "%s odls:dvm_sync request for state version %u from %s",
+                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), version,
+                         PRTE_NAME_PRINT(sender)));
+
+    /* we may still be catching up ourselves */
+    req = PMIX_NEW(prte_odls_sync_req_t);
+    req->requestor = sender->rank;
+    req->version = version;
+    pmix_list_append(&prte_odls_globals.sync_reqs, &req->super);
+    serve_sync_reqs();
+}
+
+void prte_odls_base_dvm_sync_resp(int status, pmix_proc_t *sender,
+                                  pmix_data_buffer_t *buffer,
+                                  prte_rml_tag_t tag, void *cbdata)
+{
+    pmix_data_buffer_t jbuf;
+    pmix_byte_object_t bo;
+    prte_job_t *jdata, *daemons;
+    prte_odls_deferred_t *d;
+    pmix_rank_t v, *parents;
+    uint32_t stamp;
+    int32_t cnt;
+    pmix_status_t ret;
+    int rc;
+    PRTE_HIDE_UNUSED_PARAMS(status, sender, tag, cbdata);
+
+    daemons = prte_get_job_data_object(PRTE_PROC_MY_NAME->nspace);
+
+    cnt = 1;
+    ret = PMIx_Data_unpack(NULL, buffer, &bo, &cnt, PMIX_BYTE_OBJECT);
+    while (PMIX_SUCCESS == ret) {
+        PMIX_DATA_BUFFER_CONSTRUCT(&jbuf);
+        ret = PMIx_Data_load(&jbuf, &bo);
+        if (PMIX_SUCCESS != ret) {
+            PMIX_ERROR_LOG(ret);
+            PMIX_BYTE_OBJECT_DESTRUCT(&bo);
+            break;
+        }
+        cnt = 1;
+        ret = PMIx_Data_unpack(NULL, &jbuf, &stamp, &cnt, PMIX_UINT32);
+        if (PMIX_SUCCESS != ret) {
+            PMIX_ERROR_LOG(ret);
+            PMIX_DATA_BUFFER_DESTRUCT(&jbuf);
+            break;
+        }
+        rc = prte_job_unpack(&jbuf, &jdata);
+        if (PRTE_SUCCESS != rc) {
+            PRTE_ERROR_LOG(rc);
+            PMIX_DATA_BUFFER_DESTRUCT(&jbuf);
+            prte_odls_globals.dvm_sync_rc = rc;
+            break;
+        }
+        /* check to see if we already have this one */
+        if (NULL != prte_get_job_data_object(jdata->nspace)) {
+            /* yep - so we can drop this copy */
+            jdata->index = -1;
+            PMIX_RELEASE(jdata);
+            PMIX_DATA_BUFFER_DESTRUCT(&jbuf);
+            goto next;
+        }
+        prte_set_job_data_object(jdata);
+        if (UINT32_MAX != stamp) {
+            prte_set_attribute(&jdata->attributes, PRTE_JOB_DVM_VERSION, PRTE_ATTR_LOCAL,
+                               &stamp, PMIX_UINT32);
+        }
+        if (NULL == jdata->map) {
+            jdata->map = PMIX_NEW(prte_job_map_t);
+        }
+        if (0 < jdata->num_procs) {
+            parents = (pmix_rank_t *) malloc(jdata->num_procs * sizeof(pmix_rank_t));
+            cnt = jdata->num_procs;
+            ret = PMIx_Data_unpack(NULL, &jbuf, parents, &cnt, PMIX_PROC_RANK);
+            if (PMIX_SUCCESS != ret) {
+                PMIX_ERROR_LOG(ret);
+                free(parents);
+                PMIX_DATA_BUFFER_DESTRUCT(&jbuf);
+                break;
+            }
+            rc = PRTE_SUCCESS;
+            for (v = 0; v < jdata->num_procs; v++) {
+                if (PMIX_RANK_INVALID == parents[v]) {
+                    continue;
+                }
+                rc = wire_proc(jdata, daemons, v, parents[v]);
+                if (PRTE_SUCCESS != rc) {
+                    break;
+                }
+            }
+            free(parents);
+            reset_mapped(jdata);
+            if (PRTE_SUCCESS != rc) {
+                /* we cannot host procs of a DVM whose state we
+                 * do not know - drop the partial job, which may
+                 * still be running elsewhere, and fail the sync
+                 * so the launches we held are reported as failed */
+                PRTE_ERROR_LOG(rc);
+                PMIX_DATA_BUFFER_DESTRUCT(&jbuf);
+                unwire_job(jdata);
+                prte_odls_globals.dvm_sync_rc = rc;
+                ret = PMIX_SUCCESS;
+                break;
+            }
+        }
+        PMIX_DATA_BUFFER_DESTRUCT(&jbuf);
+        // now register this job
+        rc = prte_pmix_server_register_nspace(jdata);
+        if (PRTE_SUCCESS != rc) {
+            PRTE_ERROR_LOG(rc);
+        }
+next:
+        cnt = 1;
+        ret = PMIx_Data_unpack(NULL, buffer, &bo, &cnt, PMIX_BYTE_OBJECT);
+    }
+    if (PMIX_SUCCESS != ret && PMIX_ERR_UNPACK_READ_PAST_END_OF_BUFFER != ret) {
+        PMIX_ERROR_LOG(ret);
+        prte_odls_globals.dvm_sync_rc = prte_pmix_convert_status(ret);
+    }
+
+    PMIX_OUTPUT_VERBOSE((5, prte_odls_base_framework.framework_output,
+                         "%s odls:dvm_sync complete at state version %u: %s",
+                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), prte_odls_globals.dvm_version,
+                         PRTE_ERROR_NAME(prte_odls_globals.dvm_sync_rc)));
+
+    /* we are now able to help others */
+    prte_odls_globals.dvm_synced = true;
+    prte_odls_globals.dvm_sync_pending = false;
+    serve_sync_reqs();
+
+    /* and to launch whatever arrived in the meantime */
+    while (NULL != (d = (prte_odls_deferred_t *) pmix_list_remove_first(&prte_odls_globals.deferred_launches))) {
+        rc = prte_odls.launch_local_procs(d->buf);
+        if (PRTE_SUCCESS != rc) {
+            PRTE_ERROR_LOG(rc);
+        }
+        PMIX_RELEASE(d);
+    }
+}
+
 /* IT IS CRITICAL THAT ANY CHANGE IN THE ORDER OF THE INFO PACKED IN
  * THIS FUNCTION BE REFLECTED IN THE CONSTRUCT_CHILD_LIST PARSER BELOW
  */
@@ -167,6 +910,7 @@ int prte_odls_base_default_get_add_procs_data(pmix_data_buffer_t *buffer, pmix_n
     prte_proc_t *pptr;
     uint32_t uid;
     uint32_t gid;
+    uint32_t stamp;
     pmix_byte_object_t pbo;
     void *ilist, *mlist;
     pmix_data_array_t darray;
@@ -184,17 +928,32 @@ int prte_odls_base_default_get_add_procs_data(pmix_data_buffer_t *buffer, pmix_n
         return PRTE_SUCCESS;
     }
 
+    /* stamp the job with the DVM state version it creates */
+    stamp = prte_odls_globals.dvm_version++;
+    prte_set_attribute(&jdata->attributes, PRTE_JOB_DVM_VERSION, PRTE_ATTR_LOCAL,
+                       &stamp, PMIX_UINT32);
+
     /* we need to ensure that any new daemons get a complete
      * copy of all active jobs so the grpcomm collectives can
      * properly work should a proc from one of the other jobs
      * interact with this one */
     if (prte_get_attribute(&jdata->attributes, PRTE_JOB_LAUNCHED_DAEMONS, NULL, PMIX_BOOL)) {
-        flag = 1;
+        /* if requested, the new daemons will fetch the
+         * jobs from their parent */
+        flag = prte_odls_globals.dvm_sync ? 2 : 1;
         rc = PMIx_Data_pack(NULL, buffer, &flag, 1, PMIX_INT8);
         if (PMIX_SUCCESS != rc) {
             PMIX_ERROR_LOG(rc);
             return rc;
         }
+        rc = PMIx_Data_pack(NULL, buffer, &stamp, 1, PMIX_UINT32);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            return rc;
+        }
+        if (2 == flag) {
+            goto packjob;
+        }
         PMIX_DATA_BUFFER_CONSTRUCT(&jobdata);
         for (i = 1; i < prte_job_data->size; i++) {
             jptr = pmix_pointer_array_get_item(prte_job_data, i);
@@ -265,10 +1024,31 @@ int prte_odls_base_default_get_add_procs_data(pmix_data_buffer_t *buffer, pmix_n
             PMIX_ERROR_LOG(rc);
             return rc;
         }
+        rc = PMIx_Data_pack(NULL, buffer, &stamp, 1, PMIX_UINT32);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            return rc;
+        }
+    }
+
+packjob:
+    /* flag how the procs are being sent */
+    flag = prte_odls_globals.scoped_launch ? 1 : 0;
+    rc = PMIx_Data_pack(NULL, buffer, &flag, 1, PMIX_INT8);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return rc;
     }
 
     /* pack the job struct */
-    rc = prte_job_pack(buffer, jdata);
+    if (prte_odls_globals.scoped_launch) {
+        rc = prte_job_pack_noprocs(buffer, jdata);
+        if (PRTE_SUCCESS == rc) {
+            rc = pack_scoped_procs(buffer, jdata);
+        }
+    } else {
+        rc = prte_job_pack(buffer, jdata);
+    }
     if (PMIX_SUCCESS != rc) {
         PMIX_ERROR_LOG(rc);
         return rc;
@@ -405,7 +1185,8 @@ int prte_odls_base_default_construct_child_list(pmix_data_buffer_t *buffer, pmix
     pmix_data_buffer_t dbuf, jdbuf;
     prte_proc_t *pptr, *dmn;
     prte_app_context_t *app;
-    int8_t flag;
+    int8_t flag, scoped;
+    uint32_t stamp;
     prte_pmix_lock_t lock;
     pmix_info_t *info = NULL;
     size_t ninfo = 0;
@@ -434,8 +1215,41 @@ int prte_odls_base_default_construct_child_list(pmix_data_buffer_t *buffer, pmix
         rc = prte_pmix_convert_status(rc);
         goto REPORT_ERROR;
     }
+    /* and the DVM state version this job creates */
+    cnt = 1;
+    rc = PMIx_Data_unpack(NULL, buffer, &stamp, &cnt, PMIX_UINT32);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        rc = prte_pmix_convert_status(rc);
+        goto REPORT_ERROR;
+    }
+    if (!PRTE_PROC_IS_MASTER && !prte_odls_globals.dvm_synced
+        && !prte_odls_globals.dvm_sync_pending) {
+        if (2 == flag && 0 < stamp) {
+            /* we joined a DVM that already has jobs - fetch
+             * them from our parent */
+            rc = request_sync(stamp);
+            if (PRTE_SUCCESS != rc) {
+                goto REPORT_ERROR;
+            }
+            prte_odls_globals.dvm_sync_pending = true;
+        } else {
+            /* either there were no prior jobs or they
+             * are included in this message */
+            prte_odls_globals.dvm_synced = true;
+        }
+    }
+    if (prte_odls_globals.dvm_sync_pending) {
+        /* the procs of this job may need to know about
+         * the prior ones - hold it until we have them */
+        rc = defer_launch(buffer, flag, stamp);
+        if (PRTE_SUCCESS != rc) {
+            goto REPORT_ERROR;
+        }
+        return PRTE_ERR_OP_IN_PROGRESS;
+    }
 
-    if (0 != flag) {
+    if (1 == flag) {
         /* unpack the buffer containing the info */
         cnt = 1;
         rc = PMIx_Data_unpack(NULL, buffer, &bo, &cnt, PMIX_BYTE_OBJECT);
@@ -485,12 +1299,6 @@ int prte_odls_base_default_construct_child_list(pmix_data_buffer_t *buffer, pmix
                 prte_set_job_data_object(jdata);
                 /* unpack the location of each proc in this job */
                 for (v = 0; v < jdata->num_procs; v++) {
-                    pptr = (prte_proc_t *) pmix_pointer_array_get_item(jdata->procs, v);
-                    if (NULL == pptr) {
-                        pptr = PMIX_NEW(prte_proc_t);
-                        PMIX_LOAD_PROCID(&pptr->name, jdata->nspace, v);
-                        pmix_pointer_array_set_item(jdata->procs, v, pptr);
-                    }
                     cnt = 1;
                     rc = PMIx_Data_unpack(NULL, &jdbuf, &dmnvpid, &cnt, PMIX_PROC_RANK);
                     if (PMIX_SUCCESS != rc) {
@@ -499,39 +1307,14 @@ int prte_odls_base_default_construct_child_list(pmix_data_buffer_t *buffer, pmix
                         PMIX_DATA_BUFFER_DESTRUCT(&jdbuf);
                         goto REPORT_ERROR;
                     }
-                    /* lookup the daemon */
-                    dmn = (prte_proc_t *) pmix_pointer_array_get_item(daemons->procs, dmnvpid);
-                    if (NULL == dmn) {
-                        PRTE_ERROR_LOG(PRTE_ERR_NOT_FOUND);
-                        rc = PRTE_ERR_NOT_FOUND;
+                    rc = wire_proc(jdata, daemons, v, dmnvpid);
+                    if (PRTE_SUCCESS != rc) {
                         PMIX_DATA_BUFFER_DESTRUCT(&dbuf);
                         PMIX_DATA_BUFFER_DESTRUCT(&jdbuf);
                         goto REPORT_ERROR;
                     }
-                    /* connect the two */
-                    PMIX_RETAIN(dmn->node);
-                    pptr->node = dmn->node;
-
-                    /* add the node to the job map, if needed */
-                    if (!PRTE_FLAG_TEST(pptr->node, PRTE_NODE_FLAG_MAPPED)) {
-                        PMIX_RETAIN(pptr->node);
-                        pmix_pointer_array_add(jdata->map->nodes, pptr->node);
-                        jdata->map->num_nodes++;
-                        PRTE_FLAG_SET(pptr->node, PRTE_NODE_FLAG_MAPPED);
-                    }
-                    /* add this proc to that node */
-                    PMIX_RETAIN(pptr);
-                    pmix_pointer_array_add(pptr->node->procs, pptr);
-                    pptr->node->num_procs++;
-                }
-                /* reset the mapped flags */
-                for (n = 0; n < jdata->map->nodes->size; n++) {
-                    node = (prte_node_t *) pmix_pointer_array_get_item(jdata->map->nodes, n);
-                    if (NULL != node) {
-                        PRTE_FLAG_UNSET(node, PRTE_NODE_FLAG_MAPPED);
-                    }
-
                 }
+                reset_mapped(jdata);
                 // now register this job
                 rc = prte_pmix_server_register_nspace(jdata);
                 if (PRTE_SUCCESS != rc) {
@@ -552,6 +1335,15 @@ int prte_odls_base_default_construct_child_list(pmix_data_buffer_t *buffer, pmix
     }
 
 next:
+    /* unpack the flag indicating how the procs were sent */
+    cnt = 1;
+    rc = PMIx_Data_unpack(NULL, buffer, &scoped, &cnt, PMIX_INT8);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        rc = prte_pmix_convert_status(rc);
+        goto REPORT_ERROR;
+    }
+
     /* unpack the job we are to launch */
     rc = prte_job_unpack(buffer, &jdata);
     if (PMIX_SUCCESS != rc) {
@@ -564,6 +1356,7 @@ next:
         goto REPORT_ERROR;
     }
     PMIX_LOAD_NSPACE(*job, jdata->nspace);
+    PRTE_TIMELINE_MARK(jdata->nspace, PRTE_TIMELINE_LAUNCH_RECVD);
 
     PMIX_OUTPUT_VERBOSE((5, prte_odls_base_framework.framework_output,
                          "%s odls:construct_child_list unpacking data to launch job %s",
@@ -599,6 +1392,12 @@ next:
         if (NULL == jdata->map) {
             jdata->map = PMIX_NEW(prte_job_map_t);
         }
+        if (PRTE_SUCCESS != prte_odls_globals.dvm_sync_rc) {
+            /* we never learned the state of the DVM - now that the
+             * job can be found, report that it cannot launch here */
+            rc = prte_odls_globals.dvm_sync_rc;
+            goto REPORT_ERROR;
+        }
         /* get the associated schizo module */
         if (NULL != jdata->personality) {
             tmp = PMIX_ARGV_JOIN_COMPAT(jdata->personality, ',');
@@ -619,6 +1418,14 @@ next:
         }
     }
 
+    if (0 != scoped) {
+        rc = unpack_scoped_procs(buffer, jdata);
+        if (PRTE_SUCCESS != rc) {
+            PRTE_ERROR_LOG(rc);
+            goto REPORT_ERROR;
+        }
+    }
+
     /* unpack the byte object containing any application setup info - there
      * might not be any, so it isn't an error if we don't find things */
     cnt = 1;
@@ -761,6 +1568,8 @@ next:
         }
     }
 
+    PRTE_TIMELINE_MARK(jdata->nspace, PRTE_TIMELINE_CHILDREN);
+
     /* reset the mapped flags */
     for (n = 0; n < jdata->map->nodes->size; n++) {
         node = (prte_node_t *) pmix_pointer_array_get_item(jdata->map->nodes, n);
@@ -775,6 +1584,17 @@ next:
         PRTE_ERROR_LOG(rc);
         goto REPORT_ERROR;
     }
+    PRTE_TIMELINE_MARK(jdata->nspace, PRTE_TIMELINE_REGISTERED);
+
+    /* track the DVM state version so we can bring new daemons up to date */
+    if (!PRTE_PROC_IS_MASTER) {
+        prte_set_attribute(&jdata->attributes, PRTE_JOB_DVM_VERSION, PRTE_ATTR_LOCAL,
+                           &stamp, PMIX_UINT32);
+        if (prte_odls_globals.dvm_version <= stamp) {
+            prte_odls_globals.dvm_version = stamp + 1;
+        }
+        serve_sync_reqs();
+    }
 
     /* if we have local support setup info, then execute it here - we
      * have to do so AFTER we register the nspace so the PMIx server
@@ -805,6 +1625,9 @@ next:
     if (NULL != info) {
         PMIX_INFO_FREE(info, ninfo);
     }
+    if (prte_state_base.timeline) {
+        prte_state_base_timeline_setup(jdata);
+    }
     return PRTE_SUCCESS;
 
 REPORT_ERROR:
@@ -1080,6 +1903,8 @@ void prte_odls_base_spawn_proc(int fd, short sd, void *cbdata)
         state = PRTE_PROC_STATE_FAILED_TO_START;
         goto errorout;
     }
+    PRTE_TIMELINE_MARK(child->name.nspace, PRTE_TIMELINE_FIRST_FORK);
+    PRTE_TIMELINE_MARK(child->name.nspace, PRTE_TIMELINE_LAST_FORK);
     if (PRTE_PROC_IS_MASTER) {
         /* locally store the pid */
         pidval.type = PMIX_PID;
@@ -1878,13 +2703,46 @@ MOVEON:
     PMIX_RELEASE(t2);
 }
 
+/* an escalation of signals to a set of local children. When we are
+ * running, the SIGTERM and SIGKILL phases are driven by a timer so
+ * the daemon continues to service messages, IOF and state changes
+ * while the children go away - each child is dropped from the
+ * escalation as soon as it is reaped */
+typedef struct {
+    pmix_list_item_t super;
+    prte_event_t ev;
+    bool active;
+    bool async;
+    pmix_list_t children;
+    int signal;  // next signal to send, or zero once SIGKILL has been sent
+    prte_odls_base_kill_local_fn_t kill_local;
+} prte_odls_kill_op_t;
+static void kocon(prte_odls_kill_op_t *p)
+{
+    p->active = false;
+    p->async = false;
+    PMIX_CONSTRUCT(&p->children, pmix_list_t);
+    p->signal = SIGTERM;
+    p->kill_local = NULL;
+}
+static void kodes(prte_odls_kill_op_t *p)
+{
+    if (p->active) {
+        prte_event_evtimer_del(&p->ev);
+    }
+    PMIX_LIST_DESTRUCT(&p->children);
+}
+static PMIX_CLASS_INSTANCE(prte_odls_kill_op_t, pmix_list_item_t, kocon, kodes);
+
 typedef struct {
     pmix_list_item_t super;
     prte_proc_t *child;
+    prte_odls_kill_op_t *op;
 } prte_odls_quick_caddy_t;
 static void qcdcon(prte_odls_quick_caddy_t *p)
 {
     p->child = NULL;
+    p->op = NULL;
 }
 static void qcddes(prte_odls_quick_caddy_t *p)
 {
@@ -1894,222 +2752,346 @@ static void qcddes(prte_odls_quick_caddy_t *p)
 }
 PMIX_CLASS_INSTANCE(prte_odls_quick_caddy_t, pmix_list_item_t, qcdcon, qcddes);
 
-int prte_odls_base_default_kill_local_procs(pmix_pointer_array_t *procs,
-                                            prte_odls_base_kill_local_fn_t kill_local)
+static void kill_complete(prte_odls_kill_op_t *op)
 {
-    prte_proc_t *child;
-    pmix_list_t procs_killed;
-    prte_proc_t *proc, proctmp;
-    int i, j;
-    pmix_pointer_array_t procarray, *procptr;
-    bool do_cleanup;
-    prte_odls_quick_caddy_t *cd;
-    struct timespec tp = {0, 250000000};
+    if (op->async) {
+        pmix_list_remove_item(&prte_odls_globals.kill_ops, &op->super);
+    }
+    PMIX_RELEASE(op);
+}
 
-    PMIX_CONSTRUCT(&procs_killed, pmix_list_t);
+/* the child is gone, or we are giving up on it */
+static void kill_done(prte_odls_quick_caddy_t *cd)
+{
+    prte_proc_t *child = cd->child;
 
-    /* if the pointer array is NULL, then just kill everything */
-    if (NULL == procs) {
-        PMIX_OUTPUT_VERBOSE((5, prte_odls_base_framework.framework_output,
-                             "%s odls:kill_local_proc working on WILDCARD",
-                             PRTE_NAME_PRINT(PRTE_PROC_MY_NAME)));
-        PMIX_CONSTRUCT(&procarray, pmix_pointer_array_t);
-        pmix_pointer_array_init(&procarray, 1, 1, 1);
-        PMIX_CONSTRUCT(&proctmp, prte_proc_t);
-        PMIX_LOAD_PROCID(&proctmp.name, NULL, PMIX_RANK_WILDCARD);
-        pmix_pointer_array_add(&procarray, &proctmp);
-        procptr = &procarray;
-        do_cleanup = true;
-    } else {
-        PMIX_OUTPUT_VERBOSE((5, prte_odls_base_framework.framework_output,
-                             "%s odls:kill_local_proc working on provided array",
-                             PRTE_NAME_PRINT(PRTE_PROC_MY_NAME)));
-        procptr = procs;
-        do_cleanup = false;
+    pmix_hash_table_remove_value_uint64(&prte_odls_globals.kill_index,
+                                        (uint64_t) (uintptr_t) child);
+    pmix_list_remove_item(&cd->op->children, &cd->super);
+
+    /* indicate the waitpid fired as this is effectively what
+     * has happened
+     */
+    PRTE_FLAG_SET(child, PRTE_PROC_FLAG_WAITPID);
+
+    /* Since we are not going to wait for this process, make sure
+     * we mark it as not-alive so that we don't wait for it
+     * in orted_cmd
+     */
+    PRTE_FLAG_UNSET(child, PRTE_PROC_FLAG_ALIVE);
+    child->pid = 0;
+
+    /* mark the child as "killed" */
+    if (child->state < PRTE_PROC_STATE_TERMINATED) {
+        child->state = PRTE_PROC_STATE_KILLED_BY_CMD; /* we ordered it to die */
     }
 
-    /* cycle through the provided array of processes to kill */
-    for (i = 0; i < procptr->size; i++) {
-        if (NULL == (proc = (prte_proc_t *) pmix_pointer_array_get_item(procptr, i))) {
-            continue;
-        }
-        for (j = 0; j < prte_local_children->size; j++) {
-            child = (prte_proc_t *) pmix_pointer_array_get_item(prte_local_children, j);
-            if (NULL == child) {
-                continue;
-            }
+    /* check for everything complete - this will remove
+     * the child object from our local list
+     */
+    if (!prte_finalizing &&
+        PRTE_FLAG_TEST(child, PRTE_PROC_FLAG_IOF_COMPLETE) &&
+        PRTE_FLAG_TEST(child, PRTE_PROC_FLAG_WAITPID)) {
+        PRTE_ACTIVATE_PROC_STATE(&child->name, child->state);
+    }
+    PMIX_RELEASE(cd);
+}
 
-            PMIX_OUTPUT_VERBOSE((5, prte_odls_base_framework.framework_output,
-                                 "%s odls:kill_local_proc checking child process %s",
-                                 PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
-                                 PRTE_NAME_PRINT(&child->name)));
+/* send the next signal in the sequence to everyone still alive */
+static void kill_signal(prte_odls_kill_op_t *op)
+{
+    prte_odls_quick_caddy_t *cd;
 
-            /* do we have a child from the specified job? Because the
-             *  job could be given as a WILDCARD value, we must
-             *  check for that as well as for equality.
-             */
-            if (!PMIX_NSPACE_INVALID(proc->name.nspace) &&
-                !PMIX_CHECK_NSPACE(proc->name.nspace, child->name.nspace)) {
+    PMIX_LIST_FOREACH(cd, &op->children, prte_odls_quick_caddy_t)
+    {
+        PMIX_OUTPUT_VERBOSE((5, prte_odls_base_framework.framework_output,
+                             "%s SENDING %s TO %s",
+                             PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
+                             (SIGTERM == op->signal) ? "SIGTERM" : "SIGKILL",
+                             PRTE_NAME_PRINT(&cd->child->name)));
+        op->kill_local(cd->child->pid, op->signal);
+    }
+    op->signal = (SIGTERM == op->signal) ? SIGKILL : 0;
+}
 
-                PMIX_OUTPUT_VERBOSE((5, prte_odls_base_framework.framework_output,
-                                     "%s odls:kill_local_proc child %s is not part of job %s",
-                                     PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
-                                     PRTE_NAME_PRINT(&child->name),
-                                     PRTE_JOBID_PRINT(proc->name.nspace)));
-                continue;
-            }
+static void kill_escalate(int fd, short args, void *cbdata)
+{
+    prte_odls_kill_op_t *op = (prte_odls_kill_op_t *) cbdata;
+    prte_odls_quick_caddy_t *cd, *next;
+    struct timeval tv;
+    PRTE_HIDE_UNUSED_PARAMS(fd, args);
+
+    PMIX_ACQUIRE_OBJECT(op);
+    op->active = false;
+
+    if (0 != op->signal) {
+        kill_signal(op);
+        tv.tv_sec = prte_odls_globals.kill_delay / 1000;
+        tv.tv_usec = (prte_odls_globals.kill_delay % 1000) * 1000;
+        prte_event_evtimer_add(&op->ev, &tv);
+        op->active = true;
+        return;
+    }
+
+    /* anyone left was sent a SIGKILL but has not been reaped, so
+     * stop waiting for them */
+    PMIX_LIST_FOREACH_SAFE(cd, next, &op->children, prte_odls_quick_caddy_t)
+    {
+        prte_wait_cb_cancel(cd->child);
+        kill_done(cd);
+    }
+    kill_complete(op);
+}
 
-            /* see if this is the specified proc - could be a WILDCARD again, so check
-             * appropriately
-             */
-            if (PMIX_RANK_WILDCARD != proc->name.rank && proc->name.rank != child->name.rank) {
+/* callback from the wait system when a child being killed is reaped */
+static void kill_exit(int fd, short args, void *cbdata)
+{
+    prte_wait_tracker_t *t2 = (prte_wait_tracker_t *) cbdata;
+    prte_odls_quick_caddy_t *cd;
+    prte_odls_kill_op_t *op;
+    PRTE_HIDE_UNUSED_PARAMS(fd, args);
 
-                PMIX_OUTPUT_VERBOSE((5, prte_odls_base_framework.framework_output,
-                                     "%s odls:kill_local_proc child %s is not covered by rank %s",
-                                     PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
-                                     PRTE_NAME_PRINT(&child->name),
-                                     PRTE_VPID_PRINT(proc->name.rank)));
-                continue;
-            }
+    PMIX_ACQUIRE_OBJECT(t2);
 
-            /* is this process alive? if not, then nothing for us
-             * to do to it
-             */
-            if (!PRTE_FLAG_TEST(child, PRTE_PROC_FLAG_ALIVE) || 0 == child->pid) {
+    /* if we already gave up on it, then there is nothing to do */
+    if (PMIX_SUCCESS == pmix_hash_table_get_value_uint64(&prte_odls_globals.kill_index,
+                                                         (uint64_t) (uintptr_t) t2->child,
+                                                         (void **) &cd)) {
+        PMIX_OUTPUT_VERBOSE((5, prte_odls_base_framework.framework_output,
+                             "%s odls:kill_local_proc child %s exited",
+                             PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
+                             PRTE_NAME_PRINT(&t2->child->name)));
+        op = cd->op;
+        kill_done(cd);
+        if (0 == pmix_list_get_size(&op->children)) {
+            /* everyone is gone - no need to escalate any further */
+            kill_complete(op);
+        }
+    }
+    PMIX_RELEASE(t2);
+}
 
-                PMIX_OUTPUT_VERBOSE((5, prte_odls_base_framework.framework_output,
-                                     "%s odls:kill_local_proc child %s is not alive",
-                                     PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
-                                     PRTE_NAME_PRINT(&child->name)));
+static void kill_child(prte_odls_kill_op_t *op, prte_proc_t *child)
+{
+    prte_odls_quick_caddy_t *cd;
+    prte_odls_kill_op_t *prior;
 
-                /* ensure, though, that the state is terminated so we don't lockup if
-                 * the proc never started
-                 */
-                if (PRTE_PROC_STATE_UNDEF == child->state ||
-                    PRTE_PROC_STATE_INIT == child->state ||
-                    PRTE_PROC_STATE_RUNNING == child->state) {
-                    /* we can't be sure what happened, but make sure we
-                     * at least have a value that will let us eventually wakeup
-                     */
-                    child->state = PRTE_PROC_STATE_TERMINATED;
-                    /* ensure we realize that the waitpid will never come, if
-                     * it already hasn't
-                     */
-                    PRTE_FLAG_SET(child, PRTE_PROC_FLAG_WAITPID);
-                    child->pid = 0;
-                    goto CLEANUP;
-                } else {
-                    continue;
-                }
-            }
+    PMIX_OUTPUT_VERBOSE((5, prte_odls_base_framework.framework_output,
+                         "%s odls:kill_local_proc checking child process %s",
+                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
+                         PRTE_NAME_PRINT(&child->name)));
 
-            /* ensure the stdin IOF channel for this child is closed. The other
-             * channels will automatically close when the proc is killed
-             */
-            if (NULL != prte_iof.close) {
-                prte_iof.close(&child->name, PRTE_IOF_STDIN);
-            }
+    /* is this process already being killed? */
+    if (PMIX_SUCCESS == pmix_hash_table_get_value_uint64(&prte_odls_globals.kill_index,
+                                                         (uint64_t) (uintptr_t) child,
+                                                         (void **) &cd)) {
+        if (cd->op == op || op->async) {
+            /* leave it to the escalation already in progress */
+            return;
+        }
+        /* nobody will progress the prior escalation, so take it over */
+        prior = cd->op;
+        pmix_list_remove_item(&prior->children, &cd->super);
+        if (0 == pmix_list_get_size(&prior->children)) {
+            kill_complete(prior);
+        }
+        prte_wait_cb_cancel(child);
+        cd->op = op;
+        pmix_list_append(&op->children, &cd->super);
+        return;
+    }
 
-            /* cancel the waitpid callback as this induces unmanageable race
-             * conditions when we are deliberately killing the process
-             */
-            prte_wait_cb_cancel(child);
+    /* is this process alive? if not, then nothing for us
+     * to do to it
+     */
+    if (!PRTE_FLAG_TEST(child, PRTE_PROC_FLAG_ALIVE) || 0 == child->pid) {
 
-            /* First send a SIGCONT in case the process is in stopped state.
-               If it is in a stopped state and we do not first change it to
-               running, then SIGTERM will not get delivered.  Ignore return
-               value. */
-            PMIX_OUTPUT_VERBOSE((5, prte_odls_base_framework.framework_output,
-                                 "%s SENDING SIGCONT TO %s",
-                                 PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
-                                 PRTE_NAME_PRINT(&child->name)));
-            cd = PMIX_NEW(prte_odls_quick_caddy_t);
-            PMIX_RETAIN(child);
-            cd->child = child;
-            pmix_list_append(&procs_killed, &cd->super);
-            kill_local(child->pid, SIGCONT);
-            continue;
+        PMIX_OUTPUT_VERBOSE((5, prte_odls_base_framework.framework_output,
+                             "%s odls:kill_local_proc child %s is not alive",
+                             PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
+                             PRTE_NAME_PRINT(&child->name)));
 
-        CLEANUP:
+        /* ensure, though, that the state is terminated so we don't lockup if
+         * the proc never started
+         */
+        if (PRTE_PROC_STATE_UNDEF == child->state ||
+            PRTE_PROC_STATE_INIT == child->state ||
+            PRTE_PROC_STATE_RUNNING == child->state) {
+            /* we can't be sure what happened, but make sure we
+             * at least have a value that will let us eventually wakeup
+             */
+            child->state = PRTE_PROC_STATE_TERMINATED;
+            /* ensure we realize that the waitpid will never come, if
+             * it already hasn't
+             */
+            PRTE_FLAG_SET(child, PRTE_PROC_FLAG_WAITPID);
+            child->pid = 0;
             /* check for everything complete - this will remove
              * the child object from our local list
              */
-            if (!prte_finalizing && PRTE_FLAG_TEST(child, PRTE_PROC_FLAG_IOF_COMPLETE)
-                && PRTE_FLAG_TEST(child, PRTE_PROC_FLAG_WAITPID)) {
+            if (!prte_finalizing && PRTE_FLAG_TEST(child, PRTE_PROC_FLAG_IOF_COMPLETE)) {
                 PRTE_ACTIVATE_PROC_STATE(&child->name, child->state);
             }
         }
+        return;
+    }
+
+    /* ensure the stdin IOF channel for this child is closed. The other
+     * channels will automatically close when the proc is killed
+     */
+    if (NULL != prte_iof.close) {
+        prte_iof.close(&child->name, PRTE_IOF_STDIN);
+    }
+
+    if (op->async) {
+        /* replace the normal waitpid callback - the exit of a child
+         * we are killing is reported by the escalation itself */
+        prte_wait_cb(child, kill_exit, NULL);
+    } else {
+        /* cancel the waitpid callback as this induces unmanageable race
+         * conditions when we are deliberately killing the process
+         */
+        prte_wait_cb_cancel(child);
     }
 
-    /* if we are issuing signals, then we need to wait a little
-     * and send the next in sequence */
-    if (0 < pmix_list_get_size(&procs_killed)) {
-        /* Wait a little. Do so in nanosleep() - can be interrupted by a
-         * signal. Most likely SIGCHLD in this case */
+    /* First send a SIGCONT in case the process is in stopped state.
+       If it is in a stopped state and we do not first change it to
+       running, then SIGTERM will not get delivered.  Ignore return
+       value. */
+    PMIX_OUTPUT_VERBOSE((5, prte_odls_base_framework.framework_output,
+                         "%s SENDING SIGCONT TO %s",
+                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
+                         PRTE_NAME_PRINT(&child->name)));
+    cd = PMIX_NEW(prte_odls_quick_caddy_t);
+    PMIX_RETAIN(child);
+    cd->child = child;
+    cd->op = op;
+    pmix_list_append(&op->children, &cd->super);
+    pmix_hash_table_set_value_uint64(&prte_odls_globals.kill_index,
+                                     (uint64_t) (uintptr_t) child, cd);
+    op->kill_local(child->pid, SIGCONT);
+}
+
+int prte_odls_base_default_kill_local_procs(pmix_pointer_array_t *procs,
+                                            prte_odls_base_kill_local_fn_t kill_local)
+{
+    prte_odls_kill_op_t *op;
+    prte_odls_quick_caddy_t *cd, *next;
+    prte_proc_t *child, *proc;
+    prte_job_t *jdata = NULL;
+    pmix_pointer_array_t *array;
+    struct timespec tp;
+    struct timeval tv;
+    int i, j;
+
+    op = PMIX_NEW(prte_odls_kill_op_t);
+    op->kill_local = kill_local;
+    /* if we are shutting down, then nobody will be around to
+     * progress the escalation - so do it in place */
+    op->async = !prte_finalizing && prte_event_base_active;
+
+    /* if the pointer array is NULL, then just kill everything */
+    if (NULL == procs) {
         PMIX_OUTPUT_VERBOSE((5, prte_odls_base_framework.framework_output,
-                             "%s Sleep %ld nsec",
-                             PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
-                             (long)tp.tv_nsec));
-        (void)nanosleep(&tp, NULL);
-        /* issue a SIGTERM to all */
-        PMIX_LIST_FOREACH(cd, &procs_killed, prte_odls_quick_caddy_t)
-        {
-            PMIX_OUTPUT_VERBOSE((5, prte_odls_base_framework.framework_output,
-                                 "%s SENDING SIGTERM TO %s",
-                                 PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
-                                 PRTE_NAME_PRINT(&cd->child->name)));
-            kill_local(cd->child->pid, SIGTERM);
+                             "%s odls:kill_local_proc working on WILDCARD",
+                             PRTE_NAME_PRINT(PRTE_PROC_MY_NAME)));
+        for (j = 0; j < prte_local_children->size; j++) {
+            child = (prte_proc_t *) pmix_pointer_array_get_item(prte_local_children, j);
+            if (NULL != child) {
+                kill_child(op, child);
+            }
         }
-        PMIX_OUTPUT_VERBOSE((5, prte_odls_base_framework.framework_output,
-                             "%s Sleep %ld nsec",
-                             PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
-                             (long)tp.tv_nsec));
-        /* Wait a little. Do so in nanosleep() - can be interrupted by a
-         * signal. Most likely SIGCHLD in this case */
-        (void)nanosleep(&tp, NULL);
-
-        /* issue a SIGKILL to all */
-        PMIX_LIST_FOREACH(cd, &procs_killed, prte_odls_quick_caddy_t)
-        {
+        goto escalate;
+    }
+
+    PMIX_OUTPUT_VERBOSE((5, prte_odls_base_framework.framework_output,
+                         "%s odls:kill_local_proc working on provided array",
+                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME)));
+
+    /* cycle through the provided array of processes to kill */
+    for (i = 0; i < procs->size; i++) {
+        if (NULL == (proc = (prte_proc_t *) pmix_pointer_array_get_item(procs, i))) {
+            continue;
+        }
+
+        /* the job could be given as a WILDCARD value, in which
+         * case everything goes */
+        if (PMIX_NSPACE_INVALID(proc->name.nspace)) {
+            for (j = 0; j < prte_local_children->size; j++) {
+                child = (prte_proc_t *) pmix_pointer_array_get_item(prte_local_children, j);
+                if (NULL != child) {
+                    kill_child(op, child);
+                }
+            }
+            break;
+        }
+
+        /* requests usually come in runs from the same job */
+        if (NULL == jdata || !PMIX_CHECK_NSPACE(jdata->nspace, proc->name.nspace)) {
+            jdata = prte_get_job_data_object(proc->name.nspace);
+        }
+        if (NULL == jdata || 0 == jdata->num_local_procs) {
             PMIX_OUTPUT_VERBOSE((5, prte_odls_base_framework.framework_output,
-                                 "%s SENDING SIGKILL TO %s",
+                                 "%s odls:kill_local_proc no local children in job %s",
                                  PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
-                                 PRTE_NAME_PRINT(&cd->child->name)));
-            kill_local(cd->child->pid, SIGKILL);
-            /* indicate the waitpid fired as this is effectively what
-             * has happened
-             */
-            PRTE_FLAG_SET(cd->child, PRTE_PROC_FLAG_WAITPID);
-
-            /* Since we are not going to wait for this process, make sure
-             * we mark it as not-alive so that we don't wait for it
-             * in orted_cmd
-             */
-            PRTE_FLAG_UNSET(cd->child, PRTE_PROC_FLAG_ALIVE);
-            cd->child->pid = 0;
+                                 PRTE_JOBID_PRINT(proc->name.nspace)));
+            continue;
+        }
 
-            /* mark the child as "killed" */
-            if (cd->child->state < PRTE_PROC_STATE_TERMINATED) {
-                cd->child->state = PRTE_PROC_STATE_KILLED_BY_CMD; /* we ordered it to die */
+        /* a specific rank can be looked up directly */
+        if (PMIX_RANK_WILDCARD != proc->name.rank) {
+            child = (prte_proc_t *) pmix_pointer_array_get_item(jdata->procs, proc->name.rank);
+            if (NULL != child && PRTE_FLAG_TEST(child, PRTE_PROC_FLAG_LOCAL)) {
+                kill_child(op, child);
             }
+            continue;
+        }
 
-            /* check for everything complete - this will remove
-             * the child object from our local list
-             */
-            if (!prte_finalizing &&
-                PRTE_FLAG_TEST(cd->child, PRTE_PROC_FLAG_IOF_COMPLETE) &&
-                PRTE_FLAG_TEST(cd->child, PRTE_PROC_FLAG_WAITPID)) {
-                PRTE_ACTIVATE_PROC_STATE(&cd->child->name, cd->child->state);
+        /* walk whichever is shorter - the job's procs or our children */
+        array = (jdata->procs->size < prte_local_children->size) ? jdata->procs : prte_local_children;
+        for (j = 0; j < array->size; j++) {
+            child = (prte_proc_t *) pmix_pointer_array_get_item(array, j);
+            if (NULL != child && PRTE_FLAG_TEST(child, PRTE_PROC_FLAG_LOCAL) &&
+                PMIX_CHECK_NSPACE(proc->name.nspace, child->name.nspace)) {
+                kill_child(op, child);
             }
         }
     }
-    PMIX_LIST_DESTRUCT(&procs_killed);
 
-    /* cleanup arrays, if required */
-    if (do_cleanup) {
-        PMIX_DESTRUCT(&procarray);
-        PMIX_DESTRUCT(&proctmp);
+escalate:
+    if (0 == pmix_list_get_size(&op->children)) {
+        PMIX_RELEASE(op);
+        return PRTE_SUCCESS;
+    }
+
+    if (op->async) {
+        pmix_list_append(&prte_odls_globals.kill_ops, &op->super);
+        tv.tv_sec = prte_odls_globals.kill_delay / 1000;
+        tv.tv_usec = (prte_odls_globals.kill_delay % 1000) * 1000;
+        prte_event_evtimer_set(prte_event_base, &op->ev, kill_escalate, op);
+        prte_event_evtimer_add(&op->ev, &tv);
+        op->active = true;
+        return PRTE_SUCCESS;
+    }
+
+    /* issue a SIGTERM and then a SIGKILL to all, waiting a little
+     * before each. Do so in nanosleep() - can be interrupted by a
+     * signal. Most likely SIGCHLD in this case */
+    tp.tv_sec = prte_odls_globals.kill_delay / 1000;
+    tp.tv_nsec = (prte_odls_globals.kill_delay % 1000) * 1000000;
+    while (0 != op->signal) {
+        PMIX_OUTPUT_VERBOSE((5, prte_odls_base_framework.framework_output,
+                             "%s Sleep %ld nsec",
+                             PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
+                             (long) tp.tv_nsec));
+        (void) nanosleep(&tp, NULL);
+        kill_signal(op);
+    }
+    PMIX_LIST_FOREACH_SAFE(cd, next, &op->children, prte_odls_quick_caddy_t)
+    {
+        kill_done(cd);
     }
+    PMIX_RELEASE(op);
 
     return PRTE_SUCCESS;
 }
@@ -43,6 +43,7 @@
 #include "src/mca/errmgr/errmgr.h"
 #include "src/mca/ess/ess.h"
 #include "src/mca/plm/plm_types.h"
+#include "src/rml/rml.h"
 #include "src/runtime/prte_globals.h"
 #include "src/threads/pmix_threads.h"
 #include "src/util/name_fns.h"
@@ -78,7 +79,17 @@ prte_odls_globals_t prte_odls_globals = {
     .ev_threads = NULL,
     .next_base = 0,
     .signal_direct_children_only = false,
-    .exec_agent = NULL
+    .exec_agent = NULL,
+    .scoped_launch = false,
+    .dvm_sync = false,
+    .dvm_synced = false,
+    .dvm_sync_pending = false,
+    .dvm_sync_rc = PRTE_SUCCESS,
+    .dvm_version = 0,
+    .sync_reqs = PMIX_LIST_STATIC_INIT,
+    .deferred_launches = PMIX_LIST_STATIC_INIT,
+    .kill_delay = 250,
+    .kill_ops = PMIX_LIST_STATIC_INIT
 };
 
 static prte_event_base_t **prte_event_base_ptr = NULL;
@@ -118,6 +129,30 @@ static int prte_odls_base_register(pmix_mca_base_register_flag_t flags)
                                       PMIX_MCA_BASE_VAR_TYPE_STRING,
                                       &prte_odls_globals.exec_agent);
 
+    prte_odls_globals.scoped_launch = false;
+    (void) pmix_mca_base_var_register("prte", "odls", "base", "scoped_launch",
+                                      "Send the procs of a job in the launch message as a compact location "
+                                      "table plus per-daemon slices, so each daemon only decodes the full "
+                                      "description of its own procs. The cpusets and attributes of procs "
+                                      "on other nodes are not distributed",
+                                      PMIX_MCA_BASE_VAR_TYPE_BOOL,
+                                      &prte_odls_globals.scoped_launch);
+
+    prte_odls_globals.dvm_sync = false;
+    (void) pmix_mca_base_var_register("prte", "odls", "base", "dvm_sync",
+                                      "When daemons are added to a running DVM, have only the new daemons "
+                                      "fetch the live jobs from their tree parent instead of including every "
+                                      "prior job in the launch message sent to all daemons",
+                                      PMIX_MCA_BASE_VAR_TYPE_BOOL,
+                                      &prte_odls_globals.dvm_sync);
+
+    prte_odls_globals.kill_delay = 250;
+    (void) pmix_mca_base_var_register("prte", "odls", "base", "kill_delay",
+                                      "Time (in msec) to wait between each of the SIGCONT, SIGTERM and "
+                                      "SIGKILL signals sent to local procs being killed",
+                                      PMIX_MCA_BASE_VAR_TYPE_INT,
+                                      &prte_odls_globals.kill_delay);
+
     return PRTE_SUCCESS;
 }
 
@@ -214,6 +249,15 @@ static int prte_odls_base_close(void)
     }
     PMIX_DESTRUCT(&prte_odls_globals.xterm_ranks);
 
+    PRTE_RML_CANCEL(PRTE_NAME_WILDCARD, PRTE_RML_TAG_DVM_SYNC);
+    PRTE_RML_CANCEL(PRTE_NAME_WILDCARD, PRTE_RML_TAG_DVM_SYNC_RESP);
+    PMIX_LIST_DESTRUCT(&prte_odls_globals.sync_reqs);
+    PMIX_LIST_DESTRUCT(&prte_odls_globals.deferred_launches);
+
+    /* abandon any signal escalations still in progress */
+    PMIX_LIST_DESTRUCT(&prte_odls_globals.kill_ops);
+    PMIX_DESTRUCT(&prte_odls_globals.kill_index);
+
     /* cleanup the global list of local children and job data */
     for (i = 0; i < prte_local_children->size; i++) {
         if (NULL != (proc = (prte_proc_t *) pmix_pointer_array_get_item(prte_local_children, i))) {
@@ -251,6 +295,22 @@ static int prte_odls_base_open(pmix_mca_base_open_flag_t flags)
     PMIX_CONSTRUCT(&prte_odls_globals.xterm_ranks, pmix_list_t);
     prte_odls_globals.xtermcmd = NULL;
 
+    /* the master always has the complete DVM state */
+    PMIX_CONSTRUCT(&prte_odls_globals.sync_reqs, pmix_list_t);
+    PMIX_CONSTRUCT(&prte_odls_globals.deferred_launches, pmix_list_t);
+    prte_odls_globals.dvm_synced = PRTE_PROC_IS_MASTER;
+    prte_odls_globals.dvm_sync_pending = false;
+    prte_odls_globals.dvm_sync_rc = PRTE_SUCCESS;
+    prte_odls_globals.dvm_version = 0;
+    PRTE_RML_RECV(PRTE_NAME_WILDCARD, PRTE_RML_TAG_DVM_SYNC,
+                  PRTE_RML_PERSISTENT, prte_odls_base_dvm_sync_recv, NULL);
+    PRTE_RML_RECV(PRTE_NAME_WILDCARD, PRTE_RML_TAG_DVM_SYNC_RESP,
+                  PRTE_RML_PERSISTENT, prte_odls_base_dvm_sync_resp, NULL);
+
+    PMIX_CONSTRUCT(&prte_odls_globals.kill_ops, pmix_list_t);
+    PMIX_CONSTRUCT(&prte_odls_globals.kill_index, pmix_hash_table_t);
+    pmix_hash_table_init(&prte_odls_globals.kill_index, 256);
+
     /* ensure that SIGCHLD is unblocked as we need to capture it */
     sigemptyset(&unblock);
     sigaddset(&unblock, SIGCHLD);
@@ -29,6 +29,9 @@ AC_DEFUN([MCA_prte_odls_pdefault_CONFIG],[
 
     AC_CHECK_FUNC([fork], [odls_pdefault_happy="yes"], [odls_pdefault_happy="no"])
 
+    # zygote launch needs the child subreaper
+    AC_CHECK_HEADERS([sys/prctl.h])
+
     AS_IF([test "$odls_pdefault_happy" = "yes"], [$1], [$2])
 
 ])dnl
@@ -35,11 +35,20 @@
 
 BEGIN_C_DECLS
 
+typedef struct {
+    prte_odls_base_component_t super;
+    /* fork procs from a warm zygote of their executable */
+    bool zygote;
+    int max_zygotes;
+    int zygote_timeout;
+    char *zygote_lib;
+} prte_odls_pdefault_component_t;
+
 /*
  * ODLS Default module
  */
 extern prte_odls_base_module_t prte_odls_pdefault_module;
-PRTE_MODULE_EXPORT extern prte_odls_base_component_t prte_mca_odls_pdefault_component;
+PRTE_MODULE_EXPORT extern prte_odls_pdefault_component_t prte_mca_odls_pdefault_component;
 
 END_C_DECLS
 
@@ -44,28 +44,75 @@
 
 #include "src/mca/odls/base/base.h"
 #include "odls_pdefault.h"
+#include "odls_pdefault_zygote.h"
 
+static int component_register(void);
 static int component_query(pmix_mca_base_module_t **module, int *priority);
+static int component_close(void);
 
 /*
  * Instantiate the public struct with all of our public information
  * and pointers to our public functions in it
  */
 
-prte_odls_base_component_t prte_mca_odls_pdefault_component = {
-    PRTE_ODLS_BASE_VERSION_2_0_0,
-    /* Component name and version */
-    .pmix_mca_component_name = "pdefault",
-    PMIX_MCA_BASE_MAKE_VERSION(component,
-                               PRTE_MAJOR_VERSION,
-                               PRTE_MINOR_VERSION,
-                               PMIX_RELEASE_VERSION),
-
-    /* Component open and close functions */
-    .pmix_mca_query_component = component_query,
+prte_odls_pdefault_component_t prte_mca_odls_pdefault_component = {
+    .super = {
+        PRTE_ODLS_BASE_VERSION_2_0_0,
+        /* Component name and version */
+        .pmix_mca_component_name = "pdefault",
+        PMIX_MCA_BASE_MAKE_VERSION(component,
+                                   PRTE_MAJOR_VERSION,
+                                   PRTE_MINOR_VERSION,
+                                   PMIX_RELEASE_VERSION),
+
+        /* Component open and close functions */
+        .pmix_mca_close_component = component_close,
+        .pmix_mca_query_component = component_query,
+        .pmix_mca_register_component_params = component_register
+    },
+    .zygote = false,
+    .max_zygotes = 4,
+    .zygote_timeout = 10,
+    .zygote_lib = NULL
 };
 PMIX_MCA_BASE_COMPONENT_INIT(prte, odls, pdefault)
 
+static int component_register(void)
+{
+    pmix_mca_base_component_t *component = &prte_mca_odls_pdefault_component.super;
+
+    (void) pmix_mca_base_component_var_register(component, "zygote",
+                                                "Fork procs from a warm, already linked and "
+                                                "initialized copy of their executable that is "
+                                                "kept on each node for reuse by later jobs "
+                                                "(Linux only)",
+                                                PMIX_MCA_BASE_VAR_TYPE_BOOL,
+                                                &prte_mca_odls_pdefault_component.zygote);
+
+    (void) pmix_mca_base_component_var_register(component, "max_zygotes",
+                                                "Maximum number of zygotes to keep on a node - "
+                                                "the least recently used one is stopped to make "
+                                                "room for another",
+                                                PMIX_MCA_BASE_VAR_TYPE_INT,
+                                                &prte_mca_odls_pdefault_component.max_zygotes);
+
+    (void) pmix_mca_base_component_var_register(component, "zygote_timeout",
+                                                "Seconds to allow a new zygote to report in before "
+                                                "giving up on it - until then, its executable is "
+                                                "launched the normal way",
+                                                PMIX_MCA_BASE_VAR_TYPE_INT,
+                                                &prte_mca_odls_pdefault_component.zygote_timeout);
+
+    (void) pmix_mca_base_component_var_register(component, "zygote_lib",
+                                                "Path to the library preloaded into each zygote "
+                                                "(default: prte_zygote.so in the PRRTE library "
+                                                "directory)",
+                                                PMIX_MCA_BASE_VAR_TYPE_STRING,
+                                                &prte_mca_odls_pdefault_component.zygote_lib);
+
+    return PRTE_SUCCESS;
+}
+
 static int component_query(pmix_mca_base_module_t **module, int *priority)
 {
     /* the base open/select logic protects us against operation when
@@ -82,3 +129,8 @@ static int component_query(pmix_mca_base_module_t **module, int *priority)
     return PRTE_SUCCESS;
 }
 
+static int component_close(void)
+{
+    prte_odls_pdefault_zygote_finalize();
+    return PRTE_SUCCESS;
+}
@@ -137,6 +137,7 @@
 #include "src/mca/odls/base/base.h"
 #include "src/prted/pmix/pmix_server.h"
 #include "odls_pdefault.h"
+#include "odls_pdefault_zygote.h"
 
 /*
  * Module functions (function pointers used in a struct)
@@ -611,6 +612,13 @@ static int fork_local_proc(void *cdptr)
     int p[2];
     pid_t pid;
     prte_proc_t *child = cd->child;
+    int rc;
+
+    /* fork it from a zygote if we can */
+    rc = prte_odls_pdefault_zygote_spawn(cd);
+    if (PRTE_ERR_TAKE_NEXT_OPTION != rc) {
+        return rc;
+    }
 
     /* A pipe is used to communicate between the parent and child to
        indicate whether the exec ultimately succeeded or failed.  The
@@ -665,6 +673,10 @@ static int launch_local_procs(pmix_data_buffer_t *data)
 
     /* construct the list of children we are to launch */
     rc = prte_odls_base_default_construct_child_list(data, &job);
+    if (PRTE_ERR_OP_IN_PROGRESS == rc) {
+        /* held until we have synced with the DVM */
+        return PRTE_SUCCESS;
+    }
     if (PRTE_SUCCESS != rc) {
         PMIX_OUTPUT_VERBOSE((2, prte_odls_base_framework.framework_output,
                              "%s odls:pdefault:launch:local failed to construct child list on error %s",
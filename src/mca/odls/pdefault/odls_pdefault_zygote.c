@@ -0,0 +1,665 @@
+/*
+ * Copyright (c) 2025      Nanook Consulting  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ * Daemon side of the zygote launch - see odls_pdefault_zygote.h.
+ *
+ * The daemon keeps up to max_zygotes zygotes, one for each distinct
+ * executable, working directory, argv and app environment it has been
+ * asked to launch, stopping the least recently used one to make room
+ * for another. A zygote is started the first time a proc needs it, but
+ * the daemon does not wait for it - procs go through the normal launch
+ * until it has reported in. A zygote that fails to report in within
+ * zygote_timeout seconds - e.g., because its executable is static or
+ * setuid and so ignores the preloaded library - is remembered as failed
+ * so that later procs of the same executable go straight to the normal
+ * launch.
+ *
+ * Procs are forked by a short-lived child of the zygote, so they are
+ * re-parented to the daemon - which makes itself a child subreaper -
+ * and are waited upon exactly as if the daemon had forked them itself.
+ */
+
+#include "prte_config.h"
+#include "constants.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <time.h>
+#include <unistd.h>
+#ifdef HAVE_SYS_PRCTL_H
+#    include <sys/prctl.h>
+#endif
+
+#include "src/class/pmix_list.h"
+#include "src/hwloc/hwloc-internal.h"
+#include "src/pmix/pmix-internal.h"
+#include "src/threads/pmix_mutex.h"
+#include "src/util/pmix_argv.h"
+#include "src/util/pmix_environ.h"
+#include "src/util/pmix_fd.h"
+#include "src/util/pmix_os_path.h"
+#include "src/util/pmix_output.h"
+#include "src/util/pmix_printf.h"
+#include "src/util/pmix_show_help.h"
+
+#include "src/mca/iof/base/iof_base_setup.h"
+#include "src/mca/odls/base/base.h"
+#include "src/mca/prteinstalldirs/prteinstalldirs.h"
+#include "src/mca/rmaps/rmaps_types.h"
+#include "src/runtime/prte_globals.h"
+#include "src/util/name_fns.h"
+
+#include "odls_pdefault.h"
+#include "odls_pdefault_zygote.h"
+
+#if defined(__linux__) && defined(PR_SET_CHILD_SUBREAPER)
+
+/* room left in a zygote's environment for entries
+ * that procs may have beyond those of the first one */
+#define PRTE_ZYGOTE_ENV_SLACK 32
+
+typedef struct {
+    pmix_list_item_t super;
+    char *key;
+    pid_t pid;
+    int sd;
+    bool failed;
+    bool ready;
+    time_t deadline;  // when to give up waiting for it to report in
+    uint32_t nenv;    // max environment entries of a proc
+} prte_odls_zygote_t;
+
+static void zcon(prte_odls_zygote_t *p)
+{
+    p->key = NULL;
+    p->pid = -1;
+    p->sd = -1;
+    p->failed = false;
+    p->ready = false;
+    p->deadline = 0;
+    p->nenv = 0;
+}
+static void zdes(prte_odls_zygote_t *p)
+{
+    if (NULL != p->key) {
+        free(p->key);
+    }
+    /* the zygote exits when it sees its socket close, but
+     * don't count on it */
+    if (0 <= p->sd) {
+        close(p->sd);
+    }
+    if (0 < p->pid) {
+        kill(-p->pid, SIGKILL);
+    }
+}
+static PMIX_CLASS_INSTANCE(prte_odls_zygote_t, pmix_list_item_t, zcon, zdes);
+
+/* zygotes in order of last use, most recent first */
+static pmix_list_t zygotes = PMIX_LIST_STATIC_INIT;
+static pmix_mutex_t zygote_lock = PMIX_MUTEX_STATIC_INIT;
+static bool subreaper = false;
+
+static bool eligible(prte_odls_spawn_caddy_t *cd)
+{
+    if (!prte_mca_odls_pdefault_component.zygote
+        || 0 >= prte_mca_odls_pdefault_component.max_zygotes) {
+        return false;
+    }
+    /* only app procs, and only when the executable is run
+     * directly - not under an xterm or an exec agent */
+    if (NULL == cd->child || NULL == cd->cmd || NULL == cd->app->app
+        || 0 != strcmp(cd->cmd, cd->app->app) || cd->index_argv) {
+        return false;
+    }
+    /* anything that must happen at exec time */
+    if (prte_get_attribute(&cd->jdata->attributes, PRTE_JOB_STOP_ON_EXEC, NULL, PMIX_BOOL)
+        || prte_get_attribute(&cd->jdata->attributes, PRTE_JOB_REPORT_BINDINGS, NULL,
+                              PMIX_BOOL)) {
+        return false;
+    }
+    return true;
+}
+
+/* identify the zygote a proc can come from. The file itself is part
+ * of it so that a rebuilt executable gets a new zygote. Returns NULL
+ * if the executable cannot be found */
+static char *signature(prte_odls_spawn_caddy_t *cd)
+{
+    struct stat buf;
+    char *argv, *env, *key, *path;
+    int rc;
+
+    /* a relative executable path is relative to the wdir */
+    if ('/' != cd->cmd[0] && NULL != cd->wdir) {
+        path = pmix_os_path(false, cd->wdir, cd->cmd, NULL);
+        rc = stat(path, &buf);
+        free(path);
+    } else {
+        rc = stat(cd->cmd, &buf);
+    }
+    if (0 != rc) {
+        return NULL;
+    }
+
+    argv = (NULL == cd->argv) ? strdup(cd->app->app) : PMIX_ARGV_JOIN_COMPAT(cd->argv, '\x1f');
+    env = (NULL == cd->app->env) ? strdup("") : PMIX_ARGV_JOIN_COMPAT(cd->app->env, '\n');
+    pmix_asprintf(&key, "%s\n%lu:%lu:%lld:%lld.%09ld\n%s\n%s\n%s", cd->cmd,
+                  (unsigned long) buf.st_dev, (unsigned long) buf.st_ino,
+                  (long long) buf.st_size, (long long) buf.st_mtim.tv_sec,
+                  (long) buf.st_mtim.tv_nsec, (NULL == cd->wdir) ? "" : cd->wdir, argv, env);
+    free(argv);
+    free(env);
+    return key;
+}
+
+static void set_handler_default(int sig)
+{
+    struct sigaction act;
+
+    act.sa_handler = SIG_DFL;
+    act.sa_flags = 0;
+    sigemptyset(&act.sa_mask);
+
+    sigaction(sig, &act, (struct sigaction *) 0);
+}
+
+/* exec the executable of the caddy as a zygote talking over sd */
+static void do_zygote(prte_odls_spawn_caddy_t *cd, int sd, char **env)
+{
+    char *argv[2];
+    sigset_t sigs;
+    int fd, i;
+
+    setpgid(0, 0);
+
+    /* the zygote has no output of its own - each proc
+     * it forks is handed the stdio of that proc */
+    fd = open("/dev/null", O_RDWR, 0);
+    if (0 <= fd) {
+        for (i = 0; i < 3; i++) {
+            if (fd != i) {
+                dup2(fd, i);
+            }
+        }
+        if (2 < fd && fd != sd) {
+            close(fd);
+        }
+    }
+    pmix_close_open_file_descriptors(sd);
+
+    set_handler_default(SIGTERM);
+    set_handler_default(SIGINT);
+    set_handler_default(SIGHUP);
+    set_handler_default(SIGPIPE);
+    set_handler_default(SIGCHLD);
+    set_handler_default(SIGTRAP);
+    sigprocmask(0, 0, &sigs);
+    sigprocmask(SIG_UNBLOCK, &sigs, 0);
+
+    /* a relative executable path is relative to the wdir */
+    if (NULL != cd->wdir && 0 != chdir(cd->wdir)) {
+        _exit(1);
+    }
+
+    if (NULL == cd->argv) {
+        argv[0] = cd->app->app;
+        argv[1] = NULL;
+        execve(cd->cmd, argv, env);
+    } else {
+        execve(cd->cmd, cd->argv, env);
+    }
+    _exit(1);
+}
+
+/* start a zygote for the executable of the caddy - it will
+ * report in over its socket once it is ready */
+static prte_odls_zygote_t *start_zygote(prte_odls_spawn_caddy_t *cd, char *key)
+{
+    prte_odls_zygote_t *z;
+    char **env = NULL, *lib, *value, *tmp;
+    int sv[2], n;
+
+    z = PMIX_NEW(prte_odls_zygote_t);
+    z->key = key;
+    z->failed = true;
+
+    /* make room */
+    while ((int) pmix_list_get_size(&zygotes) >= prte_mca_odls_pdefault_component.max_zygotes) {
+        pmix_list_item_t *item = pmix_list_remove_last(&zygotes);
+        PMIX_RELEASE(item);
+    }
+    pmix_list_prepend(&zygotes, &z->super);
+
+    if (NULL != prte_mca_odls_pdefault_component.zygote_lib) {
+        lib = strdup(prte_mca_odls_pdefault_component.zygote_lib);
+    } else {
+        lib = pmix_os_path(false, prte_install_dirs.prtelibdir, PRTE_ZYGOTE_LIB, NULL);
+    }
+    if (0 != access(lib, R_OK)) {
+        pmix_output_verbose(2, prte_odls_base_framework.framework_output,
+                            "%s odls:pdefault:zygote cannot access %s",
+                            PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), lib);
+        free(lib);
+        return z;
+    }
+
+    if (!subreaper) {
+        if (0 != prctl(PR_SET_CHILD_SUBREAPER, 1, 0, 0, 0)) {
+            free(lib);
+            return z;
+        }
+        subreaper = true;
+    }
+
+    if (0 != socketpair(AF_UNIX, SOCK_STREAM, 0, sv)) {
+        free(lib);
+        return z;
+    }
+
+    /* the zygote only gets the environment shared by all procs
+     * of the app - the rest is handed to each proc as it forks */
+    env = PMIX_ARGV_COPY_COMPAT(cd->app->env);
+    value = pmix_getenv("LD_PRELOAD", env);
+    if (NULL != value) {
+        pmix_asprintf(&tmp, "%s:%s", lib, value);
+        PMIX_SETENV_COMPAT("LD_PRELOAD", tmp, true, &env);
+        free(tmp);
+    } else {
+        PMIX_SETENV_COMPAT("LD_PRELOAD", lib, true, &env);
+    }
+    free(lib);
+    /* resolve everything now, once, rather than in each proc */
+    PMIX_SETENV_COMPAT("LD_BIND_NOW", "1", true, &env);
+    pmix_asprintf(&tmp, "%d", sv[1]);
+    PMIX_SETENV_COMPAT(PRTE_ZYGOTE_FD_ENV, tmp, true, &env);
+    free(tmp);
+    /* the environment of each proc is written over that of
+     * the zygote, so leave room for it */
+    for (n = PMIX_ARGV_COUNT_COMPAT(env);
+         n < PMIX_ARGV_COUNT_COMPAT(cd->env) + PRTE_ZYGOTE_ENV_SLACK; n++) {
+        pmix_asprintf(&tmp, "PRTE_ZYGOTE_PAD_%d=", n);
+        PMIX_ARGV_APPEND_NOSIZE_COMPAT(&env, tmp);
+        free(tmp);
+    }
+
+    z->pid = fork();
+    if (0 == z->pid) {
+        close(sv[0]);
+        do_zygote(cd, sv[1], env);
+        /* does not return */
+    }
+    PMIX_ARGV_FREE_COMPAT(env);
+    close(sv[1]);
+    z->sd = sv[0];
+    if (0 > z->pid) {
+        return z;
+    }
+    pmix_fd_set_cloexec(z->sd);
+
+    pmix_output_verbose(2, prte_odls_base_framework.framework_output,
+                        "%s odls:pdefault:zygote %d starting for %s",
+                        PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), (int) z->pid, cd->app->app);
+    z->deadline = time(NULL) + prte_mca_odls_pdefault_component.zygote_timeout;
+    z->failed = false;
+    return z;
+}
+
+/* see if a zygote has reported in, without waiting for it */
+static bool check_ready(prte_odls_zygote_t *z, prte_odls_spawn_caddy_t *cd)
+{
+    prte_zygote_hello_t hello;
+    struct pollfd pfd;
+    int rc;
+
+    if (z->ready) {
+        return true;
+    }
+
+    pfd.fd = z->sd;
+    pfd.events = POLLIN;
+    do {
+        rc = poll(&pfd, 1, 0);
+    } while (0 > rc && EINTR == errno);
+    if (0 == rc && time(NULL) < z->deadline) {
+        /* still starting up */
+        return false;
+    }
+    if (1 != rc || PMIX_SUCCESS != pmix_fd_read(z->sd, sizeof(hello), &hello)
+        || PRTE_ZYGOTE_VERSION != hello.version || z->pid != hello.pid) {
+        pmix_output_verbose(2, prte_odls_base_framework.framework_output,
+                            "%s odls:pdefault:zygote for %s did not report in",
+                            PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), cd->app->app);
+        close(z->sd);
+        z->sd = -1;
+        kill(-z->pid, SIGKILL);
+        z->pid = -1;
+        z->failed = true;
+        return false;
+    }
+
+    pmix_output_verbose(2, prte_odls_base_framework.framework_output,
+                        "%s odls:pdefault:zygote %d started for %s",
+                        PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), (int) z->pid, cd->app->app);
+    z->nenv = hello.nenv;
+    z->ready = true;
+    return true;
+}
+
+static prte_odls_zygote_t *get_zygote(prte_odls_spawn_caddy_t *cd)
+{
+    prte_odls_zygote_t *z;
+    char *key;
+
+    key = signature(cd);
+    if (NULL == key) {
+        return NULL;
+    }
+    PMIX_LIST_FOREACH(z, &zygotes, prte_odls_zygote_t) {
+        if (0 == strcmp(z->key, key)) {
+            free(key);
+            pmix_list_remove_item(&zygotes, &z->super);
+            pmix_list_prepend(&zygotes, &z->super);
+            return z;
+        }
+    }
+    return start_zygote(cd, key);
+}
+
+static void drop_zygote(prte_odls_zygote_t *z)
+{
+    pmix_list_remove_item(&zygotes, &z->super);
+    PMIX_RELEASE(z);
+}
+
+static int send_all(int sd, const char *ptr, size_t len)
+{
+    ssize_t rc;
+
+    while (0 < len) {
+        rc = send(sd, ptr, len, MSG_NOSIGNAL);
+        if (0 > rc) {
+            if (EINTR == errno) {
+                continue;
+            }
+            return PRTE_ERROR;
+        }
+        ptr += rc;
+        len -= rc;
+    }
+    return PRTE_SUCCESS;
+}
+
+/* the cpus the proc is to be bound to, following the
+ * rules of prte_odls_base_set */
+static char *bind_list(prte_odls_spawn_caddy_t *cd)
+{
+    hwloc_const_cpuset_t cpuset;
+    hwloc_obj_t root;
+    char *list = NULL;
+
+    if (NULL != cd->child->cpuset && 0 < strlen(cd->child->cpuset)) {
+        return strdup(cd->child->cpuset);
+    }
+    /* if the daemon is bound, then we need to "free" this proc */
+    if (NULL != prte_daemon_cores) {
+        root = hwloc_get_root_obj(prte_hwloc_topology);
+        if (NULL == root->userdata) {
+            pmix_show_help("help-prte-odls-default.txt", "incorrectly bound", true,
+                           prte_process_info.nodename, cd->app->app, __FILE__, __LINE__);
+        }
+        cpuset = hwloc_topology_get_allowed_cpuset(prte_hwloc_topology);
+        if (0 <= hwloc_bitmap_list_asprintf(&list, cpuset)) {
+            return list;
+        }
+    }
+    return strdup("");
+}
+
+static int send_request(prte_odls_zygote_t *z, prte_odls_spawn_caddy_t *cd, int *fds)
+{
+    prte_zygote_req_t req;
+    struct msghdr msg;
+    struct iovec iov;
+    union {
+        char buf[CMSG_SPACE(sizeof(int) * PRTE_ZYGOTE_NFDS)];
+        struct cmsghdr align;
+    } ctl;
+    struct cmsghdr *cmsg;
+    char *cpus, *strs, *ptr;
+    size_t len;
+    ssize_t rc;
+    int n, ret;
+
+    cpus = bind_list(cd);
+    len = strlen((NULL == cd->wdir) ? "" : cd->wdir) + 1 + strlen(cpus) + 1;
+    for (n = 0; NULL != cd->env && NULL != cd->env[n]; n++) {
+        len += strlen(cd->env[n]) + 1;
+    }
+    req.nenv = n;
+    req.len = len;
+    req.flags = 0;
+    if (NULL != cd->jdata->map && PRTE_BINDING_POLICY_IS_SET(cd->jdata->map->binding)) {
+        req.flags |= PRTE_ZYGOTE_BIND_REPORT;
+        if (PRTE_BINDING_REQUIRED(cd->jdata->map->binding)) {
+            req.flags |= PRTE_ZYGOTE_BIND_REQUIRED;
+        }
+    }
+
+    strs = (char *) malloc(len);
+    ptr = strs;
+    ptr = stpcpy(ptr, (NULL == cd->wdir) ? "" : cd->wdir) + 1;
+    ptr = stpcpy(ptr, cpus) + 1;
+    for (n = 0; n < (int) req.nenv; n++) {
+        ptr = stpcpy(ptr, cd->env[n]) + 1;
+    }
+    free(cpus);
+
+    /* the header carries the descriptors */
+    memset(&msg, 0, sizeof(msg));
+    memset(&ctl, 0, sizeof(ctl));
+    iov.iov_base = &req;
+    iov.iov_len = sizeof(req);
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = ctl.buf;
+    msg.msg_controllen = sizeof(ctl.buf);
+    cmsg = CMSG_FIRSTHDR(&msg);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type = SCM_RIGHTS;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(int) * PRTE_ZYGOTE_NFDS);
+    memcpy(CMSG_DATA(cmsg), fds, sizeof(int) * PRTE_ZYGOTE_NFDS);
+    do {
+        rc = sendmsg(z->sd, &msg, MSG_NOSIGNAL);
+    } while (0 > rc && EINTR == errno);
+
+    if (0 > rc) {
+        ret = PRTE_ERROR;
+    } else if ((size_t) rc < sizeof(req)) {
+        ret = send_all(z->sd, (char *) &req + rc, sizeof(req) - rc);
+    } else {
+        ret = PRTE_SUCCESS;
+    }
+    if (PRTE_SUCCESS == ret) {
+        ret = send_all(z->sd, strs, len);
+    }
+    free(strs);
+    return ret;
+}
+
+/* collect what the new proc had to say about setting itself up */
+static int read_errors(prte_odls_spawn_caddy_t *cd, int read_fd)
+{
+    prte_proc_t *child = cd->child;
+    prte_zygote_err_t err;
+    char *msg;
+    int rc;
+
+    while (1) {
+        rc = pmix_fd_read(read_fd, sizeof(err), &err);
+        /* If the pipe closed, then the child successfully launched */
+        if (PMIX_ERR_TIMEOUT == rc) {
+            break;
+        }
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            close(read_fd);
+            child->state = PRTE_PROC_STATE_UNDEF;
+            return prte_pmix_convert_status(rc);
+        }
+
+        switch (err.what) {
+        case PRTE_ZYGOTE_ERR_WDIR:
+            pmix_show_help("help-prun.txt", "prun:wdir-not-found", true, "prted", cd->wdir,
+                           prte_process_info.nodename, child->app_rank);
+            break;
+        case PRTE_ZYGOTE_ERR_BIND:
+            pmix_asprintf(&msg, "sched_setaffinity returned \"%s\" for bitmap \"%s\"",
+                          strerror(err.err), (NULL == child->cpuset) ? "" : child->cpuset);
+            pmix_show_help("help-prte-odls-default.txt",
+                           err.fatal ? "binding generic error" : "not bound", true,
+                           prte_process_info.nodename, cd->app->app, msg, __FILE__, __LINE__);
+            free(msg);
+            break;
+        default:
+            pmix_show_help("help-prte-odls-default.txt", "syscall fail", true,
+                           prte_process_info.nodename, cd->app->app, "environ", __FILE__,
+                           __LINE__);
+            break;
+        }
+
+        if (err.fatal) {
+            child->state = PRTE_PROC_STATE_FAILED_TO_START;
+            PRTE_FLAG_UNSET(child, PRTE_PROC_FLAG_ALIVE);
+            close(read_fd);
+            return PRTE_ERR_FAILED_TO_START;
+        }
+    }
+
+    child->state = PRTE_PROC_STATE_RUNNING;
+    PRTE_FLAG_SET(child, PRTE_PROC_FLAG_ALIVE);
+    close(read_fd);
+    return PRTE_SUCCESS;
+}
+
+int prte_odls_pdefault_zygote_spawn(void *cdptr)
+{
+    prte_odls_spawn_caddy_t *cd = (prte_odls_spawn_caddy_t *) cdptr;
+    prte_proc_t *child = cd->child;
+    prte_odls_zygote_t *z;
+    int fds[PRTE_ZYGOTE_NFDS], p[2], fdnull = -1;
+    int32_t pid;
+    int rc;
+
+    if (!eligible(cd)) {
+        return PRTE_ERR_TAKE_NEXT_OPTION;
+    }
+
+    /* the descriptors the proc would have been left with by do_child */
+    if (PRTE_FLAG_TEST(cd->jdata, PRTE_JOB_FLAG_FORWARD_OUTPUT)) {
+        if (cd->opts.usepty && PRTE_SUCCESS != prte_iof_base_setup_pty(cd->opts.p_stdout[1])) {
+            return PRTE_ERR_TAKE_NEXT_OPTION;
+        }
+        if (cd->opts.connect_stdin) {
+            fds[PRTE_ZYGOTE_FD_STDIN] = cd->opts.p_stdin[0];
+        } else {
+            fdnull = open("/dev/null", O_RDONLY, 0);
+            if (0 > fdnull) {
+                return PRTE_ERR_TAKE_NEXT_OPTION;
+            }
+            fds[PRTE_ZYGOTE_FD_STDIN] = fdnull;
+        }
+        fds[PRTE_ZYGOTE_FD_STDOUT] = cd->opts.p_stdout[1];
+        fds[PRTE_ZYGOTE_FD_STDERR] = cd->opts.p_stderr[1];
+    } else {
+        fds[PRTE_ZYGOTE_FD_STDIN] = 0;
+        fds[PRTE_ZYGOTE_FD_STDOUT] = 1;
+        fds[PRTE_ZYGOTE_FD_STDERR] = 2;
+    }
+    if (pipe(p) < 0) {
+        if (0 <= fdnull) {
+            close(fdnull);
+        }
+        return PRTE_ERR_TAKE_NEXT_OPTION;
+    }
+    fds[PRTE_ZYGOTE_FD_ERR] = p[1];
+
+    pmix_mutex_lock(&zygote_lock);
+    z = get_zygote(cd);
+    if (NULL == z || z->failed || !check_ready(z, cd)
+        || (uint32_t) PMIX_ARGV_COUNT_COMPAT(cd->env) > z->nenv) {
+        rc = PRTE_ERR_TAKE_NEXT_OPTION;
+    } else if (PRTE_SUCCESS != send_request(z, cd, fds)
+               || PMIX_SUCCESS != pmix_fd_read(z->sd, sizeof(pid), &pid)) {
+        /* the zygote has gone away - start over
+         * with a new one next time */
+        drop_zygote(z);
+        rc = PRTE_ERR_TAKE_NEXT_OPTION;
+    } else {
+        rc = PRTE_SUCCESS;
+    }
+    pmix_mutex_unlock(&zygote_lock);
+
+    close(p[1]);
+    if (0 <= fdnull) {
+        close(fdnull);
+    }
+    if (PRTE_SUCCESS != rc) {
+        close(p[0]);
+        return rc;
+    }
+
+    /* the request is out, so the proc end of
+     * the stdio is no longer ours either way */
+    if (PRTE_FLAG_TEST(cd->jdata, PRTE_JOB_FLAG_FORWARD_OUTPUT)) {
+        if (cd->opts.connect_stdin) {
+            close(cd->opts.p_stdin[0]);
+        }
+        close(cd->opts.p_stdout[1]);
+        close(cd->opts.p_stderr[1]);
+    }
+
+    if (0 > pid) {
+        close(p[0]);
+        PRTE_ERROR_LOG(PMIX_ERR_SYS_LIMITS_CHILDREN);
+        child->state = PRTE_PROC_STATE_FAILED_TO_START;
+        child->exit_code = PMIX_ERR_SYS_LIMITS_CHILDREN;
+        return PMIX_ERR_SYS_LIMITS_CHILDREN;
+    }
+    child->pid = pid;
+
+    return read_errors(cd, p[0]);
+}
+
+void prte_odls_pdefault_zygote_finalize(void)
+{
+    pmix_mutex_lock(&zygote_lock);
+    PMIX_LIST_DESTRUCT(&zygotes);
+    PMIX_CONSTRUCT(&zygotes, pmix_list_t);
+    pmix_mutex_unlock(&zygote_lock);
+}
+
+#else
+
+int prte_odls_pdefault_zygote_spawn(void *cdptr)
+{
+    PRTE_HIDE_UNUSED_PARAMS(cdptr);
+    return PRTE_ERR_TAKE_NEXT_OPTION;
+}
+
+void prte_odls_pdefault_zygote_finalize(void)
+{
+}
+
+#endif
@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2025      Nanook Consulting  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ * Zygote launch of local procs.
+ *
+ * A zygote is a copy of an executable that has been exec'd with the
+ * prte_zygote library preloaded. By the time that library's
+ * constructor runs, the executable and every library it depends upon
+ * have been loaded and relocated and their constructors have run, so
+ * the zygote parks there and forks a new proc for each request from
+ * its daemon. Each fork then returns from the constructor and carries
+ * on into main as the requested proc - skipping the exec, the dynamic
+ * linking and the library initialization it would otherwise repeat.
+ *
+ * The daemon and a zygote talk over a stream socket:
+ *
+ *    zygote -> daemon    prte_zygote_hello_t once the zygote is ready,
+ *                        giving the number of environment entries a
+ *                        proc it forks can be handed
+ *    daemon -> zygote    prte_zygote_req_t carrying PRTE_ZYGOTE_NFDS
+ *                        descriptors, followed by req.len bytes of
+ *                        NUL-terminated strings - the working dir,
+ *                        the cpu list to bind to (empty if unbound)
+ *                        and req.nenv environment entries
+ *    zygote -> daemon    an int32_t holding the pid of the new proc,
+ *                        or -errno if it could not be forked
+ *
+ * Each proc's environment is written into the zygote's own environ
+ * array - the one that will be passed to main - so the daemon starts
+ * the zygote with enough entries to hold that of any of its procs.
+ *
+ * The new proc reports any problem setting itself up as a
+ * prte_zygote_err_t on the error pipe it was handed, and closes the
+ * pipe once it is ready to enter main.
+ *
+ * This header is shared with the preload library, which must not
+ * depend on anything beyond libc.
+ */
+
+#ifndef PRTE_ODLS_PDEFAULT_ZYGOTE_H
+#define PRTE_ODLS_PDEFAULT_ZYGOTE_H
+
+#include "prte_config.h"
+
+#include <stdint.h>
+
+BEGIN_C_DECLS
+
+/* envar that tells the preload library which fd leads to the daemon */
+#define PRTE_ZYGOTE_FD_ENV "PRTE_ZYGOTE_FD"
+
+/* name of the preload library in the PRRTE library directory */
+#define PRTE_ZYGOTE_LIB "prte_zygote.so"
+
+#define PRTE_ZYGOTE_VERSION 1
+
+/* descriptors passed with each request */
+typedef enum {
+    PRTE_ZYGOTE_FD_STDIN,
+    PRTE_ZYGOTE_FD_STDOUT,
+    PRTE_ZYGOTE_FD_STDERR,
+    PRTE_ZYGOTE_FD_ERR,
+    PRTE_ZYGOTE_NFDS
+} prte_zygote_fd_t;
+
+/* request flags */
+#define PRTE_ZYGOTE_BIND_REPORT   0x01 // report a failure to bind
+#define PRTE_ZYGOTE_BIND_REQUIRED 0x02 // failing to bind is fatal
+
+typedef struct {
+    uint32_t version;
+    int32_t pid;
+    uint32_t nenv;
+} prte_zygote_hello_t;
+
+typedef struct {
+    uint32_t nenv;
+    uint32_t len;
+    uint32_t flags;
+} prte_zygote_req_t;
+
+/* what a new proc failed to do */
+typedef enum {
+    PRTE_ZYGOTE_ERR_WDIR,
+    PRTE_ZYGOTE_ERR_BIND,
+    PRTE_ZYGOTE_ERR_ENV
+} prte_zygote_what_t;
+
+typedef struct {
+    int32_t what;
+    int32_t fatal;
+    int32_t err;
+} prte_zygote_err_t;
+
+/* launch the proc of the given spawn caddy from a zygote of its
+ * executable, starting one if need be. Returns
+ * PRTE_ERR_TAKE_NEXT_OPTION if the proc must be launched the
+ * normal way instead */
+int prte_odls_pdefault_zygote_spawn(void *cdptr);
+
+/* stop all zygotes */
+void prte_odls_pdefault_zygote_finalize(void);
+
+END_C_DECLS
+
+#endif
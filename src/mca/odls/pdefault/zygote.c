@@ -0,0 +1,330 @@
+/*
+ * Copyright (c) 2025      Nanook Consulting  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ * The library preloaded into each zygote - see odls_pdefault_zygote.h.
+ *
+ * Nothing happens unless PRTE_ZYGOTE_FD is set, in which case the
+ * constructor below never returns in the zygote itself. Instead it
+ * forks a new proc for each request from the daemon, and it is each
+ * of those that returns from the constructor and carries on into the
+ * executable's own constructors and main. A proc is forked by a child
+ * of the zygote that exits right away, so the proc is re-parented to
+ * the daemon rather than to the zygote.
+ *
+ * This library runs inside the user's executable before main, so it
+ * uses nothing beyond libc.
+ *
+ * The environment of each proc is written into the environ array the
+ * zygote was exec'd with rather than into a new one. Some libcs hand
+ * main the envp they found at startup, not the current environ, so
+ * this is the only way for main to see the environment of the proc.
+ */
+
+#include "prte_config.h"
+
+#include <errno.h>
+#include <sched.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/uio.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "odls_pdefault_zygote.h"
+
+extern char **environ;
+
+static int read_all(int fd, void *buf, size_t len)
+{
+    char *ptr = (char *) buf;
+    ssize_t rc;
+
+    while (0 < len) {
+        rc = read(fd, ptr, len);
+        if (0 > rc && EINTR == errno) {
+            continue;
+        }
+        if (0 >= rc) {
+            return -1;
+        }
+        ptr += rc;
+        len -= rc;
+    }
+    return 0;
+}
+
+static int write_all(int fd, const void *buf, size_t len)
+{
+    const char *ptr = (const char *) buf;
+    ssize_t rc;
+
+    while (0 < len) {
+        rc = write(fd, ptr, len);
+        if (0 > rc && EINTR == errno) {
+            continue;
+        }
+        if (0 >= rc) {
+            return -1;
+        }
+        ptr += rc;
+        len -= rc;
+    }
+    return 0;
+}
+
+/* receive a request along with its descriptors */
+static int recv_request(int sd, prte_zygote_req_t *req, char **strs, int *fds)
+{
+    struct msghdr msg;
+    struct iovec iov;
+    union {
+        char buf[CMSG_SPACE(sizeof(int) * PRTE_ZYGOTE_NFDS)];
+        struct cmsghdr align;
+    } ctl;
+    struct cmsghdr *cmsg;
+    ssize_t rc;
+    int n;
+
+    memset(&msg, 0, sizeof(msg));
+    iov.iov_base = req;
+    iov.iov_len = sizeof(*req);
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = ctl.buf;
+    msg.msg_controllen = sizeof(ctl.buf);
+    do {
+        rc = recvmsg(sd, &msg, 0);
+    } while (0 > rc && EINTR == errno);
+    if (0 >= rc) {
+        return -1;
+    }
+
+    cmsg = CMSG_FIRSTHDR(&msg);
+    if (NULL == cmsg || SOL_SOCKET != cmsg->cmsg_level || SCM_RIGHTS != cmsg->cmsg_type
+        || CMSG_LEN(sizeof(int) * PRTE_ZYGOTE_NFDS) != cmsg->cmsg_len) {
+        return -1;
+    }
+    memcpy(fds, CMSG_DATA(cmsg), sizeof(int) * PRTE_ZYGOTE_NFDS);
+
+    if ((size_t) rc < sizeof(*req)
+        && 0 != read_all(sd, (char *) req + rc, sizeof(*req) - rc)) {
+        goto fail;
+    }
+    /* at least the wdir and the cpu list */
+    if (2 > req->len) {
+        goto fail;
+    }
+    *strs = (char *) malloc(req->len);
+    if (NULL == *strs) {
+        goto fail;
+    }
+    if (0 != read_all(sd, *strs, req->len) || '\0' != (*strs)[req->len - 1]) {
+        free(*strs);
+        goto fail;
+    }
+    return 0;
+
+fail:
+    for (n = 0; n < PRTE_ZYGOTE_NFDS; n++) {
+        close(fds[n]);
+    }
+    return -1;
+}
+
+/* bind to a list of cpus such as "0-3,8,10-11" */
+static int bind_to(const char *list)
+{
+    const char *ptr;
+    char *end;
+    cpu_set_t *set = NULL;
+    size_t size = 0;
+    long lo, hi, max = 0, n;
+    int pass, rc = 0;
+
+    /* size the set on the first pass, fill it on the second */
+    for (pass = 0; pass < 2; pass++) {
+        if (1 == pass) {
+            set = CPU_ALLOC(max + 1);
+            if (NULL == set) {
+                return ENOMEM;
+            }
+            size = CPU_ALLOC_SIZE(max + 1);
+            CPU_ZERO_S(size, set);
+        }
+        for (ptr = list; '\0' != *ptr; ptr = end) {
+            lo = strtol(ptr, &end, 10);
+            if (end == ptr || 0 > lo) {
+                return EINVAL;
+            }
+            hi = lo;
+            if ('-' == *end) {
+                ptr = end + 1;
+                hi = strtol(ptr, &end, 10);
+                if (end == ptr || hi < lo) {
+                    return EINVAL;
+                }
+            }
+            if (',' == *end) {
+                end++;
+            } else if ('\0' != *end) {
+                return EINVAL;
+            }
+            if (0 == pass) {
+                if (hi > max) {
+                    max = hi;
+                }
+            } else {
+                for (n = lo; n <= hi; n++) {
+                    CPU_SET_S(n, size, set);
+                }
+            }
+        }
+    }
+
+    if (0 != sched_setaffinity(0, size, set)) {
+        rc = errno;
+    }
+    CPU_FREE(set);
+    return rc;
+}
+
+static void report(int fd, int what, int fatal, int err)
+{
+    prte_zygote_err_t msg;
+
+    msg.what = what;
+    msg.fatal = fatal;
+    msg.err = err;
+    (void) write_all(fd, &msg, sizeof(msg));
+    if (fatal) {
+        _exit(1);
+    }
+}
+
+/* turn this copy of the zygote into the requested proc, whose
+ * environment goes into the nslots entries of envp */
+static void become_proc(prte_zygote_req_t *req, char *strs, int *fds,
+                        char **envp, uint32_t nslots)
+{
+    char *wdir, *cpus, *env;
+    uint32_t n;
+    int efd = fds[PRTE_ZYGOTE_FD_ERR];
+    int i, rc;
+
+    /* a new process group, as do_child would have set */
+    setpgid(0, 0);
+
+    for (i = 0; i < 3; i++) {
+        if (0 > dup2(fds[i], i)) {
+            _exit(1);
+        }
+        close(fds[i]);
+    }
+
+    wdir = strs;
+    cpus = wdir + strlen(wdir) + 1;
+    env = cpus + strlen(cpus) + 1;
+
+    if ('\0' != *cpus && 0 != (rc = bind_to(cpus))
+        && (req->flags & PRTE_ZYGOTE_BIND_REPORT)) {
+        report(efd, PRTE_ZYGOTE_ERR_BIND, 0 != (req->flags & PRTE_ZYGOTE_BIND_REQUIRED), rc);
+    }
+    if ('\0' != *wdir && 0 != chdir(wdir)) {
+        report(efd, PRTE_ZYGOTE_ERR_WDIR, 1, errno);
+    }
+
+    /* the strings live on for as long as the proc does */
+    if (req->nenv > nslots) {
+        report(efd, PRTE_ZYGOTE_ERR_ENV, 1, E2BIG);
+    }
+    for (n = 0; n < req->nenv; n++) {
+        envp[n] = env;
+        env += strlen(env) + 1;
+    }
+    envp[n] = NULL;
+    environ = envp;
+
+    /* all set - closing the error pipe tells the daemon so */
+    close(efd);
+}
+
+__attribute__((constructor)) static void prte_zygote_init(void)
+{
+    prte_zygote_hello_t hello;
+    prte_zygote_req_t req;
+    char *ptr, *strs, **envp;
+    int fds[PRTE_ZYGOTE_NFDS], p[2], sd, n, status;
+    uint32_t nslots;
+    int32_t pid;
+    pid_t mid;
+
+    ptr = getenv(PRTE_ZYGOTE_FD_ENV);
+    if (NULL == ptr) {
+        return;
+    }
+    sd = strtol(ptr, NULL, 10);
+
+    /* the array main will be handed */
+    envp = environ;
+    for (nslots = 0; NULL != envp[nslots]; nslots++) {
+    }
+
+    hello.version = PRTE_ZYGOTE_VERSION;
+    hello.pid = getpid();
+    hello.nenv = nslots;
+    if (0 != write_all(sd, &hello, sizeof(hello))) {
+        _exit(1);
+    }
+
+    /* the daemon closing its end is our signal to go */
+    while (0 == recv_request(sd, &req, &strs, fds)) {
+        if (0 != pipe(p)) {
+            pid = -errno;
+        } else {
+            mid = fork();
+            if (0 == mid) {
+                close(p[0]);
+                pid = fork();
+                if (0 == pid) {
+                    close(p[1]);
+                    close(sd);
+                    become_proc(&req, strs, fds, envp, nslots);
+                    /* on into main */
+                    return;
+                }
+                if (0 > pid) {
+                    pid = -errno;
+                }
+                (void) write_all(p[1], &pid, sizeof(pid));
+                _exit(0);
+            }
+            close(p[1]);
+            if (0 > mid) {
+                pid = -errno;
+            } else if (0 != read_all(p[0], &pid, sizeof(pid))) {
+                pid = -ECHILD;
+            }
+            close(p[0]);
+            if (0 < mid) {
+                while (0 > waitpid(mid, &status, 0) && EINTR == errno) {
+                }
+            }
+        }
+        for (n = 0; n < PRTE_ZYGOTE_NFDS; n++) {
+            close(fds[n]);
+        }
+        free(strs);
+        if (0 != write_all(sd, &pid, sizeof(pid))) {
+            break;
+        }
+    }
+    _exit(0);
+}
@@ -60,7 +60,8 @@ prte_plm_globals_t prte_plm_globals = {
     .daemon_nodes_assigned_at_launch = true,
     .node_regex_threshold = 0,
     .daemon_cache = PMIX_LIST_STATIC_INIT,
-    .daemon1_has_reported = false
+    .daemon1_has_reported = false,
+    .num_launch_children = -1
 };
 
 /*
@@ -903,6 +903,7 @@ void prte_plm_base_send_launch_msg(int fd, short args, void *cbdata)
     }
     PMIX_DATA_BUFFER_DESTRUCT(&jdata->launch_msg);
     PMIX_DATA_BUFFER_CONSTRUCT(&jdata->launch_msg);
+    PRTE_TIMELINE_MARK(jdata->nspace, PRTE_TIMELINE_LAUNCH_SENT);
 
     /* track that we automatically are considered to have reported - used
      * only to report launch progress
@@ -1194,6 +1195,86 @@ static PMIX_CLASS_INSTANCE(dcaddy_t,
                            pmix_list_item_t,
                            dcon, ddes);
 
+/* find a recorded topology that matches the given one. Signatures
+ * only summarize the object counts, so in hetero mode we also confirm
+ * the full trees are identical before sharing them. On a match, the
+ * provided signature and topology are consumed */
+static prte_topology_t *intern_topology(char *sig, hwloc_topology_t topo)
+{
+    prte_topology_t *t;
+    hwloc_topology_diff_t diff;
+    int i, rc;
+
+    for (i = 0; i < prte_node_topologies->size; i++) {
+        t = (prte_topology_t *) pmix_pointer_array_get_item(prte_node_topologies, i);
+        if (NULL == t || 0 != strcmp(sig, t->sig)) {
+            continue;
+        }
+        if (NULL == t->topo) {
+            t->topo = topo;
+        } else if (NULL != topo) {
+            /* the trees are identical only if hwloc finds no
+             * differences at all - a non-empty diff is still
+             * returned with success */
+            diff = NULL;
+            rc = hwloc_topology_diff_build(t->topo, topo, 0, &diff);
+            if (NULL != diff) {
+                hwloc_topology_diff_destroy(diff);
+                rc = -1;
+            }
+            if (0 != rc) {
+                /* same signature, different hardware */
+                continue;
+            }
+            hwloc_topology_destroy(topo);
+        }
+        free(sig);
+        return t;
+    }
+    return NULL;
+}
+
+/* approximate the memory held by a topology tree */
+static size_t topology_footprint(hwloc_topology_t topo)
+{
+    size_t sz = 0;
+    int d, depth;
+
+    depth = hwloc_topology_get_depth(topo);
+    for (d = 0; d < depth; d++) {
+        sz += hwloc_get_nbobjs_by_depth(topo, d) * (sizeof(struct hwloc_obj) + 4 * sizeof(hwloc_bitmap_t));
+    }
+    return sz;
+}
+
+static void report_topologies(prte_job_t *daemons)
+{
+    prte_topology_t *t;
+    size_t bytes = 0, sz;
+    int i, ntopos = 0;
+
+    if (1 > pmix_output_get_verbosity(prte_plm_base_framework.framework_output)) {
+        return;
+    }
+    for (i = 0; i < prte_node_topologies->size; i++) {
+        t = (prte_topology_t *) pmix_pointer_array_get_item(prte_node_topologies, i);
+        if (NULL == t || NULL == t->topo) {
+            continue;
+        }
+        sz = topology_footprint(t->topo);
+        pmix_output(prte_plm_base_framework.framework_output,
+                    "%s plm:base:topologies topology %d: ~%lu KB sig %s",
+                    PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), t->index,
+                    (unsigned long) (sz / 1024), t->sig);
+        bytes += sz;
+        ++ntopos;
+    }
+    pmix_output(prte_plm_base_framework.framework_output,
+                "%s plm:base:topologies %d nodes share %d distinct topologies (~%lu KB)",
+                PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), (int) daemons->num_procs, ntopos,
+                (unsigned long) (bytes / 1024));
+}
+
 static void progress_daemons(prte_job_t *daemons,
                              bool show_progress)
 {
@@ -1217,6 +1298,7 @@ static void progress_daemons(prte_job_t *daemons,
         if (daemons->num_procs == daemons->num_reported) {
             bool oneactivated = false;
             daemons->state = PRTE_JOB_STATE_DAEMONS_REPORTED;
+            report_topologies(daemons);
             /* activate the daemons_reported state for all jobs
              * whose daemons were launched
              */
@@ -1693,14 +1775,22 @@ void prte_plm_base_daemon_callback(int status, pmix_proc_t *sender, pmix_data_bu
         }
 
         if (prte_hetero_nodes) {
-            // always record the topology
-            t = PMIX_NEW(prte_topology_t);
-            t->sig = sig;
-            t->topo = topo;
-            t->index = pmix_pointer_array_add(prte_node_topologies, t);
+            // share the topology if we have already seen this hardware
+            t = intern_topology(sig, topo);
+            if (NULL == t) {
+                t = PMIX_NEW(prte_topology_t);
+                t->sig = sig;
+                t->topo = topo;
+                t->index = pmix_pointer_array_add(prte_node_topologies, t);
+                prte_hwloc_base_setup_summary(t->topo);
+            }
             daemon->node->topology = t;
+            if (NULL != daemon->node->available) {
+                hwloc_bitmap_free(daemon->node->available);
+            }
             daemon->node->available = prte_hwloc_base_filter_cpus(t->topo);
-            prte_hwloc_base_setup_summary(t->topo);
+            jdatorted->num_reported++;
+            jdatorted->num_daemons_reported++;
             // cannot have cached daemons
             free(nodename);
             nodename = NULL;
@@ -2067,6 +2157,14 @@ int prte_plm_base_prted_append_basic_args(int *argc, char ***argv, char *ess, in
     pmix_argv_append(argc, argv, param);
     free(param);
 
+    /* published data must be spread the same way by every daemon,
+     * including those that join the DVM later */
+    pmix_argv_append(argc, argv, "--prtemca");
+    pmix_argv_append(argc, argv, "pmix_pubsub_shards");
+    pmix_asprintf(&param, "%d", prte_pmix_server_pubsub_shards());
+    pmix_argv_append(argc, argv, param);
+    free(param);
+
     /* pass the HNP uri */
     pmix_argv_append(argc, argv, "--prtemca");
     pmix_argv_append(argc, argv, "prte_hnp_uri");
@@ -66,6 +66,9 @@ typedef struct {
     size_t node_regex_threshold;
     pmix_list_t daemon_cache;
     bool daemon1_has_reported;
+    /* number of daemons we launched when the launch tree
+     * differs from the routing tree, or -1 */
+    int num_launch_children;
 } prte_plm_globals_t;
 /**
  * Global instance of PLM framework data
@@ -61,6 +61,8 @@ struct prte_mca_plm_ssh_component_t {
     struct timespec delay;
     int priority;
     bool no_tree_spawn;
+    int launch_radix;
+    bool launch_timeline;
     int num_concurrent;
     char *agent;
     char *agent_path;
@@ -68,6 +70,8 @@ struct prte_mca_plm_ssh_component_t {
     bool assume_same_shell;
     bool pass_environ_mca_params;
     char *ssh_args;
+    int persist;
+    char *control_dir;
     char *pass_libpath;
     char *chdir;
 };
@@ -159,6 +159,22 @@ static int ssh_component_register(void)
                                                 PMIX_MCA_BASE_VAR_TYPE_BOOL,
                                                 &prte_mca_plm_ssh_component.no_tree_spawn);
 
+    prte_mca_plm_ssh_component.launch_radix = 0;
+    (void) pmix_mca_base_component_var_register(c, "launch_radix",
+                                                "Radix of the k-nomial tree used to launch daemons when tree spawning, "
+                                                "independent of the routing tree - a value of 2 gives a binomial tree "
+                                                "in which every started daemon immediately begins launching others "
+                                                "(default: 0, launch along the routing tree)",
+                                                PMIX_MCA_BASE_VAR_TYPE_INT,
+                                                &prte_mca_plm_ssh_component.launch_radix);
+
+    prte_mca_plm_ssh_component.launch_timeline = false;
+    (void) pmix_mca_base_component_var_register(c, "launch_timeline",
+                                                "Print a timestamped trace of each daemon launch and of each "
+                                                "daemon starting to launch its own children",
+                                                PMIX_MCA_BASE_VAR_TYPE_BOOL,
+                                                &prte_mca_plm_ssh_component.launch_timeline);
+
     /* local ssh/ssh launch agent */
     prte_mca_plm_ssh_component.agent = "ssh : rsh";
     var_id = pmix_mca_base_component_var_register(c, "agent",
@@ -199,6 +215,22 @@ static int ssh_component_register(void)
                                                 PMIX_MCA_BASE_VAR_TYPE_STRING,
                                                 &prte_mca_plm_ssh_component.pass_libpath);
 
+    prte_mca_plm_ssh_component.persist = 0;
+    (void) pmix_mca_base_component_var_register(c, "persist",
+                                                "If nonzero and the agent is ssh, multiplex all launches to a node "
+                                                "over one master connection that is kept open for this many seconds "
+                                                "after its last use, so later launches (e.g., when the DVM is "
+                                                "expanded or restarted) skip connection setup (default: 0, disabled)",
+                                                PMIX_MCA_BASE_VAR_TYPE_INT,
+                                                &prte_mca_plm_ssh_component.persist);
+
+    prte_mca_plm_ssh_component.control_dir = NULL;
+    (void) pmix_mca_base_component_var_register(c, "control_dir",
+                                                "Directory holding the master connection sockets when plm_ssh_persist "
+                                                "is set (default: prte-ssh-<uid> under the system tmp directory)",
+                                                PMIX_MCA_BASE_VAR_TYPE_STRING,
+                                                &prte_mca_plm_ssh_component.control_dir);
+
     prte_mca_plm_ssh_component.chdir = NULL;
     (void) pmix_mca_base_component_var_register(c, "chdir",
                                                 "Change working directory after ssh, but before exec of prted",
@@ -222,6 +254,11 @@ static int ssh_component_open(void)
                        prte_mca_plm_ssh_component.num_concurrent);
         prte_mca_plm_ssh_component.num_concurrent = 1;
     }
+    if (prte_mca_plm_ssh_component.launch_radix < 0) {
+        prte_mca_plm_ssh_component.launch_radix = 0;
+    } else if (1 == prte_mca_plm_ssh_component.launch_radix) {
+        prte_mca_plm_ssh_component.launch_radix = 2;
+    }
 
     if (NULL != prte_plm_ssh_delay_string) {
         prte_mca_plm_ssh_component.delay.tv_sec = strtol(prte_plm_ssh_delay_string, &ctmp, 10);
@@ -72,6 +72,7 @@
 #include "src/mca/pinstalldirs/pinstalldirs_types.h"
 #include "src/util/pmix_argv.h"
 #include "src/util/pmix_basename.h"
+#include "src/util/pmix_os_dirpath.h"
 #include "src/util/pmix_output.h"
 #include "src/util/pmix_path.h"
 #include "src/util/pmix_environ.h"
@@ -158,12 +159,15 @@ static const char *prte_plm_ssh_shell_name[7]
 static void set_handler_default(int sig);
 static prte_plm_ssh_shell_t find_shell(char *shell);
 static int launch_agent_setup(const char *agent, char *path);
+static void persistent_agent_setup(void);
 static void ssh_child(int argc, char **argv) __prte_attribute_noreturn__;
 static int ssh_probe(char *nodename, prte_plm_ssh_shell_t *shell);
 static int setup_shell(prte_plm_ssh_shell_t *sshell, prte_plm_ssh_shell_t *lshell, char *nodename,
                        int *argc, char ***argv);
 static void launch_daemons(int fd, short args, void *cbdata);
 static void process_launch_list(int fd, short args, void *cbdata);
+static void launch_tree_children(pmix_rank_t rank, pmix_rank_t ndmns, pmix_list_t *children);
+static double timeline_now(void);
 
 /* local global storage */
 static int num_in_progress = 0;
@@ -714,6 +718,19 @@ static int setup_launch(int *argcptr, char ***argvptr, char *nodename, int *node
         pmix_argv_append(&argc, &argv, "--prtemca");
         pmix_argv_append(&argc, &argv, "prte_parent_uri");
         pmix_argv_append(&argc, &argv, prte_process_info.my_uri);
+        /* they also need to follow the same launch tree */
+        if (0 < prte_mca_plm_ssh_component.launch_radix) {
+            pmix_asprintf(&param, "%d", prte_mca_plm_ssh_component.launch_radix);
+            pmix_argv_append(&argc, &argv, "--prtemca");
+            pmix_argv_append(&argc, &argv, "plm_ssh_launch_radix");
+            pmix_argv_append(&argc, &argv, param);
+            free(param);
+        }
+        if (prte_mca_plm_ssh_component.launch_timeline) {
+            pmix_argv_append(&argc, &argv, "--prtemca");
+            pmix_argv_append(&argc, &argv, "plm_ssh_launch_timeline");
+            pmix_argv_append(&argc, &argv, "1");
+        }
     }
 
     /* protect the params */
@@ -840,10 +857,30 @@ static int remote_spawn(void)
     pmix_proc_t target;
     prte_plm_ssh_caddy_t *caddy;
     prte_routed_tree_t *child;
+    pmix_list_t launch_children, *children;
     pmix_status_t ret;
 
     PMIX_OUTPUT_VERBOSE((1, prte_plm_base_framework.framework_output,
                          "%s plm:ssh: remote spawn called", PRTE_NAME_PRINT(PRTE_PROC_MY_NAME)));
+    if (prte_mca_plm_ssh_component.launch_timeline) {
+        pmix_output(0, "%s plm:ssh:timeline %.6f up",
+                    PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), timeline_now());
+    }
+
+    /* launch either our launch tree or our routing tree children */
+    PMIX_CONSTRUCT(&launch_children, pmix_list_t);
+    if (0 < prte_mca_plm_ssh_component.launch_radix) {
+        launch_tree_children(PRTE_PROC_MY_NAME->rank, prte_process_info.num_daemons,
+                             &launch_children);
+        /* our rollup goes back to the daemon that launched us, as
+         * recorded from its URI when we started */
+        prte_plm_globals.num_launch_children = pmix_list_get_size(&launch_children);
+        children = &launch_children;
+    } else {
+        /* we were launched by our routing parent */
+        prte_rml_base.launch_parent = PMIX_RANK_INVALID;
+        children = &prte_rml_base.children;
+    }
 
     /* if we hit any errors, tell the HNP it was us */
     target.rank = PRTE_PROC_MY_NAME->rank;
@@ -861,7 +898,7 @@ static int remote_spawn(void)
     pmix_prefix = getenv("PMIX_PREFIX");
 
     /* if I have no children, just return */
-    if (0 == pmix_list_get_size(&prte_rml_base.children)) {
+    if (0 == pmix_list_get_size(children)) {
         PMIX_OUTPUT_VERBOSE((1, prte_plm_base_framework.framework_output,
                              "%s plm:ssh: remote spawn - have no children!",
                              PRTE_NAME_PRINT(PRTE_PROC_MY_NAME)));
@@ -879,7 +916,7 @@ static int remote_spawn(void)
     }
 
     PMIX_LOAD_NSPACE(target.nspace, PRTE_PROC_MY_NAME->nspace);
-    PMIX_LIST_FOREACH(child, &prte_rml_base.children, prte_routed_tree_t)
+    PMIX_LIST_FOREACH(child, children, prte_routed_tree_t)
     {
         target.rank = child->rank;
 
@@ -933,6 +970,7 @@ cleanup:
     if (NULL != argv) {
         PMIX_ARGV_FREE_COMPAT(argv);
     }
+    PMIX_LIST_DESTRUCT(&launch_children);
 
     /* check for failed launch */
     if (failed_launch) {
@@ -1058,6 +1096,11 @@ static void process_launch_list(int fd, short args, void *cbdata)
                                  "%s plm:ssh: recording launch of daemon %s",
                                  PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
                                  PRTE_NAME_PRINT(&(caddy->daemon->name))));
+            if (prte_mca_plm_ssh_component.launch_timeline) {
+                pmix_output(0, "%s plm:ssh:timeline %.6f launch %s",
+                            PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), timeline_now(),
+                            PRTE_VPID_PRINT(caddy->daemon->name.rank));
+            }
             num_in_progress++;
         }
     }
@@ -1080,6 +1123,8 @@ static void launch_daemons(int fd, short args, void *cbdata)
     char *username, *nname;
     int port, *portptr;
     prte_routed_tree_t *child;
+    pmix_list_t launch_children, *children, pending;
+    pmix_list_item_t *item;
     PRTE_HIDE_UNUSED_PARAMS(fd, args);
 
     PMIX_ACQUIRE_OBJECT(state);
@@ -1126,6 +1171,11 @@ static void launch_daemons(int fd, short args, void *cbdata)
 
     PMIX_OUTPUT_VERBOSE((1, prte_plm_base_framework.framework_output, "%s plm:ssh: launching vm",
                          PRTE_NAME_PRINT(PRTE_PROC_MY_NAME)));
+    if (prte_mca_plm_ssh_component.launch_timeline) {
+        pmix_output(0, "%s plm:ssh:timeline %.6f start %d daemons",
+                    PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), timeline_now(),
+                    (int) map->num_new_daemons);
+    }
 
     if ((0 < pmix_output_get_verbosity(prte_plm_base_framework.framework_output)
          || prte_leave_session_attached)
@@ -1197,6 +1247,16 @@ static void launch_daemons(int fd, short args, void *cbdata)
         goto cleanup;
     }
 
+    /* if we are tree launching, determine our children */
+    PMIX_CONSTRUCT(&launch_children, pmix_list_t);
+    PMIX_CONSTRUCT(&pending, pmix_list_t);
+    if (0 < prte_mca_plm_ssh_component.launch_radix) {
+        launch_tree_children(PRTE_PROC_MY_NAME->rank, daemons->num_procs, &launch_children);
+        children = &launch_children;
+    } else {
+        children = &prte_rml_base.children;
+    }
+
     /*
      * Iterate through each of the nodes
      */
@@ -1207,7 +1267,7 @@ static void launch_daemons(int fd, short args, void *cbdata)
 
         /* if we are tree launching, only launch our own children */
         if (!prte_mca_plm_ssh_component.no_tree_spawn) {
-            PMIX_LIST_FOREACH(child, &prte_rml_base.children, prte_routed_tree_t)
+            PMIX_LIST_FOREACH(child, children, prte_routed_tree_t)
             {
                 if (child->rank == node->daemon->name.rank) {
                     goto launch;
@@ -1286,8 +1346,29 @@ static void launch_daemons(int fd, short args, void *cbdata)
         }
         caddy->daemon = node->daemon;
         PMIX_RETAIN(caddy->daemon);
-        pmix_list_append(&launch_list, &caddy->super);
+        pmix_list_append(&pending, &caddy->super);
     }
+    /* a launch tree starts its children in its own order, largest
+     * subtree first, rather than in the order of the map */
+    if (0 < prte_mca_plm_ssh_component.launch_radix
+        && !prte_mca_plm_ssh_component.no_tree_spawn) {
+        PMIX_LIST_FOREACH(child, children, prte_routed_tree_t)
+        {
+            PMIX_LIST_FOREACH(caddy, &pending, prte_plm_ssh_caddy_t)
+            {
+                if (caddy->daemon->name.rank == child->rank) {
+                    pmix_list_remove_item(&pending, &caddy->super);
+                    pmix_list_append(&launch_list, &caddy->super);
+                    break;
+                }
+            }
+        }
+    }
+    while (NULL != (item = pmix_list_remove_first(&pending))) {
+        pmix_list_append(&launch_list, item);
+    }
+    PMIX_DESTRUCT(&pending);
+    PMIX_LIST_DESTRUCT(&launch_children);
     /* we NEVER use tree-spawn for secondary launches - e.g.,
      * due to a dynamic launch requesting add_hosts - so be
      * sure to turn it off here */
@@ -1315,6 +1396,43 @@ cleanup:
     PMIX_RELEASE(state);
 }
 
+/* compute our children in a k-nomial launch tree over the given
+ * number of daemons. A daemon's children lie at successive powers
+ * of the radix above its own rank, so every daemon can start
+ * launching as soon as it is up. A child's subtree grows with its
+ * distance from us, so each one is put at the front of the list to
+ * start the largest subtree - and so the longest chain - earliest */
+static void launch_tree_children(pmix_rank_t rank, pmix_rank_t ndmns, pmix_list_t *children)
+{
+    prte_routed_tree_t *child;
+    uint64_t stride, c;
+    int m, radix = prte_mca_plm_ssh_component.launch_radix;
+
+    stride = 1;
+    while (stride <= rank) {
+        stride *= radix;
+    }
+    for (; stride < ndmns; stride *= radix) {
+        for (m = 1; m < radix; m++) {
+            c = rank + m * stride;
+            if (ndmns <= c) {
+                break;
+            }
+            child = PMIX_NEW(prte_routed_tree_t);
+            child->rank = (pmix_rank_t) c;
+            pmix_list_prepend(children, &child->super);
+        }
+    }
+}
+
+static double timeline_now(void)
+{
+    struct timeval tv;
+
+    gettimeofday(&tv, NULL);
+    return (double) tv.tv_sec + (double) tv.tv_usec / 1000000.0;
+}
+
 /**
  * Terminate the orteds for a given job
  */
@@ -1419,6 +1537,44 @@ static prte_plm_ssh_shell_t find_shell(char *shell)
     return PRTE_PLM_SSH_SHELL_UNKNOWN;
 }
 
+/* have ssh multiplex all sessions to a node over a single master
+ * connection that outlives us, so only the first launch to each
+ * node pays for connection setup and authentication */
+static void persistent_agent_setup(void)
+{
+    char *dir, *tmp;
+
+    if (NULL != prte_mca_plm_ssh_component.control_dir) {
+        dir = strdup(prte_mca_plm_ssh_component.control_dir);
+    } else {
+        pmix_asprintf(&dir, "%s/prte-ssh-%lu", pmix_tmp_directory(), (unsigned long) geteuid());
+    }
+    if (PMIX_SUCCESS != pmix_os_dirpath_create(dir, S_IRWXU)) {
+        pmix_output_verbose(1, prte_plm_base_framework.framework_output,
+                            "%s plm:ssh: cannot create control dir %s - not persisting connections",
+                            PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), dir);
+        free(dir);
+        return;
+    }
+
+    PMIX_ARGV_APPEND_NOSIZE_COMPAT(&ssh_agent_argv, "-o");
+    PMIX_ARGV_APPEND_NOSIZE_COMPAT(&ssh_agent_argv, "ControlMaster=auto");
+    pmix_asprintf(&tmp, "ControlPath=%s/%%C", dir);
+    PMIX_ARGV_APPEND_NOSIZE_COMPAT(&ssh_agent_argv, "-o");
+    PMIX_ARGV_APPEND_NOSIZE_COMPAT(&ssh_agent_argv, tmp);
+    free(tmp);
+    pmix_asprintf(&tmp, "ControlPersist=%d", prte_mca_plm_ssh_component.persist);
+    PMIX_ARGV_APPEND_NOSIZE_COMPAT(&ssh_agent_argv, "-o");
+    PMIX_ARGV_APPEND_NOSIZE_COMPAT(&ssh_agent_argv, tmp);
+    free(tmp);
+
+    pmix_output_verbose(1, prte_plm_base_framework.framework_output,
+                        "%s plm:ssh: persisting agent connections in %s for %d sec",
+                        PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), dir,
+                        prte_mca_plm_ssh_component.persist);
+    free(dir);
+}
+
 static int launch_agent_setup(const char *agent, char *path)
 {
     char *bname;
@@ -1469,6 +1625,9 @@ static int launch_agent_setup(const char *agent, char *path)
                 PMIX_ARGV_APPEND_NOSIZE_COMPAT(&ssh_agent_argv, "-x");
             }
         }
+        if (0 < prte_mca_plm_ssh_component.persist) {
+            persistent_agent_setup();
+        }
     }
     if (NULL != bname) {
         free(bname);
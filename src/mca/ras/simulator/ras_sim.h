@@ -29,12 +29,18 @@ struct prte_ras_sim_component_t {
     char *topologies;
     bool have_cpubind;
     bool have_membind;
+    bool control_plane;
+    int hop_latency;
+    int bandwidth;
+    int rollup_bytes;
 };
 typedef struct prte_ras_sim_component_t prte_ras_sim_component_t;
 
 PRTE_EXPORT extern prte_ras_sim_component_t prte_mca_ras_simulator_component;
 PRTE_EXPORT extern prte_ras_base_module_t prte_ras_sim_module;
 
+PRTE_EXPORT extern void prte_ras_sim_replay(prte_job_t *jdata);
+
 END_C_DECLS
 
 #endif
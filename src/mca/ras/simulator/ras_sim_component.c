@@ -79,6 +79,49 @@ static int ras_sim_register(void)
                                                 PMIX_MCA_BASE_VAR_TYPE_STRING,
                                                 &prte_mca_ras_simulator_component.num_nodes);
 
+    prte_mca_ras_simulator_component.topologies = NULL;
+    (void) pmix_mca_base_component_var_register(component, "topologies",
+                                                "Comma-separated list of hwloc synthetic topology descriptions "
+                                                "(e.g., \"pack:2 core:16 pu:2\"), one for each group of nodes "
+                                                "(default: use our own topology)",
+                                                PMIX_MCA_BASE_VAR_TYPE_STRING,
+                                                &prte_mca_ras_simulator_component.topologies);
+
+    prte_mca_ras_simulator_component.topofiles = NULL;
+    (void) pmix_mca_base_component_var_register(component, "topofiles",
+                                                "Comma-separated list of hwloc XML topology files, one for each "
+                                                "group of nodes - overridden by any synthetic topology given "
+                                                "for the same group",
+                                                PMIX_MCA_BASE_VAR_TYPE_STRING,
+                                                &prte_mca_ras_simulator_component.topofiles);
+
+    prte_mca_ras_simulator_component.control_plane = false;
+    (void) pmix_mca_base_component_var_register(component, "control_plane",
+                                                "Estimate the xcast and rollup times of each job from an analytic "
+                                                "model: the launch message is walked over the routing tree of the "
+                                                "simulated daemons using the hop_latency, bandwidth and rollup_bytes "
+                                                "parameters. No grpcomm or rml code is run",
+                                                PMIX_MCA_BASE_VAR_TYPE_BOOL,
+                                                &prte_mca_ras_simulator_component.control_plane);
+
+    prte_mca_ras_simulator_component.hop_latency = 20;
+    (void) pmix_mca_base_component_var_register(component, "hop_latency",
+                                                "Simulated latency (in microseconds) of one message between daemons",
+                                                PMIX_MCA_BASE_VAR_TYPE_INT,
+                                                &prte_mca_ras_simulator_component.hop_latency);
+
+    prte_mca_ras_simulator_component.bandwidth = 1000;
+    (void) pmix_mca_base_component_var_register(component, "bandwidth",
+                                                "Simulated bandwidth (in MB/sec) between daemons",
+                                                PMIX_MCA_BASE_VAR_TYPE_INT,
+                                                &prte_mca_ras_simulator_component.bandwidth);
+
+    prte_mca_ras_simulator_component.rollup_bytes = 64;
+    (void) pmix_mca_base_component_var_register(component, "rollup_bytes",
+                                                "Number of bytes each simulated daemon contributes to a rollup",
+                                                PMIX_MCA_BASE_VAR_TYPE_INT,
+                                                &prte_mca_ras_simulator_component.rollup_bytes);
+
     prte_mca_ras_simulator_component.have_cpubind = true;
     (void) pmix_mca_base_component_var_register(component, "have_cpubind",
                                                 "Topology supports binding to cpus",
@@ -25,6 +25,8 @@
 #include "src/util/pmix_argv.h"
 
 #include "src/mca/errmgr/errmgr.h"
+#include "src/mca/plm/base/base.h"
+#include "src/mca/state/state.h"
 #include "src/runtime/prte_globals.h"
 #include "src/util/pmix_show_help.h"
 
@@ -33,6 +35,7 @@
 /*
  * Local functions
  */
+static int init(void);
 static int allocate(prte_job_t *jdata, pmix_list_t *nodes);
 static int finalize(void);
 
@@ -40,16 +43,94 @@ static int finalize(void);
  * Global variable
  */
 prte_ras_base_module_t prte_ras_sim_module = {
-    .init = NULL,
+    .init = init,
     .allocate = allocate,
     .deallocate = NULL,
     .modify = NULL,
     .finalize = finalize
 };
 
+static void send_launch_msg(int fd, short args, void *cbdata)
+{
+    prte_state_caddy_t *caddy = (prte_state_caddy_t *) cbdata;
+
+    /* the launch message is complete at this point, so run it
+     * through the control plane model before the job is declared done */
+    prte_ras_sim_replay(caddy->jdata);
+    prte_plm_base_send_launch_msg(fd, args, cbdata);
+}
+
+static int init(void)
+{
+    int rc;
+
+    if (prte_mca_ras_simulator_component.control_plane) {
+        rc = prte_state.set_job_state_callback(PRTE_JOB_STATE_SEND_LAUNCH_MSG, send_launch_msg);
+        if (PRTE_SUCCESS != rc) {
+            PRTE_ERROR_LOG(rc);
+            return rc;
+        }
+    }
+    return PRTE_SUCCESS;
+}
+
+/* get the topology for a group of nodes - either one we already
+ * know, or one built from the given synthetic description or
+ * XML file */
+static prte_topology_t *get_topology(const char *synthetic, const char *xmlfile)
+{
+    prte_topology_t *t;
+    hwloc_topology_t topo;
+    char *sig;
+    int i;
+
+    if (NULL == synthetic && NULL == xmlfile) {
+        /* use our topology */
+        return (prte_topology_t *) pmix_pointer_array_get_item(prte_node_topologies, 0);
+    }
+
+    if (0 != hwloc_topology_init(&topo)) {
+        return NULL;
+    }
+    if (NULL != synthetic) {
+        if (0 != hwloc_topology_set_synthetic(topo, synthetic)) {
+            pmix_show_help("help-ras-sim.txt", "bad-topology", true, synthetic);
+            hwloc_topology_destroy(topo);
+            return NULL;
+        }
+    } else if (0 != hwloc_topology_set_xml(topo, xmlfile)) {
+        pmix_show_help("help-ras-sim.txt", "bad-topology", true, xmlfile);
+        hwloc_topology_destroy(topo);
+        return NULL;
+    }
+    if (0 != prte_hwloc_base_topology_set_flags(topo, HWLOC_TOPOLOGY_FLAG_IS_THISSYSTEM, true) ||
+        0 != hwloc_topology_load(topo)) {
+        hwloc_topology_destroy(topo);
+        return NULL;
+    }
+
+    /* nodes with the same topology share one object */
+    sig = prte_hwloc_base_get_topo_signature(topo);
+    for (i = 0; i < prte_node_topologies->size; i++) {
+        t = (prte_topology_t *) pmix_pointer_array_get_item(prte_node_topologies, i);
+        if (NULL != t && NULL != t->sig && 0 == strcmp(sig, t->sig)) {
+            hwloc_topology_destroy(topo);
+            free(sig);
+            return t;
+        }
+    }
+    t = PMIX_NEW(prte_topology_t);
+    t->sig = sig;
+    t->topo = topo;
+    t->index = pmix_pointer_array_add(prte_node_topologies, t);
+    prte_hwloc_base_setup_summary(t->topo);
+    return t;
+}
+
 static int allocate(prte_job_t *jdata, pmix_list_t *nodes)
 {
     int i, n, val, dig, num_nodes, nslots;
+    int rc = PRTE_SUCCESS;
     prte_node_t *node;
     prte_topology_t *t;
     hwloc_topology_t topo;
@@ -57,7 +138,10 @@ static int allocate(prte_job_t *jdata, pmix_list_t *nodes)
     char **node_cnt = NULL;
     char **slot_cnt = NULL;
     char **max_slot_cnt = NULL;
+    char **topo_desc = NULL;
+    char **topo_files = NULL;
     char *tmp, *job_cpuset = NULL;
+    char *tdesc, *tfile;
     char prefix[6];
     bool use_hwthread_cpus = false;
     hwloc_cpuset_t available;
@@ -108,22 +192,40 @@ static int allocate(prte_job_t *jdata, pmix_list_t *nodes)
         use_hwthread_cpus = false;
     }
 
-    /* use our topology */
-    t = (prte_topology_t *) pmix_pointer_array_get_item(prte_node_topologies, 0);
-    if (NULL == t) {
-        return PRTE_ERR_NOT_FOUND;
+    if (NULL != prte_mca_ras_simulator_component.topologies) {
+        topo_desc = PMIX_ARGV_SPLIT_COMPAT(prte_mca_ras_simulator_component.topologies, ',');
     }
-    topo = t->topo;
-    if (NULL != job_cpuset) {
-        available = prte_hwloc_base_generate_cpuset(topo, use_hwthread_cpus, &job_cpuset);
-    } else {
-        available = prte_hwloc_base_filter_cpus(topo);
+    if (NULL != prte_mca_ras_simulator_component.topofiles) {
+        topo_files = PMIX_ARGV_SPLIT_COMPAT(prte_mca_ras_simulator_component.topofiles, ',');
     }
 
     /* process the request */
     for (n = 0; NULL != node_cnt[n]; n++) {
         num_nodes = strtol(node_cnt[n], NULL, 10);
 
+        /* each group of nodes can have its own topology - any
+         * group beyond the given ones uses our own */
+        tdesc = NULL;
+        tfile = NULL;
+        if (NULL != topo_desc && n < PMIX_ARGV_COUNT_COMPAT(topo_desc) &&
+            0 < strlen(topo_desc[n])) {
+            tdesc = topo_desc[n];
+        } else if (NULL != topo_files && n < PMIX_ARGV_COUNT_COMPAT(topo_files) &&
+                   0 < strlen(topo_files[n])) {
+            tfile = topo_files[n];
+        }
+        t = get_topology(tdesc, tfile);
+        if (NULL == t) {
+            rc = PRTE_ERR_NOT_FOUND;
+            goto cleanup;
+        }
+        topo = t->topo;
+        if (NULL != job_cpuset) {
+            available = prte_hwloc_base_generate_cpuset(topo, use_hwthread_cpus, &job_cpuset);
+        } else {
+            available = prte_hwloc_base_filter_cpus(topo);
+        }
+
         /* get number of digits */
         val = num_nodes;
         for (dig = 0; 0 != val; dig++) {
@@ -158,8 +260,8 @@ static int allocate(prte_job_t *jdata, pmix_list_t *nodes)
             node->available = hwloc_bitmap_dup(available);
             pmix_list_append(nodes, &node->super);
         }
+        hwloc_bitmap_free(available);
     }
-    hwloc_bitmap_free(available);
 
     /* record the number of allocated nodes */
     prte_num_allocated_nodes = pmix_list_get_size(nodes);
@@ -168,6 +270,13 @@ static int allocate(prte_job_t *jdata, pmix_list_t *nodes)
     prte_set_attribute(&jdata->attributes, PRTE_JOB_DO_NOT_LAUNCH, PRTE_ATTR_GLOBAL,
                        NULL, PMIX_BOOL);
 
+cleanup:
+    if (NULL != topo_desc) {
+        PMIX_ARGV_FREE_COMPAT(topo_desc);
+    }
+    if (NULL != topo_files) {
+        PMIX_ARGV_FREE_COMPAT(topo_files);
+    }
     if (NULL != max_slot_cnt) {
         PMIX_ARGV_FREE_COMPAT(max_slot_cnt);
     }
@@ -178,7 +287,7 @@ static int allocate(prte_job_t *jdata, pmix_list_t *nodes)
     if (NULL != job_cpuset) {
         free(job_cpuset);
     }
-    return PRTE_SUCCESS;
+    return rc;
 }
 
 /*
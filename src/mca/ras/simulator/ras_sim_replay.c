@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2025      Nanook Consulting  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ * Analytic model of the control plane of a simulated job.
+ *
+ * This is NOT a run of the control plane: the simulated daemons are
+ * never started, and no grpcomm or rml code is executed. Instead the
+ * launch message of each job is walked over the routing tree that
+ * those daemons would have formed (computed by the same code as the
+ * real routing tree), with each relay timing the per-child payload
+ * copy that grpcomm makes. Every other cost - hop latency, bandwidth
+ * and the size of each daemon's rollup contribution - comes from the
+ * hop_latency, bandwidth and rollup_bytes parameters. The responses
+ * are then rolled back up the same tree twice - once as a fixed-size
+ * state report and once as an allgather whose payload grows with the
+ * subtree - giving the modelled completion time of each at the HNP.
+ *
+ * The model therefore shows how message sizes, tree shape and fanout
+ * scale with the DVM, but a regression in the xcast relay or rollup
+ * code itself will not show up in it.
+ */
+
+#include "prte_config.h"
+#include "constants.h"
+
+#include <string.h>
+#include <sys/time.h>
+
+#include "src/mca/rmaps/rmaps_types.h"
+#include "src/pmix/pmix-internal.h"
+#include "src/rml/rml.h"
+#include "src/runtime/prte_globals.h"
+#include "src/util/name_fns.h"
+#include "src/util/pmix_output.h"
+
+#include "ras_sim.h"
+
+static double now_usec(void)
+{
+    struct timeval tv;
+
+    gettimeofday(&tv, NULL);
+    return (double) tv.tv_sec * 1000000.0 + (double) tv.tv_usec;
+}
+
+void prte_ras_sim_replay(prte_job_t *jdata)
+{
+    pmix_rank_t ndmns, v, *kids = NULL;
+    pmix_data_buffer_t *copy;
+    double *t_recv = NULL, *t_state = NULL, *t_gather = NULL;
+    double latency, bw, tsend, start, relay = 0.0, xcast = 0.0, xfer;
+    uint64_t *gbytes = NULL, moved = 0;
+    int *depth = NULL, maxdepth = 0, maxfan = 0, nk, i;
+    size_t bytes;
+    pmix_status_t rc;
+
+    if (NULL == jdata->map || 0 == jdata->map->num_nodes) {
+        return;
+    }
+
+    /* the HNP plus one daemon for each node in the map */
+    ndmns = jdata->map->num_nodes + 1;
+    bytes = jdata->launch_msg.bytes_used;
+    latency = prte_mca_ras_simulator_component.hop_latency;
+    /* MB/sec is the same as bytes/usec */
+    bw = prte_mca_ras_simulator_component.bandwidth;
+    if (0.0 >= bw) {
+        bw = 1.0;
+    }
+
+    kids = (pmix_rank_t *) malloc(prte_rml_base.radix * sizeof(pmix_rank_t));
+    t_recv = (double *) calloc(ndmns, sizeof(double));
+    t_state = (double *) calloc(ndmns, sizeof(double));
+    t_gather = (double *) calloc(ndmns, sizeof(double));
+    gbytes = (uint64_t *) calloc(ndmns, sizeof(uint64_t));
+    depth = (int *) calloc(ndmns, sizeof(int));
+
+    /* xcast - children always have a higher rank than their
+     * parent, so walking the ranks in order visits every daemon
+     * after the one that relays to it */
+    for (v = 0; v < ndmns; v++) {
+        nk = prte_rml_get_tree_children(v, ndmns, kids);
+        if (nk > maxfan) {
+            maxfan = nk;
+        }
+        tsend = 0.0;
+        for (i = 0; i < nk; i++) {
+            /* the relay copies the message once for each child */
+            start = now_usec();
+            PMIX_DATA_BUFFER_CREATE(copy);
+            rc = PMIx_Data_copy_payload(copy, &jdata->launch_msg);
+            PMIX_DATA_BUFFER_RELEASE(copy);
+            if (PMIX_SUCCESS != rc) {
+                PMIX_ERROR_LOG(rc);
+                goto done;
+            }
+            xfer = now_usec() - start;
+            relay += xfer;
+            /* the sends to each child go out one after the other */
+            tsend += xfer + (double) bytes / bw;
+            t_recv[kids[i]] = t_recv[v] + tsend + latency;
+            depth[kids[i]] = depth[v] + 1;
+            if (depth[kids[i]] > maxdepth) {
+                maxdepth = depth[kids[i]];
+            }
+            moved += bytes;
+        }
+        if (t_recv[v] > xcast) {
+            xcast = t_recv[v];
+        }
+    }
+
+    /* rollups - a daemon reports once it has the launch message
+     * and has heard from all of its children */
+    for (v = ndmns; 0 < v--;) {
+        t_state[v] = t_recv[v];
+        t_gather[v] = t_recv[v];
+        gbytes[v] = prte_mca_ras_simulator_component.rollup_bytes;
+        nk = prte_rml_get_tree_children(v, ndmns, kids);
+        for (i = 0; i < nk; i++) {
+            xfer = t_state[kids[i]] + latency
+                   + (double) prte_mca_ras_simulator_component.rollup_bytes / bw;
+            if (xfer > t_state[v]) {
+                t_state[v] = xfer;
+            }
+            xfer = t_gather[kids[i]] + latency + (double) gbytes[kids[i]] / bw;
+            if (xfer > t_gather[v]) {
+                t_gather[v] = xfer;
+            }
+            gbytes[v] += gbytes[kids[i]];
+        }
+    }
+
+    pmix_output(0, "%s ras:simulator modelled job %s over %u daemons "
+                "(radix %d, depth %d, max fanout %d)\n"
+                "\tlaunch msg: %lu bytes, %lu bytes moved, %.3f msec spent copying payloads\n"
+                "\tmodelled xcast complete: %.3f msec\n"
+                "\tmodelled state rollup complete: %.3f msec\n"
+                "\tmodelled allgather of %d bytes/daemon complete: %.3f msec (%lu bytes at the HNP)",
+                PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_JOBID_PRINT(jdata->nspace),
+                (unsigned) ndmns, prte_rml_base.radix, maxdepth, maxfan,
+                (unsigned long) bytes, (unsigned long) moved, relay / 1000.0,
+                xcast / 1000.0, t_state[0] / 1000.0,
+                prte_mca_ras_simulator_component.rollup_bytes, t_gather[0] / 1000.0,
+                (unsigned long) gbytes[0]);
+
+done:
+    free(kids);
+    free(t_recv);
+    free(t_state);
+    free(t_gather);
+    free(gbytes);
+    free(depth);
+}
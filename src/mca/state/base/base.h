@@ -47,6 +47,7 @@ typedef struct {
     bool show_launch_progress;
     bool notifyerrors;
     bool autorestart;
+    bool timeline;
 } prte_state_base_t;
 PRTE_EXPORT extern prte_state_base_t prte_state_base;
 
@@ -97,6 +98,39 @@ PRTE_EXPORT void prte_state_base_check_all_complete(int fd, short args, void *cb
 PRTE_EXPORT void prte_state_base_check_fds(prte_job_t *jdata);
 PRTE_EXPORT void prte_state_base_notify_data_server(pmix_proc_t *target);
 
+/* launch timeline milestones - the first set is recorded
+ * only by the HNP, the second by every daemon */
+typedef enum {
+    PRTE_TIMELINE_INIT,           // jobid assigned
+    PRTE_TIMELINE_ALLOCATED,      // allocation complete
+    PRTE_TIMELINE_MAPPED,         // map complete
+    PRTE_TIMELINE_LAUNCH_SENT,    // launch msg sent to the daemons
+    PRTE_TIMELINE_RUNNING,        // all procs running
+    PRTE_TIMELINE_TERMINATED,     // all procs terminated
+    PRTE_TIMELINE_LAUNCH_RECVD,   // launch msg unpacked
+    PRTE_TIMELINE_CHILDREN,       // local child list built
+    PRTE_TIMELINE_REGISTERED,     // nspace registered with the local PMIx server
+    PRTE_TIMELINE_FIRST_FORK,
+    PRTE_TIMELINE_LAST_FORK,
+    PRTE_TIMELINE_FIRST_FENCE,    // first fence upcall from local procs
+    PRTE_TIMELINE_MAX
+} prte_timeline_milestone_t;
+
+#define PRTE_TIMELINE_MARK(n, m)                        \
+    do {                                                \
+        if (prte_state_base.timeline) {                 \
+            prte_state_base_timeline_mark((n), (m));    \
+        }                                               \
+    } while (0)
+
+PRTE_EXPORT void prte_state_base_timeline_mark(const pmix_nspace_t nspace,
+                                               prte_timeline_milestone_t m);
+PRTE_EXPORT void prte_state_base_timeline_job_state(prte_job_t *jdata, prte_job_state_t state);
+PRTE_EXPORT void prte_state_base_timeline_setup(prte_job_t *jdata);
+PRTE_EXPORT void prte_state_base_timeline_local_done(const pmix_nspace_t nspace);
+PRTE_EXPORT void prte_state_base_timeline_cleanup(const pmix_nspace_t nspace);
+PRTE_EXPORT void prte_state_base_timeline_finalize(void);
+
 END_C_DECLS
 
 #endif
@@ -54,6 +54,10 @@ void prte_state_base_activate_job_state(prte_job_t *jdata, prte_job_state_t stat
     prte_state_t *s;
     prte_state_caddy_t *caddy;
 
+    if (prte_state_base.timeline && NULL != jdata) {
+        prte_state_base_timeline_job_state(jdata, state);
+    }
+
     for (itm = pmix_list_get_first(&prte_job_states); itm != pmix_list_get_end(&prte_job_states);
          itm = pmix_list_get_next(itm)) {
         s = (prte_state_t *) itm;
@@ -47,7 +47,8 @@ prte_state_base_t prte_state_base = {
     .run_fdcheck = false,
     .recoverable = false,
     .max_restarts = 0,
-    .continuous = false
+    .continuous = false,
+    .timeline = false
 };
 prte_state_base_module_t prte_state = {0};
 
@@ -103,6 +104,13 @@ static int prte_state_base_register(pmix_mca_base_register_flag_t flags)
                                PMIX_MCA_BASE_VAR_TYPE_BOOL,
                                &prte_state_base.autorestart);
 
+    prte_state_base.timeline = false;
+    pmix_mca_base_var_register("prte", "state", "base", "timeline",
+                               "Timestamp the launch milestones of each job on every daemon and "
+                               "have the DVM controller print a per-phase breakdown",
+                               PMIX_MCA_BASE_VAR_TYPE_BOOL,
+                               &prte_state_base.timeline);
+
     return PRTE_SUCCESS;
 }
 
@@ -112,6 +120,9 @@ static int prte_state_base_close(void)
     if (NULL != prte_state.finalize) {
         prte_state.finalize();
     }
+    if (prte_state_base.timeline) {
+        prte_state_base_timeline_finalize();
+    }
 
     return pmix_mca_base_framework_components_close(&prte_state_base_framework, NULL);
 }
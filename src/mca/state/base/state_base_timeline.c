@@ -0,0 +1,487 @@
+/*
+ * Copyright (c) 2025      Nanook Consulting  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+/** @file **/
+
+#include "prte_config.h"
+#include "constants.h"
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef HAVE_SYS_TIME_H
+#    include <sys/time.h>
+#endif
+
+#include "src/class/pmix_list.h"
+#include "src/pmix/pmix-internal.h"
+#include "src/util/pmix_output.h"
+#include "src/util/pmix_printf.h"
+
+#include "src/mca/errmgr/errmgr.h"
+#include "src/mca/rmaps/rmaps_types.h"
+#include "src/rml/rml.h"
+#include "src/runtime/prte_globals.h"
+#include "src/util/name_fns.h"
+#include "src/util/proc_info.h"
+
+#include "src/mca/state/base/base.h"
+
+/* Launch timeline - every daemon timestamps the milestones of
+ * each job it hears about. Once a daemon is done with a job (and
+ * has heard from every routing child whose subtree hosts procs of
+ * that job), it forwards its record plus those of its subtree to
+ * its routing parent. The HNP prints the breakdown once the records
+ * of all participating daemons have arrived.
+ *
+ * Daemon phases are only ever computed from the stamps of a single
+ * daemon, so clock skew between nodes does not matter.
+ *
+ * A tracker stays on the list once its record has gone out so that
+ * anything arriving for the job after that is dropped rather than
+ * starting a new tracker that would never complete. The trackers of
+ * a job are released when the DVM cleans up the job, after which
+ * records for it are dropped as well */
+
+typedef struct {
+    pmix_list_item_t super;
+    pmix_nspace_t nspace;
+    double stamps[PRTE_TIMELINE_MAX];
+    bool setup;         // number of contributions to expect is known
+    bool participant;   // we host procs of this job
+    bool local_done;
+    bool done;          // our record has been reported or forwarded
+    int nexpected;
+    int nreported;
+    int32_t nrecords;
+    pmix_data_buffer_t bucket;  // records from our subtree
+} prte_timeline_tracker_t;
+static void tcon(prte_timeline_tracker_t *p)
+{
+    memset(p->stamps, 0, sizeof(p->stamps));
+    p->setup = false;
+    p->participant = false;
+    p->local_done = false;
+    p->done = false;
+    p->nexpected = 0;
+    p->nreported = 0;
+    p->nrecords = 0;
+    PMIX_DATA_BUFFER_CONSTRUCT(&p->bucket);
+}
+static void tdes(prte_timeline_tracker_t *p)
+{
+    PMIX_DATA_BUFFER_DESTRUCT(&p->bucket);
+}
+static PMIX_CLASS_INSTANCE(prte_timeline_tracker_t,
+                           pmix_list_item_t,
+                           tcon, tdes);
+
+typedef struct {
+    const char *name;
+    prte_timeline_milestone_t from;
+    prte_timeline_milestone_t to;
+} prte_timeline_phase_t;
+
+static prte_timeline_phase_t hnp_phases[] = {
+    {"allocate", PRTE_TIMELINE_INIT, PRTE_TIMELINE_ALLOCATED},
+    {"map", PRTE_TIMELINE_ALLOCATED, PRTE_TIMELINE_MAPPED},
+    {"launch", PRTE_TIMELINE_MAPPED, PRTE_TIMELINE_LAUNCH_SENT},
+    {"startup", PRTE_TIMELINE_LAUNCH_SENT, PRTE_TIMELINE_RUNNING},
+    {"execute", PRTE_TIMELINE_RUNNING, PRTE_TIMELINE_TERMINATED},
+    {NULL, 0, 0}
+};
+
+static prte_timeline_phase_t daemon_phases[] = {
+    {"child list", PRTE_TIMELINE_LAUNCH_RECVD, PRTE_TIMELINE_CHILDREN},
+    {"register", PRTE_TIMELINE_CHILDREN, PRTE_TIMELINE_REGISTERED},
+    {"first fork", PRTE_TIMELINE_REGISTERED, PRTE_TIMELINE_FIRST_FORK},
+    {"fork all", PRTE_TIMELINE_FIRST_FORK, PRTE_TIMELINE_LAST_FORK},
+    {"first fence", PRTE_TIMELINE_LAST_FORK, PRTE_TIMELINE_FIRST_FENCE},
+    {"local total", PRTE_TIMELINE_LAUNCH_RECVD, PRTE_TIMELINE_LAST_FORK},
+    {NULL, 0, 0}
+};
+
+static pmix_list_t trackers = PMIX_LIST_STATIC_INIT;
+static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+static bool recv_posted = false;
+
+static void timeline_recv(int status, pmix_proc_t *sender,
+                          pmix_data_buffer_t *buffer,
+                          prte_rml_tag_t tag, void *cbdata);
+
+static prte_timeline_tracker_t *get_tracker(const pmix_nspace_t nspace, bool create)
+{
+    prte_timeline_tracker_t *trk;
+
+    PMIX_LIST_FOREACH(trk, &trackers, prte_timeline_tracker_t) {
+        if (PMIX_CHECK_NSPACE(trk->nspace, nspace)) {
+            return trk;
+        }
+    }
+    if (!create) {
+        return NULL;
+    }
+    trk = PMIX_NEW(prte_timeline_tracker_t);
+    PMIX_LOAD_NSPACE(trk->nspace, nspace);
+    pmix_list_append(&trackers, &trk->super);
+    return trk;
+}
+
+static int cmpdbl(const void *a, const void *b)
+{
+    double x = *(const double *) a;
+    double y = *(const double *) b;
+
+    return (x < y) ? -1 : ((x > y) ? 1 : 0);
+}
+
+static void report(prte_timeline_tracker_t *trk)
+{
+    double *stamps = NULL, *vals = NULL;
+    pmix_rank_t rank;
+    int32_t n, cnt, nrec;
+    int m, k, nvals;
+    pmix_status_t rc;
+
+    pmix_output(0, "%s timeline for job %s: %d daemon records%s",
+                PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_JOBID_PRINT(trk->nspace),
+                (int) trk->nrecords,
+                (trk->nreported < trk->nexpected) ? " (incomplete)" : "");
+    for (m = 0; NULL != hnp_phases[m].name; m++) {
+        if (0.0 == trk->stamps[hnp_phases[m].from] || 0.0 == trk->stamps[hnp_phases[m].to]) {
+            continue;
+        }
+        pmix_output(0, "    %-12s %10.6f sec", hnp_phases[m].name,
+                    trk->stamps[hnp_phases[m].to] - trk->stamps[hnp_phases[m].from]);
+    }
+    if (0 == trk->nrecords) {
+        return;
+    }
+
+    /* unpack the daemon records */
+    stamps = (double *) malloc(trk->nrecords * PRTE_TIMELINE_MAX * sizeof(double));
+    vals = (double *) malloc(trk->nrecords * sizeof(double));
+    if (NULL == stamps || NULL == vals) {
+        PRTE_ERROR_LOG(PRTE_ERR_OUT_OF_RESOURCE);
+        goto done;
+    }
+    for (nrec = 0; nrec < trk->nrecords; nrec++) {
+        cnt = 1;
+        rc = PMIx_Data_unpack(NULL, &trk->bucket, &rank, &cnt, PMIX_PROC_RANK);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            break;
+        }
+        cnt = PRTE_TIMELINE_MAX;
+        rc = PMIx_Data_unpack(NULL, &trk->bucket, &stamps[nrec * PRTE_TIMELINE_MAX],
+                              &cnt, PMIX_DOUBLE);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            break;
+        }
+    }
+
+    pmix_output(0, "    %-12s %10s %10s %10s  (sec across daemons)", "", "min", "median", "max");
+    for (m = 0; NULL != daemon_phases[m].name; m++) {
+        nvals = 0;
+        for (n = 0; n < nrec; n++) {
+            k = n * PRTE_TIMELINE_MAX;
+            if (0.0 == stamps[k + daemon_phases[m].from] || 0.0 == stamps[k + daemon_phases[m].to]) {
+                continue;
+            }
+            vals[nvals++] = stamps[k + daemon_phases[m].to] - stamps[k + daemon_phases[m].from];
+        }
+        if (0 == nvals) {
+            continue;
+        }
+        qsort(vals, nvals, sizeof(double), cmpdbl);
+        pmix_output(0, "    %-12s %10.6f %10.6f %10.6f", daemon_phases[m].name,
+                    vals[0], vals[nvals / 2], vals[nvals - 1]);
+    }
+
+done:
+    if (NULL != stamps) {
+        free(stamps);
+    }
+    if (NULL != vals) {
+        free(vals);
+    }
+}
+
+/* must be called with the lock held */
+static void check_complete(prte_timeline_tracker_t *trk)
+{
+    pmix_data_buffer_t *buf;
+    int rc;
+
+    if (trk->done || !trk->setup || !trk->local_done || trk->nreported < trk->nexpected) {
+        return;
+    }
+    trk->done = true;
+
+    if (trk->participant) {
+        rc = PMIx_Data_pack(NULL, &trk->bucket, &PRTE_PROC_MY_NAME->rank, 1, PMIX_PROC_RANK);
+        if (PMIX_SUCCESS == rc) {
+            rc = PMIx_Data_pack(NULL, &trk->bucket, trk->stamps, PRTE_TIMELINE_MAX, PMIX_DOUBLE);
+        }
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            goto done;
+        }
+        trk->nrecords++;
+    }
+
+    if (PRTE_PROC_IS_MASTER) {
+        report(trk);
+        goto done;
+    }
+    /* if nobody in our subtree hosts this job, then our
+     * parent isn't expecting to hear from us */
+    if (0 == trk->nrecords) {
+        goto done;
+    }
+
+    PMIX_DATA_BUFFER_CREATE(buf);
+    rc = PMIx_Data_pack(NULL, buf, &trk->nspace, 1, PMIX_PROC_NSPACE);
+    if (PMIX_SUCCESS == rc) {
+        rc = PMIx_Data_pack(NULL, buf, &trk->nrecords, 1, PMIX_INT32);
+    }
+    if (PMIX_SUCCESS == rc) {
+        rc = PMIx_Data_copy_payload(buf, &trk->bucket);
+    }
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_DATA_BUFFER_RELEASE(buf);
+        goto done;
+    }
+    PRTE_RML_SEND(rc, PRTE_PROC_MY_PARENT->rank, buf, PRTE_RML_TAG_TIMELINE);
+    if (PRTE_SUCCESS != rc) {
+        PRTE_ERROR_LOG(rc);
+        PMIX_DATA_BUFFER_RELEASE(buf);
+    }
+
+done:
+    /* the records are no longer needed */
+    PMIX_DATA_BUFFER_DESTRUCT(&trk->bucket);
+    PMIX_DATA_BUFFER_CONSTRUCT(&trk->bucket);
+}
+
+void prte_state_base_timeline_mark(const pmix_nspace_t nspace, prte_timeline_milestone_t m)
+{
+    prte_timeline_tracker_t *trk;
+    double now;
+
+    if (PMIX_NSPACE_INVALID(nspace)) {
+        return;
+    }
+    PRTE_STATE_GET_TIMESTAMP(now);
+
+    pthread_mutex_lock(&lock);
+    trk = get_tracker(nspace, true);
+    /* keep the first occurrence of everything but the last fork */
+    if (!trk->done && (0.0 == trk->stamps[m] || PRTE_TIMELINE_LAST_FORK == m)) {
+        trk->stamps[m] = now;
+    }
+    pthread_mutex_unlock(&lock);
+}
+
+void prte_state_base_timeline_job_state(prte_job_t *jdata, prte_job_state_t state)
+{
+    prte_timeline_tracker_t *trk;
+
+    if (!PRTE_PROC_IS_MASTER) {
+        return;
+    }
+
+    switch (state) {
+    case PRTE_JOB_STATE_INIT_COMPLETE:
+        prte_state_base_timeline_mark(jdata->nspace, PRTE_TIMELINE_INIT);
+        break;
+    case PRTE_JOB_STATE_ALLOCATION_COMPLETE:
+        prte_state_base_timeline_mark(jdata->nspace, PRTE_TIMELINE_ALLOCATED);
+        break;
+    case PRTE_JOB_STATE_MAP_COMPLETE:
+        prte_state_base_timeline_mark(jdata->nspace, PRTE_TIMELINE_MAPPED);
+        break;
+    case PRTE_JOB_STATE_RUNNING:
+        prte_state_base_timeline_mark(jdata->nspace, PRTE_TIMELINE_RUNNING);
+        break;
+    case PRTE_JOB_STATE_TERMINATED:
+        pthread_mutex_lock(&lock);
+        trk = get_tracker(jdata->nspace, false);
+        if (NULL != trk && !trk->done) {
+            PRTE_STATE_GET_TIMESTAMP(trk->stamps[PRTE_TIMELINE_TERMINATED]);
+            trk->local_done = true;
+            if (!trk->setup) {
+                /* never launched - nothing to report */
+                pmix_list_remove_item(&trackers, &trk->super);
+                PMIX_RELEASE(trk);
+            } else {
+                check_complete(trk);
+            }
+        }
+        pthread_mutex_unlock(&lock);
+        break;
+    default:
+        break;
+    }
+}
+
+void prte_state_base_timeline_setup(prte_job_t *jdata)
+{
+    prte_timeline_tracker_t *trk;
+    prte_node_t *node;
+    pmix_rank_t *dmns;
+    size_t ndmns = 0;
+    int n;
+
+    if (!recv_posted) {
+        PRTE_RML_RECV(PRTE_NAME_WILDCARD, PRTE_RML_TAG_TIMELINE,
+                      PRTE_RML_PERSISTENT, timeline_recv, NULL);
+        recv_posted = true;
+    }
+
+    /* collect the daemons hosting procs of this job */
+    if (0 < jdata->map->nodes->size) {
+        dmns = (pmix_rank_t *) malloc(jdata->map->nodes->size * sizeof(pmix_rank_t));
+        if (NULL == dmns) {
+            PRTE_ERROR_LOG(PRTE_ERR_OUT_OF_RESOURCE);
+            return;
+        }
+    } else {
+        dmns = NULL;
+    }
+    for (n = 0; n < jdata->map->nodes->size; n++) {
+        node = (prte_node_t *) pmix_pointer_array_get_item(jdata->map->nodes, n);
+        if (NULL == node || NULL == node->daemon) {
+            continue;
+        }
+        dmns[ndmns++] = node->daemon->name.rank;
+    }
+
+    pthread_mutex_lock(&lock);
+    trk = get_tracker(jdata->nspace, true);
+    trk->setup = true;
+    trk->nexpected = prte_rml_get_num_contributors(dmns, ndmns);
+    for (n = 0; n < (int) ndmns; n++) {
+        if (PRTE_PROC_MY_NAME->rank == dmns[n]) {
+            trk->participant = true;
+            break;
+        }
+    }
+    /* the HNP is done when the job terminates - other daemons
+     * are done when their local procs terminate */
+    if (!PRTE_PROC_IS_MASTER && !trk->participant) {
+        trk->local_done = true;
+    }
+    check_complete(trk);
+    pthread_mutex_unlock(&lock);
+    if (NULL != dmns) {
+        free(dmns);
+    }
+}
+
+void prte_state_base_timeline_local_done(const pmix_nspace_t nspace)
+{
+    prte_timeline_tracker_t *trk;
+
+    pthread_mutex_lock(&lock);
+    trk = get_tracker(nspace, false);
+    if (NULL != trk) {
+        trk->local_done = true;
+        check_complete(trk);
+    }
+    pthread_mutex_unlock(&lock);
+}
+
+static void timeline_recv(int status, pmix_proc_t *sender,
+                          pmix_data_buffer_t *buffer,
+                          prte_rml_tag_t tag, void *cbdata)
+{
+    prte_timeline_tracker_t *trk;
+    pmix_nspace_t nspace;
+    int32_t cnt, nrecords;
+    pmix_status_t rc;
+    PRTE_HIDE_UNUSED_PARAMS(status, tag, cbdata);
+
+    cnt = 1;
+    rc = PMIx_Data_unpack(NULL, buffer, &nspace, &cnt, PMIX_PROC_NSPACE);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return;
+    }
+    cnt = 1;
+    rc = PMIx_Data_unpack(NULL, buffer, &nrecords, &cnt, PMIX_INT32);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return;
+    }
+
+    PMIX_OUTPUT_VERBOSE((5, prte_state_base_framework.framework_output,
+                         "%s state:base:timeline recvd %d records for job %s from %s",
+                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), (int) nrecords,
+                         PRTE_JOBID_PRINT(nspace), PRTE_NAME_PRINT(sender)));
+
+    pthread_mutex_lock(&lock);
+    /* the HNP tracks each job from its start, so a record it has no
+     * tracker for is for a job that was already cleaned up */
+    trk = get_tracker(nspace, false);
+    if (NULL == trk && !PRTE_PROC_IS_MASTER && NULL != prte_get_job_data_object(nspace)) {
+        trk = get_tracker(nspace, true);
+    }
+    if (NULL == trk || trk->done) {
+        /* too late to be included */
+        pthread_mutex_unlock(&lock);
+        return;
+    }
+    rc = PMIx_Data_copy_payload(&trk->bucket, buffer);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+    } else {
+        trk->nrecords += nrecords;
+    }
+    trk->nreported++;
+    check_complete(trk);
+    pthread_mutex_unlock(&lock);
+}
+
+void prte_state_base_timeline_cleanup(const pmix_nspace_t nspace)
+{
+    prte_timeline_tracker_t *trk;
+
+    pthread_mutex_lock(&lock);
+    trk = get_tracker(nspace, false);
+    if (NULL != trk) {
+        pmix_list_remove_item(&trackers, &trk->super);
+        /* report whatever we collected if some
+         * records never made it */
+        if (PRTE_PROC_IS_MASTER && trk->setup && !trk->done) {
+            report(trk);
+        }
+        PMIX_RELEASE(trk);
+    }
+    pthread_mutex_unlock(&lock);
+}
+
+void prte_state_base_timeline_finalize(void)
+{
+    prte_timeline_tracker_t *trk;
+
+    pthread_mutex_lock(&lock);
+    while (NULL != (trk = (prte_timeline_tracker_t *) pmix_list_remove_first(&trackers))) {
+        /* report whatever we collected for jobs that
+         * were still in flight */
+        if (PRTE_PROC_IS_MASTER && trk->setup && !trk->done) {
+            report(trk);
+        }
+        PMIX_RELEASE(trk);
+    }
+    pthread_mutex_unlock(&lock);
+    recv_posted = false;
+}
@@ -501,6 +501,10 @@ static void track_procs(int fd, short argc, void *cbdata)
         /* track job status */
         if (jdata->num_terminated == jdata->num_local_procs
             && !prte_get_attribute(&jdata->attributes, PRTE_JOB_TERM_NOTIFIED, NULL, PMIX_BOOL)) {
+            /* pass our launch timeline up the tree ahead of the update */
+            if (prte_state_base.timeline) {
+                prte_state_base_timeline_local_done(jdata->nspace);
+            }
             /* pack update state command */
             cmd = PRTE_PLM_UPDATE_PROC_STATE;
             PMIX_DATA_BUFFER_CREATE(alert);
@@ -410,6 +410,59 @@ void pmix_server_register_params(void)
                                    PMIX_MCA_BASE_VAR_TYPE_BOOL,
                                    &prte_pmix_server_globals.wait_for_server);
 
+    /* number of daemons across which to spread published data */
+    prte_pmix_server_globals.pubsub_shards = 0;
+    prte_pmix_server_globals.pubsub_shards_fixed = false;
+    (void) pmix_mca_base_var_register("prte", "pmix", NULL, "pubsub_shards",
+                                      "Number of daemons (starting with the HNP) across which "
+                                      "published data is distributed by key when no session-level "
+                                      "server is given (0 or 1 => store all data on the HNP). "
+                                      "Limited to the number of daemons the DVM starts with, and "
+                                      "not changed as the DVM grows",
+                                      PMIX_MCA_BASE_VAR_TYPE_INT,
+                                      &prte_pmix_server_globals.pubsub_shards);
+
+    /* how long to collect direct modex requests before sending them */
+    prte_pmix_server_globals.dmdx_batch_delay = 0;
+    (void) pmix_mca_base_var_register("prte", "pmix", NULL, "dmodex_batch_delay",
+                                      "Time (in microseconds) to collect direct modex requests and "
+                                      "responses bound for the same daemon before sending them as "
+                                      "one message (0 => send at the end of the current event loop pass)",
+                                      PMIX_MCA_BASE_VAR_TYPE_INT,
+                                      &prte_pmix_server_globals.dmdx_batch_delay);
+
+    /* how often to sample the resource usage of local procs */
+    prte_pmix_server_globals.rusage_interval = 0;
+    (void) pmix_mca_base_var_register("prte", "pmix", NULL, "rusage_interval",
+                                      "Time (in seconds) between samples of the resource usage "
+                                      "of local procs (0 => only sample when a resource usage "
+                                      "query arrives)",
+                                      PMIX_MCA_BASE_VAR_TYPE_INT,
+                                      &prte_pmix_server_globals.rusage_interval);
+
+    prte_pmix_server_globals.rusage_depth = 16;
+    (void) pmix_mca_base_var_register("prte", "pmix", NULL, "rusage_depth",
+                                      "Number of resource usage samples retained for each local "
+                                      "proc - utilization is computed over this window (min: 2)",
+                                      PMIX_MCA_BASE_VAR_TYPE_INT,
+                                      &prte_pmix_server_globals.rusage_depth);
+
+    prte_pmix_server_globals.rusage_timeout = 10;
+    (void) pmix_mca_base_var_register("prte", "pmix", NULL, "rusage_timeout",
+                                      "Time (in seconds) to wait for the resource usage of the "
+                                      "other daemons before answering a query with local "
+                                      "data only (min: 1)",
+                                      PMIX_MCA_BASE_VAR_TYPE_INT,
+                                      &prte_pmix_server_globals.rusage_timeout);
+
+    /* largest page returned by a paged proc table query */
+    prte_pmix_server_globals.proc_table_page_max = 65536;
+    (void) pmix_mca_base_var_register("prte", "pmix", NULL, "proc_table_page_max",
+                                      "Maximum number of procs returned in one page of a paged "
+                                      "proc table query (0 => no limit)",
+                                      PMIX_MCA_BASE_VAR_TYPE_INT,
+                                      &prte_pmix_server_globals.proc_table_page_max);
+
     /* whether or not to support tool connections */
     prte_pmix_server_globals.tool_support = true;
     (void) pmix_mca_base_var_register("prte", "pmix", NULL, "tool_support",
@@ -492,6 +545,15 @@ void pmix_server_register_params(void)
         PMIX_ARGV_FREE_COMPAT(tmp);
     }
 
+    /* whether or not to defer the locality of remote procs */
+    prte_pmix_server_globals.lazy_registration = false;
+    (void) pmix_mca_base_var_register("prte", "pmix", NULL, "lazy_registration",
+                                      "Only register the cpuset, locality string and device distances "
+                                      "of local procs when registering a job - those of remote procs "
+                                      "are provided when first requested",
+                                      PMIX_MCA_BASE_VAR_TYPE_BOOL,
+                                      &prte_pmix_server_globals.lazy_registration);
+
     prte_pmix_server_globals.system_controller = false;
     (void) pmix_mca_base_var_register("prte", "pmix", NULL, "system_controller",
                                       "Whether or not to act as the system-wide controller",
@@ -668,6 +730,12 @@ int pmix_server_init(void)
     pmix_pointer_array_init(&prte_pmix_server_globals.local_reqs, 128, INT_MAX, 2);
     PMIX_CONSTRUCT(&prte_pmix_server_globals.remote_reqs, pmix_pointer_array_t);
     pmix_pointer_array_init(&prte_pmix_server_globals.remote_reqs, 128, INT_MAX, 2);
+    PMIX_CONSTRUCT(&prte_pmix_server_globals.dmdx_reqs, pmix_hash_table_t);
+    pmix_hash_table_init(&prte_pmix_server_globals.dmdx_reqs, 1024);
+    PMIX_CONSTRUCT(&prte_pmix_server_globals.dmdx_batches, pmix_hash_table_t);
+    pmix_hash_table_init(&prte_pmix_server_globals.dmdx_batches, 64);
+    PMIX_CONSTRUCT(&prte_pmix_server_globals.locality_cache, pmix_hash_table_t);
+    pmix_hash_table_init(&prte_pmix_server_globals.locality_cache, 64);
     PMIX_CONSTRUCT(&prte_pmix_server_globals.notifications, pmix_list_t);
     prte_pmix_server_globals.server = *PRTE_NAME_INVALID;
     prte_pmix_server_globals.scheduler_connected = false;
@@ -1069,6 +1137,15 @@ void pmix_server_start(void)
     PRTE_RML_RECV(PRTE_NAME_WILDCARD, PRTE_RML_TAG_MONITOR_RESP,
                   PRTE_RML_PERSISTENT, pmix_server_monitor_resp, NULL);
 
+    /* setup recvs for resource usage collectives */
+    PRTE_RML_RECV(PRTE_NAME_WILDCARD, PRTE_RML_TAG_RUSAGE_REQUEST,
+                  PRTE_RML_PERSISTENT, pmix_server_rusage_request, NULL);
+    PRTE_RML_RECV(PRTE_NAME_WILDCARD, PRTE_RML_TAG_RUSAGE,
+                  PRTE_RML_PERSISTENT, pmix_server_rusage_rollup, NULL);
+    PRTE_RML_RECV(PRTE_NAME_WILDCARD, PRTE_RML_TAG_RUSAGE_RESP,
+                  PRTE_RML_PERSISTENT, pmix_server_rusage_resp, NULL);
+    pmix_server_rusage_init();
+
     if (PRTE_PROC_IS_MASTER) {
         /* setup recv for logging requests */
         PRTE_RML_RECV(PRTE_NAME_WILDCARD, PRTE_RML_TAG_LOGGING,
@@ -1099,6 +1176,10 @@ void pmix_server_finalize(void)
     PRTE_RML_CANCEL(PRTE_NAME_WILDCARD, PRTE_RML_TAG_SCHED_RESP);
     PRTE_RML_CANCEL(PRTE_NAME_WILDCARD, PRTE_RML_TAG_MONITOR_REQUEST);
     PRTE_RML_CANCEL(PRTE_NAME_WILDCARD, PRTE_RML_TAG_MONITOR_RESP);
+    PRTE_RML_CANCEL(PRTE_NAME_WILDCARD, PRTE_RML_TAG_RUSAGE_REQUEST);
+    PRTE_RML_CANCEL(PRTE_NAME_WILDCARD, PRTE_RML_TAG_RUSAGE);
+    PRTE_RML_CANCEL(PRTE_NAME_WILDCARD, PRTE_RML_TAG_RUSAGE_RESP);
+    pmix_server_rusage_finalize();
     if (PRTE_PROC_IS_MASTER) {
         PRTE_RML_CANCEL(PRTE_NAME_WILDCARD, PRTE_RML_TAG_LOGGING);
         PRTE_RML_CANCEL(PRTE_NAME_WILDCARD, PRTE_RML_TAG_SCHED);
@@ -1107,6 +1188,40 @@ void pmix_server_finalize(void)
     /* finalize our local data server */
     prte_data_server_finalize();
 
+    /* cleanup the direct modex trackers - the requests
+     * themselves are released with the local reqs */
+    prte_pmix_dmdx_tracker_t *trk;
+    prte_pmix_dmdx_batch_t *batch;
+    uint64_t ui64;
+    char *locstr;
+    void *key, *nptr;
+    size_t keysize;
+    int rc;
+    rc = pmix_hash_table_get_first_key_ptr(&prte_pmix_server_globals.dmdx_reqs, &key, &keysize,
+                                           (void **) &trk, &nptr);
+    while (PMIX_SUCCESS == rc) {
+        PMIX_RELEASE(trk);
+        rc = pmix_hash_table_get_next_key_ptr(&prte_pmix_server_globals.dmdx_reqs, &key, &keysize,
+                                              (void **) &trk, nptr, &nptr);
+    }
+    PMIX_DESTRUCT(&prte_pmix_server_globals.dmdx_reqs);
+    rc = pmix_hash_table_get_first_key_uint64(&prte_pmix_server_globals.dmdx_batches, &ui64,
+                                              (void **) &batch, &nptr);
+    while (PMIX_SUCCESS == rc) {
+        PMIX_RELEASE(batch);
+        rc = pmix_hash_table_get_next_key_uint64(&prte_pmix_server_globals.dmdx_batches, &ui64,
+                                                 (void **) &batch, nptr, &nptr);
+    }
+    PMIX_DESTRUCT(&prte_pmix_server_globals.dmdx_batches);
+    rc = pmix_hash_table_get_first_key_ptr(&prte_pmix_server_globals.locality_cache, &key, &keysize,
+                                           (void **) &locstr, &nptr);
+    while (PMIX_SUCCESS == rc) {
+        free(locstr);
+        rc = pmix_hash_table_get_next_key_ptr(&prte_pmix_server_globals.locality_cache, &key, &keysize,
+                                              (void **) &locstr, nptr, &nptr);
+    }
+    PMIX_DESTRUCT(&prte_pmix_server_globals.locality_cache);
+
     /* cleanup collectives */
     prte_pmix_server_req_t *cd;
     for (int i = 0; i < prte_pmix_server_globals.local_reqs.size; i++) {
@@ -1132,46 +1247,220 @@ void pmix_server_finalize(void)
     prte_pmix_server_globals.initialized = false;
 }
 
+#define PRTE_DMDX_KEY_MAX (PMIX_MAX_NSLEN + 1 + sizeof(pmix_rank_t) + PMIX_MAX_KEYLEN)
+
+/* requests are coalesced on the target and the key they require */
+static size_t dmdx_key(const pmix_proc_t *proc, const char *rkey, char *key)
+{
+    size_t len, klen;
+
+    len = strnlen(proc->nspace, PMIX_MAX_NSLEN);
+    memcpy(key, proc->nspace, len);
+    key[len++] = '\0';
+    memcpy(key + len, &proc->rank, sizeof(pmix_rank_t));
+    len += sizeof(pmix_rank_t);
+    if (NULL != rkey) {
+        klen = strnlen(rkey, PMIX_MAX_KEYLEN);
+        memcpy(key + len, rkey, klen);
+        len += klen;
+    }
+    return len;
+}
+
+prte_pmix_dmdx_tracker_t *pmix_server_dmdx_tracker(const pmix_proc_t *tproc,
+                                                   const char *rkey, bool create)
+{
+    prte_pmix_dmdx_tracker_t *trk = NULL;
+    char key[PRTE_DMDX_KEY_MAX];
+    size_t len;
+    int rc;
+
+    len = dmdx_key(tproc, rkey, key);
+    rc = pmix_hash_table_get_value_ptr(&prte_pmix_server_globals.dmdx_reqs, key, len,
+                                       (void **) &trk);
+    if (PMIX_SUCCESS == rc) {
+        return trk;
+    }
+    if (!create) {
+        return NULL;
+    }
+    trk = PMIX_NEW(prte_pmix_dmdx_tracker_t);
+    PMIX_XFER_PROCID(&trk->tproc, tproc);
+    if (NULL != rkey) {
+        trk->key = strdup(rkey);
+    }
+    pmix_hash_table_set_value_ptr(&prte_pmix_server_globals.dmdx_reqs, key, len, trk);
+    return trk;
+}
+
+static void dmdx_tracker_release(prte_pmix_dmdx_tracker_t *trk)
+{
+    char key[PRTE_DMDX_KEY_MAX];
+    size_t len;
+
+    len = dmdx_key(&trk->tproc, trk->key, key);
+    pmix_hash_table_remove_value_ptr(&prte_pmix_server_globals.dmdx_reqs, key, len);
+    PMIX_RELEASE(trk);
+}
+
+prte_pmix_dmdx_tracker_t *pmix_server_dmdx_track(prte_pmix_server_req_t *req)
+{
+    prte_pmix_dmdx_tracker_t *trk;
+    prte_pmix_dmdx_waiter_t *w;
+
+    trk = pmix_server_dmdx_tracker(&req->tproc, req->key, true);
+    w = PMIX_NEW(prte_pmix_dmdx_waiter_t);
+    w->req = req;
+    pmix_list_append(&trk->waiters, &w->super);
+    req->local_index = pmix_pointer_array_add(&prte_pmix_server_globals.local_reqs, req);
+    return trk;
+}
+
+void pmix_server_dmdx_untrack(prte_pmix_server_req_t *req)
+{
+    prte_pmix_dmdx_tracker_t *trk;
+    prte_pmix_dmdx_waiter_t *w;
+
+    pmix_pointer_array_set_item(&prte_pmix_server_globals.local_reqs, req->local_index, NULL);
+    trk = pmix_server_dmdx_tracker(&req->tproc, req->key, false);
+    if (NULL == trk) {
+        return;
+    }
+    PMIX_LIST_FOREACH(w, &trk->waiters, prte_pmix_dmdx_waiter_t) {
+        if (w->req == req) {
+            pmix_list_remove_item(&trk->waiters, &w->super);
+            PMIX_RELEASE(w);
+            if (0 == pmix_list_get_size(&trk->waiters)) {
+                dmdx_tracker_release(trk);
+            }
+            return;
+        }
+    }
+}
+
+static void dmdx_flush(int sd, short args, void *cbdata)
+{
+    prte_pmix_dmdx_batch_t *batch = (prte_pmix_dmdx_batch_t *) cbdata;
+    pmix_data_buffer_t *buf;
+    pmix_status_t prc;
+    int32_t count;
+    int rc;
+    PRTE_HIDE_UNUSED_PARAMS(sd, args);
+
+    PMIX_ACQUIRE_OBJECT(batch);
+    batch->active = false;
+    if (0 == batch->count) {
+        return;
+    }
+
+    PMIX_DATA_BUFFER_CREATE(buf);
+    count = batch->count;
+    prc = PMIx_Data_pack(NULL, buf, &count, 1, PMIX_INT32);
+    if (PMIX_SUCCESS == prc) {
+        prc = PMIx_Data_copy_payload(buf, &batch->payload);
+    }
+    PMIX_DATA_BUFFER_DESTRUCT(&batch->payload);
+    PMIX_DATA_BUFFER_CONSTRUCT(&batch->payload);
+    batch->count = 0;
+    if (PMIX_SUCCESS != prc) {
+        PMIX_ERROR_LOG(prc);
+        PMIX_DATA_BUFFER_RELEASE(buf);
+        return;
+    }
+
+    pmix_output_verbose(2, prte_pmix_server_globals.output,
+                        "%s dmdx: sending %d %s to daemon %u",
+                        PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), count,
+                        (PRTE_RML_TAG_DIRECT_MODEX == batch->tag) ? "requests" : "responses",
+                        batch->daemon);
+
+    PRTE_RML_SEND(rc, batch->daemon, buf, batch->tag);
+    if (PRTE_SUCCESS != rc) {
+        PRTE_ERROR_LOG(rc);
+        PMIX_DATA_BUFFER_RELEASE(buf);
+    }
+}
+
+int pmix_server_dmdx_queue(pmix_rank_t daemon, prte_rml_tag_t tag, pmix_data_buffer_t *entry)
+{
+    prte_pmix_dmdx_batch_t *batch = NULL;
+    uint64_t key;
+    struct timeval tv;
+    pmix_status_t prc;
+
+    key = ((uint64_t) tag << 32) | (uint64_t) daemon;
+    if (PMIX_SUCCESS != pmix_hash_table_get_value_uint64(&prte_pmix_server_globals.dmdx_batches,
+                                                         key, (void **) &batch)) {
+        batch = PMIX_NEW(prte_pmix_dmdx_batch_t);
+        batch->daemon = daemon;
+        batch->tag = tag;
+        prte_event_evtimer_set(prte_event_base, &batch->ev, dmdx_flush, batch);
+        pmix_hash_table_set_value_uint64(&prte_pmix_server_globals.dmdx_batches, key, batch);
+    }
+
+    prc = PMIx_Data_copy_payload(&batch->payload, entry);
+    if (PMIX_SUCCESS != prc) {
+        PMIX_ERROR_LOG(prc);
+        return prte_pmix_convert_status(prc);
+    }
+    batch->count++;
+
+    if (!batch->active) {
+        batch->active = true;
+        PMIX_POST_OBJECT(batch);
+        if (0 < prte_pmix_server_globals.dmdx_batch_delay) {
+            tv.tv_sec = prte_pmix_server_globals.dmdx_batch_delay / 1000000;
+            tv.tv_usec = prte_pmix_server_globals.dmdx_batch_delay % 1000000;
+            prte_event_evtimer_add(&batch->ev, &tv);
+        } else {
+            prte_event_active(&batch->ev, PRTE_EV_TIMEOUT, 1);
+        }
+    }
+    return PRTE_SUCCESS;
+}
+
 static void send_error(int status, pmix_proc_t *idreq, pmix_proc_t *remote, int remote_index)
 {
-    pmix_data_buffer_t *reply;
+    pmix_data_buffer_t reply;
     pmix_status_t prc, pstatus;
+    int rc;
 
     /* pack the status */
     pstatus = prte_pmix_convert_rc(status);
-    PMIX_DATA_BUFFER_CREATE(reply);
-    if (PMIX_SUCCESS != (prc = PMIx_Data_pack(NULL, reply, &pstatus, 1, PMIX_STATUS))) {
+    PMIX_DATA_BUFFER_CONSTRUCT(&reply);
+    if (PMIX_SUCCESS != (prc = PMIx_Data_pack(NULL, &reply, &pstatus, 1, PMIX_STATUS))) {
         PMIX_ERROR_LOG(prc);
-        PMIX_DATA_BUFFER_RELEASE(reply);
+        PMIX_DATA_BUFFER_DESTRUCT(&reply);
         return;
     }
     /* pack the id of the requested proc */
-    if (PMIX_SUCCESS != (prc = PMIx_Data_pack(NULL, reply, idreq, 1, PMIX_PROC))) {
+    if (PMIX_SUCCESS != (prc = PMIx_Data_pack(NULL, &reply, idreq, 1, PMIX_PROC))) {
         PMIX_ERROR_LOG(prc);
-        PMIX_DATA_BUFFER_RELEASE(reply);
+        PMIX_DATA_BUFFER_DESTRUCT(&reply);
         return;
     }
 
     /* pack the remote daemon's request index */
-    if (PMIX_SUCCESS != (prc = PMIx_Data_pack(NULL, reply, &remote_index, 1, PMIX_INT))) {
+    if (PMIX_SUCCESS != (prc = PMIx_Data_pack(NULL, &reply, &remote_index, 1, PMIX_INT))) {
         PMIX_ERROR_LOG(prc);
-        PMIX_DATA_BUFFER_RELEASE(reply);
+        PMIX_DATA_BUFFER_DESTRUCT(&reply);
         return;
     }
 
-    /* send the response */
-    PRTE_RML_SEND(prc, remote->rank, reply, PRTE_RML_TAG_DIRECT_MODEX_RESP);
-    if (PRTE_SUCCESS != prc) {
-        PRTE_ERROR_LOG(prc);
-        PMIX_DATA_BUFFER_RELEASE(reply);
+    /* add it to the responses headed for that daemon */
+    rc = pmix_server_dmdx_queue(remote->rank, PRTE_RML_TAG_DIRECT_MODEX_RESP, &reply);
+    if (PRTE_SUCCESS != rc) {
+        PRTE_ERROR_LOG(rc);
     }
+    PMIX_DATA_BUFFER_DESTRUCT(&reply);
 }
 
 static void _mdxresp(int sd, short args, void *cbdata)
 {
     prte_pmix_server_req_t *req = (prte_pmix_server_req_t *) cbdata;
-    pmix_data_buffer_t *reply;
+    pmix_data_buffer_t reply;
     pmix_status_t prc;
+    int rc;
     PRTE_HIDE_UNUSED_PARAMS(sd, args);
 
     PMIX_ACQUIRE_OBJECT(req);
@@ -1185,49 +1474,49 @@ static void _mdxresp(int sd, short args, void *cbdata)
     pmix_pointer_array_set_item(&prte_pmix_server_globals.remote_reqs, req->local_index, NULL);
 
     /* pack the status */
-    PMIX_DATA_BUFFER_CREATE(reply);
-    if (PMIX_SUCCESS != (prc = PMIx_Data_pack(NULL, reply, &req->pstatus, 1, PMIX_STATUS))) {
+    PMIX_DATA_BUFFER_CONSTRUCT(&reply);
+    if (PMIX_SUCCESS != (prc = PMIx_Data_pack(NULL, &reply, &req->pstatus, 1, PMIX_STATUS))) {
         PMIX_ERROR_LOG(prc);
-        PMIX_DATA_BUFFER_RELEASE(reply);
+        PMIX_DATA_BUFFER_DESTRUCT(&reply);
         goto error;
     }
     /* pack the id of the requested proc */
-    if (PMIX_SUCCESS != (prc = PMIx_Data_pack(NULL, reply, &req->tproc, 1, PMIX_PROC))) {
+    if (PMIX_SUCCESS != (prc = PMIx_Data_pack(NULL, &reply, &req->tproc, 1, PMIX_PROC))) {
         PMIX_ERROR_LOG(prc);
-        PMIX_DATA_BUFFER_RELEASE(reply);
+        PMIX_DATA_BUFFER_DESTRUCT(&reply);
         goto error;
     }
 
     /* pack the remote daemon's request index */
-    if (PMIX_SUCCESS != (prc = PMIx_Data_pack(NULL, reply, &req->remote_index, 1, PMIX_INT))) {
+    if (PMIX_SUCCESS != (prc = PMIx_Data_pack(NULL, &reply, &req->remote_index, 1, PMIX_INT))) {
         PMIX_ERROR_LOG(prc);
-        PMIX_DATA_BUFFER_RELEASE(reply);
+        PMIX_DATA_BUFFER_DESTRUCT(&reply);
         goto error;
     }
     if (PMIX_SUCCESS == req->pstatus) {
         /* return any provided data */
-        if (PMIX_SUCCESS != (prc = PMIx_Data_pack(NULL, reply, &req->sz, 1, PMIX_SIZE))) {
+        if (PMIX_SUCCESS != (prc = PMIx_Data_pack(NULL, &reply, &req->sz, 1, PMIX_SIZE))) {
             PMIX_ERROR_LOG(prc);
-            PMIX_DATA_BUFFER_RELEASE(reply);
+            PMIX_DATA_BUFFER_DESTRUCT(&reply);
             goto error;
         }
         if (0 < req->sz) {
             if (PMIX_SUCCESS
-                != (prc = PMIx_Data_pack(NULL, reply, req->data, req->sz, PMIX_BYTE))) {
+                != (prc = PMIx_Data_pack(NULL, &reply, req->data, req->sz, PMIX_BYTE))) {
                 PMIX_ERROR_LOG(prc);
-                PMIX_DATA_BUFFER_RELEASE(reply);
+                PMIX_DATA_BUFFER_DESTRUCT(&reply);
                 goto error;
             }
             free(req->data);
         }
     }
 
-    /* send the response */
-    PRTE_RML_SEND(prc, req->proxy.rank, reply, PRTE_RML_TAG_DIRECT_MODEX_RESP);
-    if (PRTE_SUCCESS != prc) {
-        PRTE_ERROR_LOG(prc);
-        PMIX_DATA_BUFFER_RELEASE(reply);
+    /* add it to the responses headed for that daemon */
+    rc = pmix_server_dmdx_queue(req->proxy.rank, PRTE_RML_TAG_DIRECT_MODEX_RESP, &reply);
+    if (PRTE_SUCCESS != rc) {
+        PRTE_ERROR_LOG(rc);
     }
+    PMIX_DATA_BUFFER_DESTRUCT(&reply);
 
 error:
     PMIX_RELEASE(req);
@@ -1355,9 +1644,7 @@ static void dmdx_check(int sd, short args, void *cbdata)
     return;
 }
 
-static void pmix_server_dmdx_recv(int status, pmix_proc_t *sender,
-                                  pmix_data_buffer_t *buffer,
-                                  prte_rml_tag_t tg, void *cbdata)
+static pmix_status_t dmdx_recv_one(pmix_proc_t *sender, pmix_data_buffer_t *buffer)
 {
     int rc, index;
     int32_t cnt, timeout = 0;
@@ -1373,12 +1660,11 @@ static void pmix_server_dmdx_recv(int status, pmix_proc_t *sender,
     size_t sz, n, refreshidx;
     bool refresh_cache = false;
     pmix_value_t *pval = NULL;
-    PRTE_HIDE_UNUSED_PARAMS(status, tg, cbdata);
 
     cnt = 1;
     if (PMIX_SUCCESS != (prc = PMIx_Data_unpack(NULL, buffer, &pproc, &cnt, PMIX_PROC))) {
         PMIX_ERROR_LOG(prc);
-        return;
+        return prc;
     }
     pmix_output_verbose(2, prte_pmix_server_globals.output,
                         "%s dmdx:recv processing request from proc %s for proc %s:%u",
@@ -1388,19 +1674,20 @@ static void pmix_server_dmdx_recv(int status, pmix_proc_t *sender,
     cnt = 1;
     if (PMIX_SUCCESS != (prc = PMIx_Data_unpack(NULL, buffer, &index, &cnt, PMIX_INT))) {
         PMIX_ERROR_LOG(prc);
-        return;
+        return prc;
     }
     cnt = 1;
     if (PMIX_SUCCESS != (prc = PMIx_Data_unpack(NULL, buffer, &ninfo, &cnt, PMIX_SIZE))) {
         PMIX_ERROR_LOG(prc);
-        return;
+        return prc;
     }
     if (0 < ninfo) {
         PMIX_INFO_CREATE(info, ninfo);
         cnt = ninfo;
         if (PMIX_SUCCESS != (prc = PMIx_Data_unpack(NULL, buffer, info, &cnt, PMIX_INFO))) {
             PMIX_ERROR_LOG(prc);
-            return;
+            PMIX_INFO_FREE(info, ninfo);
+            return prc;
         }
     }
 
@@ -1425,7 +1712,7 @@ static void pmix_server_dmdx_recv(int status, pmix_proc_t *sender,
                     if (NULL != key) {
                         free(key);
                     }
-                    return;
+                    return PMIX_SUCCESS;
                 }
                 continue;
             }
@@ -1501,7 +1788,7 @@ static void pmix_server_dmdx_recv(int status, pmix_proc_t *sender,
             tv.tv_sec = timeout;
             prte_event_evtimer_add(&req->cycle, &tv);
         }
-        return;
+        return PMIX_SUCCESS;
     }
 
     /* we know about this job - look for the proc */
@@ -1512,7 +1799,7 @@ static void pmix_server_dmdx_recv(int status, pmix_proc_t *sender,
         if (NULL != key) {
           free(key);
         }
-        return;
+        return PMIX_SUCCESS;
     }
     if (!PRTE_FLAG_TEST(proc, PRTE_PROC_FLAG_LOCAL)) {
         /* send back an error - they obviously have made a mistake */
@@ -1520,7 +1807,7 @@ static void pmix_server_dmdx_recv(int status, pmix_proc_t *sender,
         if (NULL != key) {
           free(key);
         }
-        return;
+        return PMIX_SUCCESS;
     }
 
     if (NULL != key) {
@@ -1561,7 +1848,7 @@ static void pmix_server_dmdx_recv(int status, pmix_proc_t *sender,
                 tv.tv_sec = timeout;
                 prte_event_evtimer_add(&req->ev, &tv);
             }
-            return;
+            return PMIX_SUCCESS;
         }
         /* we do already have it, so go get the payload */
         PMIX_VALUE_RELEASE(pval);
@@ -1613,9 +1900,33 @@ static void pmix_server_dmdx_recv(int status, pmix_proc_t *sender,
         pmix_pointer_array_set_item(&prte_pmix_server_globals.remote_reqs, req->local_index, NULL);
         rc = prte_pmix_convert_status(prc);
         send_error(rc, &pproc, sender, index);
+        return PMIX_SUCCESS;
+    }
+    return PMIX_SUCCESS;
+}
+
+static void pmix_server_dmdx_recv(int status, pmix_proc_t *sender,
+                                  pmix_data_buffer_t *buffer,
+                                  prte_rml_tag_t tg, void *cbdata)
+{
+    int32_t cnt, count, n;
+    pmix_status_t prc;
+    PRTE_HIDE_UNUSED_PARAMS(status, tg, cbdata);
+
+    /* requests are batched per daemon */
+    cnt = 1;
+    if (PMIX_SUCCESS != (prc = PMIx_Data_unpack(NULL, buffer, &count, &cnt, PMIX_INT32))) {
+        PMIX_ERROR_LOG(prc);
         return;
     }
-    return;
+    pmix_output_verbose(2, prte_pmix_server_globals.output,
+                        "%s dmdx:recv %d requests from %s",
+                        PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), count, PRTE_NAME_PRINT(sender));
+    for (n = 0; n < count; n++) {
+        if (PMIX_SUCCESS != dmdx_recv_one(sender, buffer)) {
+            return;
+        }
+    }
 }
 
 typedef struct {
@@ -1645,23 +1956,28 @@ static void relcbfunc(void *relcbdata)
     PMIX_RELEASE(d);
 }
 
-static void pmix_server_dmdx_resp(int status, pmix_proc_t *sender,
-                                  pmix_data_buffer_t *buffer,
-                                  prte_rml_tag_t tg, void *cbdata)
+static void dmdx_deliver(prte_pmix_server_req_t *req, pmix_status_t pret, datacaddy_t *d)
+{
+    if (NULL != req->mdxcbfunc) {
+        PMIX_RETAIN(d);
+        req->mdxcbfunc(pret, d->data, d->ndata, req->cbdata, relcbfunc, d);
+    }
+    pmix_pointer_array_set_item(&prte_pmix_server_globals.local_reqs, req->local_index, NULL);
+    PMIX_RELEASE(req);
+}
+
+static pmix_status_t dmdx_resp_one(pmix_data_buffer_t *buffer)
 {
-    int index, n;
+    int index;
     int32_t cnt;
     prte_pmix_server_req_t *req;
+    prte_pmix_dmdx_tracker_t *trk;
+    prte_pmix_dmdx_waiter_t *w;
     datacaddy_t *d;
     pmix_proc_t pproc;
+    bool found;
     size_t psz;
     pmix_status_t prc, pret;
-    PRTE_HIDE_UNUSED_PARAMS(status, tg, cbdata);
-
-    pmix_output_verbose(2, prte_pmix_server_globals.output,
-                        "%s dmdx:recv response recvd from proc %s with %d bytes",
-                        PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_NAME_PRINT(sender),
-                        (int) buffer->bytes_used);
 
     d = PMIX_NEW(datacaddy_t);
 
@@ -1670,7 +1986,7 @@ static void pmix_server_dmdx_resp(int status, pmix_proc_t *sender,
     if (PMIX_SUCCESS != (prc = PMIx_Data_unpack(NULL, buffer, &pret, &cnt, PMIX_STATUS))) {
         PMIX_ERROR_LOG(prc);
         PMIX_RELEASE(d);
-        return;
+        return prc;
     }
 
     /* unpack the id of the target whose info we just received */
@@ -1678,7 +1994,7 @@ static void pmix_server_dmdx_resp(int status, pmix_proc_t *sender,
     if (PMIX_SUCCESS != (prc = PMIx_Data_unpack(NULL, buffer, &pproc, &cnt, PMIX_PROC))) {
         PMIX_ERROR_LOG(prc);
         PMIX_RELEASE(d);
-        return;
+        return prc;
     }
 
     /* unpack our tracking index */
@@ -1686,16 +2002,16 @@ static void pmix_server_dmdx_resp(int status, pmix_proc_t *sender,
     if (PMIX_SUCCESS != (prc = PMIx_Data_unpack(NULL, buffer, &index, &cnt, PMIX_INT))) {
         PMIX_ERROR_LOG(prc);
         PMIX_RELEASE(d);
-        return;
+        return prc;
     }
 
-    /* unload the remainder of the buffer */
+    /* unload the remainder of the entry */
     if (PMIX_SUCCESS == pret) {
         cnt = 1;
         if (PMIX_SUCCESS != (prc = PMIx_Data_unpack(NULL, buffer, &psz, &cnt, PMIX_SIZE))) {
             PMIX_ERROR_LOG(prc);
             PMIX_RELEASE(d);
-            return;
+            return prc;
         }
         if (0 < psz) {
             d->ndata = psz;
@@ -1707,43 +2023,74 @@ static void pmix_server_dmdx_resp(int status, pmix_proc_t *sender,
             if (PMIX_SUCCESS != (prc = PMIx_Data_unpack(NULL, buffer, d->data, &cnt, PMIX_BYTE))) {
                 PMIX_ERROR_LOG(prc);
                 PMIX_RELEASE(d);
-                return;
+                return prc;
             }
         }
     }
 
-    /* get the request out of the tracking array */
-    req = (prte_pmix_server_req_t*)pmix_pointer_array_get_item(&prte_pmix_server_globals.local_reqs, index);
-    /* return the returned data to the requestor */
+    /* find the request we sent - it identifies the data
+     * that was returned */
+    req = (prte_pmix_server_req_t *) pmix_pointer_array_get_item(&prte_pmix_server_globals.local_reqs, index);
+    if (NULL != req && !PMIX_CHECK_PROCID(&req->tproc, &pproc)) {
+        req = NULL;
+    }
+
+    /* return the data to everyone waiting on it, unless the
+     * request was a refresh that nobody else waited upon */
+    trk = NULL;
     if (NULL != req) {
-        if (NULL != req->mdxcbfunc) {
-            PMIX_RETAIN(d);
-            req->mdxcbfunc(pret, d->data, d->ndata, req->cbdata, relcbfunc, d);
+        trk = pmix_server_dmdx_tracker(&pproc, req->key, false);
+    }
+    found = false;
+    if (NULL != trk) {
+        PMIX_LIST_FOREACH(w, &trk->waiters, prte_pmix_dmdx_waiter_t) {
+            if (w->req == req) {
+                found = true;
+                break;
+            }
         }
-        pmix_pointer_array_set_item(&prte_pmix_server_globals.local_reqs, index, NULL);
-        PMIX_RELEASE(req);
+    }
+    if (found) {
+        while (NULL != (w = (prte_pmix_dmdx_waiter_t *) pmix_list_remove_first(&trk->waiters))) {
+            dmdx_deliver(w->req, pret, d);
+            PMIX_RELEASE(w);
+        }
+        dmdx_tracker_release(trk);
+    } else if (NULL != req) {
+        dmdx_deliver(req, pret, d);
     } else {
         pmix_output_verbose(2, prte_pmix_server_globals.output,
-                            "REQ WAS NULL IN ARRAY INDEX %d",
-                            index);
+                            "%s dmdx:recv no requests waiting for %s:%u (index %d)",
+                            PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), pproc.nspace, pproc.rank, index);
     }
+    PMIX_RELEASE(d); // maintain accounting
+    return PMIX_SUCCESS;
+}
 
-    /* now see if anyone else was waiting for data from this target */
-    for (n = 0; n < prte_pmix_server_globals.local_reqs.size; n++) {
-        req = (prte_pmix_server_req_t*)pmix_pointer_array_get_item(&prte_pmix_server_globals.local_reqs, n);
-        if (NULL == req) {
-            continue;
-        }
-        if (PMIX_CHECK_PROCID(&req->tproc, &pproc)) {
-            if (NULL != req->mdxcbfunc) {
-                PMIX_RETAIN(d);
-                req->mdxcbfunc(pret, d->data, d->ndata, req->cbdata, relcbfunc, d);
-            }
-            pmix_pointer_array_set_item(&prte_pmix_server_globals.local_reqs, n, NULL);
-            PMIX_RELEASE(req);
+static void pmix_server_dmdx_resp(int status, pmix_proc_t *sender,
+                                  pmix_data_buffer_t *buffer,
+                                  prte_rml_tag_t tg, void *cbdata)
+{
+    int32_t cnt, count, n;
+    pmix_status_t prc;
+    PRTE_HIDE_UNUSED_PARAMS(status, tg, cbdata);
+
+    pmix_output_verbose(2, prte_pmix_server_globals.output,
+                        "%s dmdx:recv response recvd from proc %s with %d bytes",
+                        PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_NAME_PRINT(sender),
+                        (int) buffer->bytes_used);
+
+    /* responses are batched per daemon */
+    cnt = 1;
+    if (PMIX_SUCCESS != (prc = PMIx_Data_unpack(NULL, buffer, &count, &cnt, PMIX_INT32))) {
+        PMIX_ERROR_LOG(prc);
+        return;
+    }
+    for (n = 0; n < count; n++) {
+        if (PMIX_SUCCESS != dmdx_resp_one(buffer)) {
+            return;
         }
     }
-    PMIX_RELEASE(d); // maintain accounting
 }
 
 
@@ -2279,3 +2626,48 @@ static void psdes(prte_pmix_server_pset_t *p)
 PMIX_CLASS_INSTANCE(prte_pmix_server_pset_t,
                     pmix_list_item_t,
                     pscon, psdes);
+
+static void dtcon(prte_pmix_dmdx_tracker_t *p)
+{
+    PMIX_LOAD_PROCID(&p->tproc, NULL, PMIX_RANK_INVALID);
+    p->key = NULL;
+    p->requested = false;
+    PMIX_CONSTRUCT(&p->waiters, pmix_list_t);
+}
+static void dtdes(prte_pmix_dmdx_tracker_t *p)
+{
+    if (NULL != p->key) {
+        free(p->key);
+    }
+    PMIX_LIST_DESTRUCT(&p->waiters);
+}
+PMIX_CLASS_INSTANCE(prte_pmix_dmdx_tracker_t,
+                    pmix_object_t,
+                    dtcon, dtdes);
+
+static void dwcon(prte_pmix_dmdx_waiter_t *p)
+{
+    p->req = NULL;
+}
+PMIX_CLASS_INSTANCE(prte_pmix_dmdx_waiter_t,
+                    pmix_list_item_t,
+                    dwcon, NULL);
+
+static void dbcon(prte_pmix_dmdx_batch_t *p)
+{
+    p->active = false;
+    p->daemon = PMIX_RANK_INVALID;
+    p->tag = PRTE_RML_TAG_INVALID;
+    p->count = 0;
+    PMIX_DATA_BUFFER_CONSTRUCT(&p->payload);
+}
+static void dbdes(prte_pmix_dmdx_batch_t *p)
+{
+    if (p->active) {
+        prte_event_del(&p->ev);
+    }
+    PMIX_DATA_BUFFER_DESTRUCT(&p->payload);
+}
+PMIX_CLASS_INSTANCE(prte_pmix_dmdx_batch_t,
+                    pmix_object_t,
+                    dbcon, dbdes);
@@ -42,6 +42,11 @@ PRTE_EXPORT void prte_pmix_server_clear(pmix_proc_t *pname);
 
 PRTE_EXPORT void pmix_server_notify_spawn(pmix_nspace_t jobid, int room, pmix_status_t ret);
 
+/* the number of daemons published data is spread across - the
+ * HNP fixes it against the initial DVM the first time it is
+ * needed, and every daemon it launches is handed the result */
+PRTE_EXPORT int prte_pmix_server_pubsub_shards(void);
+
 END_C_DECLS
 
 #endif /* PMIX_SERVER_H_ */
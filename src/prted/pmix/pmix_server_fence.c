@@ -38,6 +38,7 @@
 
 #include "src/mca/errmgr/errmgr.h"
 #include "src/mca/grpcomm/base/base.h"
+#include "src/mca/state/base/base.h"
 #include "src/rml/rml.h"
 #include "src/runtime/prte_globals.h"
 #include "src/threads/pmix_threads.h"
@@ -63,6 +64,10 @@ pmix_status_t pmix_server_fencenb_fn(const pmix_proc_t procs[], size_t nprocs,
                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
                         prte_process_info.nodename);
 
+    if (0 < nprocs) {
+        PRTE_TIMELINE_MARK(procs[0].nspace, PRTE_TIMELINE_FIRST_FENCE);
+    }
+
     // just pass this along
     rc = prte_grpcomm.fence(procs, nprocs, info, ninfo,
                             data, ndata, cbfunc, cbdata);
@@ -73,11 +78,11 @@ pmix_status_t pmix_server_fencenb_fn(const pmix_proc_t procs[], size_t nprocs,
 static void dmodex_req(int sd, short args, void *cbdata)
 {
     prte_pmix_server_req_t *req = (prte_pmix_server_req_t *) cbdata;
-    prte_pmix_server_req_t *r;
+    prte_pmix_dmdx_tracker_t *trk;
     prte_job_t *jdata;
     prte_proc_t *proct, *dmn;
-    int rc, rnum;
-    pmix_data_buffer_t *buf;
+    int rc;
+    pmix_data_buffer_t buf;
     pmix_status_t prc = PMIX_ERROR;
     bool refresh_cache = false;
     pmix_value_t *pval;
@@ -128,19 +133,18 @@ static void dmodex_req(int sd, short args, void *cbdata)
         }
     }
 
-    /* has anyone already requested data for this target? If so,
-     * then the data is already on its way */
-    for (rnum = 0; rnum < prte_pmix_server_globals.local_reqs.size; rnum++) {
-        r = (prte_pmix_server_req_t*)pmix_pointer_array_get_item(&prte_pmix_server_globals.local_reqs, rnum);
-        if (NULL == r) {
-            continue;
-        }
-        if (PMIX_CHECK_PROCID(&r->target, &req->tproc)) {
-            /* save the request in the array until the
-             * data is returned */
-            req->local_index = pmix_pointer_array_add(&prte_pmix_server_globals.local_reqs, req);
-            return;
-        }
+    /* has anyone already requested this data? If so, then it
+     * is already on its way - unless they want it refreshed,
+     * which means asking for it anew */
+    trk = NULL;
+    if (!refresh_cache) {
+        trk = pmix_server_dmdx_tracker(&req->tproc, req->key, false);
+    }
+    if (NULL != trk && trk->requested) {
+        /* save the request with the others until the
+         * data is returned */
+        pmix_server_dmdx_track(req);
+        return;
     }
 
     /* lookup who is hosting this proc */
@@ -149,7 +153,7 @@ static void dmodex_req(int sd, short args, void *cbdata)
          * condition where we are being asked about a process
          * that we don't know about yet. In this case, just
          * record the request and we will process it later */
-        req->local_index = pmix_pointer_array_add(&prte_pmix_server_globals.local_reqs, req);
+        pmix_server_dmdx_track(req);
         return;
     }
     /* if this is a request for rank=WILDCARD, then they want the job-level data
@@ -179,6 +183,24 @@ static void dmodex_req(int sd, short args, void *cbdata)
         goto callback;
     }
 
+    /* if we deferred the locality of this proc when registering
+     * its nspace, then provide it now */
+    if (prte_pmix_server_globals.lazy_registration &&
+        !PRTE_FLAG_TEST(proct, PRTE_PROC_FLAG_LOCALITY_REGD)) {
+        rc = prte_pmix_server_register_locality(proct);
+        if (PRTE_SUCCESS == rc && NULL != req->key &&
+            (0 == strcmp(req->key, PMIX_CPUSET) ||
+             0 == strcmp(req->key, PMIX_LOCALITY_STRING) ||
+             0 == strcmp(req->key, PMIX_DEVICE_DISTANCES))) {
+            /* that is all they wanted - let the server find it */
+            if (NULL != req->mdxcbfunc) {
+                req->mdxcbfunc(PMIX_SUCCESS, NULL, 0, req->cbdata, NULL, NULL);
+            }
+            PMIX_RELEASE(req);
+            return;
+        }
+    }
+
     if (NULL == (dmn = proct->node->daemon)) {
         /* we don't know where this proc is located - since we already
          * found the job, and therefore know about its locations, this
@@ -191,8 +213,14 @@ static void dmodex_req(int sd, short args, void *cbdata)
      * target process */
     req->proxy = dmn->name;
     /* track the request so we know the function and cbdata
-     * to callback upon completion */
-    req->local_index = pmix_pointer_array_add(&prte_pmix_server_globals.local_reqs, req);
+     * to callback upon completion - anyone else asking for
+     * the same data will now wait for our request to be filled */
+    if (refresh_cache) {
+        req->local_index = pmix_pointer_array_add(&prte_pmix_server_globals.local_reqs, req);
+    } else {
+        trk = pmix_server_dmdx_track(req);
+        trk->requested = true;
+    }
     pmix_output_verbose(2, prte_pmix_server_globals.output,
                         "%s:%d MY REQ INDEX IS %d FOR KEY %s",
                         __FILE__, __LINE__, req->local_index,
@@ -203,48 +231,46 @@ static void dmodex_req(int sd, short args, void *cbdata)
         return;
     }
 
-    /* construct a request message */
-    PMIX_DATA_BUFFER_CREATE(buf);
-    if (PMIX_SUCCESS != (prc = PMIx_Data_pack(NULL, buf, &req->tproc, 1, PMIX_PROC))) {
+    /* construct the request */
+    PMIX_DATA_BUFFER_CONSTRUCT(&buf);
+    if (PMIX_SUCCESS != (prc = PMIx_Data_pack(NULL, &buf, &req->tproc, 1, PMIX_PROC))) {
         PMIX_ERROR_LOG(prc);
-        pmix_pointer_array_set_item(&prte_pmix_server_globals.local_reqs, req->local_index, NULL);
-        PMIX_DATA_BUFFER_RELEASE(buf);
-        goto callback;
+        goto cleanup;
     }
     /* include the request index for quick retrieval */
-    if (PMIX_SUCCESS != (prc = PMIx_Data_pack(NULL, buf, &req->local_index, 1, PMIX_INT))) {
+    if (PMIX_SUCCESS != (prc = PMIx_Data_pack(NULL, &buf, &req->local_index, 1, PMIX_INT))) {
         PMIX_ERROR_LOG(prc);
-        pmix_pointer_array_set_item(&prte_pmix_server_globals.local_reqs, req->local_index, NULL);
-        PMIX_DATA_BUFFER_RELEASE(buf);
-        goto callback;
+        goto cleanup;
     }
     /* add any qualifiers */
-    if (PRTE_SUCCESS != (prc = PMIx_Data_pack(NULL, buf, &req->ninfo, 1, PMIX_SIZE))) {
+    if (PRTE_SUCCESS != (prc = PMIx_Data_pack(NULL, &buf, &req->ninfo, 1, PMIX_SIZE))) {
         PMIX_ERROR_LOG(prc);
-        pmix_pointer_array_set_item(&prte_pmix_server_globals.local_reqs, req->local_index, NULL);
-        PMIX_DATA_BUFFER_RELEASE(buf);
-        goto callback;
+        goto cleanup;
     }
     if (0 < req->ninfo) {
-        if (PRTE_SUCCESS != (prc = PMIx_Data_pack(NULL, buf, req->info, req->ninfo, PMIX_INFO))) {
+        if (PRTE_SUCCESS != (prc = PMIx_Data_pack(NULL, &buf, req->info, req->ninfo, PMIX_INFO))) {
             PMIX_ERROR_LOG(prc);
-            pmix_pointer_array_set_item(&prte_pmix_server_globals.local_reqs, req->local_index, NULL);
-            PMIX_DATA_BUFFER_RELEASE(buf);
-            goto callback;
+            goto cleanup;
         }
     }
 
-    /* send it to the host daemon */
-    PRTE_RML_SEND(rc, dmn->name.rank, buf, PRTE_RML_TAG_DIRECT_MODEX);
+    /* add it to the requests headed for the host daemon */
+    rc = pmix_server_dmdx_queue(dmn->name.rank, PRTE_RML_TAG_DIRECT_MODEX, &buf);
     if (PRTE_SUCCESS != rc) {
         PRTE_ERROR_LOG(rc);
-        pmix_pointer_array_set_item(&prte_pmix_server_globals.local_reqs, req->local_index, NULL);
-        PMIX_DATA_BUFFER_RELEASE(buf);
         prc = prte_pmix_convert_rc(rc);
-        goto callback;
+        goto cleanup;
     }
+    PMIX_DATA_BUFFER_DESTRUCT(&buf);
     return;
 
+cleanup:
+    PMIX_DATA_BUFFER_DESTRUCT(&buf);
+    if (NULL != trk) {
+        trk->requested = false;
+    }
+    pmix_server_dmdx_untrack(req);
+
 callback:
     /* this section gets executed solely upon an error */
     if (NULL != req->mdxcbfunc) {
@@ -40,6 +40,7 @@
 #endif
 #include <pmix_server.h>
 
+#include "src/class/pmix_hash_table.h"
 #include "src/class/pmix_hotel.h"
 #include "src/event/event-internal.h"
 #include "src/mca/base/pmix_base.h"
@@ -49,6 +50,7 @@
 #include "src/util/proc_info.h"
 #include "types.h"
 
+#include "src/rml/rml_types.h"
 #include "src/runtime/prte_globals.h"
 #include "src/threads/pmix_threads.h"
 
@@ -110,6 +112,41 @@ typedef struct {
 } prte_pmix_server_req_t;
 PMIX_CLASS_DECLARATION(prte_pmix_server_req_t);
 
+/* track the local requests waiting for the same modex data
+ * of a given target proc - i.e., that require the same key -
+ * so only one request for it is sent to its host daemon.
+ * Requests to refresh the cache are never tracked here */
+typedef struct {
+    pmix_object_t super;
+    pmix_proc_t tproc;
+    /* the required key, or NULL if none was given */
+    char *key;
+    /* true once a request for the data is on its way */
+    bool requested;
+    /* prte_pmix_dmdx_waiter_t */
+    pmix_list_t waiters;
+} prte_pmix_dmdx_tracker_t;
+PMIX_CLASS_DECLARATION(prte_pmix_dmdx_tracker_t);
+
+typedef struct {
+    pmix_list_item_t super;
+    prte_pmix_server_req_t *req;
+} prte_pmix_dmdx_waiter_t;
+PMIX_CLASS_DECLARATION(prte_pmix_dmdx_waiter_t);
+
+/* collect the direct modex requests (or responses) headed
+ * for a given daemon so they can be sent as one message */
+typedef struct {
+    pmix_object_t super;
+    prte_event_t ev;
+    bool active;
+    pmix_rank_t daemon;
+    prte_rml_tag_t tag;
+    int32_t count;
+    pmix_data_buffer_t payload;
+} prte_pmix_dmdx_batch_t;
+PMIX_CLASS_DECLARATION(prte_pmix_dmdx_batch_t);
+
 /* object for thread-shifting server operations */
 typedef struct {
     pmix_object_t super;
@@ -344,6 +381,8 @@ PRTE_EXPORT extern void pmix_server_tconn_return(int status, pmix_proc_t *sender
 
 PRTE_EXPORT extern int prte_pmix_server_register_tool(prte_pmix_server_req_t *cd);
 
+PRTE_EXPORT extern int prte_pmix_server_register_locality(prte_proc_t *pptr);
+
 PRTE_EXPORT extern int pmix_server_cache_job_info(prte_job_t *jdata, pmix_info_t *info);
 
 PRTE_EXPORT extern int prte_pmix_xfer_job_info(prte_job_t *jdata,
@@ -358,6 +397,14 @@ PRTE_EXPORT extern void pmix_server_alloc_request_resp(int status, pmix_proc_t *
 
 PRTE_EXPORT extern pmix_status_t prte_pmix_set_scheduler(void);
 
+PRTE_EXPORT extern prte_pmix_dmdx_tracker_t *pmix_server_dmdx_tracker(const pmix_proc_t *tproc,
+                                                                      const char *key,
+                                                                      bool create);
+PRTE_EXPORT extern prte_pmix_dmdx_tracker_t *pmix_server_dmdx_track(prte_pmix_server_req_t *req);
+PRTE_EXPORT extern void pmix_server_dmdx_untrack(prte_pmix_server_req_t *req);
+PRTE_EXPORT extern int pmix_server_dmdx_queue(pmix_rank_t daemon, prte_rml_tag_t tag,
+                                              pmix_data_buffer_t *entry);
+
 PRTE_EXPORT extern pmix_status_t prte_server_send_request(uint8_t cmd, prte_pmix_server_req_t *req);
 
 PRTE_EXPORT extern void prte_server_lost_connection(size_t evhdlr_registration_id,
@@ -377,6 +424,76 @@ PRTE_EXPORT extern void pmix_server_monitor_resp(int status, pmix_proc_t *sender
                                                  pmix_data_buffer_t *buffer, prte_rml_tag_t tg,
                                                  void *cbdata);
 
+/* PRTE-specific proc table support. The start/count qualifiers page
+ * through PMIX_QUERY_PROC_TABLE, PMIX_QUERY_LOCAL_PROC_TABLE and the
+ * compact table, and each page reports the rank at which the next
+ * one begins. The compact table is a data array of the keyed arrays
+ * below - the unique hostnames and executables of the page, plus one
+ * entry per proc in each of the remaining arrays */
+#define PRTE_QUERY_PROC_TABLE_START     "prte.qry.ptable.start"    // (uint32_t) first rank of the page
+#define PRTE_QUERY_PROC_TABLE_COUNT     "prte.qry.ptable.count"    // (uint32_t) max number of ranks in the page
+#define PRTE_QUERY_PROC_TABLE_NEXT      "prte.qry.ptable.next"     // (uint32_t) first rank of the next page
+#define PRTE_QUERY_PROC_TABLE_COMPACT   "prte.qry.ptable.compact"  // (pmix_data_array_t) compact proc table
+#define PRTE_PROC_TABLE_HOSTS           "prte.ptable.hosts"        // (char*) hostnames
+#define PRTE_PROC_TABLE_EXES            "prte.ptable.exes"         // (char*) executables
+#define PRTE_PROC_TABLE_RANKS           "prte.ptable.ranks"        // (pmix_rank_t) ranks
+#define PRTE_PROC_TABLE_HOST_INDEX      "prte.ptable.hostidx"      // (uint32_t) index into the hostnames
+#define PRTE_PROC_TABLE_EXE_INDEX       "prte.ptable.exeidx"       // (uint32_t) index into the executables
+#define PRTE_PROC_TABLE_PIDS            "prte.ptable.pids"         // (pid_t) pids
+#define PRTE_PROC_TABLE_STATES          "prte.ptable.states"       // (pmix_proc_state_t) states
+#define PRTE_PROC_TABLE_EXIT_CODES      "prte.ptable.codes"        // (int32_t) exit codes
+
+/* resource usage summaries - the proc metrics come first, followed
+ * by those that are only reported for nodes */
+typedef enum {
+    PRTE_RUSAGE_CPU,      // accumulated cpu time (usec)
+    PRTE_RUSAGE_CPU_PCT,  // cpu utilization (hundredths of a percent)
+    PRTE_RUSAGE_RSS,      // resident set size (bytes)
+    PRTE_RUSAGE_READ,     // bytes read from storage
+    PRTE_RUSAGE_WRITE,    // bytes written to storage
+    PRTE_RUSAGE_CTXSW,    // voluntary + involuntary context switches
+    PRTE_RUSAGE_NPROCS,   // number of procs on the node
+    PRTE_RUSAGE_LOAD,     // 1-minute load average (hundredths)
+    PRTE_RUSAGE_MEMAVAIL, // available memory (bytes)
+    PRTE_RUSAGE_MAX
+} prte_rusage_metric_t;
+
+typedef struct {
+    uint64_t count;
+    uint64_t min[PRTE_RUSAGE_MAX];
+    uint64_t max[PRTE_RUSAGE_MAX];
+    uint64_t sum[PRTE_RUSAGE_MAX];
+} prte_rusage_summary_t;
+
+typedef void (*prte_rusage_cbfunc_t)(pmix_status_t status,
+                                     prte_rusage_summary_t *procs,
+                                     prte_rusage_summary_t *nodes,
+                                     void *cbdata);
+
+PRTE_EXPORT extern void prte_rusage_summary_init(prte_rusage_summary_t *s);
+PRTE_EXPORT extern void pmix_server_rusage_init(void);
+PRTE_EXPORT extern void pmix_server_rusage_finalize(void);
+PRTE_EXPORT extern void pmix_server_rusage_local(const pmix_nspace_t scope,
+                                                 prte_rusage_summary_t *procs,
+                                                 prte_rusage_summary_t *nodes);
+PRTE_EXPORT extern int pmix_server_rusage_collect(const pmix_nspace_t scope,
+                                                  prte_rusage_cbfunc_t cbfunc, void *cbdata);
+PRTE_EXPORT extern void pmix_server_rusage_load(void *results, const char *key,
+                                                prte_rusage_summary_t *s, bool node);
+PRTE_EXPORT extern void pmix_server_rusage_route_lost(pmix_rank_t route);
+
+PRTE_EXPORT extern void pmix_server_rusage_request(int status, pmix_proc_t *sender,
+                                                   pmix_data_buffer_t *buffer, prte_rml_tag_t tg,
+                                                   void *cbdata);
+
+PRTE_EXPORT extern void pmix_server_rusage_rollup(int status, pmix_proc_t *sender,
+                                                  pmix_data_buffer_t *buffer, prte_rml_tag_t tg,
+                                                  void *cbdata);
+
+PRTE_EXPORT extern void pmix_server_rusage_resp(int status, pmix_proc_t *sender,
+                                                pmix_data_buffer_t *buffer, prte_rml_tag_t tg,
+                                                void *cbdata);
+
 #define PRTE_PMIX_ALLOC_REQ      0
 #define PRTE_PMIX_SESSION_CTRL   1
 
@@ -409,6 +526,17 @@ typedef struct {
     pmix_pointer_array_t local_reqs;
     int timeout;
     bool wait_for_server;
+    int pubsub_shards;
+    bool pubsub_shards_fixed;
+    int dmdx_batch_delay;
+    int rusage_interval;
+    int rusage_depth;
+    int rusage_timeout;
+    int proc_table_page_max;
+    pmix_hash_table_t dmdx_reqs;
+    pmix_hash_table_t dmdx_batches;
+    bool lazy_registration;
+    pmix_hash_table_t locality_cache;
     pmix_proc_t server;
     pmix_list_t notifications;
     bool pubsub_init;
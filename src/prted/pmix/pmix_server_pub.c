@@ -45,6 +45,7 @@
 #include "src/threads/pmix_threads.h"
 #include "src/util/name_fns.h"
 #include "src/util/pmix_show_help.h"
+#include "src/util/proc_info.h"
 
 #include "src/prted/pmix/pmix_server_internal.h"
 
@@ -177,8 +178,15 @@ static void execute(int sd, short args, void *cbdata)
         goto callback;
     }
 
-    /* if the range is SESSION, then set the target to the global server */
-    if (PMIX_RANGE_SESSION == req->range) {
+    /* if this is one shard of a request, then it already knows its target */
+    if (PMIX_RANK_INVALID != req->target.rank) {
+        pmix_output_verbose(1, prte_pmix_server_globals.output,
+                            "%s orted:pmix:server sending shard to %s",
+                            PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
+                            PRTE_NAME_PRINT(&req->target));
+        target = &req->target;
+    } else if (PMIX_RANGE_SESSION == req->range) {
+        /* if the range is SESSION, then set the target to the global server */
         pmix_output_verbose(1, prte_pmix_server_globals.output,
                             "%s orted:pmix:server range SESSION",
                             PRTE_NAME_PRINT(PRTE_PROC_MY_NAME));
@@ -215,6 +223,280 @@ callback:
     PMIX_RELEASE(req);
 }
 
+int prte_pmix_server_pubsub_shards(void)
+{
+    /* the count must never change once data has been placed
+     * by it, or keys would no longer be found where they were
+     * published - so only the HNP settles it, and only once */
+    if (PRTE_PROC_IS_MASTER && !prte_pmix_server_globals.pubsub_shards_fixed) {
+        if (prte_pmix_server_globals.pubsub_shards > (int) prte_process_info.num_daemons) {
+            prte_pmix_server_globals.pubsub_shards = prte_process_info.num_daemons;
+        }
+        prte_pmix_server_globals.pubsub_shards_fixed = true;
+    }
+    return prte_pmix_server_globals.pubsub_shards;
+}
+
+/* Published data normally all lands on the HNP. If requested,
+ * spread it across the first few daemons by hashing the key
+ * so every daemon computes the same home for a given key. This
+ * is only done when the HNP would otherwise be the server */
+static uint32_t pubsub_shards(pmix_data_range_t range)
+{
+    int nshards;
+
+    if (NULL != prte_data_server_uri || PMIX_RANGE_LOCAL == range) {
+        return 0;
+    }
+    nshards = prte_pmix_server_pubsub_shards();
+    return (1 < nshards) ? (uint32_t) nshards : 0;
+}
+
+static pmix_rank_t shard_of(const char *key, uint32_t nshards)
+{
+    uint32_t hash = 2166136261u;
+    const unsigned char *c;
+
+    /* FNV-1a */
+    for (c = (const unsigned char *) key; '\0' != *c; c++) {
+        hash ^= *c;
+        hash *= 16777619u;
+    }
+    return hash % nshards;
+}
+
+static bool is_directive(const char *key)
+{
+    return (PMIx_Check_key(key, PMIX_RANGE) ||
+            PMIx_Check_key(key, PMIX_PERSISTENCE) ||
+            PMIx_Check_key(key, PMIX_USERID));
+}
+
+/* the shards of a request all complete on the event base, so the
+ * parent request can simply count them in */
+static void shard_opcbfunc(pmix_status_t status, void *cbdata)
+{
+    prte_pmix_server_req_t *req = (prte_pmix_server_req_t *) cbdata;
+
+    if (PMIX_SUCCESS != status && PMIX_SUCCESS == req->pstatus) {
+        req->pstatus = status;
+    }
+    req->nreported++;
+    if (req->nreported < req->ndaemons) {
+        return;
+    }
+    if (NULL != req->opcbfunc) {
+        req->opcbfunc(req->pstatus, req->cbdata);
+    }
+    PMIX_RELEASE(req);
+}
+
+static void shard_lkcbfunc(pmix_status_t status, pmix_pdata_t pdata[], size_t ndata,
+                           void *cbdata)
+{
+    prte_pmix_server_req_t *req = (prte_pmix_server_req_t *) cbdata;
+    pmix_pdata_t *results = NULL;
+    size_t n, nresults = 0;
+    int32_t cnt;
+    pmix_status_t rc;
+
+    /* hold the returned data in the parent's buffer until
+     * all shards have answered */
+    for (n = 0; n < ndata; n++) {
+        rc = PMIx_Data_pack(NULL, &req->msg, &pdata[n], 1, PMIX_PDATA);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            break;
+        }
+        req->sz++;
+    }
+    if (PMIX_ERR_NOT_FOUND == status || PMIX_ERR_PARTIAL_SUCCESS == status) {
+        /* flag that at least one key is missing */
+        req->flag = false;
+    } else if (PMIX_SUCCESS != status && PMIX_SUCCESS == req->pstatus) {
+        req->pstatus = status;
+    }
+    req->nreported++;
+    if (req->nreported < req->ndaemons) {
+        return;
+    }
+
+    if (0 < req->sz) {
+        PMIX_PDATA_CREATE(results, req->sz);
+        for (n = 0; n < req->sz; n++) {
+            cnt = 1;
+            rc = PMIx_Data_unpack(NULL, &req->msg, &results[n], &cnt, PMIX_PDATA);
+            if (PMIX_SUCCESS != rc) {
+                PMIX_ERROR_LOG(rc);
+                break;
+            }
+            nresults++;
+        }
+    }
+    if (PMIX_SUCCESS != req->pstatus) {
+        rc = req->pstatus;
+    } else if (0 == nresults) {
+        rc = PMIX_ERR_NOT_FOUND;
+    } else if (!req->flag) {
+        rc = PMIX_ERR_PARTIAL_SUCCESS;
+    } else {
+        rc = PMIX_SUCCESS;
+    }
+    if (NULL != req->lkcbfunc) {
+        req->lkcbfunc(rc, results, nresults, req->cbdata);
+    }
+    if (NULL != results) {
+        PMIX_PDATA_FREE(results, req->sz);
+    }
+    PMIX_RELEASE(req);
+}
+
+static pmix_status_t pack_shard(prte_pmix_server_req_t *child, uint8_t cmd,
+                                const pmix_proc_t *proc, char **keys,
+                                const pmix_info_t info[], size_t ninfo)
+{
+    pmix_status_t rc;
+    size_t m, n;
+
+    rc = PMIx_Data_pack(NULL, &child->msg, &cmd, 1, PMIX_UINT8);
+    if (PMIX_SUCCESS != rc) {
+        return rc;
+    }
+    rc = PMIx_Data_pack(NULL, &child->msg, (pmix_proc_t *) proc, 1, PMIX_PROC);
+    if (PMIX_SUCCESS != rc || PRTE_PMIX_PURGE_PROC_CMD == cmd) {
+        return rc;
+    }
+    if (PRTE_PMIX_PUBLISH_CMD != cmd) {
+        n = PMIX_ARGV_COUNT_COMPAT(keys);
+        rc = PMIx_Data_pack(NULL, &child->msg, &n, 1, PMIX_SIZE);
+        for (m = 0; PMIX_SUCCESS == rc && m < n; m++) {
+            rc = PMIx_Data_pack(NULL, &child->msg, &keys[m], 1, PMIX_STRING);
+        }
+        if (PMIX_SUCCESS != rc) {
+            return rc;
+        }
+    }
+    rc = PMIx_Data_pack(NULL, &child->msg, &ninfo, 1, PMIX_SIZE);
+    if (PMIX_SUCCESS == rc && 0 < ninfo) {
+        rc = PMIx_Data_pack(NULL, &child->msg, (pmix_info_t *) info, ninfo, PMIX_INFO);
+    }
+    return rc;
+}
+
+/* split a request into one request per shard that holds any of
+ * its keys. Publish requests are split by the keys of the data,
+ * carrying all directives to each shard. Purge requests must
+ * visit every shard */
+static pmix_status_t shard_request(prte_pmix_server_req_t *req, uint8_t cmd,
+                                   const pmix_proc_t *proc, char **keys,
+                                   const pmix_info_t info[], size_t ninfo,
+                                   uint32_t nshards)
+{
+    prte_pmix_server_req_t **kids, *child;
+    pmix_info_t *sinfo;
+    char **skeys;
+    size_t n, m, nsinfo, ndirs = 0;
+    uint32_t s, nkids = 0;
+    pmix_status_t rc = PMIX_SUCCESS;
+
+    if (PRTE_PMIX_PUBLISH_CMD == cmd) {
+        for (n = 0; n < ninfo; n++) {
+            if (is_directive(info[n].key)) {
+                ++ndirs;
+            }
+        }
+        if (ndirs == ninfo) {
+            /* nothing to publish */
+            return PMIX_ERR_BAD_PARAM;
+        }
+    }
+
+    kids = (prte_pmix_server_req_t **) calloc(nshards, sizeof(prte_pmix_server_req_t *));
+    for (s = 0; s < nshards; s++) {
+        skeys = NULL;
+        sinfo = NULL;
+        nsinfo = 0;
+        if (PRTE_PMIX_PUBLISH_CMD == cmd) {
+            for (n = 0; n < ninfo; n++) {
+                if (!is_directive(info[n].key) && s == shard_of(info[n].key, nshards)) {
+                    ++nsinfo;
+                }
+            }
+            if (0 == nsinfo) {
+                continue;
+            }
+            nsinfo += ndirs;
+            PMIX_INFO_CREATE(sinfo, nsinfo);
+            for (n = 0, m = 0; n < ninfo; n++) {
+                if (is_directive(info[n].key) || s == shard_of(info[n].key, nshards)) {
+                    PMIX_INFO_XFER(&sinfo[m], (pmix_info_t *) &info[n]);
+                    ++m;
+                }
+            }
+        } else if (PRTE_PMIX_PURGE_PROC_CMD != cmd) {
+            for (n = 0; NULL != keys[n]; n++) {
+                if (s == shard_of(keys[n], nshards)) {
+                    PMIX_ARGV_APPEND_NOSIZE_COMPAT(&skeys, keys[n]);
+                }
+            }
+            if (NULL == skeys) {
+                continue;
+            }
+        }
+
+        child = PMIX_NEW(prte_pmix_server_req_t);
+        pmix_asprintf(&child->operation, "%s SHARD %u: %s:%d", req->operation, s,
+                      __FILE__, __LINE__);
+        child->range = req->range;
+        child->timeout = req->timeout;
+        PMIX_LOAD_PROCID(&child->target, PRTE_PROC_MY_NAME->nspace, s);
+        child->cbdata = req;
+        if (NULL != req->lkcbfunc) {
+            child->lkcbfunc = shard_lkcbfunc;
+        } else {
+            child->opcbfunc = shard_opcbfunc;
+        }
+        if (PRTE_PMIX_PUBLISH_CMD == cmd) {
+            rc = pack_shard(child, cmd, proc, NULL, sinfo, nsinfo);
+            PMIX_INFO_FREE(sinfo, nsinfo);
+        } else {
+            rc = pack_shard(child, cmd, proc, skeys, info, ninfo);
+            PMIX_ARGV_FREE_COMPAT(skeys);
+        }
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            PMIX_RELEASE(child);
+            break;
+        }
+        kids[nkids++] = child;
+    }
+
+    if (PMIX_SUCCESS != rc) {
+        for (s = 0; s < nkids; s++) {
+            PMIX_RELEASE(kids[s]);
+        }
+        free(kids);
+        return rc;
+    }
+
+    /* the parent collects the shard results in its msg buffer */
+    PMIX_DATA_BUFFER_DESTRUCT(&req->msg);
+    PMIX_DATA_BUFFER_CONSTRUCT(&req->msg);
+    req->ndaemons = nkids;
+    req->nreported = 0;
+
+    /* thread-shift the shards so we can store their trackers */
+    for (s = 0; s < nkids; s++) {
+        child = kids[s];
+        prte_event_set(prte_event_base, &(child->ev), -1, PRTE_EV_WRITE, execute, child);
+        PMIX_POST_OBJECT(child);
+        prte_event_active(&(child->ev), PRTE_EV_WRITE, 1);
+    }
+    free(kids);
+
+    return PMIX_SUCCESS;
+}
+
 pmix_status_t pmix_server_publish_fn(const pmix_proc_t *proc, const pmix_info_t info[],
                                      size_t ninfo, pmix_op_cbfunc_t cbfunc, void *cbdata)
 {
@@ -223,6 +505,7 @@ pmix_status_t pmix_server_publish_fn(const pmix_proc_t *proc, const pmix_info_t
     int ret;
     uint8_t cmd = PRTE_PMIX_PUBLISH_CMD;
     size_t n;
+    uint32_t nshards;
 
     pmix_output_verbose(1, prte_pmix_server_globals.output, "%s orted:pmix:server PUBLISH",
                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME));
@@ -250,6 +533,16 @@ pmix_status_t pmix_server_publish_fn(const pmix_proc_t *proc, const pmix_info_t
         }
     }
 
+    /* spread the request across the shards if requested */
+    nshards = pubsub_shards(req->range);
+    if (0 < nshards) {
+        rc = shard_request(req, cmd, proc, NULL, info, ninfo, nshards);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_RELEASE(req);
+        }
+        return rc;
+    }
+
     /* pack the name of the publisher */
     if (PMIX_SUCCESS
         != (rc = PMIx_Data_pack(NULL, &req->msg, (pmix_proc_t *) proc, 1, PMIX_PROC))) {
@@ -288,6 +581,7 @@ pmix_status_t pmix_server_lookup_fn(const pmix_proc_t *proc, char **keys, const
     int ret;
     uint8_t cmd = PRTE_PMIX_LOOKUP_CMD;
     size_t m, n;
+    uint32_t nshards;
     pmix_status_t rc;
 
     if (NULL == keys || 0 == PMIX_ARGV_COUNT_COMPAT(keys)) {
@@ -316,6 +610,16 @@ pmix_status_t pmix_server_lookup_fn(const pmix_proc_t *proc, char **keys, const
         }
     }
 
+    /* spread the request across the shards if requested */
+    nshards = pubsub_shards(req->range);
+    if (0 < nshards) {
+        rc = shard_request(req, cmd, proc, keys, info, ninfo, nshards);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_RELEASE(req);
+        }
+        return rc;
+    }
+
     /* pack the name of the requestor */
     if (PMIX_SUCCESS
         != (rc = PMIx_Data_pack(NULL, &req->msg, (pmix_proc_t *) proc, 1, PMIX_PROC))) {
@@ -373,6 +677,7 @@ pmix_status_t pmix_server_unpublish_fn(const pmix_proc_t *proc, char **keys,
     int ret;
     uint8_t cmd;
     size_t m, n;
+    uint32_t nshards;
     pmix_status_t rc;
 
     // check for a "purge" command
@@ -391,6 +696,16 @@ pmix_status_t pmix_server_unpublish_fn(const pmix_proc_t *proc, char **keys,
             return PMIX_ERR_PACK_FAILURE;
         }
 
+        /* data may have been published to any of the shards */
+        nshards = pubsub_shards(req->range);
+        if (0 < nshards) {
+            rc = shard_request(req, cmd, proc, NULL, NULL, 0, nshards);
+            if (PMIX_SUCCESS != rc) {
+                PMIX_RELEASE(req);
+            }
+            return rc;
+        }
+
         /* pack the name of the requestor */
         if (PMIX_SUCCESS
             != (rc = PMIx_Data_pack(NULL, &req->msg, (pmix_proc_t *) proc, 1, PMIX_PROC))) {
@@ -431,6 +746,16 @@ pmix_status_t pmix_server_unpublish_fn(const pmix_proc_t *proc, char **keys,
         }
     }
 
+    /* spread the request across the shards if requested */
+    nshards = pubsub_shards(req->range);
+    if (0 < nshards) {
+        rc = shard_request(req, cmd, proc, keys, info, ninfo, nshards);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_RELEASE(req);
+        }
+        return rc;
+    }
+
     /* pack the name of the requestor */
     if (PMIX_SUCCESS
         != (rc = PMIx_Data_pack(NULL, &req->msg, (pmix_proc_t *) proc, 1, PMIX_PROC))) {
@@ -67,6 +67,357 @@ static void qrel(void *cbdata)
     PMIX_RELEASE(cd);
 }
 
+/* the executable of each app, resolved once per query
+ * rather than once per proc */
+static char **exe_cache(prte_job_t *jdata)
+{
+    prte_app_context_t *app;
+    char **exes;
+    int i;
+
+    exes = (char **) calloc(jdata->apps->size + 1, sizeof(char *));
+    for (i = 0; i < jdata->apps->size; i++) {
+        app = (prte_app_context_t *) pmix_pointer_array_get_item(jdata->apps, i);
+        if (NULL == app || NULL == app->app) {
+            continue;
+        }
+        if (pmix_path_is_absolute(app->app)) {
+            exes[i] = strdup(app->app);
+        } else {
+            exes[i] = pmix_os_path(false, app->cwd, app->app, NULL);
+        }
+    }
+    return exes;
+}
+
+static pmix_status_t add_array(void *list, const char *key, void *array,
+                               size_t size, pmix_data_type_t type)
+{
+    pmix_data_array_t dry;
+    pmix_status_t rc;
+
+    dry.type = type;
+    dry.size = size;
+    dry.array = array;
+    PMIX_INFO_LIST_ADD(rc, list, key, &dry, PMIX_DATA_ARRAY);
+    return rc;
+}
+
+/* the compact proc table carries each hostname and executable
+ * once, with the procs referring to them by index */
+static pmix_status_t compact_table(prte_job_t *jdata, pmix_rank_t start, pmix_rank_t end,
+                                   char **exes, void *results)
+{
+    prte_proc_t *proct;
+    pmix_rank_t *ranks = NULL, r;
+    uint32_t *hostidx = NULL, *exeidx = NULL, *nodemap = NULL;
+    pid_t *pids = NULL;
+    pmix_proc_state_t *states = NULL;
+    int32_t *codes = NULL;
+    char **hosts = NULL, **exelist = NULL;
+    uint32_t nhosts = 0, nexes = 0, *appmap = NULL;
+    size_t nprocs = 0, max;
+    pmix_data_array_t dry;
+    pmix_status_t rc;
+    void *ilist;
+
+    max = end - start;
+    ranks = (pmix_rank_t *) malloc(max * sizeof(pmix_rank_t));
+    hostidx = (uint32_t *) malloc(max * sizeof(uint32_t));
+    exeidx = (uint32_t *) malloc(max * sizeof(uint32_t));
+    pids = (pid_t *) malloc(max * sizeof(pid_t));
+    states = (pmix_proc_state_t *) malloc(max * sizeof(pmix_proc_state_t));
+    codes = (int32_t *) malloc(max * sizeof(int32_t));
+    /* index + 1 of each node/app in the tables, 0 if not seen */
+    nodemap = (uint32_t *) calloc(prte_node_pool->size, sizeof(uint32_t));
+    appmap = (uint32_t *) calloc(jdata->apps->size, sizeof(uint32_t));
+    hosts = (char **) calloc(max + 1, sizeof(char *));
+    exelist = (char **) calloc(jdata->apps->size + 1, sizeof(char *));
+
+    for (r = start; r < end; r++) {
+        proct = (prte_proc_t *) pmix_pointer_array_get_item(jdata->procs, r);
+        if (NULL == proct) {
+            continue;
+        }
+        ranks[nprocs] = proct->name.rank;
+        hostidx[nprocs] = UINT32_MAX;
+        if (NULL != proct->node && NULL != proct->node->name &&
+            proct->node->index < prte_node_pool->size) {
+            if (0 == nodemap[proct->node->index]) {
+                hosts[nhosts++] = proct->node->name;
+                nodemap[proct->node->index] = nhosts;
+            }
+            hostidx[nprocs] = nodemap[proct->node->index] - 1;
+        }
+        exeidx[nprocs] = UINT32_MAX;
+        if (proct->app_idx < jdata->apps->size && NULL != exes[proct->app_idx]) {
+            if (0 == appmap[proct->app_idx]) {
+                exelist[nexes++] = exes[proct->app_idx];
+                appmap[proct->app_idx] = nexes;
+            }
+            exeidx[nprocs] = appmap[proct->app_idx] - 1;
+        }
+        pids[nprocs] = proct->pid;
+        states[nprocs] = prte_pmix_convert_state(proct->state);
+        codes[nprocs] = proct->exit_code;
+        ++nprocs;
+    }
+
+    PMIX_INFO_LIST_START(ilist);
+    rc = add_array(ilist, PRTE_PROC_TABLE_HOSTS, hosts, nhosts, PMIX_STRING);
+    if (PMIX_SUCCESS == rc) {
+        rc = add_array(ilist, PRTE_PROC_TABLE_EXES, exelist, nexes, PMIX_STRING);
+    }
+    if (PMIX_SUCCESS == rc) {
+        rc = add_array(ilist, PRTE_PROC_TABLE_RANKS, ranks, nprocs, PMIX_PROC_RANK);
+    }
+    if (PMIX_SUCCESS == rc) {
+        rc = add_array(ilist, PRTE_PROC_TABLE_HOST_INDEX, hostidx, nprocs, PMIX_UINT32);
+    }
+    if (PMIX_SUCCESS == rc) {
+        rc = add_array(ilist, PRTE_PROC_TABLE_EXE_INDEX, exeidx, nprocs, PMIX_UINT32);
+    }
+    if (PMIX_SUCCESS == rc) {
+        rc = add_array(ilist, PRTE_PROC_TABLE_PIDS, pids, nprocs, PMIX_PID);
+    }
+    if (PMIX_SUCCESS == rc) {
+        rc = add_array(ilist, PRTE_PROC_TABLE_STATES, states, nprocs, PMIX_PROC_STATE);
+    }
+    if (PMIX_SUCCESS == rc) {
+        rc = add_array(ilist, PRTE_PROC_TABLE_EXIT_CODES, codes, nprocs, PMIX_INT32);
+    }
+    if (PMIX_SUCCESS == rc) {
+        PMIX_INFO_LIST_CONVERT(rc, ilist, &dry);
+        if (PMIX_SUCCESS == rc) {
+            PMIX_INFO_LIST_ADD(rc, results, PRTE_QUERY_PROC_TABLE_COMPACT, &dry, PMIX_DATA_ARRAY);
+            PMIX_DATA_ARRAY_DESTRUCT(&dry);
+        }
+    }
+    PMIX_INFO_LIST_RELEASE(ilist);
+
+    /* the strings belong to the nodes and the exe cache */
+    free(ranks);
+    free(hostidx);
+    free(exeidx);
+    free(pids);
+    free(states);
+    free(codes);
+    free(nodemap);
+    free(appmap);
+    free(hosts);
+    free(exelist);
+    return rc;
+}
+
+/* return the proc table for the given range of ranks. Paged requests
+ * are limited to proc_table_page_max procs and also report the rank
+ * at which the next page begins, so tools can walk the table of a
+ * very large job without the server ever holding all of it at once */
+static pmix_status_t proc_table(prte_job_t *jdata, bool local, bool compact,
+                                uint32_t start, uint32_t count, bool paged,
+                                void *results, const char *key)
+{
+    prte_proc_t *proct;
+    pmix_proc_info_t *procinfo;
+    pmix_data_array_t dry;
+    pmix_status_t rc;
+    pmix_rank_t r, end;
+    char **exes;
+    size_t max, p;
+    int i;
+
+    end = jdata->procs->size;
+    if (start > end) {
+        start = end;
+    }
+    if (paged) {
+        if (0 == count ||
+            (0 < prte_pmix_server_globals.proc_table_page_max &&
+             count > (uint32_t) prte_pmix_server_globals.proc_table_page_max)) {
+            count = prte_pmix_server_globals.proc_table_page_max;
+        }
+        /* compare against what is left rather than computing
+         * start + count, which a tool can make wrap */
+        if (0 < count && count < end - start) {
+            end = start + count;
+        }
+    }
+
+    exes = exe_cache(jdata);
+
+    if (compact) {
+        rc = compact_table(jdata, start, end, exes, results);
+    } else {
+        max = local ? jdata->num_local_procs : jdata->num_procs;
+        if (end - start < max) {
+            max = end - start;
+        }
+        PMIX_DATA_ARRAY_CONSTRUCT(&dry, max, PMIX_PROC_INFO);
+        procinfo = (pmix_proc_info_t *) dry.array;
+        p = 0;
+        for (r = start; r < end && p < max; r++) {
+            proct = (prte_proc_t *) pmix_pointer_array_get_item(jdata->procs, r);
+            if (NULL == proct) {
+                continue;
+            }
+            if (local && !PRTE_FLAG_TEST(proct, PRTE_PROC_FLAG_LOCAL)) {
+                continue;
+            }
+            PMIX_LOAD_PROCID(&procinfo[p].proc, proct->name.nspace, proct->name.rank);
+            if (NULL != proct->node && NULL != proct->node->name) {
+                procinfo[p].hostname = strdup(proct->node->name);
+            }
+            if (proct->app_idx < jdata->apps->size && NULL != exes[proct->app_idx]) {
+                procinfo[p].executable_name = strdup(exes[proct->app_idx]);
+            }
+            procinfo[p].pid = proct->pid;
+            procinfo[p].exit_code = proct->exit_code;
+            procinfo[p].state = prte_pmix_convert_state(proct->state);
+            ++p;
+        }
+        /* the unused entries own nothing */
+        dry.size = p;
+        PMIX_INFO_LIST_ADD(rc, results, key, &dry, PMIX_DATA_ARRAY);
+        PMIX_DATA_ARRAY_DESTRUCT(&dry);
+    }
+
+    for (i = 0; i < jdata->apps->size; i++) {
+        if (NULL != exes[i]) {
+            free(exes[i]);
+        }
+    }
+    free(exes);
+
+    if (PMIX_SUCCESS == rc && paged) {
+        PMIX_INFO_LIST_ADD(rc, results, PRTE_QUERY_PROC_TABLE_NEXT, &end, PMIX_UINT32);
+    }
+    return rc;
+}
+
+#if defined(PMIX_QUERY_PROC_RESOURCE_USAGE) || defined(PMIX_QUERY_NODE_RESOURCE_USAGE)
+/* resource usage summaries collected across the DVM, one
+ * slot for each query in the request */
+typedef struct prte_rusage_query_s prte_rusage_query_t;
+typedef struct {
+    prte_rusage_query_t *rq;
+    bool collected;
+    prte_rusage_summary_t procs;
+    prte_rusage_summary_t nodes;
+} prte_rusage_slot_t;
+
+struct prte_rusage_query_s {
+    prte_pmix_server_op_caddy_t *cd;
+    size_t npending;
+    prte_rusage_slot_t *slots;
+};
+
+static void _query(int sd, short args, void *cbdata);
+
+static bool rusage_wanted(pmix_query_t *q, pmix_nspace_t scope, bool *local)
+{
+    bool wanted = false;
+    size_t n;
+
+    for (n = 0; NULL != q->keys[n]; n++) {
+#ifdef PMIX_QUERY_PROC_RESOURCE_USAGE
+        if (PMIx_Check_key(q->keys[n], PMIX_QUERY_PROC_RESOURCE_USAGE)) {
+            wanted = true;
+        }
+#endif
+#ifdef PMIX_QUERY_NODE_RESOURCE_USAGE
+        if (PMIx_Check_key(q->keys[n], PMIX_QUERY_NODE_RESOURCE_USAGE)) {
+            wanted = true;
+        }
+#endif
+    }
+    if (!wanted) {
+        return false;
+    }
+    *local = false;
+    for (n = 0; NULL != q->qualifiers && n < q->nqual; n++) {
+        if (PMIX_CHECK_KEY(&q->qualifiers[n], PMIX_NSPACE)) {
+            PMIX_LOAD_NSPACE(scope, q->qualifiers[n].value.data.string);
+        } else if (PMIX_CHECK_KEY(&q->qualifiers[n], PMIX_QUERY_LOCAL_ONLY)) {
+            *local = PMIX_INFO_TRUE(&q->qualifiers[n]);
+        }
+    }
+    return true;
+}
+
+static void rusage_cbfunc(pmix_status_t status,
+                          prte_rusage_summary_t *procs,
+                          prte_rusage_summary_t *nodes,
+                          void *cbdata)
+{
+    prte_rusage_slot_t *slot = (prte_rusage_slot_t *) cbdata;
+    prte_rusage_query_t *rq = slot->rq;
+
+    if (PMIX_SUCCESS == status) {
+        slot->procs = *procs;
+        slot->nodes = *nodes;
+        slot->collected = true;
+    }
+    --rq->npending;
+    if (0 == rq->npending) {
+        /* everything is in - process the query */
+        prte_event_set(prte_event_base, &(rq->cd->ev), -1, PRTE_EV_WRITE, _query, rq->cd);
+        PMIX_POST_OBJECT(rq->cd);
+        prte_event_active(&(rq->cd->ev), PRTE_EV_WRITE, 1);
+    }
+}
+
+/* start a DVM-wide collective for each query that asks for resource
+ * usage without restricting itself to local data. Returns true if
+ * the query has to wait for them to complete */
+static bool rusage_start(prte_pmix_server_op_caddy_t *cd)
+{
+    prte_rusage_query_t *rq = NULL;
+    pmix_nspace_t scope;
+    bool local;
+    size_t m;
+    int rc;
+
+    for (m = 0; m < cd->nqueries; m++) {
+        PMIX_LOAD_NSPACE(scope, cd->proct.nspace);
+        if (!rusage_wanted(&cd->queries[m], scope, &local)) {
+            continue;
+        }
+        if (NULL == rq) {
+            rq = (prte_rusage_query_t *) calloc(1, sizeof(prte_rusage_query_t));
+            rq->cd = cd;
+            rq->slots = (prte_rusage_slot_t *) calloc(cd->nqueries, sizeof(prte_rusage_slot_t));
+            cd->server_object = rq;
+        }
+        if (local) {
+            continue;
+        }
+        rq->slots[m].rq = rq;
+        rq->npending++;
+        rc = pmix_server_rusage_collect(scope, rusage_cbfunc, &rq->slots[m]);
+        if (PRTE_SUCCESS != rc) {
+            /* fall back to our local data */
+            rq->npending--;
+        }
+    }
+    return (NULL != rq && 0 < rq->npending);
+}
+
+static void rusage_result(prte_pmix_server_op_caddy_t *cd, size_t m, pmix_nspace_t jobid,
+                          void *results, const char *key, bool node)
+{
+    prte_rusage_query_t *rq = (prte_rusage_query_t *) cd->server_object;
+    prte_rusage_summary_t procs, nodes;
+
+    if (NULL != rq && rq->slots[m].collected) {
+        procs = rq->slots[m].procs;
+        nodes = rq->slots[m].nodes;
+    } else {
+        pmix_server_rusage_local(jobid, &procs, &nodes);
+    }
+    pmix_server_rusage_load(results, key, node ? &nodes : &procs, node);
+}
+#endif
+
 static void _query(int sd, short args, void *cbdata)
 {
     prte_pmix_server_op_caddy_t *cd = (prte_pmix_server_op_caddy_t *) cbdata;
@@ -79,15 +430,16 @@ static void _query(int sd, short args, void *cbdata)
     prte_job_t *jdata;
     prte_node_t *node, *ndptr;
     int j, k, rc;
-    size_t m, n, p;
+    size_t m, n;
     uint32_t key, nodeid, sessionid = UINT32_MAX;
+    uint32_t pstart, pcount;
+    bool paged;
     char **nspaces, *hostname, *uri;
     char *cmdline;
     char **ans, *tmp;
     char *psetname;
     prte_app_context_t *app;
     int matched;
-    pmix_proc_info_t *procinfo;
     pmix_data_array_t dry;
     prte_proc_t *proct;
     pmix_proc_t *proc;
@@ -96,6 +448,14 @@ static void _query(int sd, short args, void *cbdata)
 
     PMIX_ACQUIRE_OBJECT(cd);
 
+#if defined(PMIX_QUERY_PROC_RESOURCE_USAGE) || defined(PMIX_QUERY_NODE_RESOURCE_USAGE)
+    /* resource usage has to be collected from across the DVM
+     * first - we will be called again once it is in */
+    if (NULL == cd->server_object && rusage_start(cd)) {
+        return;
+    }
+#endif
+
     pmix_output_verbose(2, prte_pmix_server_globals.output,
                         "%s processing query",
                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME));
@@ -108,6 +468,9 @@ static void _query(int sd, short args, void *cbdata)
         hostname = NULL;
         nodeid = UINT32_MAX;
         psetname = NULL;
+        pstart = 0;
+        pcount = 0;
+        paged = false;
         /* default to the requestor's jobid */
         PMIX_LOAD_NSPACE(jobid, cd->proct.nspace);
         /* see if they provided any qualifiers */
@@ -199,6 +562,14 @@ static void _query(int sd, short args, void *cbdata)
                 } else if (PMIX_CHECK_KEY(&q->qualifiers[n], PMIX_SESSION_ID)) {
                     PMIX_VALUE_GET_NUMBER(rc, &q->qualifiers[n].value, sessionid, uint32_t);
 
+                } else if (PMIX_CHECK_KEY(&q->qualifiers[n], PRTE_QUERY_PROC_TABLE_START)) {
+                    PMIX_VALUE_GET_NUMBER(rc, &q->qualifiers[n].value, pstart, uint32_t);
+                    paged = true;
+
+                } else if (PMIX_CHECK_KEY(&q->qualifiers[n], PRTE_QUERY_PROC_TABLE_COUNT)) {
+                    PMIX_VALUE_GET_NUMBER(rc, &q->qualifiers[n].value, pcount, uint32_t);
+                    paged = true;
+
                 }
 
             }
@@ -495,35 +866,8 @@ static void _query(int sd, short args, void *cbdata)
                     ret = PMIX_ERR_NOT_FOUND;
                     goto done;
                 }
-                /* cycle thru the job and create an entry for each proc */
-                PMIX_DATA_ARRAY_CONSTRUCT(&dry, jdata->num_procs, PMIX_PROC_INFO);
-                procinfo = (pmix_proc_info_t*)dry.array;
-                p = 0;
-                for (k = 0; k < jdata->procs->size; k++) {
-                    proct = (prte_proc_t *) pmix_pointer_array_get_item(jdata->procs, k);
-                    if (NULL == proct) {
-                        continue;
-                    }
-                    PMIX_LOAD_PROCID(&procinfo[p].proc, proct->name.nspace, proct->name.rank);
-                    if (NULL != proct->node && NULL != proct->node->name) {
-                        procinfo[p].hostname = strdup(proct->node->name);
-                    }
-                    app = (prte_app_context_t *) pmix_pointer_array_get_item(jdata->apps,
-                                                                             proct->app_idx);
-                    if (NULL != app && NULL != app->app) {
-                        if (pmix_path_is_absolute(app->app)) {
-                            procinfo[p].executable_name = strdup(app->app);
-                        } else {
-                            procinfo[p].executable_name = pmix_os_path(false, app->cwd, app->app, NULL);
-                        }
-                    }
-                    procinfo[p].pid = proct->pid;
-                    procinfo[p].exit_code = proct->exit_code;
-                    procinfo[p].state = prte_pmix_convert_state(proct->state);
-                    ++p;
-                }
-                PMIX_INFO_LIST_ADD(rc, results, PMIX_QUERY_PROC_TABLE, &dry, PMIX_DATA_ARRAY);
-                PMIX_DATA_ARRAY_DESTRUCT(&dry);
+                rc = proc_table(jdata, false, false, pstart, pcount, paged,
+                                results, PMIX_QUERY_PROC_TABLE);
                 if (PMIX_SUCCESS != rc) {
                     PMIX_ERROR_LOG(rc);
                     goto done;
@@ -542,37 +886,21 @@ static void _query(int sd, short args, void *cbdata)
                     ret = PMIX_ERR_NOT_FOUND;
                     goto done;
                 }
-                /* cycle thru the job and create an entry for each proc */
-                PMIX_DATA_ARRAY_CONSTRUCT(&dry, jdata->num_local_procs, PMIX_PROC_INFO);
-                procinfo = (pmix_proc_info_t *) dry.array;
-                p = 0;
-                for (k = 0; k < jdata->procs->size; k++) {
-                    proct = (prte_proc_t *) pmix_pointer_array_get_item(jdata->procs, k);
-                    if (NULL == proct) {
-                        continue;
-                    }
-                    if (PRTE_FLAG_TEST(proct, PRTE_PROC_FLAG_LOCAL)) {
-                        PMIX_LOAD_PROCID(&procinfo[p].proc, proct->name.nspace, proct->name.rank);
-                        if (NULL != proct->node && NULL != proct->node->name) {
-                            procinfo[p].hostname = strdup(proct->node->name);
-                        }
-                        app = (prte_app_context_t *) pmix_pointer_array_get_item(jdata->apps,
-                                                                                 proct->app_idx);
-                        if (NULL != app && NULL != app->app) {
-                            if (pmix_path_is_absolute(app->app)) {
-                                procinfo[p].executable_name = strdup(app->app);
-                            } else {
-                                procinfo[p].executable_name = pmix_os_path(false, app->cwd, app->app, NULL);
-                            }
-                        }
-                        procinfo[p].pid = proct->pid;
-                        procinfo[p].exit_code = proct->exit_code;
-                        procinfo[p].state = prte_pmix_convert_state(proct->state);
-                        ++p;
-                    }
+                rc = proc_table(jdata, true, false, pstart, pcount, paged,
+                                results, PMIX_QUERY_LOCAL_PROC_TABLE);
+                if (PMIX_SUCCESS != rc) {
+                    PMIX_ERROR_LOG(rc);
+                    goto done;
                 }
-                PMIX_INFO_LIST_ADD(rc, results, PMIX_QUERY_LOCAL_PROC_TABLE, &dry, PMIX_DATA_ARRAY);
-                PMIX_DATA_ARRAY_DESTRUCT(&dry);
+
+            } else if (PMIx_Check_key(q->keys[n], PRTE_QUERY_PROC_TABLE_COMPACT)) {
+                jdata = prte_get_job_data_object(jobid);
+                if (NULL == jdata || 0 == jdata->num_procs) {
+                    ret = PMIX_ERR_NOT_FOUND;
+                    goto done;
+                }
+                rc = proc_table(jdata, false, true, pstart, pcount, paged,
+                                results, PRTE_QUERY_PROC_TABLE_COMPACT);
                 if (PMIX_SUCCESS != rc) {
                     PMIX_ERROR_LOG(rc);
                     goto done;
@@ -956,12 +1284,12 @@ static void _query(int sd, short args, void *cbdata)
 
 #ifdef PMIX_QUERY_PROC_RESOURCE_USAGE
             } else if (PMIx_Check_key(q->keys[n], PMIX_QUERY_PROC_RESOURCE_USAGE)) {
-
+                rusage_result(cd, m, jobid, results, PMIX_QUERY_PROC_RESOURCE_USAGE, false);
 #endif
 
 #ifdef PMIX_QUERY_NODE_RESOURCE_USAGE
             } else if (PMIx_Check_key(q->keys[n], PMIX_QUERY_NODE_RESOURCE_USAGE)) {
-
+                rusage_result(cd, m, jobid, results, PMIX_QUERY_NODE_RESOURCE_USAGE, true);
 #endif
 
             } else {
@@ -1002,6 +1330,12 @@ done:
     rcd->info = (pmix_info_t*)dry.array;
     // memory allocated in the data array will be free'd when rcd is released
     cd->infocbfunc(ret, rcd->info, rcd->ninfo, cd->cbdata, qrel, rcd);
+#if defined(PMIX_QUERY_PROC_RESOURCE_USAGE) || defined(PMIX_QUERY_NODE_RESOURCE_USAGE)
+    if (NULL != cd->server_object) {
+        free(((prte_rusage_query_t *) cd->server_object)->slots);
+        free(cd->server_object);
+    }
+#endif
     PMIX_RELEASE(cd);
 }
 
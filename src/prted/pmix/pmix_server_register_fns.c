@@ -61,6 +61,143 @@
 
 static void opcbfunc(pmix_status_t status, void *cbdata);
 
+/* the locality string depends only on the cpuset and our own
+ * topology, so procs with identical bindings share a result */
+static pmix_status_t locality_string(pmix_cpuset_t *cpuset, const char *cpustr, char **locstr)
+{
+    char *cached = NULL;
+    size_t len;
+    pmix_status_t ret;
+
+    len = strlen(cpustr);
+    if (PMIX_SUCCESS == pmix_hash_table_get_value_ptr(&prte_pmix_server_globals.locality_cache,
+                                                      cpustr, len, (void **) &cached)) {
+        *locstr = strdup(cached);
+        return PMIX_SUCCESS;
+    }
+    ret = PMIx_server_generate_locality_string(cpuset, &cached);
+    if (PMIX_SUCCESS != ret) {
+        return ret;
+    }
+    pmix_hash_table_set_value_ptr(&prte_pmix_server_globals.locality_cache, cpustr, len, cached);
+    *locstr = strdup(cached);
+    return PMIX_SUCCESS;
+}
+
+/* add the cpuset, locality string and device distances of a proc */
+static pmix_status_t add_locality(prte_node_t *node, prte_proc_t *pptr,
+                                  void *pmap, pmix_info_t *devinfo)
+{
+    pmix_status_t ret;
+    pmix_cpuset_t cpuset;
+    pmix_topology_t topo;
+    pmix_device_distance_t *distances;
+    size_t ndist;
+    pmix_data_array_t darray;
+    char *tmp;
+
+    topo.source = "hwloc";
+    if (NULL != pptr->cpuset) {
+        /* provide the cpuset string for this proc */
+        PMIX_INFO_LIST_ADD(ret, pmap, PMIX_CPUSET, pptr->cpuset, PMIX_STRING);
+        /* let PMIx generate the locality string */
+        PMIX_CPUSET_CONSTRUCT(&cpuset);
+        cpuset.source = "hwloc";
+        cpuset.bitmap = hwloc_bitmap_alloc();
+        hwloc_bitmap_list_sscanf(cpuset.bitmap, pptr->cpuset);
+        ret = locality_string(&cpuset, pptr->cpuset, &tmp);
+        if (PMIX_SUCCESS != ret) {
+            PMIX_ERROR_LOG(ret);
+            hwloc_bitmap_free(cpuset.bitmap);
+            return ret;
+        }
+        PMIX_INFO_LIST_ADD(ret, pmap, PMIX_LOCALITY_STRING, tmp, PMIX_STRING);
+        free(tmp);
+        if (0 != prte_pmix_server_globals.generate_dist) {
+            /* compute the device distances for this proc */
+            topo.topology = node->topology->topo;
+            devinfo[1].value.data.string = node->name;
+            ret = PMIx_Compute_distances(&topo, &cpuset,
+                                         devinfo, 2, &distances, &ndist);
+            devinfo[1].value.data.string = NULL;
+            if (PMIX_SUCCESS == ret) {
+                if (4 < pmix_output_get_verbosity(prte_pmix_server_globals.output)) {
+                    size_t f;
+                    for (f=0; f < ndist; f++) {
+                        pmix_output(0, "UUID: %s OSNAME: %s TYPE: %s MIND: %u MAXD: %u",
+                                    distances[f].uuid, distances[f].osname,
+                                    PMIx_Device_type_string(distances[f].type),
+                                    distances[f].mindist, distances[f].maxdist);
+                    }
+                }
+                darray.type = PMIX_DEVICE_DIST;
+                darray.array = distances;
+                darray.size = ndist;
+                PMIX_INFO_LIST_ADD(ret, pmap, PMIX_DEVICE_DISTANCES, &darray, PMIX_DATA_ARRAY);
+                PMIX_DEVICE_DIST_FREE(distances, ndist);
+            }
+        }
+        hwloc_bitmap_free(cpuset.bitmap);
+    } else {
+        /* the proc is not bound */
+        PMIX_INFO_LIST_ADD(ret, pmap, PMIX_LOCALITY_STRING, NULL, PMIX_STRING);
+    }
+    return PMIX_SUCCESS;
+}
+
+/* provide the locality of a proc that was not included when
+ * its nspace was registered */
+int prte_pmix_server_register_locality(prte_proc_t *pptr)
+{
+    void *pmap;
+    pmix_info_t devinfo[2], *iptr;
+    pmix_data_array_t darray;
+    pmix_status_t ret;
+    size_t n;
+
+    if (PRTE_FLAG_TEST(pptr, PRTE_PROC_FLAG_LOCALITY_REGD)) {
+        return PRTE_SUCCESS;
+    }
+    pmix_output_verbose(2, prte_pmix_server_globals.output,
+                        "%s register locality for %s",
+                        PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_NAME_PRINT(&pptr->name));
+
+    if (0 != prte_pmix_server_globals.generate_dist) {
+        PMIX_INFO_LOAD(&devinfo[0], PMIX_DEVICE_TYPE, &prte_pmix_server_globals.generate_dist, PMIX_DEVTYPE);
+        PMIX_INFO_LOAD(&devinfo[1], PMIX_HOSTNAME, NULL, PMIX_STRING);
+    }
+    PMIX_INFO_LIST_START(pmap);
+    ret = add_locality(pptr->node, pptr, pmap, devinfo);
+    if (0 != prte_pmix_server_globals.generate_dist) {
+        PMIX_INFO_DESTRUCT(&devinfo[0]);
+        PMIX_INFO_DESTRUCT(&devinfo[1]);
+    }
+    if (PMIX_SUCCESS != ret) {
+        PMIX_INFO_LIST_RELEASE(pmap);
+        return prte_pmix_convert_status(ret);
+    }
+    PMIX_INFO_LIST_CONVERT(ret, pmap, &darray);
+    PMIX_INFO_LIST_RELEASE(pmap);
+    if (PMIX_SUCCESS != ret) {
+        PMIX_ERROR_LOG(ret);
+        return prte_pmix_convert_status(ret);
+    }
+
+    /* store it against the proc in our PMIx server */
+    iptr = (pmix_info_t *) darray.array;
+    for (n = 0; n < darray.size; n++) {
+        ret = PMIx_Store_internal(&pptr->name, iptr[n].key, &iptr[n].value);
+        if (PMIX_SUCCESS != ret) {
+            PMIX_ERROR_LOG(ret);
+            PMIX_DATA_ARRAY_DESTRUCT(&darray);
+            return prte_pmix_convert_status(ret);
+        }
+    }
+    PMIX_DATA_ARRAY_DESTRUCT(&darray);
+    PRTE_FLAG_SET(pptr, PRTE_PROC_FLAG_LOCALITY_REGD);
+    return PRTE_SUCCESS;
+}
+
 /* stuff proc attributes for sending back to a proc */
 int prte_pmix_server_register_nspace(prte_job_t *jdata)
 {
@@ -87,12 +224,8 @@ int prte_pmix_server_register_nspace(prte_job_t *jdata)
     prte_namelist_t *nm;
     size_t nmsize;
     prte_pmix_server_pset_t *pset;
-    pmix_cpuset_t cpuset;
     uint32_t ui32, *ui32_ptr;
     prte_job_t *parent = NULL;
-    pmix_device_distance_t *distances;
-    size_t ndist;
-    pmix_topology_t topo;
     pmix_data_array_t darray, lparray;
     bool flag, *fptr;
 
@@ -104,7 +237,6 @@ int prte_pmix_server_register_nspace(prte_job_t *jdata)
     PMIX_INFO_LIST_START(info);
     uid = geteuid();
     gid = getegid();
-    topo.source = "hwloc";
 
     /* pass the session ID */
     ui32_ptr = &ui32;
@@ -478,53 +610,17 @@ int prte_pmix_server_register_nspace(prte_job_t *jdata)
             /* must start with rank */
             PMIX_INFO_LIST_ADD(ret, pmap, PMIX_RANK, &pptr->name.rank, PMIX_PROC_RANK);
 
-            /* location, for local procs */
-            if (NULL != pptr->cpuset) {
-                /* provide the cpuset string for this proc */
-                PMIX_INFO_LIST_ADD(ret, pmap, PMIX_CPUSET, pptr->cpuset, PMIX_STRING);
-                /* let PMIx generate the locality string */
-                PMIX_CPUSET_CONSTRUCT(&cpuset);
-                cpuset.source = "hwloc";
-                cpuset.bitmap = hwloc_bitmap_alloc();
-                hwloc_bitmap_list_sscanf(cpuset.bitmap, pptr->cpuset);
-                ret = PMIx_server_generate_locality_string(&cpuset, &tmp);
+            /* location - when registering lazily, remote procs get
+             * this on first request */
+            if (!prte_pmix_server_globals.lazy_registration ||
+                PRTE_PROC_MY_NAME->rank == node->daemon->name.rank) {
+                ret = add_locality(node, pptr, pmap, devinfo);
                 if (PMIX_SUCCESS != ret) {
-                    PMIX_ERROR_LOG(ret);
-                    hwloc_bitmap_free(cpuset.bitmap);
                     PMIX_INFO_LIST_RELEASE(info);
                     PMIX_INFO_LIST_RELEASE(pmap);
                     return prte_pmix_convert_status(ret);
                 }
-                PMIX_INFO_LIST_ADD(ret, pmap, PMIX_LOCALITY_STRING, tmp, PMIX_STRING);
-                free(tmp);
-                if (0 != prte_pmix_server_globals.generate_dist) {
-                    /* compute the device distances for this proc */
-                    topo.topology = node->topology->topo;
-                    devinfo[1].value.data.string = node->name;
-                    ret = PMIx_Compute_distances(&topo, &cpuset,
-                                                 devinfo, 2, &distances, &ndist);
-                    devinfo[1].value.data.string = NULL;
-                    if (PMIX_SUCCESS == ret) {
-                        if (4 < pmix_output_get_verbosity(prte_pmix_server_globals.output)) {
-                            size_t f;
-                            for (f=0; f < ndist; f++) {
-                                pmix_output(0, "UUID: %s OSNAME: %s TYPE: %s MIND: %u MAXD: %u",
-                                            distances[f].uuid, distances[f].osname,
-                                            PMIx_Device_type_string(distances[f].type),
-                                            distances[f].mindist, distances[f].maxdist);
-                            }
-                        }
-                        darray.type = PMIX_DEVICE_DIST;
-                        darray.array = distances;
-                        darray.size = ndist;
-                        PMIX_INFO_LIST_ADD(ret, pmap, PMIX_DEVICE_DISTANCES, &darray, PMIX_DATA_ARRAY);
-                        PMIX_DEVICE_DIST_FREE(distances, ndist);
-                    }
-                }
-                hwloc_bitmap_free(cpuset.bitmap);
-            } else {
-                /* the proc is not bound */
-                PMIX_INFO_LIST_ADD(ret, pmap, PMIX_LOCALITY_STRING, NULL, PMIX_STRING);
+                PRTE_FLAG_SET(pptr, PRTE_PROC_FLAG_LOCALITY_REGD);
             }
             if (PRTE_PROC_MY_NAME->rank == node->daemon->name.rank) {
                 /* create and pass a proc-level session directory */
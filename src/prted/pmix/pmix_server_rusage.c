@@ -0,0 +1,953 @@
+/*
+ * Copyright (c) 2025      Nanook Consulting  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ * Resource usage summaries for proc and node resource-usage queries.
+ *
+ * Each daemon samples /proc for its local children - either
+ * periodically (prte_pmix_rusage_interval) into a fixed-size ring per
+ * child, or on demand when a query arrives. Queries that are not
+ * restricted to local information are answered collectively: the
+ * daemon hosting the requestor xcasts the request, every daemon
+ * combines its own summary with those of its routing children and
+ * passes the result to its parent, and the HNP returns the final
+ * summary to the requesting daemon. Only min/max/sum per metric
+ * travels up the tree, so message sizes are independent of the
+ * number of procs and nodes.
+ *
+ * Every request and every partial rollup is bounded by
+ * prte_pmix_rusage_timeout: a request that times out is answered
+ * with PMIX_ERR_TIMEOUT so the query falls back to local data, and
+ * a rollup that times out is dropped. A rollup stops waiting for a
+ * routing child as soon as the route to it is lost.
+ */
+
+#include "prte_config.h"
+
+#include <stdio.h>
+#include <string.h>
+#ifdef HAVE_UNISTD_H
+#    include <unistd.h>
+#endif
+
+#include "src/pmix/pmix-internal.h"
+#include "src/util/pmix_output.h"
+
+#include "src/mca/errmgr/errmgr.h"
+#include "src/mca/grpcomm/grpcomm.h"
+#include "src/rml/rml.h"
+#include "src/runtime/prte_globals.h"
+#include "src/util/name_fns.h"
+
+#include "src/prted/pmix/pmix_server_internal.h"
+
+/* raw per-proc sample - the values are indexed by the
+ * proc metrics, with PRTE_RUSAGE_CPU_PCT left unused */
+typedef struct {
+    double elapsed;  // seconds since the proc started
+    uint64_t value[PRTE_RUSAGE_CTXSW + 1];
+} prte_rusage_sample_t;
+
+typedef struct {
+    pmix_object_t super;
+    pmix_proc_t name;
+    uint64_t start;  // start time in clock ticks - detects pid reuse
+    unsigned generation;
+    int head;
+    int nsamples;
+    prte_rusage_sample_t *ring;
+} prte_rusage_ring_t;
+static void rgcon(prte_rusage_ring_t *p)
+{
+    p->start = 0;
+    p->generation = 0;
+    p->head = 0;
+    p->nsamples = 0;
+    p->ring = NULL;
+}
+static void rgdes(prte_rusage_ring_t *p)
+{
+    if (NULL != p->ring) {
+        free(p->ring);
+    }
+}
+static PMIX_CLASS_INSTANCE(prte_rusage_ring_t,
+                           pmix_object_t,
+                           rgcon, rgdes);
+
+/* a collective in progress on this daemon */
+typedef struct {
+    pmix_object_t super;
+    prte_event_t ev;
+    uint64_t key;
+    pmix_rank_t origin;
+    int index;
+    pmix_nspace_t scope;
+    pmix_rank_t *waiting;  // routing children that have yet to report
+    int nwaiting;
+    bool local_done;
+    prte_rusage_summary_t procs;
+    prte_rusage_summary_t nodes;
+} prte_rusage_tracker_t;
+static void tcon(prte_rusage_tracker_t *p)
+{
+    p->waiting = NULL;
+    p->nwaiting = 0;
+    p->local_done = false;
+    prte_rusage_summary_init(&p->procs);
+    prte_rusage_summary_init(&p->nodes);
+}
+static void tdes(prte_rusage_tracker_t *p)
+{
+    if (NULL != p->waiting) {
+        free(p->waiting);
+    }
+}
+static PMIX_CLASS_INSTANCE(prte_rusage_tracker_t,
+                           pmix_object_t,
+                           tcon, tdes);
+
+/* a collective requested by one of our local clients */
+typedef struct {
+    pmix_object_t super;
+    prte_event_t ev;
+    int index;
+    prte_rusage_cbfunc_t cbfunc;
+    void *cbdata;
+} prte_rusage_req_t;
+static PMIX_CLASS_INSTANCE(prte_rusage_req_t,
+                           pmix_object_t,
+                           NULL, NULL);
+
+static const char *metric_names[PRTE_RUSAGE_MAX] = {
+    "cpu", "cpu_pct", "rss", "read_bytes", "write_bytes",
+    "ctxsw", "nprocs", "load", "mem_avail"
+};
+
+static pmix_hash_table_t rings;
+static pmix_hash_table_t trackers;
+static pmix_hash_table_t requests;
+static int next_request = 0;
+static prte_event_t sample_ev;
+static bool sample_active = false;
+static bool initialized = false;
+static unsigned generation = 0;
+static long ticks_per_sec = 100;
+static long page_size = 4096;
+
+void prte_rusage_summary_init(prte_rusage_summary_t *s)
+{
+    int n;
+
+    s->count = 0;
+    for (n = 0; n < PRTE_RUSAGE_MAX; n++) {
+        s->min[n] = UINT64_MAX;
+        s->max[n] = 0;
+        s->sum[n] = 0;
+    }
+}
+
+static void summary_add(prte_rusage_summary_t *s, const uint64_t *values)
+{
+    int n;
+
+    s->count++;
+    for (n = 0; n < PRTE_RUSAGE_MAX; n++) {
+        if (values[n] < s->min[n]) {
+            s->min[n] = values[n];
+        }
+        if (values[n] > s->max[n]) {
+            s->max[n] = values[n];
+        }
+        s->sum[n] += values[n];
+    }
+}
+
+static void summary_merge(prte_rusage_summary_t *s, const prte_rusage_summary_t *src)
+{
+    int n;
+
+    if (0 == src->count) {
+        return;
+    }
+    s->count += src->count;
+    for (n = 0; n < PRTE_RUSAGE_MAX; n++) {
+        if (src->min[n] < s->min[n]) {
+            s->min[n] = src->min[n];
+        }
+        if (src->max[n] > s->max[n]) {
+            s->max[n] = src->max[n];
+        }
+        s->sum[n] += src->sum[n];
+    }
+}
+
+static pmix_status_t summary_pack(pmix_data_buffer_t *buf, prte_rusage_summary_t *s)
+{
+    pmix_status_t rc;
+
+    rc = PMIx_Data_pack(NULL, buf, &s->count, 1, PMIX_UINT64);
+    if (PMIX_SUCCESS != rc) {
+        return rc;
+    }
+    /* nothing else is meaningful for an empty summary */
+    if (0 == s->count) {
+        return PMIX_SUCCESS;
+    }
+    rc = PMIx_Data_pack(NULL, buf, s->min, PRTE_RUSAGE_MAX, PMIX_UINT64);
+    if (PMIX_SUCCESS != rc) {
+        return rc;
+    }
+    rc = PMIx_Data_pack(NULL, buf, s->max, PRTE_RUSAGE_MAX, PMIX_UINT64);
+    if (PMIX_SUCCESS != rc) {
+        return rc;
+    }
+    return PMIx_Data_pack(NULL, buf, s->sum, PRTE_RUSAGE_MAX, PMIX_UINT64);
+}
+
+static pmix_status_t summary_unpack(pmix_data_buffer_t *buf, prte_rusage_summary_t *s)
+{
+    pmix_status_t rc;
+    int32_t cnt;
+
+    prte_rusage_summary_init(s);
+    cnt = 1;
+    rc = PMIx_Data_unpack(NULL, buf, &s->count, &cnt, PMIX_UINT64);
+    if (PMIX_SUCCESS != rc || 0 == s->count) {
+        return rc;
+    }
+    cnt = PRTE_RUSAGE_MAX;
+    rc = PMIx_Data_unpack(NULL, buf, s->min, &cnt, PMIX_UINT64);
+    if (PMIX_SUCCESS != rc) {
+        return rc;
+    }
+    cnt = PRTE_RUSAGE_MAX;
+    rc = PMIx_Data_unpack(NULL, buf, s->max, &cnt, PMIX_UINT64);
+    if (PMIX_SUCCESS != rc) {
+        return rc;
+    }
+    cnt = PRTE_RUSAGE_MAX;
+    return PMIx_Data_unpack(NULL, buf, s->sum, &cnt, PMIX_UINT64);
+}
+
+/* read a "key: value" line from a /proc file */
+static bool read_field(const char *path, const char *key, uint64_t *value)
+{
+    FILE *fp;
+    char line[256];
+    size_t len = strlen(key);
+    bool found = false;
+
+    if (NULL == (fp = fopen(path, "r"))) {
+        return false;
+    }
+    while (NULL != fgets(line, sizeof(line), fp)) {
+        if (0 == strncmp(line, key, len) && ':' == line[len]) {
+            *value = strtoull(&line[len + 1], NULL, 10);
+            found = true;
+            break;
+        }
+    }
+    fclose(fp);
+    return found;
+}
+
+static bool read_uptime(double *uptime)
+{
+    FILE *fp;
+    bool ok;
+
+    if (NULL == (fp = fopen("/proc/uptime", "r"))) {
+        return false;
+    }
+    ok = (1 == fscanf(fp, "%lf", uptime));
+    fclose(fp);
+    return ok;
+}
+
+static bool read_proc(pid_t pid, double uptime, uint64_t *start, prte_rusage_sample_t *smp)
+{
+    FILE *fp;
+    char path[64], line[1024], *ptr;
+    unsigned long long utime, stime, starttime;
+    long rss;
+    uint64_t vol, nonvol;
+
+    memset(smp, 0, sizeof(*smp));
+
+    snprintf(path, sizeof(path), "/proc/%d/stat", (int) pid);
+    if (NULL == (fp = fopen(path, "r"))) {
+        return false;
+    }
+    ptr = fgets(line, sizeof(line), fp);
+    fclose(fp);
+    /* the command name can contain anything, so
+     * start parsing after its closing paren */
+    if (NULL == ptr || NULL == (ptr = strrchr(line, ')'))) {
+        return false;
+    }
+    /* fields 14/15 are utime/stime, 22 is the start time, 24 is the rss */
+    if (4 != sscanf(ptr + 2,
+                    "%*c %*d %*d %*d %*d %*d %*u %*u %*u %*u %*u %llu %llu "
+                    "%*d %*d %*d %*d %*d %*d %llu %*u %ld",
+                    &utime, &stime, &starttime, &rss)) {
+        return false;
+    }
+    *start = starttime;
+    smp->value[PRTE_RUSAGE_CPU] = (utime + stime) * 1000000ULL / ticks_per_sec;
+    smp->value[PRTE_RUSAGE_RSS] = (uint64_t) rss * page_size;
+    smp->elapsed = uptime - (double) starttime / ticks_per_sec;
+
+    /* the remaining metrics are best-effort - the io file
+     * in particular may not be readable */
+    snprintf(path, sizeof(path), "/proc/%d/io", (int) pid);
+    read_field(path, "read_bytes", &smp->value[PRTE_RUSAGE_READ]);
+    read_field(path, "write_bytes", &smp->value[PRTE_RUSAGE_WRITE]);
+    snprintf(path, sizeof(path), "/proc/%d/status", (int) pid);
+    vol = nonvol = 0;
+    read_field(path, "voluntary_ctxt_switches", &vol);
+    read_field(path, "nonvoluntary_ctxt_switches", &nonvol);
+    smp->value[PRTE_RUSAGE_CTXSW] = vol + nonvol;
+    return true;
+}
+
+/* take a sample of every live local child, dropping
+ * the rings of children that are gone */
+static void sample_all(void)
+{
+    prte_proc_t *child;
+    prte_rusage_ring_t *ring;
+    prte_rusage_sample_t smp;
+    uint64_t key, start, *stale = NULL;
+    size_t nstale = 0, n;
+    double uptime;
+    void *nptr;
+    int i, rc;
+
+    if (!read_uptime(&uptime)) {
+        return;
+    }
+    ++generation;
+
+    for (i = 0; i < prte_local_children->size; i++) {
+        child = (prte_proc_t *) pmix_pointer_array_get_item(prte_local_children, i);
+        if (NULL == child || 0 >= child->pid ||
+            !PRTE_FLAG_TEST(child, PRTE_PROC_FLAG_ALIVE)) {
+            continue;
+        }
+        if (!read_proc(child->pid, uptime, &start, &smp)) {
+            continue;
+        }
+        key = (uint64_t) child->pid;
+        ring = NULL;
+        pmix_hash_table_get_value_uint64(&rings, key, (void **) &ring);
+        if (NULL != ring && (ring->start != start || !PMIX_CHECK_PROCID(&ring->name, &child->name))) {
+            /* the pid was reused */
+            pmix_hash_table_remove_value_uint64(&rings, key);
+            PMIX_RELEASE(ring);
+            ring = NULL;
+        }
+        if (NULL == ring) {
+            ring = PMIX_NEW(prte_rusage_ring_t);
+            PMIX_XFER_PROCID(&ring->name, &child->name);
+            ring->start = start;
+            ring->ring = (prte_rusage_sample_t *) calloc(prte_pmix_server_globals.rusage_depth,
+                                                         sizeof(prte_rusage_sample_t));
+            pmix_hash_table_set_value_uint64(&rings, key, ring);
+        }
+        ring->ring[ring->head] = smp;
+        ring->head = (ring->head + 1) % prte_pmix_server_globals.rusage_depth;
+        if (ring->nsamples < prte_pmix_server_globals.rusage_depth) {
+            ring->nsamples++;
+        }
+        ring->generation = generation;
+    }
+
+    rc = pmix_hash_table_get_first_key_uint64(&rings, &key, (void **) &ring, &nptr);
+    while (PMIX_SUCCESS == rc) {
+        if (ring->generation != generation) {
+            stale = (uint64_t *) realloc(stale, (nstale + 1) * sizeof(uint64_t));
+            stale[nstale++] = key;
+        }
+        rc = pmix_hash_table_get_next_key_uint64(&rings, &key, (void **) &ring, nptr, &nptr);
+    }
+    for (n = 0; n < nstale; n++) {
+        ring = NULL;
+        pmix_hash_table_get_value_uint64(&rings, stale[n], (void **) &ring);
+        pmix_hash_table_remove_value_uint64(&rings, stale[n]);
+        if (NULL != ring) {
+            PMIX_RELEASE(ring);
+        }
+    }
+    if (NULL != stale) {
+        free(stale);
+    }
+}
+
+static void sample_tick(int sd, short args, void *cbdata)
+{
+    struct timeval tv;
+    PRTE_HIDE_UNUSED_PARAMS(sd, args, cbdata);
+
+    sample_all();
+
+    tv.tv_sec = prte_pmix_server_globals.rusage_interval;
+    tv.tv_usec = 0;
+    prte_event_evtimer_add(&sample_ev, &tv);
+}
+
+static void node_values(uint64_t *values)
+{
+    FILE *fp;
+    double load;
+    uint64_t memavail;
+
+    if (NULL != (fp = fopen("/proc/loadavg", "r"))) {
+        if (1 == fscanf(fp, "%lf", &load)) {
+            values[PRTE_RUSAGE_LOAD] = (uint64_t) (load * 100.0);
+        }
+        fclose(fp);
+    }
+    if (read_field("/proc/meminfo", "MemAvailable", &memavail)) {
+        /* reported in kB */
+        values[PRTE_RUSAGE_MEMAVAIL] = memavail * 1024;
+    }
+}
+
+void pmix_server_rusage_local(const pmix_nspace_t scope,
+                              prte_rusage_summary_t *procs,
+                              prte_rusage_summary_t *nodes)
+{
+    prte_rusage_ring_t *ring;
+    prte_rusage_sample_t *newest, *oldest;
+    uint64_t key, values[PRTE_RUSAGE_MAX], nodevals[PRTE_RUSAGE_MAX];
+    double dt;
+    void *nptr;
+    int n, rc;
+
+    prte_rusage_summary_init(procs);
+    prte_rusage_summary_init(nodes);
+    if (!initialized) {
+        return;
+    }
+    /* without a sampling timer, every query takes
+     * a fresh sample */
+    if (0 >= prte_pmix_server_globals.rusage_interval) {
+        sample_all();
+    }
+
+    memset(nodevals, 0, sizeof(nodevals));
+    rc = pmix_hash_table_get_first_key_uint64(&rings, &key, (void **) &ring, &nptr);
+    while (PMIX_SUCCESS == rc) {
+        if (0 < ring->nsamples &&
+            (PMIX_NSPACE_INVALID(scope) || PMIX_CHECK_NSPACE(scope, ring->name.nspace))) {
+            n = ring->head - 1;
+            if (0 > n) {
+                n += prte_pmix_server_globals.rusage_depth;
+            }
+            newest = &ring->ring[n];
+            n = ring->head - ring->nsamples;
+            if (0 > n) {
+                n += prte_pmix_server_globals.rusage_depth;
+            }
+            oldest = &ring->ring[n];
+
+            memset(values, 0, sizeof(values));
+            memcpy(values, newest->value, sizeof(newest->value));
+            /* utilization over the window covered by the ring, or
+             * over the life of the proc if we only have one sample */
+            if (newest != oldest) {
+                dt = newest->elapsed - oldest->elapsed;
+                if (0.0 < dt) {
+                    values[PRTE_RUSAGE_CPU_PCT] = (uint64_t) ((double) (newest->value[PRTE_RUSAGE_CPU]
+                                                                        - oldest->value[PRTE_RUSAGE_CPU])
+                                                              / dt / 100.0);
+                }
+            } else if (0.0 < newest->elapsed) {
+                values[PRTE_RUSAGE_CPU_PCT] = (uint64_t) ((double) newest->value[PRTE_RUSAGE_CPU]
+                                                          / newest->elapsed / 100.0);
+            }
+            summary_add(procs, values);
+
+            for (n = 0; n <= PRTE_RUSAGE_CTXSW; n++) {
+                nodevals[n] += values[n];
+            }
+            nodevals[PRTE_RUSAGE_NPROCS]++;
+        }
+        rc = pmix_hash_table_get_next_key_uint64(&rings, &key, (void **) &ring, nptr, &nptr);
+    }
+
+    /* nodes only count if they host part of the scope */
+    if (PMIX_NSPACE_INVALID(scope) || 0 < nodevals[PRTE_RUSAGE_NPROCS]) {
+        node_values(nodevals);
+        summary_add(nodes, nodevals);
+    }
+}
+
+void pmix_server_rusage_load(void *results, const char *key,
+                             prte_rusage_summary_t *s, bool node)
+{
+    pmix_data_array_t dry;
+    pmix_status_t rc;
+    void *ilist;
+    char *name;
+    int n, nmetrics;
+
+    nmetrics = node ? PRTE_RUSAGE_MAX : PRTE_RUSAGE_NPROCS;
+
+    PMIX_INFO_LIST_START(ilist);
+    PMIX_INFO_LIST_ADD(rc, ilist, "prte.rusage.count", &s->count, PMIX_UINT64);
+    if (0 < s->count) {
+        for (n = 0; n < nmetrics; n++) {
+            pmix_asprintf(&name, "prte.rusage.%s.min", metric_names[n]);
+            PMIX_INFO_LIST_ADD(rc, ilist, name, &s->min[n], PMIX_UINT64);
+            free(name);
+            pmix_asprintf(&name, "prte.rusage.%s.max", metric_names[n]);
+            PMIX_INFO_LIST_ADD(rc, ilist, name, &s->max[n], PMIX_UINT64);
+            free(name);
+            pmix_asprintf(&name, "prte.rusage.%s.sum", metric_names[n]);
+            PMIX_INFO_LIST_ADD(rc, ilist, name, &s->sum[n], PMIX_UINT64);
+            free(name);
+        }
+    }
+    PMIX_INFO_LIST_CONVERT(rc, ilist, &dry);
+    PMIX_INFO_LIST_RELEASE(ilist);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return;
+    }
+    PMIX_INFO_LIST_ADD(rc, results, key, &dry, PMIX_DATA_ARRAY);
+    PMIX_DATA_ARRAY_DESTRUCT(&dry);
+}
+
+static void request_timeout(int sd, short args, void *cbdata)
+{
+    prte_rusage_req_t *req = (prte_rusage_req_t *) cbdata;
+    prte_rusage_summary_t procs, nodes;
+    PRTE_HIDE_UNUSED_PARAMS(sd, args);
+
+    pmix_output_verbose(2, prte_pmix_server_globals.output,
+                        "%s rusage request %d timed out",
+                        PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), req->index);
+
+    /* a late response will no longer find it */
+    pmix_hash_table_remove_value_uint64(&requests, (uint64_t) req->index);
+    prte_rusage_summary_init(&procs);
+    prte_rusage_summary_init(&nodes);
+    req->cbfunc(PMIX_ERR_TIMEOUT, &procs, &nodes, req->cbdata);
+    PMIX_RELEASE(req);
+}
+
+int pmix_server_rusage_collect(const pmix_nspace_t scope,
+                               prte_rusage_cbfunc_t cbfunc, void *cbdata)
+{
+    prte_rusage_req_t *req;
+    pmix_data_buffer_t msg;
+    struct timeval tv;
+    pmix_status_t rc;
+    int ret;
+
+    if (!initialized) {
+        return PRTE_ERR_NOT_AVAILABLE;
+    }
+
+    req = PMIX_NEW(prte_rusage_req_t);
+    req->cbfunc = cbfunc;
+    req->cbdata = cbdata;
+    /* indices are not reused right away, so a response to a
+     * request that timed out cannot complete a newer one */
+    req->index = next_request;
+    next_request = (next_request + 1) & INT_MAX;
+    pmix_hash_table_set_value_uint64(&requests, (uint64_t) req->index, req);
+
+    PMIX_DATA_BUFFER_CONSTRUCT(&msg);
+    rc = PMIx_Data_pack(NULL, &msg, &PRTE_PROC_MY_NAME->rank, 1, PMIX_PROC_RANK);
+    if (PMIX_SUCCESS == rc) {
+        rc = PMIx_Data_pack(NULL, &msg, &req->index, 1, PMIX_INT);
+    }
+    if (PMIX_SUCCESS == rc) {
+        rc = PMIx_Data_pack(NULL, &msg, (void *) scope, 1, PMIX_PROC_NSPACE);
+    }
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        ret = prte_pmix_convert_status(rc);
+        goto error;
+    }
+
+    ret = prte_grpcomm.xcast(PRTE_RML_TAG_RUSAGE_REQUEST, &msg);
+    if (PRTE_SUCCESS != ret) {
+        PRTE_ERROR_LOG(ret);
+        goto error;
+    }
+    PMIX_DATA_BUFFER_DESTRUCT(&msg);
+
+    prte_event_evtimer_set(prte_event_base, &req->ev, request_timeout, req);
+    tv.tv_sec = prte_pmix_server_globals.rusage_timeout;
+    tv.tv_usec = 0;
+    prte_event_evtimer_add(&req->ev, &tv);
+    return PRTE_SUCCESS;
+
+error:
+    PMIX_DATA_BUFFER_DESTRUCT(&msg);
+    pmix_hash_table_remove_value_uint64(&requests, (uint64_t) req->index);
+    PMIX_RELEASE(req);
+    return ret;
+}
+
+static void tracker_timeout(int sd, short args, void *cbdata)
+{
+    prte_rusage_tracker_t *trk = (prte_rusage_tracker_t *) cbdata;
+    PRTE_HIDE_UNUSED_PARAMS(sd, args);
+
+    pmix_output_verbose(2, prte_pmix_server_globals.output,
+                        "%s rusage request %d from %s timed out with %d routes outstanding",
+                        PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), trk->index,
+                        PRTE_VPID_PRINT(trk->origin), trk->nwaiting);
+
+    /* the requestor will have timed out as well, so there
+     * is nobody left to pass a partial result to */
+    pmix_hash_table_remove_value_uint64(&trackers, trk->key);
+    PMIX_RELEASE(trk);
+}
+
+static prte_rusage_tracker_t *get_tracker(pmix_rank_t origin, int index,
+                                          const pmix_nspace_t scope)
+{
+    prte_rusage_tracker_t *trk = NULL;
+    prte_routed_tree_t *child;
+    struct timeval tv;
+    uint64_t key;
+    size_t n;
+
+    key = ((uint64_t) origin << 32) | (uint32_t) index;
+    pmix_hash_table_get_value_uint64(&trackers, key, (void **) &trk);
+    if (NULL == trk) {
+        trk = PMIX_NEW(prte_rusage_tracker_t);
+        trk->key = key;
+        trk->origin = origin;
+        trk->index = index;
+        PMIX_LOAD_NSPACE(trk->scope, scope);
+        n = pmix_list_get_size(&prte_rml_base.children);
+        if (0 < n) {
+            trk->waiting = (pmix_rank_t *) malloc(n * sizeof(pmix_rank_t));
+            PMIX_LIST_FOREACH(child, &prte_rml_base.children, prte_routed_tree_t) {
+                trk->waiting[trk->nwaiting++] = child->rank;
+            }
+        }
+        pmix_hash_table_set_value_uint64(&trackers, key, trk);
+
+        prte_event_evtimer_set(prte_event_base, &trk->ev, tracker_timeout, trk);
+        tv.tv_sec = prte_pmix_server_globals.rusage_timeout;
+        tv.tv_usec = 0;
+        prte_event_evtimer_add(&trk->ev, &tv);
+    }
+    return trk;
+}
+
+/* stop waiting for the given routing child, returning
+ * false if we were not waiting for it */
+static bool clear_waiting(prte_rusage_tracker_t *trk, pmix_rank_t rank)
+{
+    int n;
+
+    for (n = 0; n < trk->nwaiting; n++) {
+        if (rank == trk->waiting[n]) {
+            trk->waiting[n] = trk->waiting[--trk->nwaiting];
+            return true;
+        }
+    }
+    return false;
+}
+
+static void check_complete(prte_rusage_tracker_t *trk)
+{
+    pmix_data_buffer_t *buf;
+    pmix_status_t rc;
+    pmix_rank_t target;
+    prte_rml_tag_t tag;
+    int ret;
+
+    if (!trk->local_done || 0 < trk->nwaiting) {
+        return;
+    }
+    prte_event_evtimer_del(&trk->ev);
+    pmix_hash_table_remove_value_uint64(&trackers, trk->key);
+
+    PMIX_DATA_BUFFER_CREATE(buf);
+    if (PRTE_PROC_IS_MASTER) {
+        /* the rollup is complete - return it to the requestor's daemon */
+        target = trk->origin;
+        tag = PRTE_RML_TAG_RUSAGE_RESP;
+        rc = PMIx_Data_pack(NULL, buf, &trk->index, 1, PMIX_INT);
+    } else {
+        target = PRTE_PROC_MY_PARENT->rank;
+        tag = PRTE_RML_TAG_RUSAGE;
+        rc = PMIx_Data_pack(NULL, buf, &trk->origin, 1, PMIX_PROC_RANK);
+        if (PMIX_SUCCESS == rc) {
+            rc = PMIx_Data_pack(NULL, buf, &trk->index, 1, PMIX_INT);
+        }
+        if (PMIX_SUCCESS == rc) {
+            rc = PMIx_Data_pack(NULL, buf, &trk->scope, 1, PMIX_PROC_NSPACE);
+        }
+    }
+    if (PMIX_SUCCESS == rc) {
+        rc = summary_pack(buf, &trk->procs);
+    }
+    if (PMIX_SUCCESS == rc) {
+        rc = summary_pack(buf, &trk->nodes);
+    }
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_DATA_BUFFER_RELEASE(buf);
+        PMIX_RELEASE(trk);
+        return;
+    }
+    PRTE_RML_SEND(ret, target, buf, tag);
+    if (PRTE_SUCCESS != ret) {
+        PRTE_ERROR_LOG(ret);
+        PMIX_DATA_BUFFER_RELEASE(buf);
+    }
+    PMIX_RELEASE(trk);
+}
+
+void pmix_server_rusage_request(int status, pmix_proc_t *sender,
+                                pmix_data_buffer_t *buffer, prte_rml_tag_t tg,
+                                void *cbdata)
+{
+    prte_rusage_tracker_t *trk;
+    prte_rusage_summary_t procs, nodes;
+    pmix_rank_t origin;
+    pmix_nspace_t scope;
+    int32_t cnt;
+    int index;
+    pmix_status_t rc;
+    PRTE_HIDE_UNUSED_PARAMS(status, sender, tg, cbdata);
+
+    cnt = 1;
+    rc = PMIx_Data_unpack(NULL, buffer, &origin, &cnt, PMIX_PROC_RANK);
+    if (PMIX_SUCCESS == rc) {
+        cnt = 1;
+        rc = PMIx_Data_unpack(NULL, buffer, &index, &cnt, PMIX_INT);
+    }
+    if (PMIX_SUCCESS == rc) {
+        cnt = 1;
+        rc = PMIx_Data_unpack(NULL, buffer, &scope, &cnt, PMIX_PROC_NSPACE);
+    }
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return;
+    }
+
+    pmix_output_verbose(2, prte_pmix_server_globals.output,
+                        "%s rusage request %d from %s for %s",
+                        PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), index,
+                        PRTE_VPID_PRINT(origin),
+                        PMIX_NSPACE_INVALID(scope) ? "all jobs" : scope);
+
+    /* our children may already have reported */
+    trk = get_tracker(origin, index, scope);
+    pmix_server_rusage_local(scope, &procs, &nodes);
+    summary_merge(&trk->procs, &procs);
+    summary_merge(&trk->nodes, &nodes);
+    trk->local_done = true;
+    check_complete(trk);
+}
+
+void pmix_server_rusage_rollup(int status, pmix_proc_t *sender,
+                               pmix_data_buffer_t *buffer, prte_rml_tag_t tg,
+                               void *cbdata)
+{
+    prte_rusage_tracker_t *trk;
+    prte_rusage_summary_t procs, nodes;
+    pmix_rank_t origin;
+    pmix_nspace_t scope;
+    int32_t cnt;
+    int index;
+    pmix_status_t rc;
+    PRTE_HIDE_UNUSED_PARAMS(status, tg, cbdata);
+
+    cnt = 1;
+    rc = PMIx_Data_unpack(NULL, buffer, &origin, &cnt, PMIX_PROC_RANK);
+    if (PMIX_SUCCESS == rc) {
+        cnt = 1;
+        rc = PMIx_Data_unpack(NULL, buffer, &index, &cnt, PMIX_INT);
+    }
+    if (PMIX_SUCCESS == rc) {
+        cnt = 1;
+        rc = PMIx_Data_unpack(NULL, buffer, &scope, &cnt, PMIX_PROC_NSPACE);
+    }
+    if (PMIX_SUCCESS == rc) {
+        rc = summary_unpack(buffer, &procs);
+    }
+    if (PMIX_SUCCESS == rc) {
+        rc = summary_unpack(buffer, &nodes);
+    }
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return;
+    }
+
+    trk = get_tracker(origin, index, scope);
+    summary_merge(&trk->procs, &procs);
+    summary_merge(&trk->nodes, &nodes);
+    clear_waiting(trk, sender->rank);
+    check_complete(trk);
+}
+
+void pmix_server_rusage_route_lost(pmix_rank_t route)
+{
+    prte_rusage_tracker_t *trk;
+    uint64_t key, *lost = NULL;
+    size_t nlost = 0, n;
+    void *nptr;
+    int rc;
+
+    if (!initialized) {
+        return;
+    }
+
+    /* completing a tracker removes it from the table, so
+     * find the ones waiting on this route first */
+    rc = pmix_hash_table_get_first_key_uint64(&trackers, &key, (void **) &trk, &nptr);
+    while (PMIX_SUCCESS == rc) {
+        if (clear_waiting(trk, route)) {
+            lost = (uint64_t *) realloc(lost, (nlost + 1) * sizeof(uint64_t));
+            lost[nlost++] = key;
+        }
+        rc = pmix_hash_table_get_next_key_uint64(&trackers, &key, (void **) &trk, nptr, &nptr);
+    }
+    for (n = 0; n < nlost; n++) {
+        trk = NULL;
+        pmix_hash_table_get_value_uint64(&trackers, lost[n], (void **) &trk);
+        if (NULL != trk) {
+            pmix_output_verbose(2, prte_pmix_server_globals.output,
+                                "%s rusage request %d from %s lost route %s",
+                                PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), trk->index,
+                                PRTE_VPID_PRINT(trk->origin), PRTE_VPID_PRINT(route));
+            check_complete(trk);
+        }
+    }
+    if (NULL != lost) {
+        free(lost);
+    }
+}
+
+void pmix_server_rusage_resp(int status, pmix_proc_t *sender,
+                             pmix_data_buffer_t *buffer, prte_rml_tag_t tg,
+                             void *cbdata)
+{
+    prte_rusage_req_t *req;
+    prte_rusage_summary_t procs, nodes;
+    int32_t cnt;
+    int index;
+    pmix_status_t rc;
+    PRTE_HIDE_UNUSED_PARAMS(status, sender, tg, cbdata);
+
+    cnt = 1;
+    rc = PMIx_Data_unpack(NULL, buffer, &index, &cnt, PMIX_INT);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return;
+    }
+    req = NULL;
+    pmix_hash_table_get_value_uint64(&requests, (uint64_t) index, (void **) &req);
+    if (NULL == req) {
+        /* it already timed out */
+        return;
+    }
+    pmix_hash_table_remove_value_uint64(&requests, (uint64_t) index);
+    prte_event_evtimer_del(&req->ev);
+
+    rc = summary_unpack(buffer, &procs);
+    if (PMIX_SUCCESS == rc) {
+        rc = summary_unpack(buffer, &nodes);
+    }
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+    }
+    req->cbfunc(rc, &procs, &nodes, req->cbdata);
+    PMIX_RELEASE(req);
+}
+
+void pmix_server_rusage_init(void)
+{
+    struct timeval tv;
+
+    if (initialized) {
+        return;
+    }
+    initialized = true;
+
+    if (0 < sysconf(_SC_CLK_TCK)) {
+        ticks_per_sec = sysconf(_SC_CLK_TCK);
+    }
+    if (0 < sysconf(_SC_PAGESIZE)) {
+        page_size = sysconf(_SC_PAGESIZE);
+    }
+    if (2 > prte_pmix_server_globals.rusage_depth) {
+        prte_pmix_server_globals.rusage_depth = 2;
+    }
+    if (1 > prte_pmix_server_globals.rusage_timeout) {
+        prte_pmix_server_globals.rusage_timeout = 1;
+    }
+
+    PMIX_CONSTRUCT(&rings, pmix_hash_table_t);
+    pmix_hash_table_init(&rings, 256);
+    PMIX_CONSTRUCT(&trackers, pmix_hash_table_t);
+    pmix_hash_table_init(&trackers, 16);
+    PMIX_CONSTRUCT(&requests, pmix_hash_table_t);
+    pmix_hash_table_init(&requests, 16);
+
+    if (0 < prte_pmix_server_globals.rusage_interval) {
+        prte_event_evtimer_set(prte_event_base, &sample_ev, sample_tick, NULL);
+        tv.tv_sec = prte_pmix_server_globals.rusage_interval;
+        tv.tv_usec = 0;
+        prte_event_evtimer_add(&sample_ev, &tv);
+        sample_active = true;
+    }
+}
+
+void pmix_server_rusage_finalize(void)
+{
+    prte_rusage_ring_t *ring;
+    prte_rusage_tracker_t *trk;
+    prte_rusage_req_t *req;
+    uint64_t key;
+    void *nptr;
+    int rc;
+
+    if (!initialized) {
+        return;
+    }
+    initialized = false;
+
+    if (sample_active) {
+        prte_event_evtimer_del(&sample_ev);
+        sample_active = false;
+    }
+
+    rc = pmix_hash_table_get_first_key_uint64(&rings, &key, (void **) &ring, &nptr);
+    while (PMIX_SUCCESS == rc) {
+        PMIX_RELEASE(ring);
+        rc = pmix_hash_table_get_next_key_uint64(&rings, &key, (void **) &ring, nptr, &nptr);
+    }
+    PMIX_DESTRUCT(&rings);
+    rc = pmix_hash_table_get_first_key_uint64(&trackers, &key, (void **) &trk, &nptr);
+    while (PMIX_SUCCESS == rc) {
+        prte_event_evtimer_del(&trk->ev);
+        PMIX_RELEASE(trk);
+        rc = pmix_hash_table_get_next_key_uint64(&trackers, &key, (void **) &trk, nptr, &nptr);
+    }
+    PMIX_DESTRUCT(&trackers);
+    rc = pmix_hash_table_get_first_key_uint64(&requests, &key, (void **) &req, &nptr);
+    while (PMIX_SUCCESS == rc) {
+        prte_event_evtimer_del(&req->ev);
+        PMIX_RELEASE(req);
+        rc = pmix_hash_table_get_next_key_uint64(&requests, &key, (void **) &req, nptr, &nptr);
+    }
+    PMIX_DESTRUCT(&requests);
+}
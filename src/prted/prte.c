@@ -231,9 +231,10 @@ static void shutdown_callback(int fd, short flags, void *arg)
      * indicating clean termination! Instead, just forcibly cleanup
      * the local session_dir tree and exit
      */
-    prte_odls.kill_local_procs(NULL);
-    // mark that we are finalizing so the session directory will cleanup
+    // mark that we are finalizing so the session directory will cleanup - this
+    // also ensures the local procs are fully killed before we exit
     prte_finalizing = true;
+    prte_odls.kill_local_procs(NULL);
     jdata = prte_get_job_data_object(PRTE_PROC_MY_NAME->nspace);
     PMIX_RELEASE(jdata);
     exit(PRTE_ERROR_DEFAULT_EXIT_CODE);
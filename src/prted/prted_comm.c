@@ -69,6 +69,7 @@
 #include "src/mca/plm/plm.h"
 #include "src/mca/rmaps/rmaps_types.h"
 #include "src/rml/rml.h"
+#include "src/mca/state/base/base.h"
 #include "src/mca/state/state.h"
 
 #include "src/runtime/prte_globals.h"
@@ -479,6 +480,11 @@ void prte_daemon_recv(int status, pmix_proc_t *sender,
             goto CLEANUP;
         }
 
+        /* release any launch timeline we kept for it */
+        if (prte_state_base.timeline) {
+            prte_state_base_timeline_cleanup(job);
+        }
+
         /* look up job data object */
         if (NULL == (jdata = prte_get_job_data_object(job))) {
             /* we can safely ignore this request as the job
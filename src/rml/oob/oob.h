@@ -59,6 +59,8 @@ BEGIN_C_DECLS
  */
 typedef struct {
     int output;
+    prte_event_base_t *ev_base;      /**< event base on which all socket I/O is progressed */
+    bool progress_thread;            /**< progress socket I/O in a dedicated thread */
     uint32_t addr_count;             /**< total number of addresses */
     int num_links;                   /**< number of logical links per physical device */
     int max_retries;                 /**< max number of retries before declaring peer gone */
@@ -67,6 +69,10 @@ typedef struct {
     int peer_limit;                  /**< max size of tcp peer cache */
     pmix_list_t peers;               // connection addresses for peers
     int max_msg_size;                // max size of an OOB msg (in MBytes)
+    int recv_ring_size;              // size of the per-peer receive ring (0 => disabled)
+    int send_coalesce_bytes;         // max bytes to gather into a single writev
+    int send_coalesce_delay;         // usecs to wait for more messages before sending
+    bool checksum;                   // protect message bodies with a CRC32C
     
     /* Port specifications */
     int tcp_sndbuf;   /**< socket send buffer size */
@@ -122,6 +128,7 @@ typedef struct {
     pmix_object_t super;
     prte_event_t ev;
     prte_rml_send_t *msg;
+    pmix_rank_t hop;
 } prte_oob_send_t;
 PRTE_EXPORT PMIX_CLASS_DECLARATION(prte_oob_send_t);
 
@@ -138,6 +145,9 @@ PRTE_EXPORT PMIX_CLASS_DECLARATION(prte_oob_send_t);
 typedef void (*mca_oob_send_callback_fn_t)(int status, struct iovec *iov, int count, void *cbdata);
 
 PRTE_EXPORT void prte_oob_base_send_nb(int fd, short args, void *cbdata);
+/* must be called from the main thread, which owns the routing
+ * table - the next hop is resolved before the send is handed
+ * to the OOB event base */
 #define PRTE_OOB_SEND(m)                                                                          \
     do {                                                                                          \
         prte_oob_send_t *prte_oob_send_cd;                                                        \
@@ -145,7 +155,8 @@ PRTE_EXPORT void prte_oob_base_send_nb(int fd, short args, void *cbdata);
                             PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), __FILE__, __LINE__);              \
         prte_oob_send_cd = PMIX_NEW(prte_oob_send_t);                                             \
         prte_oob_send_cd->msg = (m);                                                              \
-        PRTE_PMIX_THREADSHIFT(prte_oob_send_cd, prte_event_base, prte_oob_base_send_nb);          \
+        prte_oob_send_cd->hop = prte_rml_get_route((m)->dst.rank);                                \
+        PRTE_PMIX_THREADSHIFT(prte_oob_send_cd, prte_oob_base.ev_base, prte_oob_base_send_nb);          \
     } while (0)
 
 /* During initial wireup, we can only transfer contact info on the daemon
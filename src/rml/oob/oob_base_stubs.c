@@ -46,6 +46,7 @@ void prte_oob_base_send_nb(int fd, short args, void *cbdata)
 
     /* done with this. release it now */
     msg = cd->msg;
+    PMIX_LOAD_PROCID(&hop, PRTE_PROC_MY_NAME->nspace, cd->hop);
     PMIX_RELEASE(cd);
 
     pmix_output_verbose(5, prte_oob_base.output,
@@ -62,10 +63,8 @@ void prte_oob_base_send_nb(int fd, short args, void *cbdata)
         return;
     }
 
-    /* do we have a route to this peer (could be direct)? */
-    PMIX_LOAD_NSPACE(hop.nspace, PRTE_PROC_MY_NAME->nspace);
-    hop.rank = prte_rml_get_route(msg->dst.rank);
-    /* do we know this hop? */
+    /* do we know the hop the route to this peer goes
+     * through (could be direct)? */
     if (NULL == (peer = prte_oob_tcp_peer_lookup(&hop))) {
         /* if this message is going to the HNP, send it direct */
         if (PRTE_PROC_MY_HNP->rank == msg->dst.rank) {
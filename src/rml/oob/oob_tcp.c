@@ -75,6 +75,8 @@
 
 prte_oob_base_t prte_oob_base = {
     .output = -1,
+    .ev_base = NULL,
+    .progress_thread = false,
     .addr_count = 0,
     .num_links = 0,
     .max_retries = 0,
@@ -146,6 +148,22 @@ int prte_oob_open(void)
     PMIX_CONSTRUCT(&prte_oob_base.local_ifs, pmix_list_t);
         PMIX_CONSTRUCT(&prte_oob_base.peers, pmix_list_t);
 
+    /* socket I/O can be progressed in its own thread - everything
+     * that crosses into the rest of PRRTE (message delivery, state
+     * changes) is threadshifted back onto the main event base */
+    if (prte_oob_base.progress_thread) {
+        prte_oob_base.ev_base = prte_progress_thread_init("PRTE-OOB");
+        if (NULL == prte_oob_base.ev_base) {
+            PRTE_ERROR_LOG(PRTE_ERR_OUT_OF_RESOURCE);
+            /* nothing for close to stop */
+            prte_oob_base.progress_thread = false;
+            prte_oob_base.ev_base = prte_event_base;
+            return PRTE_ERR_OUT_OF_RESOURCE;
+        }
+    } else {
+        prte_oob_base.ev_base = prte_event_base;
+    }
+
    /* if interface include was given, construct a list
      * of those interfaces which match the specifications - remember,
      * the includes could be given as named interfaces, IP addrs, or
@@ -327,6 +345,12 @@ void prte_oob_close(void)
 
     }
 
+    /* stop progressing sockets before we tear down the peers */
+    if (prte_oob_base.progress_thread) {
+        prte_progress_thread_finalize("PRTE-OOB");
+        prte_oob_base.ev_base = prte_event_base;
+    }
+
     PMIX_LIST_DESTRUCT(&prte_oob_base.local_ifs);
     PMIX_LIST_DESTRUCT(&prte_oob_base.peers);
 
@@ -366,6 +390,13 @@ static char *dyn_port_string6;
 
 int prte_oob_register(void)
 {
+    prte_oob_base.progress_thread = false;
+    (void) pmix_mca_base_var_register("prte", "prte", NULL, "oob_progress_thread",
+                                        "Progress OOB socket I/O in a dedicated thread instead "
+                                        "of the main event thread",
+                                        PMIX_MCA_BASE_VAR_TYPE_BOOL,
+                                        &prte_oob_base.progress_thread);
+
     prte_oob_base.peer_limit = -1;
     (void) pmix_mca_base_var_register("prte", "prte", NULL, "peer_limit",
                                         "Maximum number of peer connections to simultaneously maintain (-1 = infinite)",
@@ -549,6 +580,42 @@ int prte_oob_register(void)
                                         PMIX_MCA_BASE_VAR_TYPE_INT,
                                         &prte_oob_base.max_recon_attempts);
 
+    prte_oob_base.recv_ring_size = 65536;
+    (void) pmix_mca_base_var_register("prte", "prte", NULL, "recv_ring_size",
+                                        "Size in bytes of the per-peer buffer used to read and parse "
+                                        "multiple messages in a single socket read (0 => read each "
+                                        "message header and body separately)",
+                                        PMIX_MCA_BASE_VAR_TYPE_INT,
+                                        &prte_oob_base.recv_ring_size);
+    if (0 < prte_oob_base.recv_ring_size &&
+        prte_oob_base.recv_ring_size < (int) (2 * sizeof(prte_oob_tcp_hdr_t))) {
+        /* must be able to hold at least one header plus some data */
+        prte_oob_base.recv_ring_size = 2 * sizeof(prte_oob_tcp_hdr_t);
+    }
+
+    prte_oob_base.send_coalesce_bytes = 1048576;
+    (void) pmix_mca_base_var_register("prte", "prte", NULL, "send_coalesce_bytes",
+                                        "Max number of bytes from queued messages to the same peer "
+                                        "to gather into a single write (0 => one message per write)",
+                                        PMIX_MCA_BASE_VAR_TYPE_INT,
+                                        &prte_oob_base.send_coalesce_bytes);
+
+    prte_oob_base.send_coalesce_delay = 0;
+    (void) pmix_mca_base_var_register("prte", "prte", NULL, "send_coalesce_delay",
+                                        "Time (in usec) to wait for additional messages to a peer "
+                                        "to queue before starting to send (0 => send immediately)",
+                                        PMIX_MCA_BASE_VAR_TYPE_INT,
+                                        &prte_oob_base.send_coalesce_delay);
+
+    prte_oob_base.checksum = false;
+    (void) pmix_mca_base_var_register("prte", "prte", NULL, "oob_checksum",
+                                        "Compute a CRC32C of each message body as it is sent to "
+                                        "the next daemon and verify it there before the message "
+                                        "is delivered or relayed - relayed messages are checked "
+                                        "hop by hop, not end to end (default: false)",
+                                        PMIX_MCA_BASE_VAR_TYPE_BOOL,
+                                        &prte_oob_base.checksum);
+
     return PRTE_SUCCESS;
 }
 
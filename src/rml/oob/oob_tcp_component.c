@@ -201,6 +201,14 @@ static void peer_cons(prte_oob_tcp_peer_t *peer)
     PMIX_CONSTRUCT(&peer->send_queue, pmix_list_t);
     peer->send_msg = NULL;
     peer->recv_msg = NULL;
+    peer->rring = NULL;
+    peer->rring_size = 0;
+    peer->rring_head = 0;
+    peer->rring_tail = 0;
+    peer->nwrites = 0;
+    peer->nmsgs_sent = 0;
+    prte_event_evtimer_set(prte_oob_base.ev_base, &peer->coalesce_event,
+                           prte_oob_tcp_coalesce_handler, peer);
     peer->send_ev_active = false;
     peer->recv_ev_active = false;
     peer->timer_ev_active = false;
@@ -210,6 +218,12 @@ static void peer_des(prte_oob_tcp_peer_t *peer)
     if (NULL != peer->auth_method) {
         free(peer->auth_method);
     }
+    pmix_output_verbose(1, prte_oob_base.output,
+                        "%s OOB STATS FOR %s: %lu msgs in %lu writes (%.2f msgs/write)",
+                        PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_NAME_PRINT(&peer->name),
+                        (unsigned long) peer->nmsgs_sent, (unsigned long) peer->nwrites,
+                        (0 == peer->nwrites) ? 0.0 : (double) peer->nmsgs_sent / (double) peer->nwrites);
+    prte_event_del(&peer->coalesce_event);
     if (peer->send_ev_active) {
         prte_event_del(&peer->send_event);
     }
@@ -225,6 +239,9 @@ static void peer_des(prte_oob_tcp_peer_t *peer)
                             PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), peer->sd);
         CLOSE_THE_SOCKET(peer->sd);
     }
+    if (NULL != peer->rring) {
+        free(peer->rring);
+    }
     PMIX_LIST_DESTRUCT(&peer->addrs);
     PMIX_LIST_DESTRUCT(&peer->send_queue);
 }
@@ -507,6 +507,8 @@ static int tcp_peer_send_connect_ack(prte_oob_tcp_peer_t *peer)
     hdr.type = MCA_OOB_TCP_IDENT;
     hdr.tag = 0;
     hdr.seq_num = 0;
+    hdr.csum = false;
+    hdr.crc = 0;
     memset(hdr.routed, 0, PRTE_MAX_RTD_SIZE + 1);
 
     /* payload size */
@@ -562,6 +564,8 @@ static int tcp_peer_send_connect_nack(int sd, pmix_proc_t *name)
     hdr.type = MCA_OOB_TCP_IDENT;
     hdr.tag = 0;
     hdr.seq_num = 0;
+    hdr.csum = false;
+    hdr.crc = 0;
     memset(hdr.routed, 0, PRTE_MAX_RTD_SIZE + 1);
 
     /* payload size */
@@ -600,14 +604,14 @@ static void tcp_peer_event_init(prte_oob_tcp_peer_t *peer)
 {
     if (peer->sd >= 0) {
         assert(!peer->send_ev_active && !peer->recv_ev_active);
-        prte_event_set(prte_event_base, &peer->recv_event, peer->sd, PRTE_EV_READ | PRTE_EV_PERSIST,
+        prte_event_set(prte_oob_base.ev_base, &peer->recv_event, peer->sd, PRTE_EV_READ | PRTE_EV_PERSIST,
                        prte_oob_tcp_recv_handler, peer);
         if (peer->recv_ev_active) {
             prte_event_del(&peer->recv_event);
             peer->recv_ev_active = false;
         }
 
-        prte_event_set(prte_event_base, &peer->send_event, peer->sd,
+        prte_event_set(prte_oob_base.ev_base, &peer->send_event, peer->sd,
                        PRTE_EV_WRITE | PRTE_EV_PERSIST, prte_oob_tcp_send_handler, peer);
         if (peer->send_ev_active) {
             prte_event_del(&peer->send_event);
@@ -1067,6 +1071,10 @@ void prte_oob_tcp_peer_close(prte_oob_tcp_peer_t *peer)
     close(peer->sd);
     peer->sd = -1;
 
+    /* any partially received data belongs to the old socket */
+    peer->rring_head = 0;
+    peer->rring_tail = 0;
+
     /* if we were CONNECTING, then we need to mark the address as
      * failed and cycle back to try the next address */
     if (MCA_OOB_TCP_CONNECTING == peer->state) {
@@ -1098,6 +1106,7 @@ void prte_oob_tcp_peer_close(prte_oob_tcp_peer_t *peer)
         prte_event_del(&peer->send_event);
         peer->send_ev_active = false;
     }
+    prte_event_del(&peer->coalesce_event);
 
     if (prte_prteds_term_ordered || prte_finalizing || prte_abnormal_term_ordered) {
         /* nothing more to do */
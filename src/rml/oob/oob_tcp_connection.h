@@ -63,14 +63,14 @@ PMIX_CLASS_DECLARATION(prte_oob_tcp_conn_op_t);
                             __FILE__, __LINE__, PRTE_NAME_PRINT((&(p)->name)));             \
         cop = PMIX_NEW(prte_oob_tcp_conn_op_t);                                             \
         cop->peer = (p);                                                                    \
-        PRTE_PMIX_THREADSHIFT(cop, prte_event_base, (cbfunc));                              \
+        PRTE_PMIX_THREADSHIFT(cop, prte_oob_base.ev_base, (cbfunc));                        \
     } while (0);
 
 #define PRTE_ACTIVATE_TCP_ACCEPT_STATE(s, a, cbfunc)                               \
     do {                                                                           \
         prte_oob_tcp_conn_op_t *cop;                                               \
         cop = PMIX_NEW(prte_oob_tcp_conn_op_t);                                    \
-        prte_event_set(prte_event_base, &cop->ev, s, PRTE_EV_READ, (cbfunc), cop); \
+        prte_event_set(prte_oob_base.ev_base, &cop->ev, s, PRTE_EV_READ, (cbfunc), cop); \
         PMIX_POST_OBJECT(cop);                                                     \
         prte_event_add(&cop->ev, 0);                                               \
     } while (0);
@@ -83,7 +83,7 @@ PMIX_CLASS_DECLARATION(prte_oob_tcp_conn_op_t);
                             __FILE__, __LINE__, PRTE_NAME_PRINT((&(p)->name)));                   \
         cop = PMIX_NEW(prte_oob_tcp_conn_op_t);                                                   \
         cop->peer = (p);                                                                          \
-        prte_event_evtimer_set(prte_event_base, &cop->ev, (cbfunc), cop);                         \
+        prte_event_evtimer_set(prte_oob_base.ev_base, &cop->ev, (cbfunc), cop);                   \
         PMIX_POST_OBJECT(cop);                                                                    \
         prte_event_evtimer_add(&cop->ev, (tv));                                                   \
     } while (0);
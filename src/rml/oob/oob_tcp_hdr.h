@@ -65,6 +65,10 @@ typedef struct {
     uint32_t nbytes;
     /* type of message */
     prte_oob_tcp_msg_type_t type;
+    /* whether or not the crc was computed by the sender */
+    bool csum;
+    /* CRC32C of the message body */
+    uint32_t crc;
     /* routed module to be used */
     char routed[PRTE_MAX_RTD_SIZE + 1];
 } prte_oob_tcp_hdr_t;
@@ -75,7 +79,8 @@ typedef struct {
     (h)->origin.rank = ntohl((h)->origin.rank); \
     (h)->dst.rank = ntohl((h)->dst.rank);       \
     (h)->tag = PRTE_RML_TAG_NTOH((h)->tag);     \
-    (h)->nbytes = ntohl((h)->nbytes);
+    (h)->nbytes = ntohl((h)->nbytes);           \
+    (h)->crc = ntohl((h)->crc);
 
 /**
  * Convert the message header to network byte order
@@ -84,6 +89,7 @@ typedef struct {
     (h)->origin.rank = htonl((h)->origin.rank); \
     (h)->dst.rank = htonl((h)->dst.rank);       \
     (h)->tag = PRTE_RML_TAG_HTON((h)->tag);     \
-    (h)->nbytes = htonl((h)->nbytes);
+    (h)->nbytes = htonl((h)->nbytes);           \
+    (h)->crc = htonl((h)->crc);
 
 #endif /* _MCA_OOB_TCP_HDR_H_ */
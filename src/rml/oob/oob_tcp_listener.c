@@ -164,7 +164,7 @@ int prte_oob_tcp_start_listening(void)
     PMIX_LIST_FOREACH(listener, &prte_oob_base.listeners, prte_oob_tcp_listener_t)
     {
         listener->ev_active = true;
-        prte_event_set(prte_event_base, &listener->event, listener->sd,
+        prte_event_set(prte_oob_base.ev_base, &listener->event, listener->sd,
                        PRTE_EV_READ | PRTE_EV_PERSIST, connection_event_handler, 0);
         PMIX_POST_OBJECT(listener);
         prte_event_add(&listener->event, 0);
@@ -645,7 +645,7 @@ static void *listen_thread(pmix_object_t *obj)
                  * OS might start rejecting connections due to timeout.
                  */
                 pending_connection = PMIX_NEW(prte_oob_tcp_pending_connection_t);
-                prte_event_set(prte_event_base, &pending_connection->ev, -1, PRTE_EV_WRITE,
+                prte_event_set(prte_oob_base.ev_base, &pending_connection->ev, -1, PRTE_EV_WRITE,
                                connection_handler, pending_connection);
                 pending_connection->fd = accept(sd, (struct sockaddr *) &(pending_connection->addr),
                                                 &addrlen);
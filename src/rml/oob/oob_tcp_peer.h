@@ -64,9 +64,16 @@ typedef struct {
     bool recv_ev_active;
     prte_event_t timer_event; /**< timer for retrying connection failures */
     bool timer_ev_active;
+    prte_event_t coalesce_event; /**< delay before sending to allow messages to gather */
     pmix_list_t send_queue;        /**< list of messages to send */
     prte_oob_tcp_send_t *send_msg; /**< current send in progress */
     prte_oob_tcp_recv_t *recv_msg; /**< current recv in progress */
+    char *rring;                   /**< staging buffer for batched socket reads */
+    size_t rring_size;             /**< allocated size of the staging buffer */
+    size_t rring_head;             /**< offset of the first unparsed byte */
+    size_t rring_tail;             /**< offset of the end of valid data */
+    uint64_t nwrites;              /**< number of writev calls made to this peer */
+    uint64_t nmsgs_sent;           /**< number of messages completed to this peer */
 } prte_oob_tcp_peer_t;
 PMIX_CLASS_DECLARATION(prte_oob_tcp_peer_t);
 
@@ -35,6 +35,7 @@
 #    include <unistd.h>
 #endif
 #include <fcntl.h>
+#include <limits.h>
 #ifdef HAVE_SYS_UIO_H
 #    include <sys/uio.h>
 #endif
@@ -58,6 +59,7 @@
 #include "prte_stdint.h"
 #include "src/event/event-internal.h"
 #include "src/mca/prtebacktrace/prtebacktrace.h"
+#include "src/util/crc.h"
 #include "src/util/error.h"
 #include "src/util/pmix_net.h"
 #include "src/util/pmix_output.h"
@@ -79,6 +81,53 @@
 
 #define OOB_SEND_MAX_RETRIES 3
 
+/* max number of iovecs we will hand to a single writev */
+#if defined(IOV_MAX) && IOV_MAX < 128
+#    define OOB_SEND_MAX_IOV IOV_MAX
+#else
+#    define OOB_SEND_MAX_IOV 128
+#endif
+
+static void activate_send(prte_oob_tcp_peer_t *peer)
+{
+    struct timeval tv;
+
+    if (peer->send_ev_active) {
+        return;
+    }
+    peer->send_ev_active = true;
+    PMIX_POST_OBJECT(peer);
+    if (0 < prte_oob_base.send_coalesce_delay) {
+        /* give other messages for this peer a chance to
+         * queue up so they can all go out in one write */
+        tv.tv_sec = prte_oob_base.send_coalesce_delay / 1000000;
+        tv.tv_usec = prte_oob_base.send_coalesce_delay % 1000000;
+        prte_event_evtimer_add(&peer->coalesce_event, &tv);
+    } else {
+        prte_event_add(&peer->send_event, 0);
+    }
+}
+
+void prte_oob_tcp_coalesce_handler(int sd, short flags, void *cbdata)
+{
+    prte_oob_tcp_peer_t *peer = (prte_oob_tcp_peer_t *) cbdata;
+    PRTE_HIDE_UNUSED_PARAMS(sd, flags);
+
+    PMIX_ACQUIRE_OBJECT(peer);
+    if (!peer->send_ev_active) {
+        /* the send was cancelled while we waited */
+        return;
+    }
+    if (MCA_OOB_TCP_CONNECTED != peer->state) {
+        /* the connection went away while we waited - the
+         * queued messages will be started once it is
+         * re-established */
+        peer->send_ev_active = false;
+        return;
+    }
+    prte_event_add(&peer->send_event, 0);
+}
+
 void prte_oob_tcp_queue_msg(int sd, short args, void *cbdata)
 {
     prte_oob_tcp_send_t *snd = (prte_oob_tcp_send_t *) cbdata;
@@ -102,47 +151,126 @@ void prte_oob_tcp_queue_msg(int sd, short args, void *cbdata)
             PRTE_ACTIVATE_TCP_CONN_STATE(peer, prte_oob_tcp_peer_try_connect);
         } else {
             /* ensure the send event is active */
-            if (!peer->send_ev_active) {
-                peer->send_ev_active = true;
-                PMIX_POST_OBJECT(peer);
-                prte_event_add(&peer->send_event, 0);
-            }
+            activate_send(peer);
         }
     }
 }
 
-static int send_msg(prte_oob_tcp_peer_t *peer, prte_oob_tcp_send_t *msg)
+static char *msg_body(prte_oob_tcp_send_t *msg)
+{
+    if (NULL != msg->data) {
+        /* relay message - just send that data */
+        return msg->data;
+    }
+    /* buffer send */
+    return msg->msg->dbuf->base_ptr;
+}
+
+/* Load the unsent portion of a message into the provided iovec
+ * array, returning the number of entries used. The caller must
+ * have room for at least two entries */
+static int msg_iov(prte_oob_tcp_send_t *msg, struct iovec *iov, size_t *nbytes)
+{
+    int n = 0;
+
+    *nbytes = 0;
+    if (0 < msg->sdbytes) {
+        iov[n].iov_base = msg->sdptr;
+        iov[n].iov_len = msg->sdbytes;
+        *nbytes += msg->sdbytes;
+        ++n;
+    }
+    if (!msg->hdr_sent && 0 < ntohl(msg->hdr.nbytes)) {
+        iov[n].iov_base = msg_body(msg);
+        iov[n].iov_len = ntohl(msg->hdr.nbytes);
+        *nbytes += iov[n].iov_len;
+        ++n;
+    }
+    return n;
+}
+
+/* Account for nbytes having been written from the front of the
+ * message, returning the number of bytes consumed. On return,
+ * the message is complete if hdr_sent is set and sdbytes is zero */
+static size_t msg_advance(prte_oob_tcp_send_t *msg, size_t nbytes)
+{
+    size_t used, total = 0;
+
+    used = (nbytes < msg->sdbytes) ? nbytes : msg->sdbytes;
+    msg->sdptr += used;
+    msg->sdbytes -= used;
+    total += used;
+    if (0 == msg->sdbytes && !msg->hdr_sent) {
+        /* header is done - move on to the data */
+        msg->hdr_sent = true;
+        msg->sdptr = msg_body(msg);
+        msg->sdbytes = ntohl(msg->hdr.nbytes);
+        used = ((nbytes - total) < msg->sdbytes) ? (nbytes - total) : msg->sdbytes;
+        msg->sdptr += used;
+        msg->sdbytes -= used;
+        total += used;
+    }
+    return total;
+}
+
+static void complete_msg(prte_oob_tcp_peer_t *peer, prte_oob_tcp_send_t *msg)
 {
-    struct iovec iov[2];
-    int iov_count, retries = 0;
-    ssize_t remain = msg->sdbytes, rc;
-
-    iov[0].iov_base = msg->sdptr;
-    iov[0].iov_len = msg->sdbytes;
-    if (!msg->hdr_sent) {
-        if (NULL != msg->data) {
-            /* relay message - just send that data */
-            iov[1].iov_base = msg->data;
+    if (NULL != msg->data || NULL == msg->msg) {
+        /* the relay is complete - release the data */
+        pmix_output_verbose(2, prte_oob_base.output,
+                            "%s MESSAGE RELAY COMPLETE TO %s OF %d BYTES ON SOCKET %d",
+                            PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
+                            PRTE_NAME_PRINT(&(peer->name)),
+                            (int) ntohl(msg->hdr.nbytes), peer->sd);
+    } else {
+        /* we are done - notify the RML */
+        pmix_output_verbose(2, prte_oob_base.output,
+                            "%s MESSAGE SEND COMPLETE TO %s OF %d BYTES ON SOCKET %d",
+                            PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
+                            PRTE_NAME_PRINT(&(peer->name)),
+                            (int) ntohl(msg->hdr.nbytes), peer->sd);
+        msg->msg->status = PRTE_SUCCESS;
+        PRTE_RML_SEND_COMPLETE(msg->msg);
+    }
+    PMIX_RELEASE(msg);
+}
+
+/* Write the on-deck message plus as many of the queued messages
+ * as fit within the iovec and byte budget in a single writev.
+ * Completed messages are retired, and the first incomplete one
+ * (if any) is left on-deck */
+static int send_msg(prte_oob_tcp_peer_t *peer)
+{
+    struct iovec iov[OOB_SEND_MAX_IOV];
+    prte_oob_tcp_send_t *msgs[OOB_SEND_MAX_IOV];
+    prte_oob_tcp_send_t *msg;
+    int iov_count = 0, nmsgs = 0, retries = 0, n;
+    size_t remain = 0, len;
+    ssize_t rc;
+
+    /* gather the on-deck message and as much of the queue as we can */
+    msg = peer->send_msg;
+    while (NULL != msg) {
+        iov_count += msg_iov(msg, &iov[iov_count], &len);
+        remain += len;
+        msgs[nmsgs++] = msg;
+        if ((size_t) prte_oob_base.send_coalesce_bytes <= remain ||
+            OOB_SEND_MAX_IOV < iov_count + 2) {
+            break;
+        }
+        if (msg == peer->send_msg) {
+            msg = (prte_oob_tcp_send_t *) pmix_list_get_first(&peer->send_queue);
         } else {
-            /* buffer send */
-            iov[1].iov_base = msg->msg->dbuf->base_ptr;
+            msg = (prte_oob_tcp_send_t *) pmix_list_get_next(&msg->super);
+        }
+        if ((prte_oob_tcp_send_t *) pmix_list_get_end(&peer->send_queue) == msg) {
+            break;
         }
-        iov[1].iov_len = ntohl(msg->hdr.nbytes);
-        remain += ntohl(msg->hdr.nbytes);
-        iov_count = 2;
-    } else {
-        iov_count = 1;
     }
 
 retry:
     rc = writev(peer->sd, iov, iov_count);
-    if (PMIX_LIKELY(rc == remain)) {
-        /* we successfully sent the header and the msg data if any */
-        msg->hdr_sent = true;
-        msg->sdbytes = 0;
-        msg->sdptr = (char *) iov[iov_count - 1].iov_base + iov[iov_count - 1].iov_len;
-        return PRTE_SUCCESS;
-    } else if (rc < 0) {
+    if (rc < 0) {
         if (prte_socket_errno == EINTR) {
             goto retry;
         } else if (prte_socket_errno == EAGAIN) {
@@ -171,24 +299,33 @@ retry:
                         strerror(prte_socket_errno), prte_socket_errno, peer->sd);
             return PRTE_ERR_UNREACH;
         }
-    } else {
-        /* short writev. This usually means the kernel buffer is full,
-         * so there is no point for retrying at that time.
-         * simply update the msg and return with PMIX_ERR_RESOURCE_BUSY */
-        if ((size_t) rc < msg->sdbytes) {
-            /* partial write of the header or the msg data */
-            msg->sdptr = (char *) msg->sdptr + rc;
-            msg->sdbytes -= rc;
+    }
+    ++peer->nwrites;
+
+    /* retire the messages that were completely written. A short
+     * writev usually means the kernel buffer is full, so there is
+     * no point retrying right now - leave the first incomplete
+     * message on-deck and tell the caller the socket is busy */
+    len = rc;
+    for (n = 0; n < nmsgs; n++) {
+        msg = msgs[n];
+        len -= msg_advance(msg, len);
+        if (!msg->hdr_sent || 0 < msg->sdbytes) {
+            if (msg != peer->send_msg) {
+                pmix_list_remove_item(&peer->send_queue, &msg->super);
+                peer->send_msg = msg;
+            }
+            return PRTE_ERR_RESOURCE_BUSY;
+        }
+        if (msg == peer->send_msg) {
+            peer->send_msg = NULL;
         } else {
-            /* header was fully written, but only a part of the msg data was written */
-            msg->hdr_sent = true;
-            rc -= msg->sdbytes;
-            assert(2 == iov_count);
-            msg->sdptr = (char *) iov[1].iov_base + rc;
-            msg->sdbytes = ntohl(msg->hdr.nbytes) - rc;
+            pmix_list_remove_item(&peer->send_queue, &msg->super);
         }
-        return PRTE_ERR_RESOURCE_BUSY;
+        ++peer->nmsgs_sent;
+        complete_msg(peer, msg);
     }
+    return PRTE_SUCCESS;
 }
 
 /*
@@ -231,29 +368,8 @@ void prte_oob_tcp_send_handler(int sd, short flags, void *cbdata)
         if (NULL != msg) {
             pmix_output_verbose(2, prte_oob_base.output,
                                 "oob:tcp:send_handler SENDING MSG");
-            if (PRTE_SUCCESS == (rc = send_msg(peer, msg))) {
-                /* this msg is complete */
-                if (NULL != msg->data || NULL == msg->msg) {
-                    /* the relay is complete - release the data */
-                    pmix_output_verbose(2, prte_oob_base.output,
-                                        "%s MESSAGE RELAY COMPLETE TO %s OF %d BYTES ON SOCKET %d",
-                                        PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
-                                        PRTE_NAME_PRINT(&(peer->name)),
-                                        (int) ntohl(msg->hdr.nbytes), peer->sd);
-                    PMIX_RELEASE(msg);
-                    peer->send_msg = NULL;
-                } else {
-                    /* we are done - notify the RML */
-                    pmix_output_verbose(2, prte_oob_base.output,
-                                        "%s MESSAGE SEND COMPLETE TO %s OF %d BYTES ON SOCKET %d",
-                                        PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
-                                        PRTE_NAME_PRINT(&(peer->name)),
-                                        (int) ntohl(msg->hdr.nbytes), peer->sd);
-                    msg->msg->status = PRTE_SUCCESS;
-                    PRTE_RML_SEND_COMPLETE(msg->msg);
-                    PMIX_RELEASE(msg);
-                    peer->send_msg = NULL;
-                }
+            if (PRTE_SUCCESS == (rc = send_msg(peer))) {
+                /* all gathered messages are complete */
                 /* fall thru to queue the next message */
             } else if (PRTE_ERR_RESOURCE_BUSY == rc || PRTE_ERR_WOULD_BLOCK == rc) {
                 /* exit this event and let the event lib progress */
@@ -264,6 +380,7 @@ void prte_oob_tcp_send_handler(int sd, short flags, void *cbdata)
                     0, "%s-%s prte_oob_tcp_peer_send_handler: unable to send message ON SOCKET %d",
                     PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_NAME_PRINT(&(peer->name)), peer->sd);
                 prte_event_del(&peer->send_event);
+                msg = peer->send_msg;
                 msg->msg->status = rc;
                 PRTE_RML_SEND_COMPLETE(msg->msg);
                 PMIX_RELEASE(msg);
@@ -300,6 +417,34 @@ void prte_oob_tcp_send_handler(int sd, short flags, void *cbdata)
     }
 }
 
+static void peer_disconnected(prte_oob_tcp_peer_t *peer)
+{
+    pmix_output_verbose(OOB_TCP_DEBUG_FAIL, prte_oob_base.output,
+                        "%s-%s prte_oob_tcp_msg_recv: peer closed connection",
+                        PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_NAME_PRINT(&(peer->name)));
+    /* stop all events */
+    if (peer->recv_ev_active) {
+        prte_event_del(&peer->recv_event);
+        peer->recv_ev_active = false;
+    }
+    if (peer->timer_ev_active) {
+        prte_event_del(&peer->timer_event);
+        peer->timer_ev_active = false;
+    }
+    if (peer->send_ev_active) {
+        prte_event_del(&peer->send_event);
+        peer->send_ev_active = false;
+    }
+    if (NULL != peer->recv_msg) {
+        PMIX_RELEASE(peer->recv_msg);
+        peer->recv_msg = NULL;
+    }
+    prte_oob_tcp_peer_close(peer);
+    // if (NULL != mca_oob_tcp.oob_exception_callback) {
+    //   mca_oob_tcp.oob_exception_callback(&peer->peer_name, PRTE_RML_PEER_DISCONNECTED);
+    //}
+}
+
 static int read_bytes(prte_oob_tcp_peer_t *peer)
 {
     int rc;
@@ -340,28 +485,7 @@ static int read_bytes(prte_oob_tcp_peer_t *peer)
             /* the remote peer closed the connection - report that condition
              * and let the caller know
              */
-            pmix_output_verbose(OOB_TCP_DEBUG_FAIL, prte_oob_base.output,
-                                "%s-%s prte_oob_tcp_msg_recv: peer closed connection",
-                                PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_NAME_PRINT(&(peer->name)));
-            /* stop all events */
-            if (peer->recv_ev_active) {
-                prte_event_del(&peer->recv_event);
-                peer->recv_ev_active = false;
-            }
-            if (peer->timer_ev_active) {
-                prte_event_del(&peer->timer_event);
-                peer->timer_ev_active = false;
-            }
-            if (peer->send_ev_active) {
-                prte_event_del(&peer->send_event);
-                peer->send_ev_active = false;
-            }
-            PMIX_RELEASE(peer->recv_msg);
-            peer->recv_msg = NULL;
-            prte_oob_tcp_peer_close(peer);
-            // if (NULL != mca_oob_tcp.oob_exception_callback) {
-            //   mca_oob_tcp.oob_exception_callback(&peer->peer_name, PRTE_RML_PEER_DISCONNECTED);
-            //}
+            peer_disconnected(peer);
             return PRTE_ERR_WOULD_BLOCK;
         }
         /* we were able to read something, so adjust counters and location */
@@ -373,6 +497,242 @@ static int read_bytes(prte_oob_tcp_peer_t *peer)
     return PRTE_SUCCESS;
 }
 
+/* Read whatever the socket currently has available into the
+ * peer's staging ring with a single read call. Returns PRTE_SUCCESS
+ * if at least one byte was added to the ring */
+static int read_ring(prte_oob_tcp_peer_t *peer)
+{
+    ssize_t rc;
+
+    while (1) {
+        rc = read(peer->sd, peer->rring + peer->rring_tail,
+                  peer->rring_size - peer->rring_tail);
+        if (0 < rc) {
+            peer->rring_tail += rc;
+            return PRTE_SUCCESS;
+        }
+        if (0 == rc) {
+            /* the remote peer closed the connection */
+            peer_disconnected(peer);
+            return PRTE_ERR_WOULD_BLOCK;
+        }
+        if (prte_socket_errno == EINTR) {
+            continue;
+        } else if (prte_socket_errno == EAGAIN) {
+            return PRTE_ERR_RESOURCE_BUSY;
+        } else if (prte_socket_errno == EWOULDBLOCK) {
+            return PRTE_ERR_WOULD_BLOCK;
+        }
+        pmix_output_verbose(OOB_TCP_DEBUG_FAIL, prte_oob_base.output,
+                            "%s-%s prte_oob_tcp_msg_recv: read failed: %s (%d)",
+                            PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_NAME_PRINT(&(peer->name)),
+                            strerror(prte_socket_errno), prte_socket_errno);
+        return PRTE_ERR_COMM_FAILURE;
+    }
+}
+
+static bool msg_too_big(prte_oob_tcp_peer_t *peer, prte_oob_tcp_hdr_t *hdr)
+{
+    if (hdr->nbytes > (uint32_t)(prte_oob_base.max_msg_size * 1024 * 1024)) {
+        pmix_show_help("help-oob-tcp.txt", "msg-too-big", true,
+                        PRTE_NAME_PRINT(&peer->name), PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
+                        hdr->nbytes, prte_oob_base.max_msg_size);
+        peer->state = MCA_OOB_TCP_FAILED;
+        prte_oob_tcp_peer_close(peer);
+        return true;
+    }
+    return false;
+}
+
+/* send on a message we received for someone else */
+static void relay_msg(int fd, short args, void *cbdata)
+{
+    prte_oob_send_t *cd = (prte_oob_send_t *) cbdata;
+    prte_rml_send_t *snd;
+    PRTE_HIDE_UNUSED_PARAMS(fd, args);
+
+    PMIX_ACQUIRE_OBJECT(cd);
+    snd = cd->msg;
+    PMIX_RELEASE(cd);
+    PRTE_OOB_SEND(snd);
+}
+
+/* Hand a completely received message to the RML, or relay it
+ * onward if we are not the final recipient. The header must
+ * already be in host order. Ownership of the data region is
+ * transferred by this call */
+static void process_msg(prte_oob_tcp_peer_t *peer, prte_oob_tcp_hdr_t *hdr, char *data)
+{
+    prte_rml_send_t *snd;
+    prte_oob_send_t *cd;
+    pmix_byte_object_t bo;
+    pmix_status_t rc;
+
+    pmix_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base.output,
+                        "%s RECVD COMPLETE MESSAGE FROM %s (ORIGIN %s) OF %d BYTES FOR DEST %s TAG %d",
+                        PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_NAME_PRINT(&peer->name),
+                        PRTE_NAME_PRINT(&hdr->origin), (int) hdr->nbytes,
+                        PRTE_NAME_PRINT(&hdr->dst), hdr->tag);
+
+    /* if the sender protected the body, check it before we
+     * either deliver or relay it - a relayed message is
+     * protected anew for the next hop */
+    if (hdr->csum && hdr->crc != prte_crc32c(data, hdr->nbytes)) {
+        pmix_show_help("help-oob-tcp.txt", "msg-corrupt", true,
+                       PRTE_NAME_PRINT(&hdr->origin), PRTE_NAME_PRINT(&peer->name),
+                       PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), hdr->tag, hdr->nbytes);
+        free(data);
+        return;
+    }
+
+    /* am I the intended recipient? */
+    if (PMIX_CHECK_PROCID(&hdr->dst, PRTE_PROC_MY_NAME)) {
+        /* yes - post it to the RML for delivery */
+        pmix_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base.output,
+                            "%s DELIVERING TO RML tag = %d seq_num = %d",
+                            PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), hdr->tag, hdr->seq_num);
+        PRTE_RML_POST_MESSAGE(&hdr->origin, hdr->tag, hdr->seq_num, data, hdr->nbytes);
+        return;
+    }
+
+    /* promote this to the OOB as some other transport might
+     * be the next best hop */
+    pmix_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base.output,
+                        "%s TCP PROMOTING ROUTED MESSAGE FOR %s TO OOB",
+                        PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_NAME_PRINT(&hdr->dst));
+    snd = PMIX_NEW(prte_rml_send_t);
+    snd->dst = hdr->dst;
+    PMIX_XFER_PROCID(&snd->origin, &hdr->origin);
+    snd->tag = hdr->tag;
+    bo.bytes = data;
+    bo.size = hdr->nbytes;
+    PMIX_DATA_BUFFER_CREATE(snd->dbuf);
+    rc = PMIx_Data_load(snd->dbuf, &bo);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+    }
+    snd->seq_num = hdr->seq_num;
+    snd->cbfunc = NULL;
+    snd->cbdata = NULL;
+    if (prte_oob_base.ev_base == prte_event_base) {
+        /* activate the OOB send state */
+        PRTE_OOB_SEND(snd);
+        return;
+    }
+    /* the next hop has to be found on the main thread */
+    cd = PMIX_NEW(prte_oob_send_t);
+    cd->msg = snd;
+    PRTE_PMIX_THREADSHIFT(cd, prte_event_base, relay_msg);
+}
+
+/* A message in the ring could not be given a data region of its
+ * own. Rather than quietly lose it, fail the connection so the loss
+ * is handled like that of any other connection */
+static void recv_ring_failed(prte_oob_tcp_peer_t *peer)
+{
+    PRTE_ERROR_LOG(PRTE_ERR_OUT_OF_RESOURCE);
+    pmix_output(0, "%s-%s prte_oob_tcp_peer_recv_handler: unable to allocate message\n",
+                PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_NAME_PRINT(&(peer->name)));
+    peer->state = MCA_OOB_TCP_FAILED;
+    prte_oob_tcp_peer_close(peer);
+}
+
+/* Read everything the socket has into the staging ring and parse
+ * as many framed messages out of it as are complete. A message that
+ * is too large to ever fit in the ring is handed off to the
+ * per-message path in peer->recv_msg */
+static void recv_ring(prte_oob_tcp_peer_t *peer)
+{
+    prte_oob_tcp_hdr_t hdr;
+    size_t avail;
+    char *data;
+    int rc;
+
+    if (NULL == peer->rring) {
+        peer->rring_size = prte_oob_base.recv_ring_size;
+        peer->rring = (char *) malloc(peer->rring_size);
+        if (NULL == peer->rring) {
+            pmix_output(0, "%s-%s prte_oob_tcp_peer_recv_handler: unable to allocate recv ring\n",
+                        PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_NAME_PRINT(&(peer->name)));
+            return;
+        }
+        peer->rring_head = 0;
+        peer->rring_tail = 0;
+    }
+
+    rc = read_ring(peer);
+    if (PRTE_ERR_RESOURCE_BUSY == rc || PRTE_ERR_WOULD_BLOCK == rc) {
+        /* exit this event and let the event lib progress */
+        return;
+    } else if (PRTE_SUCCESS != rc) {
+        /* close the connection */
+        pmix_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base.output,
+                            "%s:tcp:recv:handler error reading bytes - closing connection",
+                            PRTE_NAME_PRINT(PRTE_PROC_MY_NAME));
+        prte_oob_tcp_peer_close(peer);
+        return;
+    }
+
+    while (sizeof(prte_oob_tcp_hdr_t) <= peer->rring_tail - peer->rring_head) {
+        memcpy(&hdr, peer->rring + peer->rring_head, sizeof(prte_oob_tcp_hdr_t));
+        MCA_OOB_TCP_HDR_NTOH(&hdr);
+        if (msg_too_big(peer, &hdr)) {
+            return;
+        }
+        avail = peer->rring_tail - peer->rring_head - sizeof(prte_oob_tcp_hdr_t);
+
+        if (hdr.nbytes <= avail) {
+            /* the entire message is in the ring */
+            data = NULL;
+            if (0 < hdr.nbytes) {
+                data = (char *) malloc(hdr.nbytes);
+                if (NULL == data) {
+                    recv_ring_failed(peer);
+                    return;
+                }
+                memcpy(data, peer->rring + peer->rring_head + sizeof(prte_oob_tcp_hdr_t),
+                       hdr.nbytes);
+            }
+            peer->rring_head += sizeof(prte_oob_tcp_hdr_t) + hdr.nbytes;
+            process_msg(peer, &hdr, data);
+            continue;
+        }
+
+        if (peer->rring_size < sizeof(prte_oob_tcp_hdr_t) + hdr.nbytes) {
+            /* this message can never fit in the ring - move what we
+             * have of it into a dedicated recv and read the remainder
+             * directly into its data region */
+            peer->recv_msg = PMIX_NEW(prte_oob_tcp_recv_t);
+            peer->recv_msg->hdr = hdr;
+            peer->recv_msg->hdr_recvd = true;
+            peer->recv_msg->data = (char *) malloc(hdr.nbytes);
+            if (NULL == peer->recv_msg->data) {
+                PMIX_RELEASE(peer->recv_msg);
+                peer->recv_msg = NULL;
+                recv_ring_failed(peer);
+                return;
+            }
+            memcpy(peer->recv_msg->data,
+                   peer->rring + peer->rring_head + sizeof(prte_oob_tcp_hdr_t), avail);
+            peer->recv_msg->rdptr = peer->recv_msg->data + avail;
+            peer->recv_msg->rdbytes = hdr.nbytes - avail;
+            peer->rring_head = peer->rring_tail;
+        }
+        break;
+    }
+
+    /* shift any partial message to the front of the ring */
+    if (peer->rring_head == peer->rring_tail) {
+        peer->rring_head = 0;
+        peer->rring_tail = 0;
+    } else if (0 < peer->rring_head) {
+        memmove(peer->rring, peer->rring + peer->rring_head,
+                peer->rring_tail - peer->rring_head);
+        peer->rring_tail -= peer->rring_head;
+        peer->rring_head = 0;
+    }
+}
+
 /*
  * Dispatch to the appropriate action routine based on the state
  * of the connection with the peer.
@@ -382,8 +742,6 @@ void prte_oob_tcp_recv_handler(int sd, short flags, void *cbdata)
 {
     prte_oob_tcp_peer_t *peer = (prte_oob_tcp_peer_t *) cbdata;
     int rc;
-    prte_rml_send_t *snd;
-    pmix_byte_object_t bo;
     PRTE_HIDE_UNUSED_PARAMS(sd, flags);
 
     PMIX_ACQUIRE_OBJECT(peer);
@@ -434,6 +792,12 @@ void prte_oob_tcp_recv_handler(int sd, short flags, void *cbdata)
     case MCA_OOB_TCP_CONNECTED:
         pmix_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base.output,
                             "%s:tcp:recv:handler CONNECTED", PRTE_NAME_PRINT(PRTE_PROC_MY_NAME));
+        /* unless we are in the middle of a message that was too
+         * large for the ring, batch the read through the ring */
+        if (NULL == peer->recv_msg && 0 < prte_oob_base.recv_ring_size) {
+            recv_ring(peer);
+            return;
+        }
         /* allocate a new message and setup for recv */
         if (NULL == peer->recv_msg) {
             pmix_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base.output,
@@ -473,12 +837,7 @@ void prte_oob_tcp_recv_handler(int sd, short flags, void *cbdata)
                                         "%s:tcp:recv:handler allocate data region of size %lu",
                                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
                                         (unsigned long) peer->recv_msg->hdr.nbytes);
-                    if (peer->recv_msg->hdr.nbytes > (uint32_t)(prte_oob_base.max_msg_size * 1024 * 1024)) {
-                        pmix_show_help("help-oob-tcp.txt", "msg-too-big", true,
-                                        PRTE_NAME_PRINT(&peer->name), PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
-                                        peer->recv_msg->hdr.nbytes, prte_oob_base.max_msg_size);
-                        peer->state = MCA_OOB_TCP_FAILED;
-                        prte_oob_tcp_peer_close(peer);
+                    if (msg_too_big(peer, &peer->recv_msg->hdr)) {
                         return;
                     }
                     /* allocate the data region */
@@ -507,54 +866,11 @@ void prte_oob_tcp_recv_handler(int sd, short flags, void *cbdata)
              * beginning or somewhere in the message
              */
             if (PRTE_SUCCESS == (rc = read_bytes(peer))) {
-                /* we recvd all of the message */
-                pmix_output_verbose(
-                    OOB_TCP_DEBUG_CONNECT, prte_oob_base.output,
-                    "%s RECVD COMPLETE MESSAGE FROM %s (ORIGIN %s) OF %d BYTES FOR DEST %s TAG %d",
-                    PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_NAME_PRINT(&peer->name),
-                    PRTE_NAME_PRINT(&peer->recv_msg->hdr.origin), (int) peer->recv_msg->hdr.nbytes,
-                    PRTE_NAME_PRINT(&peer->recv_msg->hdr.dst), peer->recv_msg->hdr.tag);
-
-                /* am I the intended recipient (header was already converted back to host order)? */
-                if (PMIX_CHECK_PROCID(&peer->recv_msg->hdr.dst, PRTE_PROC_MY_NAME)) {
-                    /* yes - post it to the RML for delivery */
-                    pmix_output_verbose(OOB_TCP_DEBUG_CONNECT,
-                                        prte_oob_base.output,
-                                        "%s DELIVERING TO RML tag = %d seq_num = %d",
-                                        PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), peer->recv_msg->hdr.tag,
-                                        peer->recv_msg->hdr.seq_num);
-                    PRTE_RML_POST_MESSAGE(&peer->recv_msg->hdr.origin, peer->recv_msg->hdr.tag,
-                                          peer->recv_msg->hdr.seq_num, peer->recv_msg->data,
-                                          peer->recv_msg->hdr.nbytes);
-                    PMIX_RELEASE(peer->recv_msg);
-                } else {
-                    /* promote this to the OOB as some other transport might
-                     * be the next best hop */
-                    pmix_output_verbose(OOB_TCP_DEBUG_CONNECT,
-                                        prte_oob_base.output,
-                                        "%s TCP PROMOTING ROUTED MESSAGE FOR %s TO OOB",
-                                        PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
-                                        PRTE_NAME_PRINT(&peer->recv_msg->hdr.dst));
-                    snd = PMIX_NEW(prte_rml_send_t);
-                    snd->dst = peer->recv_msg->hdr.dst;
-                    PMIX_XFER_PROCID(&snd->origin, &peer->recv_msg->hdr.origin);
-                    snd->tag = peer->recv_msg->hdr.tag;
-                    bo.bytes = peer->recv_msg->data;
-                    bo.size = peer->recv_msg->hdr.nbytes;
-                    PMIX_DATA_BUFFER_CREATE(snd->dbuf);
-                    rc = PMIx_Data_load(snd->dbuf, &bo);
-                    if (PMIX_SUCCESS != rc) {
-                        PMIX_ERROR_LOG(rc);
-                    }
-                    snd->seq_num = peer->recv_msg->hdr.seq_num;
-                    snd->cbfunc = NULL;
-                    snd->cbdata = NULL;
-                    /* activate the OOB send state */
-                    PRTE_OOB_SEND(snd);
-                    /* cleanup */
-                    peer->recv_msg->data = NULL;
-                    PMIX_RELEASE(peer->recv_msg);
-                }
+                /* we recvd all of the message - the data region
+                 * now belongs to whoever processes it */
+                process_msg(peer, &peer->recv_msg->hdr, peer->recv_msg->data);
+                peer->recv_msg->data = NULL;
+                PMIX_RELEASE(peer->recv_msg);
                 peer->recv_msg = NULL;
                 return;
             } else if (PRTE_ERR_RESOURCE_BUSY == rc || PRTE_ERR_WOULD_BLOCK == rc) {
@@ -29,6 +29,7 @@
 #include "prte_config.h"
 
 #include "src/class/pmix_list.h"
+#include "src/util/crc.h"
 #include "src/util/pmix_string_copy.h"
 
 #include "src/rml/oob/oob_tcp.h"
@@ -86,7 +87,7 @@ PMIX_CLASS_DECLARATION(prte_oob_tcp_recv_t);
     do {                                                                        \
         (s)->peer = (struct prte_oob_tcp_peer_t *) (p);                         \
         (s)->activate = (f);                                                    \
-        PRTE_PMIX_THREADSHIFT((s), prte_event_base, prte_oob_tcp_queue_msg);    \
+        PRTE_PMIX_THREADSHIFT((s), prte_oob_base.ev_base, prte_oob_tcp_queue_msg); \
     } while (0)
 
 /* queue a message to be sent by one of our modules - must
@@ -112,6 +113,12 @@ PMIX_CLASS_DECLARATION(prte_oob_tcp_recv_t);
         _s->msg = (m);                                                                         \
         /* set the total number of bytes to be sent */                                         \
         _s->hdr.nbytes = (m)->dbuf->bytes_used;                                                 \
+        /* protect the body if requested */                                                    \
+        _s->hdr.csum = prte_oob_base.checksum;                                                 \
+        _s->hdr.crc = 0;                                                                       \
+        if (_s->hdr.csum) {                                                                    \
+            _s->hdr.crc = prte_crc32c((m)->dbuf->base_ptr, (m)->dbuf->bytes_used);             \
+        }                                                                                      \
         /* prep header for xmission */                                                         \
         MCA_OOB_TCP_HDR_HTON(&_s->hdr);                                                        \
         /* start the send with the header */                                                   \
@@ -144,6 +151,12 @@ PMIX_CLASS_DECLARATION(prte_oob_tcp_recv_t);
         _s->msg = (m);                                                                            \
         /* set the total number of bytes to be sent */                                            \
         _s->hdr.nbytes = (m)->dbuf->bytes_used;                                                    \
+        /* protect the body if requested */                                                       \
+        _s->hdr.csum = prte_oob_base.checksum;                                                    \
+        _s->hdr.crc = 0;                                                                          \
+        if (_s->hdr.csum) {                                                                       \
+            _s->hdr.crc = prte_crc32c((m)->dbuf->base_ptr, (m)->dbuf->bytes_used);                \
+        }                                                                                         \
         /* prep header for xmission */                                                            \
         MCA_OOB_TCP_HDR_HTON(&_s->hdr);                                                           \
         /* start the send with the header */                                                      \
@@ -201,7 +214,7 @@ PMIX_CLASS_DECLARATION(prte_oob_tcp_msg_op_t);
                             __FILE__, __LINE__, PRTE_NAME_PRINT(&((ms)->dst)));               \
         mop = PMIX_NEW(prte_oob_tcp_msg_op_t);                                                \
         mop->msg = (ms);                                                                      \
-        PRTE_PMIX_THREADSHIFT(mop, prte_event_base, (cbfunc));                                \
+        PRTE_PMIX_THREADSHIFT(mop, prte_oob_base.ev_base, (cbfunc));                          \
     } while (0);
 
 typedef struct {
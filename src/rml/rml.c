@@ -36,16 +36,34 @@
 prte_rml_base_t prte_rml_base = {
     .rml_output = -1,
     .routed_output = -1,
-    .posted_recvs = PMIX_LIST_STATIC_INIT,
-    .unmatched_msgs = PMIX_LIST_STATIC_INIT,
     .max_retries = 0,
     .lifeline = PMIX_RANK_INVALID,
+    .launch_parent = PMIX_RANK_INVALID,
     .children = PMIX_LIST_STATIC_INIT,
     .radix = 64,
     .static_ports = false
 };
 
 static int verbosity = 0;
+static bool rml_opened = false;
+
+static void destruct_tag_lists(pmix_list_t *lists, pmix_hash_table_t *table)
+{
+    pmix_list_t *lst;
+    uint32_t key;
+    void *node;
+    int n, rc;
+
+    for (n = 0; n < PRTE_RML_TAG_MAX; n++) {
+        PMIX_LIST_DESTRUCT(&lists[n]);
+    }
+    rc = pmix_hash_table_get_first_key_uint32(table, &key, (void **) &lst, &node);
+    while (PMIX_SUCCESS == rc) {
+        PMIX_LIST_RELEASE(lst);
+        rc = pmix_hash_table_get_next_key_uint32(table, &key, (void **) &lst, node, &node);
+    }
+    PMIX_DESTRUCT(table);
+}
 
 void prte_rml_register(void)
 {
@@ -100,8 +118,11 @@ void prte_rml_register(void)
 void prte_rml_close(void)
 {
     prte_oob_close();
-    PMIX_LIST_DESTRUCT(&prte_rml_base.posted_recvs);
-    PMIX_LIST_DESTRUCT(&prte_rml_base.unmatched_msgs);
+    if (rml_opened) {
+        destruct_tag_lists(prte_rml_base.posted_recvs, &prte_rml_base.dyn_posted_recvs);
+        destruct_tag_lists(prte_rml_base.unmatched_msgs, &prte_rml_base.dyn_unmatched_msgs);
+        rml_opened = false;
+    }
     PMIX_LIST_DESTRUCT(&prte_rml_base.children);
     if (0 <= prte_rml_base.rml_output) {
         pmix_output_close(prte_rml_base.rml_output);
@@ -112,11 +133,18 @@ int prte_rml_open(void)
 {
     char *uri = NULL;
     pmix_value_t val;
-    int ret;
+    int ret, n;
 
-    /* construct object for holding the active plugin modules */
-    PMIX_CONSTRUCT(&prte_rml_base.posted_recvs, pmix_list_t);
-    PMIX_CONSTRUCT(&prte_rml_base.unmatched_msgs, pmix_list_t);
+    /* construct the tag-indexed recv and msg lists */
+    for (n = 0; n < PRTE_RML_TAG_MAX; n++) {
+        PMIX_CONSTRUCT(&prte_rml_base.posted_recvs[n], pmix_list_t);
+        PMIX_CONSTRUCT(&prte_rml_base.unmatched_msgs[n], pmix_list_t);
+    }
+    PMIX_CONSTRUCT(&prte_rml_base.dyn_posted_recvs, pmix_hash_table_t);
+    pmix_hash_table_init(&prte_rml_base.dyn_posted_recvs, 16);
+    PMIX_CONSTRUCT(&prte_rml_base.dyn_unmatched_msgs, pmix_hash_table_t);
+    pmix_hash_table_init(&prte_rml_base.dyn_unmatched_msgs, 16);
+    rml_opened = true;
     PMIX_CONSTRUCT(&prte_rml_base.children, pmix_list_t);
 
     /* compute the routing tree - only thing we need to know is the
@@ -125,7 +153,11 @@ int prte_rml_open(void)
 
     prte_rml_base.lifeline = PRTE_PROC_MY_PARENT->rank;
 
-    prte_oob_open();
+    ret = prte_oob_open();
+    if (PRTE_SUCCESS != ret) {
+        PRTE_ERROR_LOG(ret);
+        return ret;
+    }
 
     /* store our URI for later */
     prte_oob_base_get_addr(&uri);
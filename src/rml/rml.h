@@ -45,6 +45,7 @@
 #    include <unistd.h>
 #endif
 
+#include "src/class/pmix_hash_table.h"
 #include "src/rml/rml_types.h"
 #include "src/pmix/pmix-internal.h"
 
@@ -147,9 +148,19 @@ typedef struct {
     int routed_output;
     int oob_output;
     int max_retries;
-    pmix_list_t posted_recvs;
-    pmix_list_t unmatched_msgs;
+    /* posted recvs and unmatched msgs are indexed by tag - the
+     * well-known tags are directly indexed, while any tag at or
+     * above PRTE_RML_TAG_MAX is found via the hash tables. Each
+     * entry is a list so that recvs from different (or wildcard)
+     * peers on the same tag can coexist */
+    pmix_list_t posted_recvs[PRTE_RML_TAG_MAX];
+    pmix_list_t unmatched_msgs[PRTE_RML_TAG_MAX];
+    pmix_hash_table_t dyn_posted_recvs;
+    pmix_hash_table_t dyn_unmatched_msgs;
     pmix_rank_t lifeline;
+    /* daemon that launched us when the launch tree differs
+     * from the routing tree */
+    pmix_rank_t launch_parent;
     pmix_list_t children;
     int radix;
     bool static_ports;
@@ -168,6 +179,8 @@ PRTE_EXPORT void prte_rml_send_callback(int status, pmix_proc_t *peer,
                                         prte_rml_tag_t tag, void *cbdata);
 PRTE_EXPORT void prte_rml_compute_routing_tree(void);
 PRTE_EXPORT int prte_rml_get_num_contributors(pmix_rank_t *dmns, size_t ndmns);
+PRTE_EXPORT int prte_rml_get_tree_children(pmix_rank_t rank, pmix_rank_t ndaemons,
+                                           pmix_rank_t *children);
 PRTE_EXPORT int prte_rml_route_lost(pmix_rank_t route);
 PRTE_EXPORT pmix_rank_t prte_rml_get_route(pmix_rank_t target);
 
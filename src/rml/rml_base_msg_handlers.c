@@ -52,10 +52,37 @@
 
 static void msg_match_recv(prte_rml_posted_recv_t *rcv, bool get_all);
 
+/* return the list holding entries for the given tag, creating
+ * it if requested and the tag is beyond the directly-indexed
+ * range. Returns NULL if no such list exists */
+static pmix_list_t *tag_list(pmix_list_t *lists, pmix_hash_table_t *table,
+                             prte_rml_tag_t tag, bool create)
+{
+    pmix_list_t *lst = NULL;
+
+    if (tag < PRTE_RML_TAG_MAX) {
+        return &lists[tag];
+    }
+    if (PMIX_SUCCESS == pmix_hash_table_get_value_uint32(table, tag, (void **) &lst)) {
+        return lst;
+    }
+    if (create) {
+        lst = PMIX_NEW(pmix_list_t);
+        pmix_hash_table_set_value_uint32(table, tag, lst);
+    }
+    return lst;
+}
+
+#define POSTED_RECVS(t, c) \
+    tag_list(prte_rml_base.posted_recvs, &prte_rml_base.dyn_posted_recvs, (t), (c))
+#define UNMATCHED_MSGS(t, c) \
+    tag_list(prte_rml_base.unmatched_msgs, &prte_rml_base.dyn_unmatched_msgs, (t), (c))
+
 void prte_rml_base_post_recv(int sd, short args, void *cbdata)
 {
     prte_rml_recv_request_t *req = (prte_rml_recv_request_t *) cbdata;
     prte_rml_posted_recv_t *post, *recv;
+    pmix_list_t *posted;
     PRTE_HIDE_UNUSED_PARAMS(sd, args);
 
     PMIX_ACQUIRE_OBJECT(req);
@@ -72,20 +99,25 @@ void prte_rml_base_post_recv(int sd, short args, void *cbdata)
         return;
     }
     post = req->post;
+    posted = POSTED_RECVS(post->tag, !req->cancel);
 
     /* if the request is to cancel a recv, then find the recv
      * and remove it from our list
      */
     if (req->cancel) {
-        PMIX_LIST_FOREACH(recv, &prte_rml_base.posted_recvs, prte_rml_posted_recv_t)
+        if (NULL == posted) {
+            PMIX_RELEASE(req);
+            return;
+        }
+        PMIX_LIST_FOREACH(recv, posted, prte_rml_posted_recv_t)
         {
-            if (PMIX_CHECK_PROCID(&post->peer, &recv->peer) && post->tag == recv->tag) {
+            if (PMIX_CHECK_PROCID(&post->peer, &recv->peer)) {
                 pmix_output_verbose(5, prte_rml_base.rml_output,
                                     "%s canceling recv %d for peer %s",
                                     PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), post->tag,
                                     PRTE_NAME_PRINT(&recv->peer));
                 /* got a match - remove it */
-                pmix_list_remove_item(&prte_rml_base.posted_recvs, &recv->super);
+                pmix_list_remove_item(posted, &recv->super);
                 PMIX_RELEASE(recv);
                 break;
             }
@@ -95,9 +127,9 @@ void prte_rml_base_post_recv(int sd, short args, void *cbdata)
     }
 
     /* bozo check - cannot have two receives for the same peer/tag combination */
-    PMIX_LIST_FOREACH(recv, &prte_rml_base.posted_recvs, prte_rml_posted_recv_t)
+    PMIX_LIST_FOREACH(recv, posted, prte_rml_posted_recv_t)
     {
-        if (PMIX_CHECK_PROCID(&post->peer, &recv->peer) && post->tag == recv->tag) {
+        if (PMIX_CHECK_PROCID(&post->peer, &recv->peer)) {
             pmix_output(0, "%s TWO RECEIVES WITH SAME PEER %s AND TAG %d - ABORTING",
                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_NAME_PRINT(&post->peer),
                         post->tag);
@@ -111,7 +143,7 @@ void prte_rml_base_post_recv(int sd, short args, void *cbdata)
                         (post->persistent) ? "persistent" : "non-persistent", post->tag,
                         PRTE_NAME_PRINT(&post->peer));
     /* add it to the list of recvs */
-    pmix_list_append(&prte_rml_base.posted_recvs, &post->super);
+    pmix_list_append(posted, &post->super);
     req->post = NULL;
     /* handle any messages that may have already arrived for this recv */
     msg_match_recv(post, post->persistent);
@@ -124,13 +156,20 @@ static void msg_match_recv(prte_rml_posted_recv_t *rcv, bool get_all)
 {
     pmix_list_item_t *item, *next;
     prte_rml_recv_t *msg;
+    pmix_list_t *unmatched;
+
+    /* only messages with this tag can match */
+    unmatched = UNMATCHED_MSGS(rcv->tag, false);
+    if (NULL == unmatched) {
+        return;
+    }
 
     /* scan thru the list of unmatched recvd messages and
      * see if any matches this spec - if so, push the first
      * into the recvd msg queue and look no further
      */
-    item = pmix_list_get_first(&prte_rml_base.unmatched_msgs);
-    while (item != pmix_list_get_end(&prte_rml_base.unmatched_msgs)) {
+    item = pmix_list_get_first(unmatched);
+    while (item != pmix_list_get_end(unmatched)) {
         next = pmix_list_get_next(item);
         msg = (prte_rml_recv_t *) item;
         pmix_output_verbose(5, prte_rml_base.rml_output,
@@ -141,9 +180,9 @@ static void msg_match_recv(prte_rml_posted_recv_t *rcv, bool get_all)
         /* since names could include wildcards, must use
          * the more generalized comparison function
          */
-        if (PMIX_CHECK_PROCID(&msg->sender, &rcv->peer) && msg->tag == rcv->tag) {
+        if (PMIX_CHECK_PROCID(&msg->sender, &rcv->peer)) {
+            pmix_list_remove_item(unmatched, item);
             PRTE_RML_ACTIVATE_MESSAGE(msg);
-            pmix_list_remove_item(&prte_rml_base.unmatched_msgs, item);
             if (!get_all) {
                 break;
             }
@@ -156,6 +195,7 @@ void prte_rml_base_process_msg(int fd, short flags, void *cbdata)
 {
     prte_rml_recv_t *msg = (prte_rml_recv_t *) cbdata;
     prte_rml_posted_recv_t *post;
+    pmix_list_t *posted;
     PRTE_HIDE_UNUSED_PARAMS(fd, flags);
 
     PMIX_ACQUIRE_OBJECT(msg);
@@ -190,13 +230,19 @@ void prte_rml_base_process_msg(int fd, short flags, void *cbdata)
         }
     }
 
-    /* see if we have a waiting recv for this message */
-    PMIX_LIST_FOREACH(post, &prte_rml_base.posted_recvs, prte_rml_posted_recv_t)
+    /* see if we have a waiting recv for this message - only
+     * recvs posted on this tag need to be checked. Don't create
+     * a list for a dynamic tag nobody has posted on */
+    posted = POSTED_RECVS(msg->tag, false);
+    if (NULL == posted) {
+        goto unmatched;
+    }
+    PMIX_LIST_FOREACH(post, posted, prte_rml_posted_recv_t)
     {
         /* since names could include wildcards, must use
          * the more generalized comparison function
          */
-        if (PMIX_CHECK_PROCID(&msg->sender, &post->peer) && msg->tag == post->tag) {
+        if (PMIX_CHECK_PROCID(&msg->sender, &post->peer)) {
             /* deliver the data to this location */
             post->cbfunc(PRTE_SUCCESS, &msg->sender, msg->dbuf, msg->tag, post->cbdata);
             /* the user must have unloaded the buffer if they wanted
@@ -214,7 +260,7 @@ void prte_rml_base_process_msg(int fd, short flags, void *cbdata)
                                  PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), post->tag));
             /* if the recv is non-persistent, remove it */
             if (!post->persistent) {
-                pmix_list_remove_item(&prte_rml_base.posted_recvs, &post->super);
+                pmix_list_remove_item(posted, &post->super);
                 /*PMIX_OUTPUT_VERBOSE((5, prte_rml_base.rml_output,
                                      "%s non persistent recv %p remove success releasing now",
                                      PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
@@ -224,6 +270,7 @@ void prte_rml_base_process_msg(int fd, short flags, void *cbdata)
             return;
         }
     }
+unmatched:
     /* we get here if no matching recv was found - we then hold
      * the message until such a recv is issued
      */
@@ -231,5 +278,5 @@ void prte_rml_base_process_msg(int fd, short flags, void *cbdata)
         (5, prte_rml_base.rml_output,
          "%s message received bytes from %s for tag %d Not Matched adding to unmatched msgs",
          PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_NAME_PRINT(&msg->sender), msg->tag));
-    pmix_list_append(&prte_rml_base.unmatched_msgs, &msg->super);
+    pmix_list_append(UNMATCHED_MSGS(msg->tag, true), &msg->super);
 }
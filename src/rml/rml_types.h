@@ -174,6 +174,18 @@ typedef void (*prte_rml_buffer_callback_fn_t)(int status, pmix_proc_t *peer,
 #define PRTE_RML_TAG_MONITOR_REQUEST      76
 #define PRTE_RML_TAG_MONITOR_RESP         77
 
+// DVM state sync for newly added daemons
+#define PRTE_RML_TAG_DVM_SYNC             78
+#define PRTE_RML_TAG_DVM_SYNC_RESP        79
+
+// launch timeline records
+#define PRTE_RML_TAG_TIMELINE             80
+
+// resource usage queries
+#define PRTE_RML_TAG_RUSAGE_REQUEST       81
+#define PRTE_RML_TAG_RUSAGE               82
+#define PRTE_RML_TAG_RUSAGE_RESP          83
+
 #define PRTE_RML_TAG_MAX                 100
 
 #define PRTE_RML_TAG_NTOH(t) ntohl(t)
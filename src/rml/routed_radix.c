@@ -54,6 +54,14 @@ pmix_rank_t prte_rml_get_route(pmix_rank_t target)
         goto found;
     }
 
+    /* we can always reach the daemon that launched us, even
+     * before we know how to reach our routing parent */
+    if (PMIX_RANK_INVALID != prte_rml_base.launch_parent &&
+        prte_rml_base.launch_parent == target) {
+        ret = target;
+        goto found;
+    }
+
     /* search routing tree for next step to that daemon */
     PMIX_LIST_FOREACH(child, &prte_rml_base.children, prte_routed_tree_t)
     {
@@ -121,24 +129,36 @@ int prte_rml_route_lost(pmix_rank_t route)
     return PRTE_SUCCESS;
 }
 
-static void radix_tree(int rank,
-                       pmix_list_t *children,
-                       pmix_bitmap_t *relatives)
+/* locate a rank in the radix tree - returns the number of ranks
+ * in its level and, if first is given, the lowest rank in that
+ * level. The children of a rank are rank + n * level-size for
+ * n = 1..radix, and its parent is found by reversing that */
+static uint64_t tree_level(uint64_t rank, uint64_t *first)
 {
-    int i, peer, Sum, NInLevel;
-    prte_routed_tree_t *child;
-    pmix_bitmap_t *relations;
+    uint64_t Sum, NInLevel;
 
-    /* compute how many procs are at my level */
     Sum = 1;
     NInLevel = 1;
-
     while (Sum < (rank + 1)) {
         NInLevel *= prte_rml_base.radix;
         Sum += NInLevel;
     }
+    if (NULL != first) {
+        *first = Sum - NInLevel;
+    }
+    return NInLevel;
+}
+
+static void radix_tree(int rank,
+                       pmix_list_t *children,
+                       pmix_bitmap_t *relatives)
+{
+    int i, peer, NInLevel;
+    prte_routed_tree_t *child;
+    pmix_bitmap_t *relations;
 
     /* our children start at our rank + num_in_level */
+    NInLevel = (int) tree_level(rank, NULL);
     peer = rank + NInLevel;
     for (i = 0; i < prte_rml_base.radix; i++) {
         if (peer < (int) prte_process_info.num_daemons) {
@@ -174,19 +194,14 @@ void prte_rml_compute_routing_tree(void)
     int j;
     int Sum, NInLevel, Ii;
     int NInPrevLevel;
+    uint64_t first;
     prte_job_t *dmns;
     prte_proc_t *d;
 
     /* compute my parent */
     Ii = PRTE_PROC_MY_NAME->rank;
-    Sum = 1;
-    NInLevel = 1;
-
-    while (Sum < (Ii + 1)) {
-        NInLevel *= prte_rml_base.radix;
-        Sum += NInLevel;
-    }
-    Sum -= NInLevel;
+    NInLevel = (int) tree_level(Ii, &first);
+    Sum = (int) first;
 
     NInPrevLevel = NInLevel / prte_rml_base.radix;
 
@@ -235,6 +250,27 @@ void prte_rml_compute_routing_tree(void)
     }
 }
 
+/* compute the direct children of any daemon in a routing tree
+ * spanning the given number of daemons - the children array
+ * must have room for prte_rml_base.radix entries */
+int prte_rml_get_tree_children(pmix_rank_t rank, pmix_rank_t ndaemons,
+                               pmix_rank_t *children)
+{
+    uint64_t peer, NInLevel;
+    int i, n;
+
+    /* the children start at rank + num_in_level, exactly
+     * as in our own routing tree */
+    n = 0;
+    NInLevel = tree_level(rank, NULL);
+    peer = rank + NInLevel;
+    for (i = 0; i < prte_rml_base.radix && peer < ndaemons; i++) {
+        children[n++] = (pmix_rank_t) peer;
+        peer += NInLevel;
+    }
+    return n;
+}
+
 int prte_rml_get_num_contributors(pmix_rank_t *dmns, size_t ndmns)
 {
     int j, n;
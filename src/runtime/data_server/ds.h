@@ -31,6 +31,7 @@
 #include "prte_config.h"
 #include "types.h"
 
+#include "src/class/pmix_hash_table.h"
 #include "src/pmix/pmix-internal.h"
 
 BEGIN_C_DECLS
@@ -74,6 +75,28 @@ typedef struct {
 PMIX_CLASS_DECLARATION(prte_data_req_t);
 
 
+/* define a reference to either a data object or a pending
+ * request - used to track them in the per-key index */
+typedef struct {
+    pmix_list_item_t super;
+    prte_data_object_t *data;
+    prte_data_req_t *req;
+} prte_ds_ref_t;
+PMIX_CLASS_DECLARATION(prte_ds_ref_t);
+
+/* define an entry in the key index - all data objects that
+ * contain this key, and all pending requests waiting for it.
+ * Range and uid checks are still done against the objects
+ * on these lists as they depend on the requestor */
+typedef struct {
+    pmix_object_t super;
+    char *key;
+    pmix_list_t data;
+    pmix_list_t waiters;
+} prte_ds_key_t;
+PMIX_CLASS_DECLARATION(prte_ds_key_t);
+
+
 /* define a container for data object cleanups */
 typedef struct {
     pmix_list_item_t super;
@@ -94,6 +117,7 @@ PMIX_CLASS_DECLARATION(prte_ds_info_t);
 typedef struct {
     pmix_pointer_array_t store;
     pmix_list_t pending;
+    pmix_hash_table_t keys;
     int output;
     int verbosity;
 } prte_data_store_t;
@@ -119,6 +143,14 @@ PRTE_EXPORT void prte_ds_purge(pmix_proc_t *sender,
 PRTE_EXPORT pmix_status_t prte_data_server_check_range(prte_data_req_t *req,
                                                        prte_data_object_t *data);
 
+/* key index support */
+PRTE_EXPORT prte_ds_key_t *prte_ds_get_key(const char *key, bool create);
+PRTE_EXPORT void prte_ds_index_data(prte_data_object_t *data);
+PRTE_EXPORT void prte_ds_unindex_data(prte_data_object_t *data, const char *key);
+PRTE_EXPORT void prte_ds_remove_data(prte_data_object_t *data);
+PRTE_EXPORT void prte_ds_add_waiter(prte_data_req_t *req);
+PRTE_EXPORT void prte_ds_remove_waiter(prte_data_req_t *req, const char *key);
+
 END_C_DECLS
 
 #endif /* PRTE_DS_INTERNAL_H */
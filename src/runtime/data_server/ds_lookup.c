@@ -54,7 +54,7 @@ pmix_status_t prte_ds_lookup(pmix_proc_t *sender, int room_number,
                              pmix_data_buffer_t *answer)
 {
     int32_t count;
-    int i, k;
+    int i;
     size_t nanswers;
     pmix_status_t rc;
     pmix_proc_t requestor;
@@ -68,7 +68,9 @@ pmix_status_t prte_ds_lookup(pmix_proc_t *sender, int room_number,
     pmix_data_range_t range=PMIX_RANGE_UNDEF;
     prte_data_object_t *data;
     prte_ds_info_t *rinfo;
-    prte_info_item_t *ds1, *ds2;
+    prte_info_item_t *ds1;
+    prte_ds_key_t *k;
+    prte_ds_ref_t *ref;
     pmix_list_t answers;
     bool found;
     prte_data_req_t *req, rq;
@@ -153,12 +155,14 @@ pmix_status_t prte_ds_lookup(pmix_proc_t *sender, int room_number,
                             "%s data server: looking for %s",
                             PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), keys[i]);
         found = false;
-        /* cycle across the stored data, looking for a match */
-        for (k = 0; k < prte_data_store.store.size && !found; k++) {
-            data = (prte_data_object_t *) pmix_pointer_array_get_item(&prte_data_store.store, k);
-            if (NULL == data) {
-                continue;
-            }
+        /* cycle across the stored data holding this key, looking for a match */
+        k = prte_ds_get_key(keys[i], false);
+        if (NULL == k) {
+            PMIX_ARGV_APPEND_NOSIZE_COMPAT(&cache, keys[i]);
+            continue;
+        }
+        PMIX_LIST_FOREACH(ref, &k->data, prte_ds_ref_t) {
+            data = ref->data;
             /* for security reasons, can only access data posted by the same user id */
             if (uid != data->uid) {
                 pmix_output_verbose(10, prte_data_store.output,
@@ -172,8 +176,8 @@ pmix_status_t prte_ds_lookup(pmix_proc_t *sender, int room_number,
             if (PMIX_SUCCESS != prte_data_server_check_range(&rq, data)) {
                 continue;
             }
-            /* see if we have this key */
-            PMIX_LIST_FOREACH_SAFE(ds1, ds2, &data->info, prte_info_item_t) {
+            /* find the key within this object */
+            PMIX_LIST_FOREACH(ds1, &data->info, prte_info_item_t) {
                 pmix_output_verbose(10, prte_data_store.output,
                                     "%s COMPARING %s %s",
                                     PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), keys[i],
@@ -182,15 +186,10 @@ pmix_status_t prte_ds_lookup(pmix_proc_t *sender, int room_number,
                     rinfo = PMIX_NEW(prte_ds_info_t);
                     memcpy(&rinfo->source, &data->owner, sizeof(pmix_proc_t));
                     PMIX_INFO_XFER(&rinfo->info, &ds1->info);
-                    // check the persistence
                     pmix_output_verbose(1, prte_data_store.output,
                                         "%s data server: adding %s to data from %s",
                                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), ds1->info.key,
                                         PRTE_NAME_PRINT(&data->owner));
-                    if (PMIX_PERSIST_FIRST_READ == data->persistence) {
-                        pmix_list_remove_item(&data->info, &ds1->super);
-                        PMIX_RELEASE(ds1);
-                    }
                     pmix_list_append(&answers, &rinfo->super);
                     // can only find it once - keys are required to be globally unique
                     // within a given range, and we checked the range above
@@ -198,7 +197,20 @@ pmix_status_t prte_ds_lookup(pmix_proc_t *sender, int room_number,
                     break;
                 }
             }
+            if (found) {
+                break;
+            }
         } // loop over stored data
+        // check the persistence - done outside the loop over the
+        // index as removing the key may release that index entry
+        if (found && PMIX_PERSIST_FIRST_READ == data->persistence) {
+            prte_ds_unindex_data(data, ds1->info.key);
+            pmix_list_remove_item(&data->info, &ds1->super);
+            PMIX_RELEASE(ds1);
+            if (0 == pmix_list_get_size(&data->info)) {
+                prte_ds_remove_data(data);
+            }
+        }
         if (!found) {
             // cache the key
             PMIX_ARGV_APPEND_NOSIZE_COMPAT(&cache, keys[i]);
@@ -261,6 +273,7 @@ pmix_status_t prte_ds_lookup(pmix_proc_t *sender, int room_number,
             req->keys = cache;
             cache = NULL;
             pmix_list_append(&prte_data_store.pending, &req->super);
+            prte_ds_add_waiter(req);
             PMIX_ARGV_FREE_COMPAT(keys);
             PMIX_DATA_BUFFER_DESTRUCT(&pbkt);
             return PMIX_SUCCESS; // do not return an answer
@@ -35,6 +35,7 @@
 #    include <sys/time.h>
 #endif
 
+#include "src/class/pmix_hash_table.h"
 #include "src/class/pmix_pointer_array.h"
 #include "src/pmix/pmix-internal.h"
 #include "src/util/pmix_argv.h"
@@ -90,6 +91,12 @@ int prte_data_server_init(void)
 
     PMIX_CONSTRUCT(&prte_data_store.pending, pmix_list_t);
 
+    PMIX_CONSTRUCT(&prte_data_store.keys, pmix_hash_table_t);
+    if (PMIX_SUCCESS != (rc = pmix_hash_table_init(&prte_data_store.keys, 256))) {
+        PMIX_ERROR_LOG(rc);
+        return rc;
+    }
+
     PRTE_RML_RECV(PRTE_NAME_WILDCARD, PRTE_RML_TAG_DATA_SERVER,
                   PRTE_RML_PERSISTENT, prte_data_server, NULL);
 
@@ -100,12 +107,27 @@ void prte_data_server_finalize(void)
 {
     int32_t i;
     prte_data_object_t *data;
+    prte_ds_key_t *k;
+    void *key, *nptr;
+    size_t keysize;
+    int rc;
 
     if (!initialized) {
         return;
     }
     initialized = false;
 
+    /* the index holds references to the stored data
+     * and pending requests, so release it first */
+    rc = pmix_hash_table_get_first_key_ptr(&prte_data_store.keys, &key, &keysize,
+                                           (void **) &k, &nptr);
+    while (PMIX_SUCCESS == rc) {
+        PMIX_RELEASE(k);
+        rc = pmix_hash_table_get_next_key_ptr(&prte_data_store.keys, &key, &keysize,
+                                              (void **) &k, nptr, &nptr);
+    }
+    PMIX_DESTRUCT(&prte_data_store.keys);
+
     for (i = 0; i < prte_data_store.store.size; i++) {
         data = (prte_data_object_t *) pmix_pointer_array_get_item(&prte_data_store.store, i);
         if (NULL != data) {
@@ -278,6 +300,133 @@ pmix_status_t prte_data_server_check_range(prte_data_req_t *req,
     return PMIX_ERROR;
 }
 
+prte_ds_key_t *prte_ds_get_key(const char *key, bool create)
+{
+    prte_ds_key_t *k = NULL;
+    int rc;
+
+    rc = pmix_hash_table_get_value_ptr(&prte_data_store.keys, key, strlen(key), (void **) &k);
+    if (PMIX_SUCCESS == rc) {
+        return k;
+    }
+    if (!create) {
+        return NULL;
+    }
+    k = PMIX_NEW(prte_ds_key_t);
+    k->key = strdup(key);
+    rc = pmix_hash_table_set_value_ptr(&prte_data_store.keys, k->key, strlen(k->key), k);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_RELEASE(k);
+        return NULL;
+    }
+    return k;
+}
+
+/* drop an index entry once nothing references its key */
+static void key_gc(prte_ds_key_t *k)
+{
+    if (0 == pmix_list_get_size(&k->data) && 0 == pmix_list_get_size(&k->waiters)) {
+        pmix_hash_table_remove_value_ptr(&prte_data_store.keys, k->key, strlen(k->key));
+        PMIX_RELEASE(k);
+    }
+}
+
+void prte_ds_index_data(prte_data_object_t *data)
+{
+    prte_info_item_t *ds;
+    prte_ds_key_t *k;
+    prte_ds_ref_t *ref;
+    bool found;
+
+    PMIX_LIST_FOREACH(ds, &data->info, prte_info_item_t) {
+        k = prte_ds_get_key(ds->info.key, true);
+        if (NULL == k) {
+            continue;
+        }
+        found = false;
+        PMIX_LIST_FOREACH(ref, &k->data, prte_ds_ref_t) {
+            if (ref->data == data) {
+                found = true;
+                break;
+            }
+        }
+        if (!found) {
+            ref = PMIX_NEW(prte_ds_ref_t);
+            PMIX_RETAIN(data);
+            ref->data = data;
+            pmix_list_append(&k->data, &ref->super);
+        }
+    }
+}
+
+void prte_ds_unindex_data(prte_data_object_t *data, const char *key)
+{
+    prte_ds_key_t *k;
+    prte_ds_ref_t *ref;
+
+    k = prte_ds_get_key(key, false);
+    if (NULL == k) {
+        return;
+    }
+    PMIX_LIST_FOREACH(ref, &k->data, prte_ds_ref_t) {
+        if (ref->data == data) {
+            pmix_list_remove_item(&k->data, &ref->super);
+            PMIX_RELEASE(ref);
+            break;
+        }
+    }
+    key_gc(k);
+}
+
+void prte_ds_remove_data(prte_data_object_t *data)
+{
+    prte_info_item_t *ds;
+
+    PMIX_LIST_FOREACH(ds, &data->info, prte_info_item_t) {
+        prte_ds_unindex_data(data, ds->info.key);
+    }
+    pmix_pointer_array_set_item(&prte_data_store.store, data->index, NULL);
+    PMIX_RELEASE(data);
+}
+
+void prte_ds_add_waiter(prte_data_req_t *req)
+{
+    prte_ds_key_t *k;
+    prte_ds_ref_t *ref;
+    int i;
+
+    for (i = 0; NULL != req->keys[i]; i++) {
+        k = prte_ds_get_key(req->keys[i], true);
+        if (NULL == k) {
+            continue;
+        }
+        ref = PMIX_NEW(prte_ds_ref_t);
+        PMIX_RETAIN(req);
+        ref->req = req;
+        pmix_list_append(&k->waiters, &ref->super);
+    }
+}
+
+void prte_ds_remove_waiter(prte_data_req_t *req, const char *key)
+{
+    prte_ds_key_t *k;
+    prte_ds_ref_t *ref;
+
+    k = prte_ds_get_key(key, false);
+    if (NULL == k) {
+        return;
+    }
+    PMIX_LIST_FOREACH(ref, &k->waiters, prte_ds_ref_t) {
+        if (ref->req == req) {
+            pmix_list_remove_item(&k->waiters, &ref->super);
+            PMIX_RELEASE(ref);
+            break;
+        }
+    }
+    key_gc(k);
+}
+
 // CLASS INSTANCE
 static void construct(prte_data_object_t *ptr)
 {
@@ -314,6 +463,44 @@ PMIX_CLASS_INSTANCE(prte_data_req_t,
                     rqcon, rqdes);
 
 
+static void refcon(prte_ds_ref_t *p)
+{
+    p->data = NULL;
+    p->req = NULL;
+}
+static void refdes(prte_ds_ref_t *p)
+{
+    if (NULL != p->data) {
+        PMIX_RELEASE(p->data);
+    }
+    if (NULL != p->req) {
+        PMIX_RELEASE(p->req);
+    }
+}
+PMIX_CLASS_INSTANCE(prte_ds_ref_t,
+                    pmix_list_item_t,
+                    refcon, refdes);
+
+
+static void keycon(prte_ds_key_t *p)
+{
+    p->key = NULL;
+    PMIX_CONSTRUCT(&p->data, pmix_list_t);
+    PMIX_CONSTRUCT(&p->waiters, pmix_list_t);
+}
+static void keydes(prte_ds_key_t *p)
+{
+    if (NULL != p->key) {
+        free(p->key);
+    }
+    PMIX_LIST_DESTRUCT(&p->data);
+    PMIX_LIST_DESTRUCT(&p->waiters);
+}
+PMIX_CLASS_INSTANCE(prte_ds_key_t,
+                    pmix_object_t,
+                    keycon, keydes);
+
+
 PMIX_CLASS_INSTANCE(prte_data_cleanup_t,
                     pmix_list_item_t,
                     NULL, NULL);
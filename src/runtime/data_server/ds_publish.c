@@ -61,7 +61,10 @@ pmix_status_t prte_ds_publish(pmix_proc_t *sender,
     size_t ninfo;
     uint32_t i;
     bool complete_resolved, found;
-    prte_data_req_t *req, *rqnext;
+    prte_data_req_t *req;
+    prte_ds_key_t *k;
+    prte_ds_ref_t *ref, *cand;
+    pmix_list_t candidates;
     pmix_data_buffer_t pbkt;
     pmix_byte_object_t pbo;
     pmix_status_t ret;
@@ -135,18 +138,46 @@ pmix_status_t prte_ds_publish(pmix_proc_t *sender,
         }
     }
 
-    // add this data to our store
+    // add this data to our store and index its keys
     data->index = pmix_pointer_array_add(&prte_data_store.store, data);
+    prte_ds_index_data(data);
 
     pmix_output_verbose(1, prte_data_store.output,
                         "%s data server: checking for pending requests",
                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME));
 
-    /* check for pending requests that match this data */
+    /* collect the pending requests waiting on any of the
+     * keys we were given - a request may be waiting on more
+     * than one of them, so only take it once */
+    PMIX_CONSTRUCT(&candidates, pmix_list_t);
+    PMIX_LIST_FOREACH(ds1, &data->info, prte_info_item_t) {
+        k = prte_ds_get_key(ds1->info.key, false);
+        if (NULL == k) {
+            continue;
+        }
+        PMIX_LIST_FOREACH(ref, &k->waiters, prte_ds_ref_t) {
+            found = false;
+            PMIX_LIST_FOREACH(cand, &candidates, prte_ds_ref_t) {
+                if (cand->req == ref->req) {
+                    found = true;
+                    break;
+                }
+            }
+            if (!found) {
+                cand = PMIX_NEW(prte_ds_ref_t);
+                PMIX_RETAIN(ref->req);
+                cand->req = ref->req;
+                pmix_list_append(&candidates, &cand->super);
+            }
+        }
+    }
+
+    /* check those requests against this data */
     reply = NULL;
     rc = PRTE_SUCCESS;
-    PMIX_LIST_FOREACH_SAFE(req, rqnext, &prte_data_store.pending, prte_data_req_t)
+    PMIX_LIST_FOREACH(cand, &candidates, prte_ds_ref_t)
     {
+        req = cand->req;
         if (req->uid != data->uid) {
             continue;
         }
@@ -184,9 +215,12 @@ pmix_status_t prte_ds_publish(pmix_proc_t *sender,
                     pmix_list_append(&answers, &ds3->super);
                     // if the persistence is "first read", then remove this info
                     if (PMIX_PERSIST_FIRST_READ == data->persistence) {
+                        prte_ds_unindex_data(data, ds1->info.key);
                         pmix_list_remove_item(&data->info, &ds1->super);
                         PMIX_RELEASE(ds1);
                     }
+                    // this request no longer waits on this key
+                    prte_ds_remove_waiter(req, req->keys[i]);
                     found = true;
                     break; // a key can only occur once
                 }
@@ -225,6 +259,7 @@ pmix_status_t prte_ds_publish(pmix_proc_t *sender,
         if (PMIX_SUCCESS != rc) {
             PMIX_ERROR_LOG(rc);
             PMIX_DATA_BUFFER_RELEASE(reply);
+            PMIX_LIST_DESTRUCT(&candidates);
             return rc;
         }
         /* we are responding to a lookup cmd */
@@ -233,6 +268,7 @@ pmix_status_t prte_ds_publish(pmix_proc_t *sender,
         if (PMIX_SUCCESS != rc) {
             PMIX_ERROR_LOG(rc);
             PMIX_DATA_BUFFER_RELEASE(reply);
+            PMIX_LIST_DESTRUCT(&candidates);
             return rc;
         }
         /* if we found all of the requested keys, then indicate so */
@@ -246,6 +282,7 @@ pmix_status_t prte_ds_publish(pmix_proc_t *sender,
         if (PMIX_SUCCESS != rc) {
             PMIX_ERROR_LOG(rc);
             PMIX_DATA_BUFFER_RELEASE(reply);
+            PMIX_LIST_DESTRUCT(&candidates);
             return rc;
         }
 
@@ -258,6 +295,7 @@ pmix_status_t prte_ds_publish(pmix_proc_t *sender,
             PMIX_DATA_BUFFER_DESTRUCT(&pbkt);
             rc = PRTE_ERR_PACK_FAILURE;
             PMIX_DATA_BUFFER_RELEASE(reply);
+            PMIX_LIST_DESTRUCT(&candidates);
             return rc;
         }
         /* loop thru and pack the individual responses - this is somewhat less
@@ -272,6 +310,7 @@ pmix_status_t prte_ds_publish(pmix_proc_t *sender,
                 PMIX_DATA_BUFFER_DESTRUCT(&pbkt);
                 rc = PRTE_ERR_PACK_FAILURE;
                 PMIX_DATA_BUFFER_RELEASE(reply);
+                PMIX_LIST_DESTRUCT(&candidates);
                 return rc;
             }
             /* pack the data */
@@ -281,6 +320,7 @@ pmix_status_t prte_ds_publish(pmix_proc_t *sender,
                 PMIX_DATA_BUFFER_DESTRUCT(&pbkt);
                 rc = PRTE_ERR_PACK_FAILURE;
                 PMIX_DATA_BUFFER_RELEASE(reply);
+                PMIX_LIST_DESTRUCT(&candidates);
                 return rc;
             }
         }
@@ -295,7 +335,7 @@ pmix_status_t prte_ds_publish(pmix_proc_t *sender,
         if (PMIX_SUCCESS != rc) {
             PMIX_ERROR_LOG(rc);
             PMIX_DATA_BUFFER_RELEASE(reply);
-            PMIX_RELEASE(req);
+            PMIX_LIST_DESTRUCT(&candidates);
             return rc;
         }
         PRTE_RML_SEND(rc, req->proxy.rank, reply, PRTE_RML_TAG_DATA_CLIENT);
@@ -305,8 +345,7 @@ pmix_status_t prte_ds_publish(pmix_proc_t *sender,
         }
         if (0 == pmix_list_get_size(&data->info)) {
             // all the data was removed, so we no longer need this entry
-            pmix_pointer_array_set_item(&prte_data_store.store, data->index, NULL);
-            PMIX_RELEASE(data);
+            prte_ds_remove_data(data);
             data = NULL;
         }
         if (complete_resolved) {
@@ -318,6 +357,7 @@ pmix_status_t prte_ds_publish(pmix_proc_t *sender,
             break;
         }
     }
+    PMIX_LIST_DESTRUCT(&candidates);
 
     if (PMIX_SUCCESS == rc) {
         // send back an answer
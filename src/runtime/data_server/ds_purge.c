@@ -85,8 +85,7 @@ void prte_ds_purge(pmix_proc_t *sender,
             continue;
         }
         /* remove the object */
-        pmix_pointer_array_set_item(&prte_data_store.store, data->index, NULL);
-        PMIX_RELEASE(data);
+        prte_ds_remove_data(data);
     }
 
 done:
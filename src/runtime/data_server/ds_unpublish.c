@@ -56,7 +56,9 @@ pmix_status_t prte_ds_unpublish(pmix_proc_t *sender,
     int32_t count;
     prte_data_object_t *data;
     pmix_status_t rc;
-    int k;
+    prte_ds_key_t *k;
+    prte_ds_ref_t *ref, *match;
+    pmix_list_t matches;
     size_t n, ninfo;
     uint32_t i;
     char *str;
@@ -141,12 +143,15 @@ pmix_status_t prte_ds_unpublish(pmix_proc_t *sender,
 
     /* cycle across the provided keys */
     for (i = 0; NULL != rq.keys[i]; i++) {
-        /* cycle across the stored data, looking for a match */
-        for (k = 0; k < prte_data_store.store.size; k++) {
-            data = (prte_data_object_t *) pmix_pointer_array_get_item(&prte_data_store.store, k);
-            if (NULL == data) {
-                continue;
-            }
+        k = prte_ds_get_key(rq.keys[i], false);
+        if (NULL == k) {
+            continue;
+        }
+        /* collect the matching data objects first as removing
+         * the key from them may release this index entry */
+        PMIX_CONSTRUCT(&matches, pmix_list_t);
+        PMIX_LIST_FOREACH(ref, &k->data, prte_ds_ref_t) {
+            data = ref->data;
             /* can only access data posted by the same user id */
             if (rq.uid != data->uid) {
                 continue;
@@ -160,6 +165,13 @@ pmix_status_t prte_ds_unpublish(pmix_proc_t *sender,
             if (PMIX_SUCCESS != prte_data_server_check_range(&rq, data)) {
                 continue;
             }
+            match = PMIX_NEW(prte_ds_ref_t);
+            PMIX_RETAIN(data);
+            match->data = data;
+            pmix_list_append(&matches, &match->super);
+        }
+        PMIX_LIST_FOREACH(match, &matches, prte_ds_ref_t) {
+            data = match->data;
             /* see if we have this key */
             PMIX_LIST_FOREACH_SAFE(ds1, ds2, &data->info, prte_info_item_t) {
                 if (PMIx_Check_key(ds1->info.key, rq.keys[i])) {
@@ -168,12 +180,13 @@ pmix_status_t prte_ds_unpublish(pmix_proc_t *sender,
                     PMIX_RELEASE(ds1);
                 }
             }
+            prte_ds_unindex_data(data, rq.keys[i]);
             /* if all the data has been removed, then remove the object */
             if (0 == pmix_list_get_size(&data->info)) {
-                pmix_pointer_array_set_item(&prte_data_store.store, data->index, NULL);
-                PMIX_RELEASE(data);
+                prte_ds_remove_data(data);
             }
         }
+        PMIX_LIST_DESTRUCT(&matches);
     }
     PMIX_DESTRUCT(&rq);
 
@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2025      Nanook Consulting  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ * Compact encoding of the procs of a job object.
+ *
+ * When packed with the compact encoding, the procs of a job are sent
+ * as a single byte object laid out as:
+ *
+ *    version                        1 byte
+ *    number of cpuset strings       varint
+ *    each cpuset string             varint length, then the bytes
+ *    one column per proc field      one varint per proc
+ *
+ * Every column holds the zigzag-encoded difference between the value
+ * of each proc and that of the proc before it, so runs of equal or
+ * consecutive values - ranks, parent daemons, app indices, local
+ * ranks - cost a single byte per proc. The cpuset column holds an
+ * index into the string table, with zero meaning "no cpuset".
+ */
+
+#ifndef PRTE_DT_COMPACT_H
+#define PRTE_DT_COMPACT_H
+
+#include "prte_config.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+BEGIN_C_DECLS
+
+/* encodings for the procs of a packed job object */
+#define PRTE_JOB_PROCS_FULL    0 // each proc packed by prte_proc_pack
+#define PRTE_JOB_PROCS_COMPACT 1 // the columnar encoding described above
+
+#define PRTE_JOB_PROCS_COMPACT_VERSION 1
+
+typedef enum {
+    PRTE_DT_COL_RANK,
+    PRTE_DT_COL_PARENT,
+    PRTE_DT_COL_APP_IDX,
+    PRTE_DT_COL_APP_RANK,
+    PRTE_DT_COL_LOCAL_RANK,
+    PRTE_DT_COL_NODE_RANK,
+    PRTE_DT_COL_STATE,
+    PRTE_DT_COL_CPUSET,
+    PRTE_DT_COL_MAX
+} prte_dt_col_t;
+
+/* max bytes a varint of a 64-bit value can take */
+#define PRTE_DT_VARINT_MAX 10
+
+static inline uint8_t *prte_dt_put_varint(uint8_t *ptr, uint64_t val)
+{
+    while (0x80 <= val) {
+        *ptr++ = (uint8_t) (val | 0x80);
+        val >>= 7;
+    }
+    *ptr++ = (uint8_t) val;
+    return ptr;
+}
+
+static inline bool prte_dt_get_varint(const uint8_t **ptr, const uint8_t *end, uint64_t *val)
+{
+    const uint8_t *p = *ptr;
+    uint64_t v = 0;
+    int shift = 0;
+
+    while (p < end && shift < 64) {
+        v |= (uint64_t) (*p & 0x7f) << shift;
+        if (0 == (*p++ & 0x80)) {
+            *val = v;
+            *ptr = p;
+            return true;
+        }
+        shift += 7;
+    }
+    return false;
+}
+
+static inline uint64_t prte_dt_zigzag(int64_t val)
+{
+    return ((uint64_t) val << 1) ^ (uint64_t) (val >> 63);
+}
+
+static inline int64_t prte_dt_unzigzag(uint64_t val)
+{
+    return (int64_t) (val >> 1) ^ -(int64_t) (val & 1);
+}
+
+END_C_DECLS
+
+#endif
@@ -13,7 +13,7 @@
  * Copyright (c) 2011-2013 Los Alamos National Security, LLC.
  *                         All rights reserved.
  * Copyright (c) 2014-2020 Intel, Inc.  All rights reserved.
- * Copyright (c) 2021-2024 Nanook Consulting  All rights reserved.
+ * Copyright (c) 2021-2025 Nanook Consulting  All rights reserved.
  * $COPYRIGHT$
  *
  * Additional copyrights may follow
@@ -24,8 +24,10 @@
 #include "prte_config.h"
 #include "types.h"
 
+#include <string.h>
 #include <sys/types.h>
 
+#include "src/class/pmix_hash_table.h"
 #include "src/class/pmix_pointer_array.h"
 #include "src/hwloc/hwloc-internal.h"
 #include "src/mca/errmgr/errmgr.h"
@@ -33,8 +35,112 @@
 #include "src/pmix/pmix-internal.h"
 #include "src/util/pmix_argv.h"
 
+#include "src/runtime/data_type_support/prte_dt_compact.h"
 #include "src/runtime/prte_globals.h"
 
+/* Encode the procs of a job in the compact form described in
+ * prte_dt_compact.h. Returns PRTE_ERR_NOT_SUPPORTED if the procs
+ * cannot be represented that way - e.g., because some of them carry
+ * attributes that must be sent along - in which case the caller
+ * has to fall back to packing each proc */
+static int compact_procs(prte_job_t *job, int32_t count, pmix_byte_object_t *bo)
+{
+    pmix_hash_table_t cpusets;
+    char **table = NULL;
+    uint32_t *vals, prev;
+    uint8_t *ptr;
+    size_t len, nbytes;
+    prte_proc_t *proc;
+    prte_attribute_t *kv;
+    void *idx;
+    int32_t j, k, n, ntable = 0;
+    int rc = PRTE_SUCCESS;
+
+    vals = (uint32_t *) malloc((size_t) count * PRTE_DT_COL_MAX * sizeof(uint32_t));
+    if (NULL == vals) {
+        return PRTE_ERR_OUT_OF_RESOURCE;
+    }
+    PMIX_CONSTRUCT(&cpusets, pmix_hash_table_t);
+    pmix_hash_table_init(&cpusets, 64);
+
+    /* collect the columns and the table of cpusets */
+    nbytes = 1 + PRTE_DT_VARINT_MAX;
+    n = 0;
+    for (j = 0; j < job->procs->size && n < count; j++) {
+        proc = (prte_proc_t *) pmix_pointer_array_get_item(job->procs, j);
+        if (NULL == proc) {
+            continue;
+        }
+        PMIX_LIST_FOREACH(kv, &proc->attributes, prte_attribute_t)
+        {
+            if (PRTE_ATTR_GLOBAL == kv->local) {
+                rc = PRTE_ERR_NOT_SUPPORTED;
+                goto cleanup;
+            }
+        }
+        vals[PRTE_DT_COL_RANK * count + n] = proc->name.rank;
+        vals[PRTE_DT_COL_PARENT * count + n] = proc->parent;
+        vals[PRTE_DT_COL_APP_IDX * count + n] = proc->app_idx;
+        vals[PRTE_DT_COL_APP_RANK * count + n] = proc->app_rank;
+        vals[PRTE_DT_COL_LOCAL_RANK * count + n] = proc->local_rank;
+        vals[PRTE_DT_COL_NODE_RANK * count + n] = proc->node_rank;
+        vals[PRTE_DT_COL_STATE * count + n] = proc->state;
+        vals[PRTE_DT_COL_CPUSET * count + n] = 0;
+        if (NULL != proc->cpuset) {
+            len = strlen(proc->cpuset);
+            if (PMIX_SUCCESS != pmix_hash_table_get_value_ptr(&cpusets, proc->cpuset, len, &idx)) {
+                PMIX_ARGV_APPEND_NOSIZE_COMPAT(&table, proc->cpuset);
+                ++ntable;
+                idx = (void *) (uintptr_t) ntable;
+                pmix_hash_table_set_value_ptr(&cpusets, proc->cpuset, len, idx);
+                nbytes += PRTE_DT_VARINT_MAX + len;
+            }
+            vals[PRTE_DT_COL_CPUSET * count + n] = (uint32_t) (uintptr_t) idx;
+        }
+        ++n;
+    }
+    if (n != count) {
+        /* the proc array doesn't match the number of procs */
+        rc = PRTE_ERR_NOT_SUPPORTED;
+        goto cleanup;
+    }
+
+    /* a delta between two 32-bit values never takes more than
+     * five bytes once encoded */
+    nbytes += (size_t) count * PRTE_DT_COL_MAX * 5;
+    bo->bytes = (char *) malloc(nbytes);
+    if (NULL == bo->bytes) {
+        rc = PRTE_ERR_OUT_OF_RESOURCE;
+        goto cleanup;
+    }
+    ptr = (uint8_t *) bo->bytes;
+    *ptr++ = PRTE_JOB_PROCS_COMPACT_VERSION;
+    ptr = prte_dt_put_varint(ptr, ntable);
+    for (k = 0; k < ntable; k++) {
+        len = strlen(table[k]);
+        ptr = prte_dt_put_varint(ptr, len);
+        memcpy(ptr, table[k], len);
+        ptr += len;
+    }
+    for (k = 0; k < PRTE_DT_COL_MAX; k++) {
+        prev = 0;
+        for (j = 0; j < count; j++) {
+            ptr = prte_dt_put_varint(ptr, prte_dt_zigzag((int64_t) vals[k * count + j]
+                                                         - (int64_t) prev));
+            prev = vals[k * count + j];
+        }
+    }
+    bo->size = ptr - (uint8_t *) bo->bytes;
+
+cleanup:
+    free(vals);
+    PMIX_DESTRUCT(&cpusets);
+    if (NULL != table) {
+        PMIX_ARGV_FREE_COMPAT(table);
+    }
+    return rc;
+}
+
 /*
  * JOB
  * NOTE: We do not pack all of the job object's fields as many of them have no
@@ -42,7 +148,7 @@
  * sending a job object is to communicate the data required to dynamically
  * spawn another job - so we only pack that limited set of required data
  */
-int prte_job_pack(pmix_data_buffer_t *bkt, prte_job_t *job)
+static int job_pack(pmix_data_buffer_t *bkt, prte_job_t *job, bool procs)
 {
     pmix_status_t rc;
     int32_t j, count, bookmark;
@@ -51,6 +157,8 @@ int prte_job_pack(pmix_data_buffer_t *bkt, prte_job_t *job)
     prte_attribute_t *kv;
     pmix_list_t *cache;
     prte_info_item_t *val;
+    pmix_byte_object_t bo;
+    uint8_t encoding;
 
     /* pack the nspace */
     rc = PMIx_Data_pack(NULL, bkt, (void *) &job->nspace, 1, PMIX_PROC_NSPACE);
@@ -173,8 +281,36 @@ int prte_job_pack(pmix_data_buffer_t *bkt, prte_job_t *job)
         return prte_pmix_convert_status(rc);
     }
 
-    if (0 < job->num_procs) {
-        for (j = 0; j < job->procs->size; j++) {
+    /* pack the number of proc objects that follow */
+    count = procs ? (int32_t) job->num_procs : 0;
+    rc = PMIx_Data_pack(NULL, bkt, (void *) &count, 1, PMIX_INT32);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return prte_pmix_convert_status(rc);
+    }
+    if (0 < count) {
+        /* flag how the procs are encoded */
+        PMIX_BYTE_OBJECT_CONSTRUCT(&bo);
+        encoding = PRTE_JOB_PROCS_FULL;
+        if (prte_compact_job_encoding) {
+            rc = compact_procs(job, count, &bo);
+            if (PRTE_SUCCESS == rc) {
+                encoding = PRTE_JOB_PROCS_COMPACT;
+            } else if (PRTE_ERR_NOT_SUPPORTED != rc) {
+                PRTE_ERROR_LOG(rc);
+                return rc;
+            }
+        }
+        rc = PMIx_Data_pack(NULL, bkt, (void *) &encoding, 1, PMIX_UINT8);
+        if (PMIX_SUCCESS == rc && PRTE_JOB_PROCS_COMPACT == encoding) {
+            rc = PMIx_Data_pack(NULL, bkt, (void *) &bo, 1, PMIX_BYTE_OBJECT);
+        }
+        PMIX_BYTE_OBJECT_DESTRUCT(&bo);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            return prte_pmix_convert_status(rc);
+        }
+        for (j = 0; PRTE_JOB_PROCS_FULL == encoding && j < job->procs->size; j++) {
             if (NULL == (proc = (prte_proc_t *) pmix_pointer_array_get_item(job->procs, j))) {
                 continue;
             }
@@ -259,6 +395,18 @@ int prte_job_pack(pmix_data_buffer_t *bkt, prte_job_t *job)
     return PRTE_SUCCESS;
 }
 
+int prte_job_pack(pmix_data_buffer_t *bkt, prte_job_t *job)
+{
+    return job_pack(bkt, job, true);
+}
+
+/* pack everything but the proc objects - used when the
+ * caller conveys the procs in some other form */
+int prte_job_pack_noprocs(pmix_data_buffer_t *bkt, prte_job_t *job)
+{
+    return job_pack(bkt, job, false);
+}
+
 int prte_node_pack(pmix_data_buffer_t *bkt, prte_node_t *node)
 {
     int rc;
@@ -13,7 +13,7 @@
  * Copyright (c) 2011-2013 Los Alamos National Security, LLC.
  *                         All rights reserved.
  * Copyright (c) 2014-2020 Intel, Inc.  All rights reserved.
- * Copyright (c) 2021-2024 Nanook Consulting  All rights reserved.
+ * Copyright (c) 2021-2025 Nanook Consulting  All rights reserved.
  * $COPYRIGHT$
  *
  * Additional copyrights may follow
@@ -24,6 +24,7 @@
 #include "prte_config.h"
 #include "types.h"
 
+#include <string.h>
 #include <sys/types.h>
 
 #include "src/hwloc/hwloc-internal.h"
@@ -32,8 +33,132 @@
 #include "src/pmix/pmix-internal.h"
 #include "src/util/pmix_argv.h"
 
+#include "src/runtime/data_type_support/prte_dt_compact.h"
 #include "src/runtime/prte_globals.h"
 
+/* Recreate the procs of a job from the compact form described
+ * in prte_dt_compact.h */
+static int expand_procs(prte_job_t *jptr, int32_t count, pmix_byte_object_t *bo)
+{
+    const uint8_t *ptr = (const uint8_t *) bo->bytes;
+    const uint8_t *end = ptr + bo->size;
+    prte_proc_t **procs = NULL;
+    char **table = NULL;
+    uint64_t v, ntable = 0, len, k;
+    int64_t prev;
+    uint32_t val;
+    int32_t j;
+    int col, rc = PRTE_ERR_UNPACK_FAILURE;
+
+    if (ptr >= end || PRTE_JOB_PROCS_COMPACT_VERSION != *ptr++) {
+        return PRTE_ERR_UNPACK_FAILURE;
+    }
+
+    /* the table of cpusets */
+    if (!prte_dt_get_varint(&ptr, end, &ntable) || ntable > (uint64_t) (end - ptr)) {
+        return PRTE_ERR_UNPACK_FAILURE;
+    }
+    if (0 < ntable) {
+        table = (char **) calloc(ntable, sizeof(char *));
+        if (NULL == table) {
+            return PRTE_ERR_OUT_OF_RESOURCE;
+        }
+    }
+    for (k = 0; k < ntable; k++) {
+        if (!prte_dt_get_varint(&ptr, end, &len) || len > (uint64_t) (end - ptr)) {
+            goto cleanup;
+        }
+        table[k] = (char *) malloc(len + 1);
+        if (NULL == table[k]) {
+            rc = PRTE_ERR_OUT_OF_RESOURCE;
+            goto cleanup;
+        }
+        memcpy(table[k], ptr, len);
+        table[k][len] = '\0';
+        ptr += len;
+    }
+
+    procs = (prte_proc_t **) calloc(count, sizeof(prte_proc_t *));
+    if (NULL == procs) {
+        rc = PRTE_ERR_OUT_OF_RESOURCE;
+        goto cleanup;
+    }
+    for (j = 0; j < count; j++) {
+        procs[j] = PMIX_NEW(prte_proc_t);
+        if (NULL == procs[j]) {
+            rc = PRTE_ERR_OUT_OF_RESOURCE;
+            goto cleanup;
+        }
+        PMIX_LOAD_NSPACE(procs[j]->name.nspace, jptr->nspace);
+    }
+
+    /* the columns */
+    for (col = 0; col < PRTE_DT_COL_MAX; col++) {
+        prev = 0;
+        for (j = 0; j < count; j++) {
+            if (!prte_dt_get_varint(&ptr, end, &v)) {
+                goto cleanup;
+            }
+            prev += prte_dt_unzigzag(v);
+            val = (uint32_t) prev;
+            switch (col) {
+            case PRTE_DT_COL_RANK:
+                procs[j]->name.rank = val;
+                break;
+            case PRTE_DT_COL_PARENT:
+                procs[j]->parent = val;
+                break;
+            case PRTE_DT_COL_APP_IDX:
+                procs[j]->app_idx = val;
+                break;
+            case PRTE_DT_COL_APP_RANK:
+                procs[j]->app_rank = val;
+                break;
+            case PRTE_DT_COL_LOCAL_RANK:
+                procs[j]->local_rank = (prte_local_rank_t) val;
+                break;
+            case PRTE_DT_COL_NODE_RANK:
+                procs[j]->node_rank = (prte_node_rank_t) val;
+                break;
+            case PRTE_DT_COL_STATE:
+                procs[j]->state = val;
+                break;
+            case PRTE_DT_COL_CPUSET:
+                if (ntable < val) {
+                    goto cleanup;
+                }
+                if (0 < val) {
+                    procs[j]->cpuset = strdup(table[val - 1]);
+                }
+                break;
+            }
+        }
+    }
+
+    for (j = 0; j < count; j++) {
+        pmix_pointer_array_add(jptr->procs, procs[j]);
+        procs[j] = NULL;
+    }
+    rc = PRTE_SUCCESS;
+
+cleanup:
+    if (NULL != procs) {
+        for (j = 0; j < count; j++) {
+            if (NULL != procs[j]) {
+                PMIX_RELEASE(procs[j]);
+            }
+        }
+        free(procs);
+    }
+    if (NULL != table) {
+        for (k = 0; k < ntable; k++) {
+            free(table[k]);
+        }
+        free(table);
+    }
+    return rc;
+}
+
 /*
  * JOB
  * NOTE: We do not pack all of the job object's fields as many of them have no
@@ -53,6 +178,8 @@ int prte_job_unpack(pmix_data_buffer_t *bkt, prte_job_t **job)
     prte_info_item_t *val;
     pmix_info_t pval;
     pmix_list_t *cache;
+    pmix_byte_object_t bo;
+    uint8_t encoding;
 
     /* create the prte_job_t object */
     jptr = PMIX_NEW(prte_job_t);
@@ -193,9 +320,47 @@ int prte_job_unpack(pmix_data_buffer_t *bkt, prte_job_t **job)
         return prte_pmix_convert_status(rc);
     }
 
-    if (0 < jptr->num_procs) {
+    /* unpack the number of proc objects that follow */
+    n = 1;
+    rc = PMIx_Data_unpack(NULL, bkt, &count, &n, PMIX_INT32);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_RELEASE(jptr);
+        return prte_pmix_convert_status(rc);
+    }
+    if (0 < count) {
         prte_proc_t *proc;
-        for (j = 0; j < jptr->num_procs; j++) {
+        /* see how they were encoded */
+        n = 1;
+        rc = PMIx_Data_unpack(NULL, bkt, &encoding, &n, PMIX_UINT8);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            PMIX_RELEASE(jptr);
+            return prte_pmix_convert_status(rc);
+        }
+        if (PRTE_JOB_PROCS_COMPACT == encoding) {
+            n = 1;
+            rc = PMIx_Data_unpack(NULL, bkt, &bo, &n, PMIX_BYTE_OBJECT);
+            if (PMIX_SUCCESS != rc) {
+                PMIX_ERROR_LOG(rc);
+                PMIX_RELEASE(jptr);
+                return prte_pmix_convert_status(rc);
+            }
+            rc = expand_procs(jptr, count, &bo);
+            PMIX_BYTE_OBJECT_DESTRUCT(&bo);
+            if (PRTE_SUCCESS != rc) {
+                PRTE_ERROR_LOG(rc);
+                PMIX_RELEASE(jptr);
+                return rc;
+            }
+            /* nothing more to do */
+            count = 0;
+        } else if (PRTE_JOB_PROCS_FULL != encoding) {
+            PRTE_ERROR_LOG(PRTE_ERR_UNPACK_FAILURE);
+            PMIX_RELEASE(jptr);
+            return PRTE_ERR_UNPACK_FAILURE;
+        }
+        for (k = 0; k < count; k++) {
             rc = prte_proc_unpack(bkt, &proc);
             if (PMIX_SUCCESS != rc) {
                 PMIX_ERROR_LOG(rc);
@@ -66,6 +66,7 @@ int prte_clean_output = -1;
 /* globals used by RTE */
 bool prte_debug_daemons_file_flag = false;
 bool prte_leave_session_attached = false;
+int prte_session_dir_cleanup_max = 64;
 char *prte_topo_signature = NULL;
 char *prte_data_server_uri = NULL;
 char *prte_tool_basename = NULL;
@@ -73,6 +73,9 @@ PRTE_EXPORT extern char *prte_tool_basename;       // argv[0] of prun or one of
 PRTE_EXPORT extern char *prte_tool_actual;         // actual tool executable
 PRTE_EXPORT extern char *prte_progress_thread_cpus;
 PRTE_EXPORT extern bool prte_bind_progress_thread_reqd;
+PRTE_EXPORT extern bool prte_progress_thread_report;
+PRTE_EXPORT extern bool prte_compact_job_encoding;
+PRTE_EXPORT extern bool prte_compact_nidmap;
 PRTE_EXPORT extern bool prte_show_launch_progress;
 PRTE_EXPORT extern bool prte_bootstrap_setup;
 PRTE_EXPORT extern bool prte_silence_shared_fs;
@@ -479,6 +482,7 @@ PRTE_EXPORT int prte_set_job_data_object(prte_job_t *jdata);
 
 /** Pack/unpack a job object */
 PRTE_EXPORT int prte_job_pack(pmix_data_buffer_t *bkt, prte_job_t *job);
+PRTE_EXPORT int prte_job_pack_noprocs(pmix_data_buffer_t *bkt, prte_job_t *job);
 PRTE_EXPORT int prte_job_unpack(pmix_data_buffer_t *bkt, prte_job_t **job);
 PRTE_EXPORT int prte_job_copy(prte_job_t **dest, prte_job_t *src);
 PRTE_EXPORT void prte_job_print(char **output, prte_job_t *jdata);
@@ -531,6 +535,7 @@ PRTE_EXPORT bool prte_quickmatch(prte_node_t *nd, char *name);
 PRTE_EXPORT extern bool prte_debug_daemons_flag;
 PRTE_EXPORT extern bool prte_debug_daemons_file_flag;
 PRTE_EXPORT extern bool prte_leave_session_attached;
+PRTE_EXPORT extern int prte_session_dir_cleanup_max;
 PRTE_EXPORT extern char *prte_topo_signature;
 PRTE_EXPORT extern char *prte_data_server_uri;
 PRTE_EXPORT extern bool prte_dvm_ready;
@@ -66,6 +66,9 @@ char *prte_set_max_sys_limits = NULL;
 int prte_pmix_verbose_output = 0;
 char *prte_progress_thread_cpus = NULL;
 bool prte_bind_progress_thread_reqd = false;
+bool prte_progress_thread_report = false;
+bool prte_compact_job_encoding = true;
+bool prte_compact_nidmap = true;
 bool prte_silence_shared_fs = false;
 int prte_max_thread_in_progress = 1;
 
@@ -323,6 +326,15 @@ int prte_register_params(void)
                                       PMIX_MCA_BASE_VAR_TYPE_STRING,
                                       &prte_prohibited_session_dirs);
 
+    prte_session_dir_cleanup_max = 64;
+    (void) pmix_mca_base_var_register("prte", "prte", NULL, "session_dir_cleanup_max",
+                                      "Maximum number of job session directories that can be queued "
+                                      "for removal by a background thread when their job terminates - "
+                                      "directories beyond that are removed immediately (0 = always "
+                                      "remove them immediately)",
+                                      PMIX_MCA_BASE_VAR_TYPE_INT,
+                                      &prte_session_dir_cleanup_max);
+
     prte_fwd_environment = false;
     (void) pmix_mca_base_var_register("prte", "prte", NULL, "fwd_environment",
                                       "Forward the entire local environment",
@@ -516,11 +528,30 @@ int prte_register_params(void)
                                       PMIX_MCA_BASE_VAR_TYPE_BOOL,
                                       &prte_bind_progress_thread_reqd);
 
+    (void) pmix_mca_base_var_register("prte", "prte", NULL, "progress_thread_report",
+                                      "Report the CPU utilization of each internal PRRTE progress "
+                                      "thread when it exits",
+                                      PMIX_MCA_BASE_VAR_TYPE_BOOL,
+                                      &prte_progress_thread_report);
+
     (void) pmix_mca_base_var_register("prte", "prte", NULL, "hetero_nodes",
                                       "Allocation contains hetero nodes",
                                       PMIX_MCA_BASE_VAR_TYPE_BOOL,
                                       &prte_hetero_nodes);
 
+    (void) pmix_mca_base_var_register("prte", "prte", NULL, "compact_job_encoding",
+                                      "Send the procs of a job object in a compact columnar "
+                                      "encoding instead of packing each proc individually",
+                                      PMIX_MCA_BASE_VAR_TYPE_BOOL,
+                                      &prte_compact_job_encoding);
+
+    (void) pmix_mca_base_var_register("prte", "prte", NULL, "compact_nidmap",
+                                      "Send the node names, aliases and daemon vpids of the "
+                                      "nidmap as runs of consecutive values instead of as "
+                                      "delimited lists",
+                                      PMIX_MCA_BASE_VAR_TYPE_BOOL,
+                                      &prte_compact_nidmap);
+
     /* pickup the RML params */
     prte_rml_register();
 
@@ -16,6 +16,7 @@
 #    include <unistd.h>
 #endif
 #include <string.h>
+#include <time.h>
 #include <pthread.h>
 #ifdef HAVE_PTHREAD_NP_H
 #    include <pthread_np.h>
@@ -26,7 +27,9 @@
 #include "src/threads/pmix_threads.h"
 #include "src/util/pmix_argv.h"
 #include "src/util/error.h"
+#include "src/util/name_fns.h"
 #include "src/util/pmix_fd.h"
+#include "src/util/pmix_output.h"
 
 #include "src/runtime/prte_progress_threads.h"
 
@@ -223,11 +226,26 @@ static void *progress_engine(pmix_object_t *obj)
 {
     pmix_thread_t *t = (pmix_thread_t *) obj;
     prte_progress_tracker_t *trk = (prte_progress_tracker_t *) t->t_arg;
+    struct timespec wstart, wstop, cpu;
+    double wall, busy;
+
+    clock_gettime(CLOCK_MONOTONIC, &wstart);
 
     while (trk->ev_active) {
         prte_event_loop(trk->ev_base, PRTE_EVLOOP_ONCE);
     }
 
+    if (prte_progress_thread_report) {
+        clock_gettime(CLOCK_MONOTONIC, &wstop);
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &cpu);
+        wall = (double) (wstop.tv_sec - wstart.tv_sec) +
+               (double) (wstop.tv_nsec - wstart.tv_nsec) / 1.0e9;
+        busy = (double) cpu.tv_sec + (double) cpu.tv_nsec / 1.0e9;
+        pmix_output(0, "%s progress thread %s: %.3f sec cpu over %.3f sec (%.1f%% busy)",
+                    PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), trk->name, busy, wall,
+                    (0.0 < wall) ? 100.0 * busy / wall : 0.0);
+    }
+
     return PMIX_THREAD_CANCELLED;
 }
 
@@ -51,6 +51,7 @@
 #    include <sys/wait.h>
 #endif
 
+#include "src/class/pmix_hash_table.h"
 #include "src/class/pmix_list.h"
 #include "src/class/pmix_object.h"
 #include "src/event/event-internal.h"
@@ -81,6 +82,7 @@ PMIX_CLASS_INSTANCE(prte_timer_t, pmix_object_t,
 static void wccon(prte_wait_tracker_t *p)
 {
     p->child = NULL;
+    p->pid = 0;
     p->cbfunc = NULL;
     p->cbdata = NULL;
 }
@@ -95,7 +97,12 @@ PMIX_CLASS_INSTANCE(prte_wait_tracker_t, pmix_list_item_t,
 
 /* Local Variables */
 static prte_event_t handler;
-static pmix_list_t pending_cbs;
+/* pending callbacks are keyed by the child object - they are
+ * registered before the child is forked, so we don't yet know
+ * the pid. They are also indexed by pid once it is known so
+ * that a mass exit can be reaped in linear time */
+static pmix_hash_table_t pending_cbs;
+static pmix_hash_table_t pending_pids;
 
 /* Local Function Prototypes */
 static void wait_signal_callback(int fd, short event, void *arg);
@@ -114,7 +121,10 @@ void prte_wait_enable(void)
 
 int prte_wait_init(void)
 {
-    PMIX_CONSTRUCT(&pending_cbs, pmix_list_t);
+    PMIX_CONSTRUCT(&pending_cbs, pmix_hash_table_t);
+    pmix_hash_table_init(&pending_cbs, 256);
+    PMIX_CONSTRUCT(&pending_pids, pmix_hash_table_t);
+    pmix_hash_table_init(&pending_pids, 256);
 
     prte_event_set(prte_event_base, &handler, SIGCHLD,
                    PRTE_EV_SIGNAL | PRTE_EV_PERSIST,
@@ -126,10 +136,21 @@ int prte_wait_init(void)
 
 int prte_wait_finalize(void)
 {
+    prte_wait_tracker_t *t2;
+    uint64_t key;
+    void *node;
+    int rc;
+
     prte_event_del(&handler);
 
     /* clear out the pending cbs */
-    PMIX_LIST_DESTRUCT(&pending_cbs);
+    rc = pmix_hash_table_get_first_key_uint64(&pending_cbs, &key, (void **) &t2, &node);
+    while (PMIX_SUCCESS == rc) {
+        PMIX_RELEASE(t2);
+        rc = pmix_hash_table_get_next_key_uint64(&pending_cbs, &key, (void **) &t2, node, &node);
+    }
+    PMIX_DESTRUCT(&pending_cbs);
+    PMIX_DESTRUCT(&pending_pids);
 
     return PRTE_SUCCESS;
 }
@@ -164,13 +185,16 @@ void prte_wait_cb(prte_proc_t *child,
     }
 
     /* we just override any existing registration */
-    PMIX_LIST_FOREACH(t2, &pending_cbs, prte_wait_tracker_t)
-    {
-        if (t2->child == child) {
-            t2->cbfunc = callback;
-            t2->cbdata = data;
-            return;
+    if (PMIX_SUCCESS == pmix_hash_table_get_value_uint64(&pending_cbs, (uint64_t) (uintptr_t) child,
+                                                         (void **) &t2)) {
+        t2->cbfunc = callback;
+        t2->cbdata = data;
+        /* the child may be about to be forked again */
+        if (0 != t2->pid && t2->pid != child->pid) {
+            pmix_hash_table_remove_value_uint32(&pending_pids, (uint32_t) t2->pid);
+            t2->pid = 0;
         }
+        return;
     }
     /* get here if this is a new registration */
     t2 = PMIX_NEW(prte_wait_tracker_t);
@@ -178,7 +202,38 @@ void prte_wait_cb(prte_proc_t *child,
     t2->child = child;
     t2->cbfunc = callback;
     t2->cbdata = data;
-    pmix_list_append(&pending_cbs, &t2->super);
+    pmix_hash_table_set_value_uint64(&pending_cbs, (uint64_t) (uintptr_t) child, t2);
+}
+
+static void remove_tracker(prte_wait_tracker_t *t2)
+{
+    pmix_hash_table_remove_value_uint64(&pending_cbs, (uint64_t) (uintptr_t) t2->child);
+    if (0 != t2->pid) {
+        pmix_hash_table_remove_value_uint32(&pending_pids, (uint32_t) t2->pid);
+    }
+}
+
+/* index any pending trackers whose child has been (re)forked
+ * since we last looked */
+static void index_pids(void)
+{
+    prte_wait_tracker_t *t2;
+    uint64_t key;
+    void *node;
+    int rc;
+
+    rc = pmix_hash_table_get_first_key_uint64(&pending_cbs, &key, (void **) &t2, &node);
+    while (PMIX_SUCCESS == rc) {
+        /* a restarted child may still carry its previous pid */
+        if (0 < t2->child->pid && t2->pid != t2->child->pid) {
+            if (0 != t2->pid) {
+                pmix_hash_table_remove_value_uint32(&pending_pids, (uint32_t) t2->pid);
+            }
+            t2->pid = t2->child->pid;
+            pmix_hash_table_set_value_uint32(&pending_pids, (uint32_t) t2->pid, t2);
+        }
+        rc = pmix_hash_table_get_next_key_uint64(&pending_cbs, &key, (void **) &t2, node, &node);
+    }
 }
 
 static void cancel_callback(int fd, short args, void *cbdata)
@@ -189,14 +244,11 @@ static void cancel_callback(int fd, short args, void *cbdata)
 
     PMIX_ACQUIRE_OBJECT(trk);
 
-    PMIX_LIST_FOREACH(t2, &pending_cbs, prte_wait_tracker_t)
-    {
-        if (t2->child == trk->child) {
-            pmix_list_remove_item(&pending_cbs, &t2->super);
-            PMIX_RELEASE(t2);
-            PMIX_RELEASE(trk);
-            return;
-        }
+    if (PMIX_SUCCESS == pmix_hash_table_get_value_uint64(&pending_cbs,
+                                                         (uint64_t) (uintptr_t) trk->child,
+                                                         (void **) &t2)) {
+        remove_tracker(t2);
+        PMIX_RELEASE(t2);
     }
 
     PMIX_RELEASE(trk);
@@ -248,21 +300,25 @@ static void wait_signal_callback(int fd, short event, void *arg)
             return;
         }
 
-        /* we are already in an event, so it is safe to access the list */
-        PMIX_LIST_FOREACH(t2, &pending_cbs, prte_wait_tracker_t)
-        {
-            if (pid == t2->child->pid) {
-                /* found it! */
-                t2->child->exit_code = status;
-                pmix_list_remove_item(&pending_cbs, &t2->super);
-                if (NULL != t2->cbfunc) {
-                    prte_event_set(prte_event_base, &t2->ev, -1, PRTE_EV_WRITE, t2->cbfunc, t2);
-                    prte_event_active(&t2->ev, PRTE_EV_WRITE, 1);
-                } else {
-                    PMIX_RELEASE(t2);
-                }
-                break;
+        /* we are already in an event, so it is safe to access the
+         * trackers - if this pid isn't indexed yet, then index
+         * everything forked since the last time we looked */
+        if (PMIX_SUCCESS != pmix_hash_table_get_value_uint32(&pending_pids, (uint32_t) pid,
+                                                             (void **) &t2)) {
+            index_pids();
+            if (PMIX_SUCCESS != pmix_hash_table_get_value_uint32(&pending_pids, (uint32_t) pid,
+                                                                 (void **) &t2)) {
+                /* not one of ours */
+                continue;
             }
         }
+        t2->child->exit_code = status;
+        remove_tracker(t2);
+        if (NULL != t2->cbfunc) {
+            prte_event_set(prte_event_base, &t2->ev, -1, PRTE_EV_WRITE, t2->cbfunc, t2);
+            prte_event_active(&t2->ev, PRTE_EV_WRITE, 1);
+        } else {
+            PMIX_RELEASE(t2);
+        }
     }
 }
@@ -64,6 +64,7 @@ typedef struct {
     pmix_list_item_t super;
     prte_event_t ev;
     prte_proc_t *child;
+    pid_t pid;  // pid this tracker is indexed under, 0 if not yet indexed
     prte_wait_cbfunc_t cbfunc;
     void *cbdata;
 } prte_wait_tracker_t;
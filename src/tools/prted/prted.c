@@ -499,6 +499,10 @@ int main(int argc, char *argv[])
             PRTE_ERROR_LOG(ret);
             goto DONE;
         }
+        /* this is the daemon that launched us - our routing parent
+         * is recomputed later and may differ from it when the launch
+         * follows its own tree */
+        prte_rml_base.launch_parent = PRTE_PROC_MY_PARENT->rank;
         if (PRTE_PROC_MY_PARENT->rank != PRTE_PROC_MY_HNP->rank) {
             PMIX_VALUE_LOAD(&val, prte_parent_uri, PMIX_STRING);
             PMIX_LOAD_NSPACE(proc.nspace, prte_process_info.myproc.nspace);
@@ -837,9 +841,10 @@ static void shutdown_callback(int fd, short flags, void *arg)
      * indicating clean termination! Instead, just forcibly cleanup
      * the local session_dir tree and exit
      */
-    prte_odls.kill_local_procs(NULL);
-    // mark that we are finalizing so the session directory will cleanup
+    // mark that we are finalizing so the session directory will cleanup - this
+    // also ensures the local procs are fully killed before we exit
     prte_finalizing = true;
+    prte_odls.kill_local_procs(NULL);
     jdata = prte_get_job_data_object(PRTE_PROC_MY_NAME->nspace);
     PMIX_RELEASE(jdata);
     exit(PRTE_ERROR_DEFAULT_EXIT_CODE);
@@ -906,9 +911,17 @@ report:
 static void report_prted(void)
 {
     int nreqd, ret;
+    pmix_rank_t parent;
 
-    /* get the number of children */
-    nreqd = pmix_list_get_size(&prte_rml_base.children) + 1;
+    /* get the number of children - if we were started by a
+     * launch tree, then the rollup follows that tree */
+    if (0 <= prte_plm_globals.num_launch_children) {
+        nreqd = prte_plm_globals.num_launch_children + 1;
+        parent = prte_rml_base.launch_parent;
+    } else {
+        nreqd = pmix_list_get_size(&prte_rml_base.children) + 1;
+        parent = PRTE_PROC_MY_PARENT->rank;
+    }
     if (nreqd == ncollected && NULL != mybucket && !node_regex_waiting) {
         /* add the collection of our children's buckets to ours */
         ret = PMIx_Data_copy_payload(mybucket, bucket);
@@ -917,7 +930,7 @@ static void report_prted(void)
         }
         PMIX_DATA_BUFFER_RELEASE(bucket);
         /* relay this on to our parent */
-        PRTE_RML_SEND(ret, PRTE_PROC_MY_PARENT->rank, mybucket,
+        PRTE_RML_SEND(ret, parent, mybucket,
                       PRTE_RML_TAG_PRTED_CALLBACK);
         if (PRTE_SUCCESS != ret) {
             PRTE_ERROR_LOG(ret);
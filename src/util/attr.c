@@ -521,6 +521,8 @@ const char *prte_attr_key_to_str(prte_attribute_key_t key)
             return "REPORT PHYSICAL CPUS";
         case PRTE_JOB_ALLOC_DISPLAYED:
             return "ALLOCATION DISPLAYED";
+        case PRTE_JOB_DVM_VERSION:
+            return "DVM VERSION";
 
         case PRTE_PROC_NOBARRIER:
             return "PROC-NOBARRIER";
@@ -240,6 +240,7 @@ typedef uint16_t prte_job_flags_t;
 #define PRTE_JOB_FWD_ENVIRONMENT            (PRTE_JOB_START_KEY + 120) // bool - forward local environment to procs in this job
 #define PRTE_JOB_REPORT_PHYSICAL_CPUS       (PRTE_JOB_START_KEY + 121) // bool - report using physical (vs logical) cpu IDs
 #define PRTE_JOB_ALLOC_DISPLAYED            (PRTE_JOB_START_KEY + 122) // bool - allocation has been displayed
+#define PRTE_JOB_DVM_VERSION                (PRTE_JOB_START_KEY + 123) // uint32 - DVM state version at which this job was launched
 
 #define PRTE_JOB_MAX_KEY (PRTE_JOB_START_KEY + 200)
 
@@ -260,6 +261,7 @@ typedef uint16_t prte_proc_flags_t;
 #define PRTE_PROC_FLAG_DATA_RECVD       0x1000 // modex data for this proc has been received
 #define PRTE_PROC_FLAG_SM_ACCESS        0x2000 // indicate if process can read modex data from shared memory region
 #define PRTE_PROC_FLAG_TERM_REPORTED    0x4000 // proc termination has been reported
+#define PRTE_PROC_FLAG_LOCALITY_REGD    0x8000 // locality info for this proc has been given to the local PMIx server
 
 
 /***   PROCESS ATTRIBUTE KEYS   ***/
@@ -24,6 +24,7 @@
 #ifdef HAVE_STDIO_H
 #    include <stdio.h>
 #endif /* HAVE_STDIO_H */
+#include <pthread.h>
 #include <stdlib.h>
 #ifdef HAVE_STRINGS_H
 #    include <strings.h>
@@ -1109,3 +1110,167 @@ unsigned int prte_uicrc_partial(const void *source, size_t crclen, unsigned int
 
     return partial_crc;
 }
+
+/*
+ * CRC32C (Castagnoli) support. The polynomial is used in its
+ * reflected form so the result matches that of the SSE4.2 and ARMv8
+ * CRC32C instructions, which are used whenever the processor has
+ * them. Otherwise the checksum is computed eight bytes at a time
+ * using the "slicing-by-8" tables.
+ */
+
+#define CRC32C_POLYNOMIAL ((uint32_t) 0x82f63b78)
+
+typedef uint32_t (*prte_crc32c_fn_t)(uint32_t crc, const unsigned char *src, size_t len);
+
+static pthread_once_t _prte_crc32c_once = PTHREAD_ONCE_INIT;
+static uint32_t _prte_crc32c_table[8][256];
+static prte_crc32c_fn_t _prte_crc32c_fn = NULL;
+static const char *_prte_crc32c_method = NULL;
+
+static uint32_t crc32c_sb8(uint32_t crc, const unsigned char *src, size_t len)
+{
+#if !defined(WORDS_BIGENDIAN)
+    uint32_t lo, hi;
+
+    /* align the source so the word loads below are aligned */
+    while (0 < len && 0 != ((uintptr_t) src & 7)) {
+        crc = (crc >> 8) ^ _prte_crc32c_table[0][(crc ^ *src++) & 0xff];
+        len--;
+    }
+    while (8 <= len) {
+        lo = *(const uint32_t *) src ^ crc;
+        hi = *(const uint32_t *) (src + 4);
+        crc = _prte_crc32c_table[7][lo & 0xff] ^ _prte_crc32c_table[6][(lo >> 8) & 0xff]
+              ^ _prte_crc32c_table[5][(lo >> 16) & 0xff] ^ _prte_crc32c_table[4][lo >> 24]
+              ^ _prte_crc32c_table[3][hi & 0xff] ^ _prte_crc32c_table[2][(hi >> 8) & 0xff]
+              ^ _prte_crc32c_table[1][(hi >> 16) & 0xff] ^ _prte_crc32c_table[0][hi >> 24];
+        src += 8;
+        len -= 8;
+    }
+#endif
+    while (len--) {
+        crc = (crc >> 8) ^ _prte_crc32c_table[0][(crc ^ *src++) & 0xff];
+    }
+    return crc;
+}
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#    define PRTE_CRC32C_HW "sse4.2"
+
+__attribute__((target("sse4.2")))
+static uint32_t crc32c_hw(uint32_t crc, const unsigned char *src, size_t len)
+{
+    uint64_t crc64;
+
+    while (0 < len && 0 != ((uintptr_t) src & 7)) {
+        crc = __builtin_ia32_crc32qi(crc, *src++);
+        len--;
+    }
+    crc64 = crc;
+    while (8 <= len) {
+        crc64 = __builtin_ia32_crc32di(crc64, *(const uint64_t *) src);
+        src += 8;
+        len -= 8;
+    }
+    crc = (uint32_t) crc64;
+    while (len--) {
+        crc = __builtin_ia32_crc32qi(crc, *src++);
+    }
+    return crc;
+}
+
+static bool crc32c_hw_available(void)
+{
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("sse4.2") ? true : false;
+}
+
+#elif defined(__GNUC__) && defined(__aarch64__) && defined(__linux__)
+#    include <sys/auxv.h>
+#    if defined(HWCAP_CRC32)
+#        define PRTE_CRC32C_HW "armv8"
+#        if defined(__clang__)
+#            define PRTE_CRC32C_TARGET __attribute__((target("crc")))
+#        else
+#            define PRTE_CRC32C_TARGET __attribute__((target("+crc")))
+#        endif
+
+PRTE_CRC32C_TARGET
+static uint32_t crc32c_hw(uint32_t crc, const unsigned char *src, size_t len)
+{
+    while (0 < len && 0 != ((uintptr_t) src & 7)) {
+        __asm__("crc32cb %w0, %w0, %w1" : "+r"(crc) : "r"(*src));
+        src++;
+        len--;
+    }
+    while (8 <= len) {
+        __asm__("crc32cx %w0, %w0, %x1" : "+r"(crc) : "r"(*(const uint64_t *) src));
+        src += 8;
+        len -= 8;
+    }
+    while (len--) {
+        __asm__("crc32cb %w0, %w0, %w1" : "+r"(crc) : "r"(*src));
+        src++;
+    }
+    return crc;
+}
+
+static bool crc32c_hw_available(void)
+{
+    return (getauxval(AT_HWCAP) & HWCAP_CRC32) ? true : false;
+}
+#    endif
+#endif
+
+static void prte_initialize_crc32c(void)
+{
+    uint32_t crc;
+    int i, j;
+
+    for (i = 0; i < 256; i++) {
+        crc = i;
+        for (j = 0; j < 8; j++) {
+            crc = (crc & 1) ? (crc >> 1) ^ CRC32C_POLYNOMIAL : (crc >> 1);
+        }
+        _prte_crc32c_table[0][i] = crc;
+    }
+    for (i = 0; i < 256; i++) {
+        crc = _prte_crc32c_table[0][i];
+        for (j = 1; j < 8; j++) {
+            crc = (crc >> 8) ^ _prte_crc32c_table[0][crc & 0xff];
+            _prte_crc32c_table[j][i] = crc;
+        }
+    }
+
+    _prte_crc32c_fn = crc32c_sb8;
+    _prte_crc32c_method = "slicing-by-8";
+#if defined(PRTE_CRC32C_HW)
+    if (crc32c_hw_available()) {
+        _prte_crc32c_fn = crc32c_hw;
+        _prte_crc32c_method = PRTE_CRC32C_HW;
+    }
+#endif
+}
+
+/* the oob and filem threads can both be first to checksum
+ * something, so the tables and function pointer must be
+ * complete before either of them uses the result */
+const char *prte_crc32c_method(void)
+{
+    pthread_once(&_prte_crc32c_once, prte_initialize_crc32c);
+    return _prte_crc32c_method;
+}
+
+uint32_t prte_crc32c_partial(const void *source, size_t crclen, uint32_t partial_crc)
+{
+    pthread_once(&_prte_crc32c_once, prte_initialize_crc32c);
+    return ~_prte_crc32c_fn(~partial_crc, (const unsigned char *) source, crclen);
+}
+
+uint32_t prte_bcopy_crc32c_partial(const void *source, void *destination, size_t copylen,
+                                   size_t crclen, uint32_t partial_crc)
+{
+    memcpy(destination, source, copylen);
+    return prte_crc32c_partial(source, (crclen > copylen) ? crclen : copylen, partial_crc);
+}
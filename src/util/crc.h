@@ -133,6 +133,35 @@ static inline unsigned int prte_uicrc(const void *source, size_t crclen)
     return prte_uicrc_partial(source, crclen, CRC_INITIAL_REGISTER);
 }
 
+/*
+ * CRC32C Support - the partial routines take the result of a previous
+ * call so a checksum can be computed over noncontiguous data, starting
+ * from PRTE_CRC32C_INITIAL
+ */
+
+#define PRTE_CRC32C_INITIAL ((uint32_t) 0)
+
+PRTE_EXPORT uint32_t prte_crc32c_partial(const void *source, size_t crclen,
+                                         uint32_t partial_crc);
+
+static inline uint32_t prte_crc32c(const void *source, size_t crclen)
+{
+    return prte_crc32c_partial(source, crclen, PRTE_CRC32C_INITIAL);
+}
+
+PRTE_EXPORT uint32_t prte_bcopy_crc32c_partial(const void *source, void *destination,
+                                               size_t copylen, size_t crclen,
+                                               uint32_t partial_crc);
+
+static inline uint32_t prte_bcopy_crc32c(const void *source, void *destination, size_t copylen,
+                                         size_t crclen)
+{
+    return prte_bcopy_crc32c_partial(source, destination, copylen, crclen, PRTE_CRC32C_INITIAL);
+}
+
+/* name of the CRC32C implementation in use on this processor */
+PRTE_EXPORT const char *prte_crc32c_method(void);
+
 END_C_DECLS
 
 #endif
@@ -21,82 +21,654 @@
 #    include <unistd.h>
 #endif
 #include <ctype.h>
+#include <limits.h>
+#include <string.h>
 
+#include "src/class/pmix_hash_table.h"
 #include "src/util/pmix_argv.h"
+#include "src/util/pmix_printf.h"
 
 #include "src/mca/errmgr/errmgr.h"
 #include "src/mca/rmaps/base/base.h"
 #include "src/rml/rml.h"
 #include "src/pmix/pmix-internal.h"
+#include "src/runtime/data_type_support/prte_dt_compact.h"
 #include "src/runtime/prte_globals.h"
 
 #include "src/util/nidmap.h"
 
-int prte_util_nidmap_create(pmix_pointer_array_t *pool, pmix_data_buffer_t *buffer)
+/*
+ * Range encoding of the nodes in a nidmap.
+ *
+ * Cluster hostnames are nearly always a common prefix followed by a
+ * (possibly zero-padded) node number, so the names are sent as runs of
+ * consecutive numbers that share a prefix, suffix and width - in effect
+ * "node[0001-4096]" - with any name that doesn't fit a run sent as a
+ * run of its own. The encoded object is laid out as:
+ *
+ *    version                        1 byte
+ *    number of nodes                varint
+ *    size of each section           3 varints
+ *    names section - runs of:
+ *        prefix, suffix             2 strings
+ *        width                      varint, zero for a name sent as is
+ *        first number, count        2 varints, absent if width is zero
+ *    vpids section - runs of:
+ *        first vpid                 zigzag varint, relative to the vpid
+ *                                   following the previous run
+ *        count                      varint
+ *    aliases section - runs of nodes with the same aliases:
+ *        count, number of aliases   2 varints
+ *        each alias                 varint flag, then a string - a flag
+ *                                   of one means the alias is the name
+ *                                   of the node followed by the string
+ *
+ * A string is a varint index into the table of strings already seen in
+ * that section, with zero being the empty string and the next unused
+ * index introducing a new string as a varint length plus the bytes.
+ * Keeping the sections apart lets the receiver walk all three at once
+ * and hand over each node as soon as it has been decoded.
+ */
+#define PRTE_NIDMAP_RANGES_VERSION 1
+
+/* longest node number we treat as such - anything longer
+ * is sent as part of a literal name */
+#define PRTE_NIDMAP_MAX_DIGITS 18
+/* the most digits a number can take once decoded */
+#define PRTE_NIDMAP_MAX_WIDTH 20
+
+enum {
+    NIDMAP_NAMES,
+    NIDMAP_VPIDS,
+    NIDMAP_ALIASES,
+    NIDMAP_NSECTIONS
+};
+
+typedef struct {
+    uint8_t *bytes;
+    size_t size;
+    size_t used;
+    bool failed;
+    pmix_hash_table_t strings;
+    uint64_t nstrings;
+} nidmap_section_t;
+
+typedef struct {
+    const uint8_t *ptr;
+    const uint8_t *end;
+    char **strings;
+    uint64_t nstrings;
+    uint64_t size;
+} nidmap_cursor_t;
+
+typedef struct {
+    const char *name;
+    size_t len;
+    size_t plen; // length of the prefix
+    size_t dlen; // number of digits, zero if the name has no number
+    uint64_t num;
+} nidmap_name_t;
+
+static bool reserve(nidmap_section_t *s, size_t n)
+{
+    uint8_t *tmp;
+    size_t size;
+
+    if (s->failed) {
+        return false;
+    }
+    if (s->used + n <= s->size) {
+        return true;
+    }
+    size = (0 == s->size) ? 1024 : s->size;
+    while (size < s->used + n) {
+        size *= 2;
+    }
+    tmp = (uint8_t *) realloc(s->bytes, size);
+    if (NULL == tmp) {
+        s->failed = true;
+        return false;
+    }
+    s->bytes = tmp;
+    s->size = size;
+    return true;
+}
+
+static void put_varint(nidmap_section_t *s, uint64_t val)
+{
+    if (reserve(s, PRTE_DT_VARINT_MAX)) {
+        s->used = prte_dt_put_varint(s->bytes + s->used, val) - s->bytes;
+    }
+}
+
+static void put_string(nidmap_section_t *s, const char *str, size_t len)
+{
+    void *idx;
+
+    if (0 == len) {
+        put_varint(s, 0);
+        return;
+    }
+    if (PMIX_SUCCESS == pmix_hash_table_get_value_ptr(&s->strings, str, len, &idx)) {
+        put_varint(s, (uint64_t) (uintptr_t) idx);
+        return;
+    }
+    ++s->nstrings;
+    pmix_hash_table_set_value_ptr(&s->strings, str, len, (void *) (uintptr_t) s->nstrings);
+    put_varint(s, s->nstrings);
+    put_varint(s, len);
+    if (reserve(s, len)) {
+        memcpy(s->bytes + s->used, str, len);
+        s->used += len;
+    }
+}
+
+/* split a name around its last run of digits */
+static void split_name(const char *name, nidmap_name_t *nm)
+{
+    size_t start, end, k;
+
+    nm->name = name;
+    nm->len = strlen(name);
+    nm->plen = nm->len;
+    nm->dlen = 0;
+    nm->num = 0;
+
+    end = nm->len;
+    while (0 < end && !isdigit((unsigned char) name[end - 1])) {
+        --end;
+    }
+    start = end;
+    while (0 < start && isdigit((unsigned char) name[start - 1])) {
+        --start;
+    }
+    if (start == end || PRTE_NIDMAP_MAX_DIGITS < end - start) {
+        return;
+    }
+    nm->plen = start;
+    nm->dlen = end - start;
+    for (k = start; k < end; k++) {
+        nm->num = 10 * nm->num + (uint64_t) (name[k] - '0');
+    }
+}
+
+/* can the name continue the run that starts with first? */
+static bool extends_run(const nidmap_name_t *first, const nidmap_name_t *nm, size_t width,
+                        uint64_t next)
+{
+    if (0 == nm->dlen || nm->num != next || nm->plen != first->plen
+        || nm->len - nm->dlen != first->len - first->dlen
+        || 0 != strncmp(nm->name, first->name, first->plen)
+        || 0 != strcmp(nm->name + nm->plen + nm->dlen, first->name + first->plen + first->dlen)) {
+        return false;
+    }
+    /* the number has to print the same way at the width of the run */
+    return width == nm->dlen || ('0' != nm->name[nm->plen] && width < nm->dlen);
+}
+
+static bool skip_alias(const char *alias)
+{
+    return (0 == strcmp(alias, "localhost") || 0 == strcmp(alias, "127.0.0.1"));
+}
+
+/* return the part of the alias that isn't the name of the node */
+static const char *alias_rem(prte_node_t *nptr, const char *alias, size_t *len, uint64_t *flag)
+{
+    size_t nlen = strlen(nptr->name);
+
+    if (0 == strncmp(alias, nptr->name, nlen)) {
+        *flag = 1;
+        alias += nlen;
+    } else {
+        *flag = 0;
+    }
+    *len = strlen(alias);
+    return alias;
+}
+
+static int num_aliases(prte_node_t *nptr)
+{
+    int m, n = 0;
+
+    for (m = 0; NULL != nptr->aliases && NULL != nptr->aliases[m]; m++) {
+        if (!skip_alias(nptr->aliases[m])) {
+            ++n;
+        }
+    }
+    return n;
+}
+
+static bool same_aliases(prte_node_t *a, prte_node_t *b)
+{
+    const char *r1, *r2;
+    size_t l1, l2;
+    uint64_t f1, f2;
+    int m = 0, k = 0;
+
+    if (num_aliases(a) != num_aliases(b)) {
+        return false;
+    }
+    while (NULL != a->aliases && NULL != a->aliases[m]) {
+        if (skip_alias(a->aliases[m])) {
+            ++m;
+            continue;
+        }
+        while (skip_alias(b->aliases[k])) {
+            ++k;
+        }
+        r1 = alias_rem(a, a->aliases[m++], &l1, &f1);
+        r2 = alias_rem(b, b->aliases[k++], &l2, &f2);
+        if (f1 != f2 || l1 != l2 || 0 != memcmp(r1, r2, l1)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static int encode_ranges(prte_node_t **nodes, int nnodes, pmix_byte_object_t *bo)
+{
+    nidmap_section_t sec[NIDMAP_NSECTIONS], *s;
+    nidmap_name_t first, nm;
+    pmix_rank_t vstart, vnext = 0;
+    const char *rem;
+    size_t len, width, nbytes;
+    uint64_t next, flag;
+    uint8_t *ptr;
+    int k, m, n, rc = PRTE_SUCCESS;
+
+    memset(sec, 0, sizeof(sec));
+    for (k = 0; k < NIDMAP_NSECTIONS; k++) {
+        PMIX_CONSTRUCT(&sec[k].strings, pmix_hash_table_t);
+        pmix_hash_table_init(&sec[k].strings, 64);
+    }
+
+    /* the names */
+    s = &sec[NIDMAP_NAMES];
+    for (n = 0; n < nnodes; n = m) {
+        split_name(nodes[n]->name, &first);
+        if (0 == first.dlen) {
+            put_string(s, first.name, first.len);
+            put_varint(s, 0);
+            put_varint(s, 0);
+            m = n + 1;
+            continue;
+        }
+        width = ('0' == first.name[first.plen] && 1 < first.dlen) ? first.dlen : 1;
+        next = first.num + 1;
+        for (m = n + 1; m < nnodes; m++, next++) {
+            split_name(nodes[m]->name, &nm);
+            if (!extends_run(&first, &nm, width, next)) {
+                break;
+            }
+        }
+        put_string(s, first.name, first.plen);
+        put_string(s, first.name + first.plen + first.dlen, first.len - first.plen - first.dlen);
+        put_varint(s, width);
+        put_varint(s, first.num);
+        put_varint(s, m - n);
+    }
+
+    /* the daemon vpids */
+    s = &sec[NIDMAP_VPIDS];
+    for (n = 0; n < nnodes; n = m) {
+        vstart = nodes[n]->daemon->name.rank;
+        for (m = n + 1; m < nnodes && nodes[m]->daemon->name.rank == vstart + (m - n); m++) {
+        }
+        put_varint(s, prte_dt_zigzag((int64_t) vstart - (int64_t) vnext));
+        put_varint(s, m - n);
+        vnext = vstart + (m - n);
+    }
+
+    /* the aliases */
+    s = &sec[NIDMAP_ALIASES];
+    for (n = 0; n < nnodes; n = m) {
+        for (m = n + 1; m < nnodes && same_aliases(nodes[n], nodes[m]); m++) {
+        }
+        put_varint(s, m - n);
+        put_varint(s, num_aliases(nodes[n]));
+        for (k = 0; NULL != nodes[n]->aliases && NULL != nodes[n]->aliases[k]; k++) {
+            if (skip_alias(nodes[n]->aliases[k])) {
+                continue;
+            }
+            rem = alias_rem(nodes[n], nodes[n]->aliases[k], &len, &flag);
+            put_varint(s, flag);
+            put_string(s, rem, len);
+        }
+    }
+
+    nbytes = 1 + (1 + NIDMAP_NSECTIONS) * PRTE_DT_VARINT_MAX;
+    for (k = 0; k < NIDMAP_NSECTIONS; k++) {
+        if (sec[k].failed) {
+            rc = PRTE_ERR_OUT_OF_RESOURCE;
+            goto cleanup;
+        }
+        nbytes += sec[k].used;
+    }
+    bo->bytes = (char *) malloc(nbytes);
+    if (NULL == bo->bytes) {
+        rc = PRTE_ERR_OUT_OF_RESOURCE;
+        goto cleanup;
+    }
+    ptr = (uint8_t *) bo->bytes;
+    *ptr++ = PRTE_NIDMAP_RANGES_VERSION;
+    ptr = prte_dt_put_varint(ptr, nnodes);
+    for (k = 0; k < NIDMAP_NSECTIONS; k++) {
+        ptr = prte_dt_put_varint(ptr, sec[k].used);
+    }
+    for (k = 0; k < NIDMAP_NSECTIONS; k++) {
+        if (0 < sec[k].used) {
+            memcpy(ptr, sec[k].bytes, sec[k].used);
+            ptr += sec[k].used;
+        }
+    }
+    bo->size = ptr - (uint8_t *) bo->bytes;
+
+cleanup:
+    for (k = 0; k < NIDMAP_NSECTIONS; k++) {
+        free(sec[k].bytes);
+        PMIX_DESTRUCT(&sec[k].strings);
+    }
+    return rc;
+}
+
+static bool get_varint(nidmap_cursor_t *c, uint64_t *val)
+{
+    return prte_dt_get_varint(&c->ptr, c->end, val);
+}
+
+static bool get_string(nidmap_cursor_t *c, const char **str)
+{
+    uint64_t idx, len, size;
+    char **tmp;
+
+    if (!get_varint(c, &idx)) {
+        return false;
+    }
+    if (0 == idx) {
+        *str = "";
+        return true;
+    }
+    if (idx <= c->nstrings) {
+        *str = c->strings[idx - 1];
+        return true;
+    }
+    if (idx != c->nstrings + 1 || !get_varint(c, &len) || len > (uint64_t) (c->end - c->ptr)) {
+        return false;
+    }
+    if (c->nstrings == c->size) {
+        size = (0 == c->size) ? 16 : 2 * c->size;
+        tmp = (char **) realloc(c->strings, size * sizeof(char *));
+        if (NULL == tmp) {
+            return false;
+        }
+        c->strings = tmp;
+        c->size = size;
+    }
+    c->strings[c->nstrings] = (char *) malloc(len + 1);
+    if (NULL == c->strings[c->nstrings]) {
+        return false;
+    }
+    memcpy(c->strings[c->nstrings], c->ptr, len);
+    c->strings[c->nstrings][len] = '\0';
+    c->ptr += len;
+    *str = c->strings[c->nstrings++];
+    return true;
+}
+
+/* print the number right after the prefix, returning its length */
+static size_t put_number(char *dst, uint64_t num, uint64_t width)
+{
+    char tmp[PRTE_NIDMAP_MAX_WIDTH];
+    size_t k = 0, n;
+
+    do {
+        tmp[k++] = (char) ('0' + num % 10);
+        num /= 10;
+    } while (0 != num);
+    while (k < width) {
+        tmp[k++] = '0';
+    }
+    for (n = 0; n < k; n++) {
+        dst[n] = tmp[k - 1 - n];
+    }
+    return k;
+}
+
+static int decode_ranges(const pmix_byte_object_t *bo, prte_util_nidmap_node_fn_t fn,
+                         void *cbdata)
+{
+    const uint8_t *ptr = (const uint8_t *) bo->bytes;
+    const uint8_t *end = ptr + bo->size;
+    nidmap_cursor_t cur[NIDMAP_NSECTIONS];
+    const char *prefix = "", *suffix = "", **rems = NULL;
+    uint64_t nnodes, len[NIDMAP_NSECTIONS], v, k, width = 0, num = 0, nalias = 0;
+    uint64_t nrun = 0, vrun = 0, arun = 0, *flags = NULL;
+    size_t plen = 0, slen = 0, nlen;
+    pmix_rank_t vnext = 0, vpid;
+    char *name = NULL, **aliases;
+    int n, rc = PRTE_ERR_UNPACK_FAILURE;
+
+    memset(cur, 0, sizeof(cur));
+    if (ptr >= end || PRTE_NIDMAP_RANGES_VERSION != *ptr++) {
+        return PRTE_ERR_UNPACK_FAILURE;
+    }
+    if (!prte_dt_get_varint(&ptr, end, &nnodes) || INT_MAX < nnodes) {
+        return PRTE_ERR_UNPACK_FAILURE;
+    }
+    for (n = 0; n < NIDMAP_NSECTIONS; n++) {
+        if (!prte_dt_get_varint(&ptr, end, &len[n])) {
+            return PRTE_ERR_UNPACK_FAILURE;
+        }
+    }
+    for (n = 0; n < NIDMAP_NSECTIONS; n++) {
+        if (len[n] > (uint64_t) (end - ptr)) {
+            return PRTE_ERR_UNPACK_FAILURE;
+        }
+        cur[n].ptr = ptr;
+        cur[n].end = ptr + len[n];
+        ptr += len[n];
+    }
+
+    for (n = 0; n < (int) nnodes; n++) {
+        /* the name */
+        if (0 == nrun) {
+            if (!get_string(&cur[NIDMAP_NAMES], &prefix)
+                || !get_string(&cur[NIDMAP_NAMES], &suffix)
+                || !get_varint(&cur[NIDMAP_NAMES], &width) || PRTE_NIDMAP_MAX_WIDTH < width) {
+                goto cleanup;
+            }
+            nrun = 1;
+            if (0 < width && (!get_varint(&cur[NIDMAP_NAMES], &num)
+                              || !get_varint(&cur[NIDMAP_NAMES], &nrun) || 0 == nrun)) {
+                goto cleanup;
+            }
+            plen = strlen(prefix);
+            slen = strlen(suffix);
+            free(name);
+            name = (char *) malloc(plen + PRTE_NIDMAP_MAX_WIDTH + slen + 1);
+            if (NULL == name) {
+                rc = PRTE_ERR_OUT_OF_RESOURCE;
+                goto cleanup;
+            }
+            memcpy(name, prefix, plen);
+            nlen = plen;
+            if (0 == width) {
+                memcpy(name + nlen, suffix, slen + 1);
+            }
+        }
+        if (0 < width) {
+            nlen = plen + put_number(name + plen, num++, width);
+            memcpy(name + nlen, suffix, slen + 1);
+        }
+        --nrun;
+
+        /* the daemon vpid */
+        if (0 == vrun) {
+            if (!get_varint(&cur[NIDMAP_VPIDS], &v) || !get_varint(&cur[NIDMAP_VPIDS], &vrun)
+                || 0 == vrun) {
+                goto cleanup;
+            }
+            vnext = (pmix_rank_t) ((int64_t) vnext + prte_dt_unzigzag(v));
+        }
+        vpid = vnext++;
+        --vrun;
+
+        /* the aliases */
+        if (0 == arun) {
+            if (!get_varint(&cur[NIDMAP_ALIASES], &arun)
+                || !get_varint(&cur[NIDMAP_ALIASES], &nalias) || 0 == arun
+                || nalias > (uint64_t) (cur[NIDMAP_ALIASES].end - cur[NIDMAP_ALIASES].ptr)) {
+                goto cleanup;
+            }
+            free(flags);
+            free(rems);
+            flags = NULL;
+            rems = NULL;
+            if (0 < nalias) {
+                flags = (uint64_t *) malloc(nalias * sizeof(uint64_t));
+                rems = (const char **) malloc(nalias * sizeof(char *));
+                if (NULL == flags || NULL == rems) {
+                    rc = PRTE_ERR_OUT_OF_RESOURCE;
+                    goto cleanup;
+                }
+            }
+            for (k = 0; k < nalias; k++) {
+                if (!get_varint(&cur[NIDMAP_ALIASES], &flags[k])
+                    || !get_string(&cur[NIDMAP_ALIASES], &rems[k])) {
+                    goto cleanup;
+                }
+            }
+        }
+        --arun;
+
+        if (NULL == fn) {
+            continue;
+        }
+        aliases = NULL;
+        if (0 < nalias) {
+            aliases = (char **) calloc(nalias + 1, sizeof(char *));
+            for (k = 0; NULL != aliases && k < nalias; k++) {
+                if (flags[k]) {
+                    pmix_asprintf(&aliases[k], "%s%s", name, rems[k]);
+                } else {
+                    aliases[k] = strdup(rems[k]);
+                }
+            }
+        }
+        fn(n, name, aliases, vpid, cbdata);
+    }
+    rc = PRTE_SUCCESS;
+
+cleanup:
+    for (n = 0; n < NIDMAP_NSECTIONS; n++) {
+        for (k = 0; k < cur[n].nstrings; k++) {
+            free(cur[n].strings[k]);
+        }
+        free(cur[n].strings);
+    }
+    free(name);
+    free(flags);
+    free(rems);
+    return rc;
+}
+
+/* pack a bool indicating compression followed by the object,
+ * taking ownership of the data */
+static int pack_object(pmix_data_buffer_t *buffer, uint8_t *data, size_t size)
 {
-    char *raw = NULL;
-    pmix_rank_t *vpids = NULL;
-    uint8_t u8;
-    int n, m, ndaemons, nbytes;
-    bool compressed;
-    char **names = NULL;
-    char **aliases = NULL, **als;
-    prte_node_t *nptr;
     pmix_byte_object_t bo;
+    bool compressed;
     size_t sz;
     pmix_status_t rc;
 
-    /* pack a flag indicating if the HNP was included in the allocation */
-    if (prte_hnp_is_allocated) {
-        u8 = 1;
+    if (PMIx_Data_compress(data, size, (uint8_t **) &bo.bytes, &sz)) {
+        /* mark that this was compressed */
+        compressed = true;
+        bo.size = sz;
+        free(data);
     } else {
-        u8 = 0;
+        /* mark that this was not compressed */
+        compressed = false;
+        bo.bytes = (char *) data;
+        bo.size = size;
     }
-    rc = PMIx_Data_pack(PRTE_PROC_MY_NAME, buffer, &u8, 1, PMIX_UINT8);
+    /* indicate compression */
+    rc = PMIx_Data_pack(PRTE_PROC_MY_NAME, buffer, &compressed, 1, PMIX_BOOL);
     if (PMIX_SUCCESS != rc) {
         PMIX_ERROR_LOG(rc);
+        free(bo.bytes);
         return rc;
     }
-
-    /* pack a flag indicating if we are in a managed allocation */
-    if (prte_managed_allocation) {
-        u8 = 1;
-    } else {
-        u8 = 0;
+    /* add the object */
+    rc = PMIx_Data_pack(PRTE_PROC_MY_NAME, buffer, &bo, 1, PMIX_BYTE_OBJECT);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
     }
-    rc = PMIx_Data_pack(PRTE_PROC_MY_NAME, buffer, &u8, 1, PMIX_UINT8);
+    free(bo.bytes);
+    return rc;
+}
+
+/* unpack an object packed by pack_object, decompressing it if required */
+static int unpack_object(pmix_data_buffer_t *buf, uint8_t **data, size_t *size)
+{
+    pmix_byte_object_t pbo;
+    bool compressed;
+    int cnt;
+    pmix_status_t rc;
+
+    /* unpack compression flag */
+    cnt = 1;
+    rc = PMIx_Data_unpack(PRTE_PROC_MY_NAME, buf, &compressed, &cnt, PMIX_BOOL);
     if (PMIX_SUCCESS != rc) {
         PMIX_ERROR_LOG(rc);
         return rc;
     }
 
-    /* daemon vpids start from 0 and increase linearly by one
-     * up to the number of nodes in the system. The vpid is
-     * a 32-bit value. We don't know how many of the nodes
-     * in the system have daemons - we may not be using them
-     * all just yet. However, even the largest systems won't
-     * have more than a million nodes for quite some time,
-     * so for now we'll just allocate enough space to hold
-     * them all. Someone can optimize this further later */
-    nbytes = prte_process_info.num_daemons * sizeof(pmix_rank_t);
-    vpids = (pmix_rank_t *) malloc(nbytes);
+    /* unpack the object */
+    cnt = 1;
+    rc = PMIx_Data_unpack(PRTE_PROC_MY_NAME, buf, &pbo, &cnt, PMIX_BYTE_OBJECT);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return rc;
+    }
 
-    ndaemons = 0;
-    for (n = 0; n < pool->size; n++) {
-        if (NULL == (nptr = (prte_node_t *) pmix_pointer_array_get_item(pool, n))) {
-            continue;
-        }
-        if (NULL == nptr->daemon) {
-            continue;
+    /* if compressed, decompress */
+    if (compressed) {
+        if (!PMIx_Data_decompress((uint8_t *) pbo.bytes, pbo.size, data, size)) {
+            PRTE_ERROR_LOG(PRTE_ERROR);
+            PMIX_BYTE_OBJECT_DESTRUCT(&pbo);
+            return PRTE_ERROR;
         }
+    } else {
+        *data = (uint8_t *) pbo.bytes;
+        *size = pbo.size;
+        pbo.bytes = NULL; // protect the data
+        pbo.size = 0;
+    }
+    PMIX_BYTE_OBJECT_DESTRUCT(&pbo);
+    return PRTE_SUCCESS;
+}
+
+static int pack_lists(prte_node_t **nodes, int nnodes, pmix_data_buffer_t *buffer)
+{
+    char *raw = NULL;
+    pmix_rank_t *vpids = NULL;
+    int n, m;
+    char **names = NULL;
+    char **aliases = NULL, **als;
+    prte_node_t *nptr;
+    pmix_status_t rc;
+
+    vpids = (pmix_rank_t *) malloc(nnodes * sizeof(pmix_rank_t));
+    for (n = 0; n < nnodes; n++) {
+        nptr = nodes[n];
         /* add the hostname to the argv */
         PMIX_ARGV_APPEND_NOSIZE_COMPAT(&names, nptr->name);
         als = NULL;
         if (NULL != nptr->aliases) {
             for (m=0; NULL != nptr->aliases[m]; m++) {
                 // skip any localhost entries
-                if (0 == strcmp(nptr->aliases[m], "localhost") ||
-                    0 == strcmp(nptr->aliases[m], "127.0.0.1")) {
+                if (skip_alias(nptr->aliases[m])) {
                     continue;
                 }
                 PMIX_ARGV_APPEND_NOSIZE_COMPAT(&als, nptr->aliases[m]);
@@ -109,125 +681,171 @@ int prte_util_nidmap_create(pmix_pointer_array_t *pool, pmix_data_buffer_t *buff
             PMIX_ARGV_APPEND_NOSIZE_COMPAT(&aliases, "PRTENONE");
         }
         /* store the vpid */
-        vpids[ndaemons] = nptr->daemon->name.rank;
-        ++ndaemons;
-    }
-
-    /* little protection */
-    if (NULL == names || NULL == aliases) {
-        PRTE_ERROR_LOG(PRTE_ERR_NOT_FOUND);
-        free(vpids);
-        return PRTE_ERR_NOT_FOUND;
+        vpids[n] = nptr->daemon->name.rank;
     }
 
     /* construct the string of node names for compression */
     raw = PMIX_ARGV_JOIN_COMPAT(names, ',');
     PMIX_ARGV_FREE_COMPAT(names);
-    if (PMIx_Data_compress((uint8_t *) raw, strlen(raw) + 1, (uint8_t **) &bo.bytes, &sz)) {
-        /* mark that this was compressed */
-        compressed = true;
-        bo.size = sz;
-        free(raw);
-    } else {
-        /* mark that this was not compressed */
-        compressed = false;
-        bo.bytes = (char *) raw;
-        bo.size = strlen(raw) + 1;
-    }
-    /* indicate compression */
-    rc = PMIx_Data_pack(PRTE_PROC_MY_NAME, buffer, &compressed, 1, PMIX_BOOL);
+    rc = pack_object(buffer, (uint8_t *) raw, strlen(raw) + 1);
     if (PMIX_SUCCESS != rc) {
-        PMIX_ERROR_LOG(rc);
-        free(bo.bytes);
+        PMIX_ARGV_FREE_COMPAT(aliases);
         free(vpids);
         return rc;
     }
-    /* add the object */
-    rc = PMIx_Data_pack(PRTE_PROC_MY_NAME, buffer, &bo, 1, PMIX_BYTE_OBJECT);
-    if (PMIX_SUCCESS != rc) {
-        PMIX_ERROR_LOG(rc);
-        free(bo.bytes);
-        free(vpids);
-        return rc;
-    }
-    free(bo.bytes);
 
     /* construct the string of aliases for compression */
     raw = PMIX_ARGV_JOIN_COMPAT(aliases, ';');
     PMIX_ARGV_FREE_COMPAT(aliases);
-    if (PMIx_Data_compress((uint8_t *) raw, strlen(raw) + 1, (uint8_t **) &bo.bytes, &sz)) {
-        /* mark that this was compressed */
-        compressed = true;
-        bo.size = sz;
-        free(raw);
-    } else {
-        /* mark that this was not compressed */
-        compressed = false;
-        bo.bytes = (char *) raw;
-        bo.size = strlen(raw) + 1;
-    }
-    /* indicate compression */
-    rc = PMIx_Data_pack(PRTE_PROC_MY_NAME, buffer, &compressed, 1, PMIX_BOOL);
+    rc = pack_object(buffer, (uint8_t *) raw, strlen(raw) + 1);
     if (PMIX_SUCCESS != rc) {
-        PMIX_ERROR_LOG(rc);
-        free(bo.bytes);
         free(vpids);
         return rc;
     }
-    /* add the object */
-    rc = PMIx_Data_pack(PRTE_PROC_MY_NAME, buffer, &bo, 1, PMIX_BYTE_OBJECT);
+
+    /* compress the vpids */
+    return pack_object(buffer, (uint8_t *) vpids, nnodes * sizeof(pmix_rank_t));
+}
+
+static int unpack_lists(pmix_data_buffer_t *buf, prte_util_nidmap_node_fn_t fn, void *cbdata)
+{
+    pmix_rank_t *vpid = NULL;
+    size_t sz, nvpids;
+    char *raw = NULL, **names = NULL, **aliases = NULL, **als;
+    int n, rc;
+
+    /* the node names */
+    rc = unpack_object(buf, (uint8_t **) &raw, &sz);
+    if (PRTE_SUCCESS != rc) {
+        goto cleanup;
+    }
+    names = PMIX_ARGV_SPLIT_COMPAT(raw, ',');
+    free(raw);
+
+    /* the node aliases */
+    rc = unpack_object(buf, (uint8_t **) &raw, &sz);
+    if (PRTE_SUCCESS != rc) {
+        goto cleanup;
+    }
+    aliases = PMIX_ARGV_SPLIT_COMPAT(raw, ';');
+    free(raw);
+
+    /* the daemon vpids */
+    rc = unpack_object(buf, (uint8_t **) &vpid, &sz);
+    if (PRTE_SUCCESS != rc) {
+        goto cleanup;
+    }
+    nvpids = sz / sizeof(pmix_rank_t);
+
+    for (n = 0; NULL != fn && NULL != names && NULL != names[n]; n++) {
+        if (NULL == aliases || NULL == aliases[n] || (size_t) n >= nvpids) {
+            PRTE_ERROR_LOG(PRTE_ERR_UNPACK_FAILURE);
+            rc = PRTE_ERR_UNPACK_FAILURE;
+            goto cleanup;
+        }
+        als = NULL;
+        if (0 != strcmp(aliases[n], "PRTENONE")) {
+            als = PMIX_ARGV_SPLIT_COMPAT(aliases[n], ',');
+        }
+        fn(n, names[n], als, vpid[n], cbdata);
+    }
+
+cleanup:
+    if (NULL != vpid) {
+        free(vpid);
+    }
+    if (NULL != names) {
+        PMIX_ARGV_FREE_COMPAT(names);
+    }
+    if (NULL != aliases) {
+        PMIX_ARGV_FREE_COMPAT(aliases);
+    }
+    return rc;
+}
+
+int prte_util_nidmap_create(pmix_pointer_array_t *pool, pmix_data_buffer_t *buffer)
+{
+    uint8_t u8;
+    int n, nnodes;
+    prte_node_t *nptr, **nodes;
+    pmix_byte_object_t bo;
+    pmix_status_t rc;
+
+    /* pack a flag indicating if the HNP was included in the allocation */
+    if (prte_hnp_is_allocated) {
+        u8 = 1;
+    } else {
+        u8 = 0;
+    }
+    rc = PMIx_Data_pack(PRTE_PROC_MY_NAME, buffer, &u8, 1, PMIX_UINT8);
     if (PMIX_SUCCESS != rc) {
         PMIX_ERROR_LOG(rc);
-        free(bo.bytes);
-        free(vpids);
         return rc;
     }
-    free(bo.bytes);
 
-    /* compress the vpids */
-    if (PMIx_Data_compress((uint8_t *) vpids, nbytes, (uint8_t **) &bo.bytes, &sz)) {
-        /* mark that this was compressed */
-        compressed = true;
-        bo.size = sz;
-        free(vpids);
+    /* pack a flag indicating if we are in a managed allocation */
+    if (prte_managed_allocation) {
+        u8 = 1;
     } else {
-        /* mark that this was not compressed */
-        compressed = false;
-        bo.bytes = (char *) vpids;
-        bo.size = ndaemons * sizeof(pmix_rank_t);
+        u8 = 0;
     }
-    /* indicate compression */
-    rc = PMIx_Data_pack(PRTE_PROC_MY_NAME, buffer, &compressed, 1, PMIX_BOOL);
+    rc = PMIx_Data_pack(PRTE_PROC_MY_NAME, buffer, &u8, 1, PMIX_UINT8);
     if (PMIX_SUCCESS != rc) {
         PMIX_ERROR_LOG(rc);
-        free(bo.bytes);
         return rc;
     }
-    /* add the object */
-    rc = PMIx_Data_pack(PRTE_PROC_MY_NAME, buffer, &bo, 1, PMIX_BYTE_OBJECT);
+
+    /* collect the nodes that have daemons on them */
+    nodes = (prte_node_t **) malloc(pool->size * sizeof(prte_node_t *));
+    if (NULL == nodes) {
+        PRTE_ERROR_LOG(PRTE_ERR_OUT_OF_RESOURCE);
+        return PRTE_ERR_OUT_OF_RESOURCE;
+    }
+    nnodes = 0;
+    for (n = 0; n < pool->size; n++) {
+        if (NULL == (nptr = (prte_node_t *) pmix_pointer_array_get_item(pool, n))) {
+            continue;
+        }
+        if (NULL == nptr->daemon) {
+            continue;
+        }
+        nodes[nnodes++] = nptr;
+    }
+
+    /* little protection */
+    if (0 == nnodes) {
+        PRTE_ERROR_LOG(PRTE_ERR_NOT_FOUND);
+        free(nodes);
+        return PRTE_ERR_NOT_FOUND;
+    }
+
+    u8 = prte_compact_nidmap ? PRTE_NIDMAP_RANGES : PRTE_NIDMAP_LISTS;
+    rc = PMIx_Data_pack(PRTE_PROC_MY_NAME, buffer, &u8, 1, PMIX_UINT8);
     if (PMIX_SUCCESS != rc) {
         PMIX_ERROR_LOG(rc);
-        free(bo.bytes);
+        free(nodes);
         return rc;
     }
-    free(bo.bytes);
-
+    if (PRTE_NIDMAP_RANGES == u8) {
+        rc = encode_ranges(nodes, nnodes, &bo);
+        if (PRTE_SUCCESS == rc) {
+            rc = pack_object(buffer, (uint8_t *) bo.bytes, bo.size);
+        } else {
+            PRTE_ERROR_LOG(rc);
+        }
+    } else {
+        rc = pack_lists(nodes, nnodes, buffer);
+    }
+    free(nodes);
     return rc;
 }
 
-int prte_util_decode_nidmap(pmix_data_buffer_t *buf)
+int prte_util_nidmap_unpack(pmix_data_buffer_t *buf, prte_util_nidmap_node_fn_t fn, void *cbdata)
 {
     uint8_t u8;
-    pmix_rank_t *vpid = NULL;
-    int cnt, n;
-    bool compressed;
+    pmix_byte_object_t bo;
     size_t sz;
-    pmix_byte_object_t pbo;
-    char *raw = NULL, **names = NULL, **aliases = NULL;
-    prte_node_t *nd;
-    prte_job_t *daemons;
-    prte_proc_t *proc;
-    prte_topology_t *t = NULL;
+    int cnt;
     pmix_status_t rc;
 
     /* unpack the flag indicating if HNP is in allocation */
@@ -235,7 +853,7 @@ int prte_util_decode_nidmap(pmix_data_buffer_t *buf)
     rc = PMIx_Data_unpack(PRTE_PROC_MY_NAME, buf, &u8, &cnt, PMIX_UINT8);
     if (PMIX_SUCCESS != rc) {
         PMIX_ERROR_LOG(rc);
-        goto cleanup;
+        return rc;
     }
     if (1 == u8) {
         prte_hnp_is_allocated = true;
@@ -248,7 +866,7 @@ int prte_util_decode_nidmap(pmix_data_buffer_t *buf)
     rc = PMIx_Data_unpack(PRTE_PROC_MY_NAME, buf, &u8, &cnt, PMIX_UINT8);
     if (PMIX_SUCCESS != rc) {
         PMIX_ERROR_LOG(rc);
-        goto cleanup;
+        return rc;
     }
     if (1 == u8) {
         prte_managed_allocation = true;
@@ -256,182 +874,123 @@ int prte_util_decode_nidmap(pmix_data_buffer_t *buf)
         prte_managed_allocation = false;
     }
 
-    /* unpack compression flag for node names */
+    /* unpack the encoding of the nodes */
     cnt = 1;
-    rc = PMIx_Data_unpack(PRTE_PROC_MY_NAME, buf, &compressed, &cnt, PMIX_BOOL);
-    if (PMIX_SUCCESS != rc) {
-        PMIX_ERROR_LOG(rc);
-        goto cleanup;
-    }
-
-    /* unpack the nodename object */
-    cnt = 1;
-    rc = PMIx_Data_unpack(PRTE_PROC_MY_NAME, buf, &pbo, &cnt, PMIX_BYTE_OBJECT);
+    rc = PMIx_Data_unpack(PRTE_PROC_MY_NAME, buf, &u8, &cnt, PMIX_UINT8);
     if (PMIX_SUCCESS != rc) {
         PMIX_ERROR_LOG(rc);
-        goto cleanup;
+        return rc;
     }
-
-    /* if compressed, decompress */
-    if (compressed) {
-        if (!PMIx_Data_decompress((uint8_t *) pbo.bytes, pbo.size, (uint8_t **) &raw, &sz)) {
-            PRTE_ERROR_LOG(PRTE_ERROR);
-            PMIX_BYTE_OBJECT_DESTRUCT(&pbo);
-            rc = PRTE_ERROR;
-            goto cleanup;
-        }
-    } else {
-        raw = (char *) pbo.bytes;
-        pbo.bytes = NULL; // protect the data
-        pbo.size = 0;
+    if (PRTE_NIDMAP_LISTS == u8) {
+        return unpack_lists(buf, fn, cbdata);
     }
-    PMIX_BYTE_OBJECT_DESTRUCT(&pbo);
-    names = PMIX_ARGV_SPLIT_COMPAT(raw, ',');
-    free(raw);
-
-    /* unpack compression flag for node aliases */
-    cnt = 1;
-    rc = PMIx_Data_unpack(PRTE_PROC_MY_NAME, buf, &compressed, &cnt, PMIX_BOOL);
-    if (PMIX_SUCCESS != rc) {
-        PMIX_ERROR_LOG(rc);
-        goto cleanup;
+    if (PRTE_NIDMAP_RANGES != u8) {
+        PRTE_ERROR_LOG(PRTE_ERR_UNPACK_FAILURE);
+        return PRTE_ERR_UNPACK_FAILURE;
     }
-
-    /* unpack the aliases object */
-    cnt = 1;
-    rc = PMIx_Data_unpack(PRTE_PROC_MY_NAME, buf, &pbo, &cnt, PMIX_BYTE_OBJECT);
-    if (PMIX_SUCCESS != rc) {
-        PMIX_ERROR_LOG(rc);
-        goto cleanup;
+    rc = unpack_object(buf, (uint8_t **) &bo.bytes, &sz);
+    if (PRTE_SUCCESS != rc) {
+        return rc;
     }
-
-    /* if compressed, decompress */
-    if (compressed) {
-        if (!PMIx_Data_decompress((uint8_t *) pbo.bytes, pbo.size, (uint8_t **) &raw, &sz)) {
-            PRTE_ERROR_LOG(PRTE_ERROR);
-            PMIX_BYTE_OBJECT_DESTRUCT(&pbo);
-            rc = PRTE_ERROR;
-            goto cleanup;
+    bo.size = sz;
+    if (NULL != fn) {
+        rc = decode_ranges(&bo, fn, cbdata);
+        if (PRTE_SUCCESS != rc) {
+            PRTE_ERROR_LOG(rc);
         }
-    } else {
-        raw = (char *) pbo.bytes;
-        pbo.bytes = NULL; // protect the data
-        pbo.size = 0;
     }
-    PMIX_BYTE_OBJECT_DESTRUCT(&pbo);
-    aliases = PMIX_ARGV_SPLIT_COMPAT(raw, ';');
-    free(raw);
+    free(bo.bytes);
+    return rc;
+}
 
-    /* unpack compression flag for daemon vpids */
-    cnt = 1;
-    rc = PMIx_Data_unpack(PRTE_PROC_MY_NAME, buf, &compressed, &cnt, PMIX_BOOL);
-    if (PMIX_SUCCESS != rc) {
-        PMIX_ERROR_LOG(rc);
-        goto cleanup;
-    }
+typedef struct {
+    prte_job_t *daemons;
+    prte_topology_t *t;
+} nidmap_decode_t;
 
-    /* unpack the vpid object */
-    cnt = 1;
-    rc = PMIx_Data_unpack(PRTE_PROC_MY_NAME, buf, &pbo, &cnt, PMIX_BYTE_OBJECT);
-    if (PMIX_SUCCESS != rc) {
-        PMIX_ERROR_LOG(rc);
-        goto cleanup;
-    }
+/* add a node to the node pool */
+static void add_node(int n, const char *name, char **aliases, pmix_rank_t vpid, void *cbdata)
+{
+    nidmap_decode_t *dec = (nidmap_decode_t *) cbdata;
+    prte_node_t *nd;
+    prte_proc_t *proc;
 
-    /* if compressed, decompress */
-    if (compressed) {
-        if (!PMIx_Data_decompress((uint8_t *) pbo.bytes, pbo.size, (uint8_t **) &vpid, &sz)) {
-            PRTE_ERROR_LOG(PRTE_ERROR);
-            PMIX_BYTE_OBJECT_DESTRUCT(&pbo);
-            rc = PRTE_ERROR;
-            goto cleanup;
+    /* do we already have this node? */
+    nd = (prte_node_t*)pmix_pointer_array_get_item(prte_node_pool, n);
+    if (NULL != nd) {
+        /* check the name */
+        if (0 != strcmp(nd->name, name)) {
+            free(nd->name);
+            nd->name = strdup(name);
         }
-    } else {
-        vpid = (pmix_rank_t *) pbo.bytes;
-        sz = pbo.size;
-        pbo.bytes = NULL;
-        pbo.size = 0;
-    }
-    PMIX_BYTE_OBJECT_DESTRUCT(&pbo);
+        if (NULL != aliases) {
+            if (NULL != nd->aliases) {
+                PMIX_ARGV_FREE_COMPAT(nd->aliases);
+            }
+            nd->aliases = aliases;
+        }
+        return;
+    }
+    /* add this name to the pool */
+    nd = PMIX_NEW(prte_node_t);
+    nd->name = strdup(name);
+    nd->index = n;
+    pmix_pointer_array_set_item(prte_node_pool, n, nd);
+    /* add any aliases */
+    nd->aliases = aliases;
+    /* set the topology - always default to homogeneous
+     * as that is the most common scenario */
+    nd->topology = dec->t;
+    /* record the daemon on it */
+    proc = (prte_proc_t *) pmix_pointer_array_get_item(dec->daemons->procs, vpid);
+    if (NULL == proc) {
+        proc = PMIX_NEW(prte_proc_t);
+        PMIX_LOAD_PROCID(&proc->name, PRTE_PROC_MY_NAME->nspace, vpid);
+        proc->state = PRTE_PROC_STATE_RUNNING;
+        PRTE_FLAG_SET(proc, PRTE_PROC_FLAG_ALIVE);
+        dec->daemons->num_procs++;
+        pmix_pointer_array_set_item(dec->daemons->procs, proc->name.rank, proc);
+    }
+    PMIX_RETAIN(nd);
+    proc->node = nd;
+    PMIX_RETAIN(proc);
+    nd->daemon = proc;
+}
+
+int prte_util_decode_nidmap(pmix_data_buffer_t *buf)
+{
+    nidmap_decode_t dec;
+    pmix_status_t rc;
 
     /* if we are the HNP, we don't need any of this stuff */
     if (PRTE_PROC_IS_MASTER) {
-        rc = PRTE_SUCCESS;
-        goto cleanup;
+        return prte_util_nidmap_unpack(buf, NULL, NULL);
     }
 
     /* get the daemon job object */
-    daemons = prte_get_job_data_object(PRTE_PROC_MY_NAME->nspace);
+    dec.daemons = prte_get_job_data_object(PRTE_PROC_MY_NAME->nspace);
 
     /* get our topology */
-    t = (prte_topology_t *) pmix_pointer_array_get_item(prte_node_topologies, 0);
-    if (NULL == t) {
+    dec.t = (prte_topology_t *) pmix_pointer_array_get_item(prte_node_topologies, 0);
+    if (NULL == dec.t) {
         /* should never happen */
         PRTE_ERROR_LOG(PRTE_ERR_NOT_FOUND);
-        rc = PRTE_ERR_NOT_FOUND;
-        goto cleanup;
+        return PRTE_ERR_NOT_FOUND;
     }
+
     /* create the node pool array - this will include
      * _all_ nodes known to the allocation */
-    for (n = 0; NULL != names[n]; n++) {
-        /* do we already have this node? */
-        nd = (prte_node_t*)pmix_pointer_array_get_item(prte_node_pool, n);
-        if (NULL != nd) {
-            /* check the name */
-            if (0 != strcmp(nd->name, names[n])) {
-                free(nd->name);
-                nd->name = strdup(names[n]);
-            }
-            if (0 != strcmp(aliases[n], "PRTENONE")) {
-                if (NULL != nd->aliases) {
-                    PMIX_ARGV_FREE_COMPAT(nd->aliases);
-                }
-                nd->aliases = PMIX_ARGV_SPLIT_COMPAT(aliases[n], ',');
-            }
-            continue;
-        }
-        /* add this name to the pool */
-        nd = PMIX_NEW(prte_node_t);
-        nd->name = strdup(names[n]);
-        nd->index = n;
-        pmix_pointer_array_set_item(prte_node_pool, n, nd);
-        /* add any aliases */
-        if (0 != strcmp(aliases[n], "PRTENONE")) {
-            nd->aliases = PMIX_ARGV_SPLIT_COMPAT(aliases[n], ',');
-        }
-        /* set the topology - always default to homogeneous
-         * as that is the most common scenario */
-        nd->topology = t;
-        /* record the daemon on it */
-        proc = (prte_proc_t *) pmix_pointer_array_get_item(daemons->procs, vpid[n]);
-        if (NULL == proc) {
-            proc = PMIX_NEW(prte_proc_t);
-            PMIX_LOAD_PROCID(&proc->name, PRTE_PROC_MY_NAME->nspace, vpid[n]);
-            proc->state = PRTE_PROC_STATE_RUNNING;
-            PRTE_FLAG_SET(proc, PRTE_PROC_FLAG_ALIVE);
-            daemons->num_procs++;
-            pmix_pointer_array_set_item(daemons->procs, proc->name.rank, proc);
-        }
-        PMIX_RETAIN(nd);
-        proc->node = nd;
-        PMIX_RETAIN(proc);
-        nd->daemon = proc;
+    rc = prte_util_nidmap_unpack(buf, add_node, &dec);
+    if (PRTE_SUCCESS != rc) {
+        return rc;
     }
 
     /* update num procs */
-    if (prte_process_info.num_daemons != daemons->num_procs) {
-        prte_process_info.num_daemons = daemons->num_procs;
+    if (prte_process_info.num_daemons != dec.daemons->num_procs) {
+        prte_process_info.num_daemons = dec.daemons->num_procs;
         /* update the routing tree */
         prte_rml_compute_routing_tree();
     }
 
-
-cleanup:
-    if (NULL != vpid) {
-        free(vpid);
-    }
-    if (NULL != names) {
-        PMIX_ARGV_FREE_COMPAT(names);
-    }
     return rc;
 }
@@ -13,7 +13,7 @@
  *                         All rights reserved.
  * Copyright (c) 2010-2020 Cisco Systems, Inc.  All rights reserved
  * Copyright (c) 2015-2019 Intel, Inc.  All rights reserved.
- * Copyright (c) 2021-2022 Nanook Consulting.  All rights reserved.
+ * Copyright (c) 2021-2025 Nanook Consulting.  All rights reserved.
  * $COPYRIGHT$
  *
  * Additional copyrights may follow
@@ -30,9 +30,24 @@
 #include "src/pmix/pmix-internal.h"
 #include "src/runtime/prte_globals.h"
 
+/* encodings of the nodes in a nidmap */
+#define PRTE_NIDMAP_LISTS  0 // delimited strings of names and of aliases
+#define PRTE_NIDMAP_RANGES 1 // runs of names sharing a prefix - see nidmap.c
+
+/* called for each node as it is unpacked from a nidmap. The name is
+ * only valid for the duration of the call, while the aliases (NULL if
+ * the node has none) belong to the callee */
+typedef void (*prte_util_nidmap_node_fn_t)(int index, const char *name, char **aliases,
+                                           pmix_rank_t vpid, void *cbdata);
+
 /* pass info about the nodes in an allocation */
 PRTE_EXPORT int prte_util_nidmap_create(pmix_pointer_array_t *pool, pmix_data_buffer_t *buf);
 
 PRTE_EXPORT int prte_util_decode_nidmap(pmix_data_buffer_t *buf);
 
+/* unpack a nidmap, passing each node to the given function - or
+ * just stepping over them if it is NULL */
+PRTE_EXPORT int prte_util_nidmap_unpack(pmix_data_buffer_t *buf, prte_util_nidmap_node_fn_t fn,
+                                        void *cbdata);
+
 #endif /* PRTE_NIDMAP_H */
@@ -43,6 +43,7 @@
 #    include <unistd.h>
 #endif /* HAVE_UNISTD_H */
 #include <errno.h>
+#include <pthread.h>
 #ifdef HAVE_DIRENT_H
 #    include <dirent.h>
 #endif /* HAVE_DIRENT_H */
@@ -67,6 +68,7 @@
 #include "src/mca/ras/base/base.h"
 #include "src/runtime/prte_globals.h"
 #include "src/runtime/runtime.h"
+#include "src/threads/pmix_threads.h"
 
 #include "src/util/session_dir.h"
 
@@ -77,6 +79,39 @@ static bool _check_file(const char *root, const char *path);
 
 static bool setup_base_complete = false;
 
+/* job session directories are renamed out of the way when their
+ * job terminates and then destroyed by a worker thread, so the
+ * daemon isn't held up by the filesystem between jobs. Anything
+ * the worker keeps is moved back to where it came from */
+typedef struct {
+    pmix_list_item_t super;
+    char *path;
+    char *orig;
+} prte_session_dir_trash_t;
+static void trcon(prte_session_dir_trash_t *p)
+{
+    p->path = NULL;
+    p->orig = NULL;
+}
+static void trdes(prte_session_dir_trash_t *p)
+{
+    if (NULL != p->path) {
+        free(p->path);
+    }
+    if (NULL != p->orig) {
+        free(p->orig);
+    }
+}
+static PMIX_CLASS_INSTANCE(prte_session_dir_trash_t, pmix_list_item_t, trcon, trdes);
+
+static pthread_mutex_t trash_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t trash_cond = PTHREAD_COND_INITIALIZER;
+static pmix_list_t trash = PMIX_LIST_STATIC_INIT;
+static pmix_thread_t trash_thread;
+static bool trash_active = false;
+static bool trash_stop = false;
+static unsigned long trash_count = 0;
+
 #define PRTE_PRINTF_FIX_STRING(a) ((NULL == a) ? "(null)" : a)
 
 /****************************
@@ -224,6 +259,103 @@ static int setup_base(void)
     return rc;
 }
 
+static void *trash_worker(pmix_object_t *obj)
+{
+    prte_session_dir_trash_t *tr;
+    PRTE_HIDE_UNUSED_PARAMS(obj);
+
+    pthread_mutex_lock(&trash_lock);
+    while (1) {
+        tr = (prte_session_dir_trash_t *) pmix_list_remove_first(&trash);
+        if (NULL == tr) {
+            if (trash_stop) {
+                break;
+            }
+            pthread_cond_wait(&trash_cond, &trash_lock);
+            continue;
+        }
+        pthread_mutex_unlock(&trash_lock);
+        pmix_os_dirpath_destroy(tr->path, true, _check_file);
+        if (0 != rmdir(tr->path) && 0 != rename(tr->path, tr->orig)) {
+            /* output files we kept must stay where the user
+             * expects to find them - if we can't put them
+             * back, at least say where they are */
+            pmix_output(0, "%s kept files of %s left in %s",
+                        PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), tr->orig, tr->path);
+        }
+        PMIX_RELEASE(tr);
+        pthread_mutex_lock(&trash_lock);
+    }
+    pthread_mutex_unlock(&trash_lock);
+    return NULL;
+}
+
+/* hand the directory to the worker thread, returning false
+ * if the caller has to destroy it */
+static bool trash_dir(const char *dir)
+{
+    prte_session_dir_trash_t *tr;
+    char *path;
+    bool queued = false;
+
+    if (0 >= prte_session_dir_cleanup_max || prte_finalizing ||
+        NULL == prte_process_info.top_session_dir) {
+        return false;
+    }
+
+    pthread_mutex_lock(&trash_lock);
+    if (prte_session_dir_cleanup_max <= (int) pmix_list_get_size(&trash)) {
+        /* the worker has fallen behind */
+        goto done;
+    }
+    if (!trash_active) {
+        PMIX_CONSTRUCT(&trash_thread, pmix_thread_t);
+        trash_thread.t_run = trash_worker;
+        trash_thread.t_arg = NULL;
+        trash_stop = false;
+        if (PRTE_SUCCESS != pmix_thread_start(&trash_thread)) {
+            PMIX_DESTRUCT(&trash_thread);
+            goto done;
+        }
+        trash_active = true;
+    }
+    /* the job dir lives in the top-level dir, so renaming it
+     * there is atomic and frees the name for a new job */
+    if (0 > pmix_asprintf(&path, "%s/.trash-%lu",
+                          prte_process_info.top_session_dir, trash_count++)) {
+        goto done;
+    }
+    if (0 != rename(dir, path)) {
+        free(path);
+        goto done;
+    }
+    tr = PMIX_NEW(prte_session_dir_trash_t);
+    tr->path = path;
+    tr->orig = strdup(dir);
+    pmix_list_append(&trash, &tr->super);
+    pthread_cond_signal(&trash_cond);
+    queued = true;
+
+done:
+    pthread_mutex_unlock(&trash_lock);
+    return queued;
+}
+
+/* wait for the worker thread to destroy everything it was given */
+static void trash_drain(void)
+{
+    if (!trash_active) {
+        return;
+    }
+    pthread_mutex_lock(&trash_lock);
+    trash_stop = true;
+    pthread_cond_signal(&trash_cond);
+    pthread_mutex_unlock(&trash_lock);
+    pmix_thread_join(&trash_thread, NULL);
+    PMIX_DESTRUCT(&trash_thread);
+    trash_active = false;
+}
+
 /*
  * Construct the session directory and create it if necessary
  */
@@ -291,6 +423,7 @@ void prte_job_session_dir_finalize(prte_job_t *jdata)
      * session directory, but only if we are finalizing */
     if (NULL == jdata || PMIX_CHECK_NSPACE(PRTE_PROC_MY_NAME->nspace, jdata->nspace)) {
         if (prte_finalizing) {
+            trash_drain();
             if (NULL != prte_process_info.top_session_dir) {
                 pmix_os_dirpath_destroy(prte_process_info.top_session_dir, true, _check_file);
                 rmdir(prte_process_info.top_session_dir);
@@ -305,9 +438,11 @@ void prte_job_session_dir_finalize(prte_job_t *jdata)
         return;
     }
 
-    pmix_os_dirpath_destroy(jdata->session_dir, true, _check_file);
-    /* if the job-level session dir is now empty, remove it */
-    rmdir(jdata->session_dir);
+    if (!trash_dir(jdata->session_dir)) {
+        pmix_os_dirpath_destroy(jdata->session_dir, true, _check_file);
+        /* if the job-level session dir is now empty, remove it */
+        rmdir(jdata->session_dir);
+    }
     free(jdata->session_dir);
     jdata->session_dir = NULL;
     return;
@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2025      Nanook Consulting  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ * Measure the throughput of the PRRTE checksum routines:
+ *
+ *    ./crcbench [MBytes]
+ *
+ * Each routine is run over a buffer of the given size (default 64
+ * MBytes) for about half a second, and its throughput reported in
+ * GB/sec. The CRC32C line also names the implementation that was
+ * picked for this processor.
+ *
+ * This is built against the PRRTE tree - see the Makefile.
+ */
+
+#include "prte_config.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+
+#include "src/util/crc.h"
+
+#define CRCBENCH_SIZE 64 /* MBytes */
+
+typedef enum {
+    CRC_CSUM,
+    CRC_UICSUM,
+    CRC_UICRC,
+    CRC_CRC32C,
+    CRC_BCOPY_UICRC,
+    CRC_BCOPY_CRC32C
+} crc_routine_t;
+
+static double now(void)
+{
+    struct timeval tv;
+
+    gettimeofday(&tv, NULL);
+    return (double) tv.tv_sec + (double) tv.tv_usec / 1000000.0;
+}
+
+/* time the given routine over the buffer, returning GB/sec */
+static double bench(crc_routine_t r, unsigned char *src, unsigned char *dst, size_t len)
+{
+    volatile unsigned long sink = 0;
+    double start, elapsed;
+    int n, reps = 0;
+
+    start = now();
+    do {
+        for (n = 0; n < 4; n++) {
+            switch (r) {
+            case CRC_CSUM:
+                sink += prte_csum(src, len);
+                break;
+            case CRC_UICSUM:
+                sink += prte_uicsum(src, len);
+                break;
+            case CRC_UICRC:
+                sink += prte_uicrc(src, len);
+                break;
+            case CRC_CRC32C:
+                sink += prte_crc32c(src, len);
+                break;
+            case CRC_BCOPY_UICRC:
+                sink += prte_bcopy_uicrc(src, dst, len, len);
+                break;
+            case CRC_BCOPY_CRC32C:
+                sink += prte_bcopy_crc32c(src, dst, len, len);
+                break;
+            }
+        }
+        reps += 4;
+        elapsed = now() - start;
+    } while (elapsed < 0.5);
+
+    (void) sink;
+    return (double) reps * (double) len / elapsed / 1.0e9;
+}
+
+int main(int argc, char **argv)
+{
+    unsigned char *src, *dst;
+    size_t len, n;
+    int mbytes = CRCBENCH_SIZE;
+
+    if (1 < argc) {
+        mbytes = strtol(argv[1], NULL, 10);
+        if (0 >= mbytes) {
+            fprintf(stderr, "usage: %s [MBytes]\n", argv[0]);
+            exit(1);
+        }
+    }
+    len = (size_t) mbytes * 1024 * 1024;
+    src = (unsigned char *) malloc(len);
+    dst = (unsigned char *) malloc(len);
+    if (NULL == src || NULL == dst) {
+        fprintf(stderr, "could not allocate two buffers of %d MBytes\n", mbytes);
+        exit(1);
+    }
+    /* touch everything so page faults aren't part of the timing */
+    for (n = 0; n < len; n++) {
+        src[n] = (unsigned char) (n * 2654435761U >> 24);
+    }
+    memset(dst, 0, len);
+
+    printf("Buffer size: %d MBytes\n", mbytes);
+    printf("%-24s %8.2f GB/s\n", "csum", bench(CRC_CSUM, src, dst, len));
+    printf("%-24s %8.2f GB/s\n", "uicsum", bench(CRC_UICSUM, src, dst, len));
+    printf("%-24s %8.2f GB/s\n", "uicrc", bench(CRC_UICRC, src, dst, len));
+    printf("crc32c (%-15s) %8.2f GB/s\n", prte_crc32c_method(), bench(CRC_CRC32C, src, dst, len));
+    printf("%-24s %8.2f GB/s\n", "bcopy+uicrc", bench(CRC_BCOPY_UICRC, src, dst, len));
+    printf("%-24s %8.2f GB/s\n", "bcopy+crc32c", bench(CRC_BCOPY_CRC32C, src, dst, len));
+
+    free(src);
+    free(dst);
+    return 0;
+}
@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2025      Nanook Consulting  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ * Measure direct modex retrieval. Each rank posts a value and
+ * executes a fence without data collection, then retrieves the
+ * value posted by a number of its peers. Run across several
+ * daemons so the retrievals require direct modex requests, e.g.:
+ *
+ *    prterun -n 64 --map-by ppr:8:node ./dmodexbench [npeers]
+ *
+ * By default every rank retrieves the value of every other rank.
+ * Setting "--prtemca pmix_dmodex_batch_delay <usec>" allows the
+ * daemons to collect more requests into each message.
+ */
+
+#define _GNU_SOURCE
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/time.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <pmix.h>
+
+static pmix_proc_t myproc;
+
+static double now(void)
+{
+    struct timeval tv;
+
+    gettimeofday(&tv, NULL);
+    return (double) tv.tv_sec + (double) tv.tv_usec / 1000000.0;
+}
+
+int main(int argc, char **argv)
+{
+    pmix_status_t rc;
+    pmix_proc_t proc;
+    pmix_value_t value, *val;
+    uint32_t nprocs, n, npeers = 0;
+    int nerrs = 0;
+    double start, stop;
+
+    if (1 < argc) {
+        npeers = strtoul(argv[1], NULL, 10);
+    }
+
+    if (PMIX_SUCCESS != (rc = PMIx_Init(&myproc, NULL, 0))) {
+        fprintf(stderr, "PMIx_Init failed: %s\n", PMIx_Error_string(rc));
+        exit(1);
+    }
+    PMIX_LOAD_PROCID(&proc, myproc.nspace, PMIX_RANK_WILDCARD);
+    rc = PMIx_Get(&proc, PMIX_JOB_SIZE, NULL, 0, &val);
+    if (PMIX_SUCCESS != rc) {
+        fprintf(stderr, "[%s:%u] Get of job size failed: %s\n",
+                myproc.nspace, myproc.rank, PMIx_Error_string(rc));
+        goto done;
+    }
+    nprocs = val->data.uint32;
+    PMIX_VALUE_RELEASE(val);
+    if (0 == npeers || nprocs <= npeers) {
+        npeers = nprocs - 1;
+    }
+
+    /* post our value */
+    value.type = PMIX_UINT32;
+    value.data.uint32 = myproc.rank;
+    if (PMIX_SUCCESS != (rc = PMIx_Put(PMIX_GLOBAL, "dmodexbench", &value))) {
+        fprintf(stderr, "[%s:%u] Put failed: %s\n",
+                myproc.nspace, myproc.rank, PMIx_Error_string(rc));
+        goto done;
+    }
+    if (PMIX_SUCCESS != (rc = PMIx_Commit())) {
+        fprintf(stderr, "[%s:%u] Commit failed: %s\n",
+                myproc.nspace, myproc.rank, PMIx_Error_string(rc));
+        goto done;
+    }
+    /* no data collection, so peer values must be requested */
+    PMIx_Fence(NULL, 0, NULL, 0);
+
+    start = now();
+    for (n = 1; n <= npeers; n++) {
+        PMIX_LOAD_PROCID(&proc, myproc.nspace, (myproc.rank + n) % nprocs);
+        rc = PMIx_Get(&proc, "dmodexbench", NULL, 0, &val);
+        if (PMIX_SUCCESS != rc) {
+            fprintf(stderr, "[%s:%u] Get from rank %u failed: %s\n",
+                    myproc.nspace, myproc.rank, proc.rank, PMIx_Error_string(rc));
+            ++nerrs;
+            continue;
+        }
+        if (PMIX_UINT32 != val->type || proc.rank != val->data.uint32) {
+            fprintf(stderr, "[%s:%u] Wrong value from rank %u\n",
+                    myproc.nspace, myproc.rank, proc.rank);
+            ++nerrs;
+        }
+        PMIX_VALUE_RELEASE(val);
+    }
+    /* wait for everyone to finish */
+    PMIx_Fence(NULL, 0, NULL, 0);
+    stop = now();
+
+    if (0 == myproc.rank) {
+        fprintf(stderr, "dmodex: %u procs retrieved %u peers each in %.3f sec (%.1f usec/get)\n",
+                nprocs, npeers, stop - start,
+                1000000.0 * (stop - start) / ((double) nprocs * npeers));
+    }
+    if (0 < nerrs) {
+        fprintf(stderr, "[%s:%u] %d errors\n", myproc.nspace, myproc.rank, nerrs);
+    }
+
+done:
+    PMIx_Finalize(NULL, 0);
+    return (0 == nerrs) ? 0 : 1;
+}
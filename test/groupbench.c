@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) 2025      Nanook Consulting  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ * Measure the time required to construct very large groups, e.g.:
+ *
+ *    prterun -n 8 --map-by ppr:4:node ./groupbench [nmembers...]
+ *
+ * Every rank acts as a bootstrap leader and contributes its own
+ * slice of the membership, with each slice overlapping its neighbor
+ * so that the DVM controller has to filter duplicates while merging
+ * the contributions. The default sizes are 10k, 100k and 1M members.
+ *
+ * Only the ranks of the job actually participate - the remaining
+ * members are synthetic ranks of the same nspace that never run.
+ * The groups are therefore left in place rather than destructed.
+ */
+
+#define _GNU_SOURCE
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <pmix.h>
+
+#ifndef PMIX_GROUP_BOOTSTRAP
+
+int main(int argc, char **argv)
+{
+    fprintf(stderr, "groupbench requires a PMIx library that supports PMIX_GROUP_BOOTSTRAP\n");
+    return 0;
+}
+
+#else
+
+static pmix_proc_t myproc;
+
+static double now(void)
+{
+    struct timeval tv;
+
+    gettimeofday(&tv, NULL);
+    return (double) tv.tv_sec + (double) tv.tv_usec / 1000000.0;
+}
+
+int main(int argc, char **argv)
+{
+    pmix_status_t rc;
+    pmix_proc_t proc, *procs;
+    pmix_info_t info;
+    pmix_info_t *results;
+    pmix_value_t *val;
+    uint32_t size, nbootstrap;
+    size_t nresults, nprocs, chunk, first, last, n;
+    size_t defaults[] = {10000, 100000, 1000000};
+    size_t *sizes = defaults, nsizes = 3, nmembers, nfinal;
+    char grpid[64];
+    double start, stop;
+    int i;
+
+    if (1 < argc) {
+        nsizes = argc - 1;
+        sizes = (size_t *) malloc(nsizes * sizeof(size_t));
+        for (i = 1; i < argc; i++) {
+            sizes[i - 1] = strtoul(argv[i], NULL, 10);
+        }
+    }
+
+    if (PMIX_SUCCESS != (rc = PMIx_Init(&myproc, NULL, 0))) {
+        fprintf(stderr, "PMIx_Init failed: %s\n", PMIx_Error_string(rc));
+        exit(1);
+    }
+    PMIX_LOAD_PROCID(&proc, myproc.nspace, PMIX_RANK_WILDCARD);
+    rc = PMIx_Get(&proc, PMIX_JOB_SIZE, NULL, 0, &val);
+    if (PMIX_SUCCESS != rc) {
+        fprintf(stderr, "[%s:%u] Get of job size failed: %s\n",
+                myproc.nspace, myproc.rank, PMIx_Error_string(rc));
+        goto done;
+    }
+    size = val->data.uint32;
+    PMIX_VALUE_RELEASE(val);
+
+    for (i = 0; i < (int) nsizes; i++) {
+        nmembers = sizes[i];
+        if (nmembers < size) {
+            nmembers = size;
+        }
+        /* the synthetic members follow the real ranks - each rank
+         * contributes itself plus two chunks of them, the second of
+         * which is shared with the next rank */
+        chunk = (nmembers - size + size - 1) / size;
+        first = size + myproc.rank * chunk;
+        last = first + 2 * chunk;
+        if (last > nmembers) {
+            last = nmembers;
+        }
+        if (first > last) {
+            first = last;
+        }
+        nprocs = 1 + last - first;
+        PMIX_PROC_CREATE(procs, nprocs);
+        PMIX_LOAD_PROCID(&procs[0], myproc.nspace, myproc.rank);
+        for (n = 1; n < nprocs; n++) {
+            PMIX_LOAD_PROCID(&procs[n], myproc.nspace, (pmix_rank_t) (first + n - 1));
+        }
+
+        snprintf(grpid, sizeof(grpid), "groupbench-%lu", (unsigned long) nmembers);
+        nbootstrap = size;
+        PMIX_INFO_LOAD(&info, PMIX_GROUP_BOOTSTRAP, &nbootstrap, PMIX_UINT32);
+
+        PMIx_Fence(NULL, 0, NULL, 0);
+        start = now();
+        rc = PMIx_Group_construct(grpid, procs, nprocs, &info, 1, &results, &nresults);
+        stop = now();
+        PMIX_INFO_DESTRUCT(&info);
+        PMIX_PROC_FREE(procs, nprocs);
+        if (PMIX_SUCCESS != rc) {
+            fprintf(stderr, "[%s:%u] Group construct of %lu members failed: %s\n",
+                    myproc.nspace, myproc.rank, (unsigned long) nmembers,
+                    PMIx_Error_string(rc));
+            break;
+        }
+
+        nfinal = 0;
+        for (n = 0; n < nresults; n++) {
+            if (PMIX_CHECK_KEY(&results[n], PMIX_GROUP_MEMBERSHIP)) {
+                nfinal = results[n].value.data.darray->size;
+            }
+        }
+        if (0 < nresults) {
+            PMIX_INFO_FREE(results, nresults);
+        }
+        if (0 == myproc.rank) {
+            fprintf(stderr, "construct: %lu members (%lu returned) in %.3f sec\n",
+                    (unsigned long) nmembers, (unsigned long) nfinal, stop - start);
+        }
+    }
+
+done:
+    PMIx_Finalize(NULL, 0);
+    if (sizes != defaults) {
+        free(sizes);
+    }
+    return 0;
+}
+
+#endif
@@ -0,0 +1,21 @@
+#!/bin/bash
+#
+# Abort a large job and report how quickly the daemons answered
+# queries from procs that were waiting to be killed, e.g.:
+#
+#    ./killstorm.bash 10000
+#    ./killstorm.bash 10000 --prtemca odls_base_kill_delay 1000
+#
+
+NPROCS=${1:-10000}
+shift
+
+OUT=$(prterun -n $NPROCS --map-by :oversubscribe "$@" ./killstorm 2>/dev/null | sed -n 's/^answered: //p' | sort -n)
+NANS=$(echo "$OUT" | grep -c .)
+
+echo "$NANS of $(($NPROCS - 1)) procs had a query answered between SIGTERM and SIGKILL"
+if [ 0 -lt $NANS ] ; then
+    echo "median: $(echo "$OUT" | sed -n "$(( ($NANS + 1) / 2 ))p") msec"
+    echo "max:    $(echo "$OUT" | tail -n 1) msec"
+fi
+exit 0
@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2025      Nanook Consulting  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ * Measure how responsive the local daemon remains while it is
+ * tearing down a large job, e.g.:
+ *
+ *    prterun -n 10000 --map-by :oversubscribe ./killstorm
+ *
+ * Rank 0 aborts the job once everyone is up. All other ranks catch
+ * the resulting SIGTERM and immediately time a query that has to be
+ * answered by their daemon, printing the round trip in msec. They
+ * then wait for the SIGKILL, so the daemon has to escalate the
+ * signals for every one of them. Use killstorm.bash to summarize
+ * the results.
+ */
+
+#define _GNU_SOURCE
+#include <signal.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/time.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <pmix.h>
+
+static volatile sig_atomic_t termed = 0;
+
+static void term_handler(int sig)
+{
+    (void) sig;
+    termed = 1;
+}
+
+static double now(void)
+{
+    struct timeval tv;
+
+    gettimeofday(&tv, NULL);
+    return (double) tv.tv_sec + (double) tv.tv_usec / 1000000.0;
+}
+
+int main(int argc, char **argv)
+{
+    pmix_status_t rc;
+    pmix_proc_t myproc;
+    pmix_query_t query;
+    pmix_info_t *results;
+    size_t nresults;
+    double start, stop;
+
+    signal(SIGTERM, term_handler);
+
+    if (PMIX_SUCCESS != (rc = PMIx_Init(&myproc, NULL, 0))) {
+        fprintf(stderr, "PMIx_Init failed: %s\n", PMIx_Error_string(rc));
+        exit(1);
+    }
+
+    /* wait for everyone to be up */
+    PMIx_Fence(NULL, 0, NULL, 0);
+
+    if (0 == myproc.rank) {
+        PMIx_Abort(1, "killstorm", NULL, 0);
+        exit(1);
+    }
+
+    while (!termed) {
+        usleep(1000);
+    }
+
+    PMIX_QUERY_CONSTRUCT(&query);
+    PMIX_ARGV_APPEND(rc, query.keys, PMIX_QUERY_NAMESPACES);
+    start = now();
+    rc = PMIx_Query_info(&query, 1, &results, &nresults);
+    stop = now();
+    if (PMIX_SUCCESS == rc) {
+        fprintf(stdout, "answered: %.3f\n", 1000.0 * (stop - start));
+        fflush(stdout);
+        PMIX_INFO_FREE(results, nresults);
+    }
+    PMIX_QUERY_DESTRUCT(&query);
+
+    /* wait for the SIGKILL */
+    while (1) {
+        pause();
+    }
+    return 0;
+}
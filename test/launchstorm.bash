@@ -0,0 +1,39 @@
+#!/bin/bash
+#
+# Fire a storm of concurrent launches at a persistent DVM and
+# time how long it takes for all of them to complete. Compare
+# runs with and without the DVM's extra event threads, e.g.:
+#
+#    ./launchstorm.bash 64 ./hello
+#    PRTE_MCA_oob_progress_thread=1 PRTE_MCA_iof_base_progress_thread=1 \
+#        PRTE_MCA_prte_progress_thread_report=1 ./launchstorm.bash 64 ./hello
+#
+
+NJOBS=${1:-32}
+shift
+APP=${@:-hostname}
+URIFILE=$(mktemp)
+
+prte --daemonize --report-uri $URIFILE
+while [ ! -s $URIFILE ]; do
+    sleep 0.1
+done
+
+START=$(date +%s.%N)
+for i in $(seq 1 $NJOBS) ; do
+    prun --dvm-uri file:$URIFILE -n 1 $APP > /dev/null &
+done
+FAILED=0
+for pid in $(jobs -p) ; do
+    wait $pid || FAILED=$(expr $FAILED + 1)
+done
+STOP=$(date +%s.%N)
+
+pterm --dvm-uri file:$URIFILE
+rm -f $URIFILE
+
+echo "$NJOBS launches in $(echo "$STOP - $START" | bc) sec ($FAILED failed)"
+if [[ $FAILED != 0 ]] ; then
+    exit 1
+fi
+exit 0
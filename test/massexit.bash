@@ -0,0 +1,27 @@
+#!/bin/bash
+#
+# Time how long it takes from a mass exit of local children to
+# the launcher returning, e.g.:
+#
+#    ./massexit.bash 1000
+#    ./massexit.bash 1000 5
+#
+
+NPROCS=${1:-1000}
+NRUNS=${2:-3}
+
+TOTAL=0
+for i in $(seq 1 $NRUNS) ; do
+    RELEASED=$(prterun -n $NPROCS --map-by :oversubscribe ./massexit | sed -n 's/^released: //p')
+    DONE=$(date +%s.%N)
+    if [ -z "$RELEASED" ] ; then
+        echo "run $i failed"
+        exit 1
+    fi
+    T=$(echo "$DONE - $RELEASED" | bc)
+    echo "run $i: $T sec from exit to job terminated"
+    TOTAL=$(echo "$TOTAL + $T" | bc)
+done
+
+echo "average: $(echo "scale=3; $TOTAL / $NRUNS" | bc) sec"
+exit 0
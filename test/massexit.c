@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) 2025      Nanook Consulting  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ * Have every rank exit at the same moment so the local daemon
+ * has to reap a burst of children at once. Rank 0 prints the
+ * time at which the ranks were released - massexit.bash uses it
+ * to measure how long the DVM takes to declare the job
+ * terminated, e.g.:
+ *
+ *    prterun -n 1000 --map-by :oversubscribe ./massexit
+ */
+
+#define _GNU_SOURCE
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/time.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <pmix.h>
+
+int main(int argc, char **argv)
+{
+    pmix_status_t rc;
+    pmix_proc_t myproc;
+    struct timeval tv;
+
+    if (PMIX_SUCCESS != (rc = PMIx_Init(&myproc, NULL, 0))) {
+        fprintf(stderr, "PMIx_Init failed: %s\n", PMIx_Error_string(rc));
+        exit(1);
+    }
+
+    /* wait for everyone to be up */
+    PMIx_Fence(NULL, 0, NULL, 0);
+    PMIx_Finalize(NULL, 0);
+
+    if (0 == myproc.rank) {
+        gettimeofday(&tv, NULL);
+        fprintf(stdout, "released: %ld.%06ld\n", (long) tv.tv_sec, (long) tv.tv_usec);
+        fflush(stdout);
+    }
+    return 0;
+}
@@ -0,0 +1,218 @@
+/*
+ * Copyright (c) 2025      Nanook Consulting  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ * Measure the size of the nidmap and the time taken to create and
+ * decode it:
+ *
+ *    ./nidmapbench [nnodes]
+ *
+ * A synthetic cluster of the given number of nodes (default 100k
+ * zero-padded nodes with gaps and fabric aliases) is round-tripped
+ * through both the list and the range encodings of the node names,
+ * reporting the bytes per node and the time taken to create the
+ * nidmap and to decode it into a node pool.
+ *
+ * This is built against the PRRTE tree - see the Makefile.
+ */
+
+#include "prte_config.h"
+
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+
+#include "src/class/pmix_pointer_array.h"
+#include "src/pmix/pmix-internal.h"
+#include "src/runtime/prte_globals.h"
+#include "src/runtime/runtime.h"
+#include "src/util/error.h"
+#include "src/util/nidmap.h"
+#include "src/util/pmix_argv.h"
+#include "src/util/pmix_printf.h"
+
+#define NIDMAPBENCH_NODES 100000
+#define NIDMAPBENCH_GAP   1000
+#define NIDMAPBENCH_REPS  3
+
+static double now(void)
+{
+    struct timeval tv;
+
+    gettimeofday(&tv, NULL);
+    return (double) tv.tv_sec + (double) tv.tv_usec / 1000000.0;
+}
+
+/* a pool the way a large cluster reports it - a login node
+ * followed by zero-padded compute nodes, with the occasional
+ * node missing and each one also known by its fabric name */
+static void make_pool(pmix_pointer_array_t *pool, int nnodes)
+{
+    prte_node_t *node;
+    char *alias;
+    int n;
+
+    for (n = 0; n < nnodes; n++) {
+        node = PMIX_NEW(prte_node_t);
+        if (0 == n) {
+            node->name = strdup("login1");
+        } else {
+            pmix_asprintf(&node->name, "node%06d", n + n / NIDMAPBENCH_GAP);
+            pmix_asprintf(&alias, "%s-ib", node->name);
+            PMIX_ARGV_APPEND_NOSIZE_COMPAT(&node->aliases, alias);
+            free(alias);
+        }
+        node->index = n;
+        node->daemon = PMIX_NEW(prte_proc_t);
+        PMIX_LOAD_PROCID(&node->daemon->name, "nidmapbench", n);
+        pmix_pointer_array_set_item(pool, n, node);
+    }
+}
+
+static void release_pool(pmix_pointer_array_t *pool)
+{
+    prte_node_t *node;
+    int n;
+
+    for (n = 0; n < pool->size; n++) {
+        node = (prte_node_t *) pmix_pointer_array_get_item(pool, n);
+        if (NULL != node) {
+            /* releases the daemon along with it */
+            PMIX_RELEASE(node);
+            pmix_pointer_array_set_item(pool, n, NULL);
+        }
+    }
+}
+
+/* add each node to the pool as it is decoded, the way the daemons do */
+static void add_node(int index, const char *name, char **aliases, pmix_rank_t vpid, void *cbdata)
+{
+    pmix_pointer_array_t *pool = (pmix_pointer_array_t *) cbdata;
+    prte_node_t *node;
+
+    node = PMIX_NEW(prte_node_t);
+    node->name = strdup(name);
+    node->aliases = aliases;
+    node->index = index;
+    node->daemon = PMIX_NEW(prte_proc_t);
+    node->daemon->name.rank = vpid;
+    pmix_pointer_array_set_item(pool, index, node);
+}
+
+static bool same_pool(pmix_pointer_array_t *a, pmix_pointer_array_t *b, int nnodes)
+{
+    prte_node_t *n1, *n2;
+    char *s1, *s2;
+    bool same;
+    int n;
+
+    for (n = 0; n < nnodes; n++) {
+        n1 = (prte_node_t *) pmix_pointer_array_get_item(a, n);
+        n2 = (prte_node_t *) pmix_pointer_array_get_item(b, n);
+        if (NULL == n1 || NULL == n2 || 0 != strcmp(n1->name, n2->name)
+            || n1->daemon->name.rank != n2->daemon->name.rank) {
+            return false;
+        }
+        s1 = (NULL == n1->aliases) ? strdup("") : PMIX_ARGV_JOIN_COMPAT(n1->aliases, ',');
+        s2 = (NULL == n2->aliases) ? strdup("") : PMIX_ARGV_JOIN_COMPAT(n2->aliases, ',');
+        same = (0 == strcmp(s1, s2));
+        free(s1);
+        free(s2);
+        if (!same) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* round-trip the pool through the given encoding, reporting the
+ * bytes per node and the time taken to create and decode it */
+static void bench(pmix_pointer_array_t *pool, int nnodes, bool compact)
+{
+    pmix_data_buffer_t buf;
+    pmix_pointer_array_t copy;
+    double start, tcreate = 0.0, tdecode = 0.0, t;
+    size_t bytes = 0;
+    bool saved = prte_compact_nidmap;
+    bool hnp = prte_hnp_is_allocated, managed = prte_managed_allocation;
+    bool ok = true;
+    int n, rc;
+
+    prte_compact_nidmap = compact;
+    for (n = 0; n < NIDMAPBENCH_REPS && ok; n++) {
+        PMIX_DATA_BUFFER_CONSTRUCT(&buf);
+        start = now();
+        rc = prte_util_nidmap_create(pool, &buf);
+        t = now() - start;
+        if (PRTE_SUCCESS != rc) {
+            ok = false;
+            PMIX_DATA_BUFFER_DESTRUCT(&buf);
+            break;
+        }
+        if (0 == n || t < tcreate) {
+            tcreate = t;
+        }
+        bytes = buf.bytes_used;
+
+        PMIX_CONSTRUCT(&copy, pmix_pointer_array_t);
+        pmix_pointer_array_init(&copy, nnodes, INT_MAX, 1024);
+        start = now();
+        rc = prte_util_nidmap_unpack(&buf, add_node, &copy);
+        t = now() - start;
+        PMIX_DATA_BUFFER_DESTRUCT(&buf);
+        ok = (PRTE_SUCCESS == rc && same_pool(pool, &copy, nnodes));
+        if (0 == n || t < tdecode) {
+            tdecode = t;
+        }
+        release_pool(&copy);
+        PMIX_DESTRUCT(&copy);
+    }
+    prte_compact_nidmap = saved;
+    prte_hnp_is_allocated = hnp;
+    prte_managed_allocation = managed;
+
+    printf("%d nodes (%-6s) ", nnodes, compact ? "ranges" : "lists");
+    if (ok) {
+        printf("%lu bytes, %.3f bytes/node, create %.3f msec, decode %.3f msec\n",
+               (unsigned long) bytes, (double) bytes / nnodes, 1000.0 * tcreate,
+               1000.0 * tdecode);
+    } else {
+        printf("round trip FAILED\n");
+    }
+}
+
+int main(int argc, char **argv)
+{
+    pmix_pointer_array_t pool;
+    int nnodes = NIDMAPBENCH_NODES;
+    int rc;
+
+    if (1 < argc) {
+        nnodes = strtol(argv[1], NULL, 10);
+        if (0 >= nnodes) {
+            fprintf(stderr, "usage: %s [nnodes]\n", argv[0]);
+            exit(1);
+        }
+    }
+
+    rc = prte_init_util(PRTE_PROC_MASTER);
+    if (PRTE_SUCCESS != rc) {
+        fprintf(stderr, "prte_init_util failed: %s\n", prte_strerror(rc));
+        exit(1);
+    }
+
+    PMIX_CONSTRUCT(&pool, pmix_pointer_array_t);
+    pmix_pointer_array_init(&pool, nnodes, INT_MAX, 1024);
+    make_pool(&pool, nnodes);
+    bench(&pool, nnodes, false);
+    bench(&pool, nnodes, true);
+    release_pool(&pool);
+    PMIX_DESTRUCT(&pool);
+    return 0;
+}
@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2025      Nanook Consulting  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ * Measure daemon-to-daemon OOB performance. Run with one proc
+ * on each of two daemons, e.g.:
+ *
+ *    prterun -n 2 --map-by ppr:1:node ./oobbench [iterations]
+ *
+ * The "ping-pong" phase times back-to-back fences, each of which
+ * requires a round trip between the daemons. The "flood" phase
+ * has each rank fire a burst of small event notifications at the
+ * other rank and then times how long it takes for all of them
+ * to be delivered.
+ */
+
+#define _GNU_SOURCE
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/time.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <pmix.h>
+
+#define OOBBENCH_EVENT (PMIX_EXTERNAL_ERR_BASE - 4242)
+
+static pmix_proc_t myproc;
+static volatile int nrecvd = 0;
+
+static double now(void)
+{
+    struct timeval tv;
+
+    gettimeofday(&tv, NULL);
+    return (double) tv.tv_sec + (double) tv.tv_usec / 1000000.0;
+}
+
+static void notify_cbfunc(size_t evhdlr_registration_id, pmix_status_t status,
+                          const pmix_proc_t *source, pmix_info_t info[], size_t ninfo,
+                          pmix_info_t *results, size_t nresults,
+                          pmix_event_notification_cbfunc_fn_t cbfunc, void *cbdata)
+{
+    ++nrecvd;
+    if (NULL != cbfunc) {
+        cbfunc(PMIX_EVENT_ACTION_COMPLETE, NULL, 0, NULL, NULL, cbdata);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    pmix_status_t rc;
+    pmix_status_t code = OOBBENCH_EVENT;
+    pmix_proc_t peer;
+    pmix_info_t info[2];
+    pmix_value_t *val;
+    int n, iters = 1000;
+    double start, stop;
+
+    if (1 < argc) {
+        iters = strtol(argv[1], NULL, 10);
+    }
+
+    if (PMIX_SUCCESS != (rc = PMIx_Init(&myproc, NULL, 0))) {
+        fprintf(stderr, "PMIx_Init failed: %s\n", PMIx_Error_string(rc));
+        exit(1);
+    }
+    PMIX_LOAD_PROCID(&peer, myproc.nspace, PMIX_RANK_WILDCARD);
+    rc = PMIx_Get(&peer, PMIX_JOB_SIZE, NULL, 0, &val);
+    if (PMIX_SUCCESS != rc || 2 != val->data.uint32) {
+        fprintf(stderr, "oobbench requires exactly two procs\n");
+        goto done;
+    }
+    PMIX_VALUE_RELEASE(val);
+
+    rc = PMIx_Register_event_handler(&code, 1, NULL, 0, notify_cbfunc, NULL, NULL);
+    if (0 > rc) {
+        fprintf(stderr, "[%s:%u] Event handler registration failed: %s\n",
+                myproc.nspace, myproc.rank, PMIx_Error_string(rc));
+        goto done;
+    }
+
+    /* ping-pong */
+    PMIx_Fence(NULL, 0, NULL, 0);
+    start = now();
+    for (n = 0; n < iters; n++) {
+        PMIx_Fence(NULL, 0, NULL, 0);
+    }
+    stop = now();
+    if (0 == myproc.rank) {
+        fprintf(stderr, "ping-pong: %d round trips in %.3f sec (%.1f usec/round trip)\n",
+                iters, stop - start, 1000000.0 * (stop - start) / iters);
+    }
+
+    /* flood */
+    PMIX_LOAD_PROCID(&peer, myproc.nspace, (0 == myproc.rank) ? 1 : 0);
+    PMIX_INFO_LOAD(&info[0], PMIX_EVENT_CUSTOM_RANGE, &peer, PMIX_PROC);
+    PMIX_INFO_LOAD(&info[1], PMIX_EVENT_NON_DEFAULT, NULL, PMIX_BOOL);
+    PMIx_Fence(NULL, 0, NULL, 0);
+    start = now();
+    for (n = 0; n < iters; n++) {
+        rc = PMIx_Notify_event(OOBBENCH_EVENT, &myproc, PMIX_RANGE_CUSTOM, info, 2, NULL, NULL);
+        if (PMIX_SUCCESS != rc && PMIX_OPERATION_SUCCEEDED != rc) {
+            fprintf(stderr, "[%s:%u] Notify failed: %s\n",
+                    myproc.nspace, myproc.rank, PMIx_Error_string(rc));
+            break;
+        }
+    }
+    while (nrecvd < iters) {
+        usleep(10);
+    }
+    stop = now();
+    PMIX_INFO_DESTRUCT(&info[0]);
+    PMIX_INFO_DESTRUCT(&info[1]);
+    PMIx_Fence(NULL, 0, NULL, 0);
+    if (0 == myproc.rank) {
+        fprintf(stderr, "flood: %d messages in %.3f sec (%.0f msgs/sec)\n",
+                iters, stop - start, iters / (stop - start));
+    }
+
+done:
+    PMIx_Finalize(NULL, 0);
+    return 0;
+}
@@ -0,0 +1,188 @@
+/*
+ * Copyright (c) 2025      Nanook Consulting  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ * Measure the size of a packed job object and the time taken to
+ * pack and unpack it:
+ *
+ *    ./packbench [nprocs,...]
+ *
+ * A synthetic job of each of the given sizes (default 1k to 1M
+ * ranks) is round-tripped through both the full and the compact
+ * encoding of its procs, reporting the bytes per rank and the
+ * usecs per rank taken to pack and to unpack it, and checking
+ * that the procs survive the trip.
+ *
+ * This is built against the PRRTE tree - see the Makefile.
+ */
+
+#include "prte_config.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+
+#include "src/mca/plm/plm_types.h"
+#include "src/pmix/pmix-internal.h"
+#include "src/runtime/prte_globals.h"
+#include "src/runtime/runtime.h"
+#include "src/util/error.h"
+#include "src/util/pmix_argv.h"
+#include "src/util/pmix_printf.h"
+
+#define PACKBENCH_SIZES "1000,10000,100000,1000000"
+#define PACKBENCH_PPN   64
+#define PACKBENCH_REPS  3
+
+static double now(void)
+{
+    struct timeval tv;
+
+    gettimeofday(&tv, NULL);
+    return (double) tv.tv_sec + (double) tv.tv_usec / 1000000.0;
+}
+
+/* a job laid out the way the mappers would - PPN procs on each
+ * node, each bound to its own core */
+static prte_job_t *make_job(pmix_rank_t nprocs)
+{
+    prte_job_t *jdata;
+    prte_app_context_t *app;
+    prte_proc_t *proc;
+    pmix_rank_t v;
+
+    jdata = PMIX_NEW(prte_job_t);
+    PMIX_LOAD_NSPACE(jdata->nspace, "packbench");
+    app = PMIX_NEW(prte_app_context_t);
+    app->app = strdup("a.out");
+    PMIX_ARGV_APPEND_NOSIZE_COMPAT(&app->argv, "a.out");
+    app->num_procs = nprocs;
+    pmix_pointer_array_add(jdata->apps, app);
+    jdata->num_apps = 1;
+    jdata->num_procs = nprocs;
+
+    for (v = 0; v < nprocs; v++) {
+        proc = PMIX_NEW(prte_proc_t);
+        PMIX_LOAD_PROCID(&proc->name, jdata->nspace, v);
+        proc->parent = 1 + v / PACKBENCH_PPN;
+        proc->app_idx = 0;
+        proc->app_rank = v;
+        proc->local_rank = v % PACKBENCH_PPN;
+        proc->node_rank = v % PACKBENCH_PPN;
+        proc->state = PRTE_PROC_STATE_INIT;
+        pmix_asprintf(&proc->cpuset, "%d", (int) (v % PACKBENCH_PPN));
+        pmix_pointer_array_add(jdata->procs, proc);
+    }
+    return jdata;
+}
+
+static bool same_procs(prte_job_t *a, prte_job_t *b)
+{
+    prte_proc_t *p1, *p2;
+    int n;
+
+    if (a->num_procs != b->num_procs) {
+        return false;
+    }
+    for (n = 0; n < (int) a->num_procs; n++) {
+        p1 = (prte_proc_t *) pmix_pointer_array_get_item(a->procs, n);
+        p2 = (prte_proc_t *) pmix_pointer_array_get_item(b->procs, n);
+        if (NULL == p1 || NULL == p2 || !PMIX_CHECK_PROCID(&p1->name, &p2->name)
+            || p1->parent != p2->parent || p1->app_idx != p2->app_idx
+            || p1->app_rank != p2->app_rank || p1->local_rank != p2->local_rank
+            || p1->node_rank != p2->node_rank || p1->state != p2->state
+            || 0 != strcmp(p1->cpuset, p2->cpuset)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* round-trip the job through the given encoding, reporting the
+ * bytes and usecs per rank taken to pack and to unpack it */
+static void bench(prte_job_t *jdata, bool compact)
+{
+    pmix_data_buffer_t buf;
+    prte_job_t *copy = NULL;
+    double start, tpack = 0.0, tunpack = 0.0, t;
+    size_t bytes = 0;
+    bool saved = prte_compact_job_encoding;
+    bool ok = true;
+    int n, rc;
+
+    prte_compact_job_encoding = compact;
+    for (n = 0; n < PACKBENCH_REPS && ok; n++) {
+        PMIX_DATA_BUFFER_CONSTRUCT(&buf);
+        start = now();
+        rc = prte_job_pack(&buf, jdata);
+        t = now() - start;
+        if (PRTE_SUCCESS != rc) {
+            ok = false;
+            PMIX_DATA_BUFFER_DESTRUCT(&buf);
+            break;
+        }
+        if (0 == n || t < tpack) {
+            tpack = t;
+        }
+        bytes = buf.bytes_used;
+
+        start = now();
+        rc = prte_job_unpack(&buf, &copy);
+        t = now() - start;
+        PMIX_DATA_BUFFER_DESTRUCT(&buf);
+        if (PRTE_SUCCESS != rc) {
+            ok = false;
+            break;
+        }
+        if (0 == n || t < tunpack) {
+            tunpack = t;
+        }
+        ok = same_procs(jdata, copy);
+        PMIX_RELEASE(copy);
+    }
+    prte_compact_job_encoding = saved;
+
+    printf("%8u ranks (%-7s) ", (unsigned) jdata->num_procs, compact ? "compact" : "full");
+    if (ok) {
+        printf("%lu bytes, %.2f bytes/rank, pack %.3f usec/rank, unpack %.3f usec/rank\n",
+               (unsigned long) bytes, (double) bytes / jdata->num_procs,
+               1.0e6 * tpack / jdata->num_procs, 1.0e6 * tunpack / jdata->num_procs);
+    } else {
+        printf("round trip FAILED\n");
+    }
+}
+
+int main(int argc, char **argv)
+{
+    prte_job_t *jdata;
+    char **list;
+    long nprocs;
+    int n, rc;
+
+    rc = prte_init_util(PRTE_PROC_MASTER);
+    if (PRTE_SUCCESS != rc) {
+        fprintf(stderr, "prte_init_util failed: %s\n", prte_strerror(rc));
+        exit(1);
+    }
+
+    list = PMIX_ARGV_SPLIT_COMPAT((1 < argc) ? argv[1] : PACKBENCH_SIZES, ',');
+    for (n = 0; NULL != list && NULL != list[n]; n++) {
+        nprocs = strtol(list[n], NULL, 10);
+        if (0 >= nprocs) {
+            continue;
+        }
+        jdata = make_job((pmix_rank_t) nprocs);
+        bench(jdata, false);
+        bench(jdata, true);
+        PMIX_RELEASE(jdata);
+    }
+    if (NULL != list) {
+        PMIX_ARGV_FREE_COMPAT(list);
+    }
+    return 0;
+}
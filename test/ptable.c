@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2025      Nanook Consulting  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ * Walk the proc table of the running job one page at a time, e.g.:
+ *
+ *    prterun -n 64 ./ptable [pagesize]
+ *
+ * Rank 0 retrieves the table twice - once as pages of pmix_proc_info_t
+ * and once in the compact encoding - and checks that every rank of
+ * the job was returned exactly once in each case.
+ */
+
+#define _GNU_SOURCE
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <pmix.h>
+
+#define PTABLE_START   "prte.qry.ptable.start"
+#define PTABLE_COUNT   "prte.qry.ptable.count"
+#define PTABLE_NEXT    "prte.qry.ptable.next"
+#define PTABLE_COMPACT "prte.qry.ptable.compact"
+#define PTABLE_RANKS   "prte.ptable.ranks"
+
+static pmix_proc_t myproc;
+
+static double now(void)
+{
+    struct timeval tv;
+
+    gettimeofday(&tv, NULL);
+    return (double) tv.tv_sec + (double) tv.tv_usec / 1000000.0;
+}
+
+/* retrieve one page, returning the number of procs in it and
+ * the rank at which the next page starts */
+static int get_page(bool compact, uint32_t start, uint32_t count,
+                    unsigned char *seen, uint32_t size, uint32_t *next)
+{
+    pmix_query_t query;
+    pmix_info_t *results, *iptr;
+    pmix_proc_info_t *pinfo;
+    pmix_rank_t *ranks;
+    size_t nresults, n, k, sz;
+    pmix_status_t rc;
+    int nprocs = 0;
+
+    PMIX_QUERY_CONSTRUCT(&query);
+    PMIX_ARGV_APPEND(rc, query.keys, compact ? PTABLE_COMPACT : PMIX_QUERY_PROC_TABLE);
+    query.nqual = 3;
+    PMIX_INFO_CREATE(query.qualifiers, query.nqual);
+    PMIX_INFO_LOAD(&query.qualifiers[0], PMIX_NSPACE, myproc.nspace, PMIX_STRING);
+    PMIX_INFO_LOAD(&query.qualifiers[1], PTABLE_START, &start, PMIX_UINT32);
+    PMIX_INFO_LOAD(&query.qualifiers[2], PTABLE_COUNT, &count, PMIX_UINT32);
+    rc = PMIx_Query_info(&query, 1, &results, &nresults);
+    PMIX_QUERY_DESTRUCT(&query);
+    if (PMIX_SUCCESS != rc) {
+        fprintf(stderr, "query of page at %u failed: %s\n", start, PMIx_Error_string(rc));
+        return -1;
+    }
+
+    *next = size;
+    for (n = 0; n < nresults; n++) {
+        if (PMIX_CHECK_KEY(&results[n], PTABLE_NEXT)) {
+            *next = results[n].value.data.uint32;
+        } else if (PMIX_CHECK_KEY(&results[n], PMIX_QUERY_PROC_TABLE)) {
+            pinfo = (pmix_proc_info_t *) results[n].value.data.darray->array;
+            sz = results[n].value.data.darray->size;
+            for (k = 0; k < sz; k++) {
+                if (pinfo[k].proc.rank < size) {
+                    seen[pinfo[k].proc.rank]++;
+                }
+            }
+            nprocs = sz;
+        } else if (PMIX_CHECK_KEY(&results[n], PTABLE_COMPACT)) {
+            iptr = (pmix_info_t *) results[n].value.data.darray->array;
+            sz = results[n].value.data.darray->size;
+            for (k = 0; k < sz; k++) {
+                if (PMIX_CHECK_KEY(&iptr[k], PTABLE_RANKS)) {
+                    ranks = (pmix_rank_t *) iptr[k].value.data.darray->array;
+                    nprocs = iptr[k].value.data.darray->size;
+                    while (0 < nprocs--) {
+                        if (ranks[nprocs] < size) {
+                            seen[ranks[nprocs]]++;
+                        }
+                    }
+                    nprocs = iptr[k].value.data.darray->size;
+                }
+            }
+        }
+    }
+    PMIX_INFO_FREE(results, nresults);
+    return nprocs;
+}
+
+static int walk(bool compact, uint32_t size, uint32_t pagesize)
+{
+    unsigned char *seen;
+    uint32_t start = 0, next, n;
+    int npages = 0, ret = 0;
+    double t0, t1;
+
+    seen = (unsigned char *) calloc(size, 1);
+    t0 = now();
+    while (start < size) {
+        if (0 > get_page(compact, start, pagesize, seen, size, &next)) {
+            ret = 1;
+            break;
+        }
+        ++npages;
+        if (next <= start) {
+            fprintf(stderr, "page at %u did not advance\n", start);
+            ret = 1;
+            break;
+        }
+        start = next;
+    }
+    t1 = now();
+    for (n = 0; 0 == ret && n < size; n++) {
+        if (1 != seen[n]) {
+            fprintf(stderr, "rank %u returned %d times\n", n, (int) seen[n]);
+            ret = 1;
+        }
+    }
+    free(seen);
+    fprintf(stderr, "%s table: %u procs in %d pages in %.3f msec%s\n",
+            compact ? "compact" : "full", size, npages, 1000.0 * (t1 - t0),
+            ret ? " - FAILED" : "");
+    return ret;
+}
+
+int main(int argc, char **argv)
+{
+    pmix_status_t rc;
+    pmix_proc_t proc;
+    pmix_value_t *val;
+    uint32_t size, pagesize = 16;
+    int ret = 0;
+
+    if (1 < argc) {
+        pagesize = strtoul(argv[1], NULL, 10);
+    }
+
+    if (PMIX_SUCCESS != (rc = PMIx_Init(&myproc, NULL, 0))) {
+        fprintf(stderr, "PMIx_Init failed: %s\n", PMIx_Error_string(rc));
+        exit(1);
+    }
+    PMIX_LOAD_PROCID(&proc, myproc.nspace, PMIX_RANK_WILDCARD);
+    rc = PMIx_Get(&proc, PMIX_JOB_SIZE, NULL, 0, &val);
+    if (PMIX_SUCCESS != rc) {
+        fprintf(stderr, "[%s:%u] Get of job size failed: %s\n",
+                myproc.nspace, myproc.rank, PMIx_Error_string(rc));
+        goto done;
+    }
+    size = val->data.uint32;
+    PMIX_VALUE_RELEASE(val);
+
+    if (0 == myproc.rank) {
+        ret |= walk(false, size, pagesize);
+        ret |= walk(true, size, pagesize);
+    }
+    PMIx_Fence(NULL, 0, NULL, 0);
+
+done:
+    PMIx_Finalize(NULL, 0);
+    return ret;
+}
@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2025      Nanook Consulting  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ * Measure publish/lookup throughput of the PRRTE data server.
+ * Each rank publishes a set of unique keys, then looks up the
+ * keys published by its neighbor, e.g.:
+ *
+ *    prterun -n 16 --map-by ppr:4:node ./pubbench [nkeys]
+ *
+ * Run with "--prtemca pmix_pubsub_shards N" to spread the keys
+ * across the first N daemons instead of the HNP alone. The
+ * "wait" phase uses blocking lookups that may be posted before
+ * the matching publish arrives to exercise the pending-request path.
+ */
+
+#define _GNU_SOURCE
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <pmix.h>
+
+static pmix_proc_t myproc;
+
+static double now(void)
+{
+    struct timeval tv;
+
+    gettimeofday(&tv, NULL);
+    return (double) tv.tv_sec + (double) tv.tv_usec / 1000000.0;
+}
+
+static void report(const char *phase, int nops, double start, double stop)
+{
+    if (0 == myproc.rank) {
+        fprintf(stderr, "%s: %d ops/rank in %.3f sec (%.0f ops/sec/rank)\n",
+                phase, nops, stop - start, nops / (stop - start));
+    }
+}
+
+int main(int argc, char **argv)
+{
+    pmix_status_t rc;
+    pmix_proc_t proc;
+    pmix_info_t info[2];
+    pmix_pdata_t pdata;
+    pmix_value_t *val;
+    uint32_t size, peer, waitpeer;
+    int n, nkeys = 1000;
+    double start, stop;
+    char *keys[2];
+
+    if (1 < argc) {
+        nkeys = strtol(argv[1], NULL, 10);
+    }
+
+    if (PMIX_SUCCESS != (rc = PMIx_Init(&myproc, NULL, 0))) {
+        fprintf(stderr, "PMIx_Init failed: %s\n", PMIx_Error_string(rc));
+        exit(1);
+    }
+    PMIX_LOAD_PROCID(&proc, myproc.nspace, PMIX_RANK_WILDCARD);
+    rc = PMIx_Get(&proc, PMIX_JOB_SIZE, NULL, 0, &val);
+    if (PMIX_SUCCESS != rc) {
+        fprintf(stderr, "[%s:%u] Get job size failed: %s\n",
+                myproc.nspace, myproc.rank, PMIx_Error_string(rc));
+        goto done;
+    }
+    size = val->data.uint32;
+    PMIX_VALUE_RELEASE(val);
+    peer = (myproc.rank + 1) % size;
+    waitpeer = (myproc.rank + size - 1) % size;
+
+    /* publish */
+    PMIx_Fence(NULL, 0, NULL, 0);
+    start = now();
+    for (n = 0; n < nkeys; n++) {
+        snprintf(info[0].key, PMIX_MAX_KEYLEN, "pub.%u.%d", myproc.rank, n);
+        info[0].value.type = PMIX_INT;
+        info[0].value.data.integer = n;
+        rc = PMIx_Publish(info, 1);
+        if (PMIX_SUCCESS != rc) {
+            fprintf(stderr, "[%s:%u] Publish failed: %s\n",
+                    myproc.nspace, myproc.rank, PMIx_Error_string(rc));
+            goto done;
+        }
+    }
+    stop = now();
+    report("publish", nkeys, start, stop);
+
+    /* lookup */
+    PMIx_Fence(NULL, 0, NULL, 0);
+    start = now();
+    for (n = 0; n < nkeys; n++) {
+        PMIX_PDATA_CONSTRUCT(&pdata);
+        snprintf(pdata.key, PMIX_MAX_KEYLEN, "pub.%u.%d", peer, n);
+        rc = PMIx_Lookup(&pdata, 1, NULL, 0);
+        if (PMIX_SUCCESS != rc || n != pdata.value.data.integer) {
+            fprintf(stderr, "[%s:%u] Lookup of %s failed: %s\n",
+                    myproc.nspace, myproc.rank, pdata.key, PMIx_Error_string(rc));
+            goto done;
+        }
+        PMIX_PDATA_DESTRUCT(&pdata);
+    }
+    stop = now();
+    report("lookup", nkeys, start, stop);
+
+    /* wait - each rank publishes a key and then blocks on the
+     * matching key from its neighbor, which may not be there yet */
+    PMIx_Fence(NULL, 0, NULL, 0);
+    start = now();
+    PMIX_INFO_LOAD(&info[1], PMIX_WAIT, NULL, PMIX_BOOL);
+    for (n = 0; n < nkeys; n++) {
+        snprintf(info[0].key, PMIX_MAX_KEYLEN, "wait.%u.%d", myproc.rank, n);
+        info[0].value.type = PMIX_INT;
+        info[0].value.data.integer = n;
+        rc = PMIx_Publish(info, 1);
+        if (PMIX_SUCCESS != rc) {
+            fprintf(stderr, "[%s:%u] Publish failed: %s\n",
+                    myproc.nspace, myproc.rank, PMIx_Error_string(rc));
+            goto done;
+        }
+        PMIX_PDATA_CONSTRUCT(&pdata);
+        snprintf(pdata.key, PMIX_MAX_KEYLEN, "wait.%u.%d", waitpeer, n);
+        rc = PMIx_Lookup(&pdata, 1, &info[1], 1);
+        if (PMIX_SUCCESS != rc) {
+            fprintf(stderr, "[%s:%u] Lookup of %s failed: %s\n",
+                    myproc.nspace, myproc.rank, pdata.key, PMIx_Error_string(rc));
+            goto done;
+        }
+        PMIX_PDATA_DESTRUCT(&pdata);
+    }
+    stop = now();
+    report("wait", nkeys, start, stop);
+
+    /* unpublish */
+    PMIx_Fence(NULL, 0, NULL, 0);
+    start = now();
+    keys[1] = NULL;
+    for (n = 0; n < nkeys; n++) {
+        if (0 > asprintf(&keys[0], "pub.%u.%d", myproc.rank, n)) {
+            goto done;
+        }
+        rc = PMIx_Unpublish(keys, NULL, 0);
+        free(keys[0]);
+        if (PMIX_SUCCESS != rc) {
+            fprintf(stderr, "[%s:%u] Unpublish failed: %s\n",
+                    myproc.nspace, myproc.rank, PMIx_Error_string(rc));
+            goto done;
+        }
+    }
+    stop = now();
+    report("unpublish", nkeys, start, stop);
+    PMIx_Fence(NULL, 0, NULL, 0);
+
+done:
+    PMIx_Finalize(NULL, 0);
+    return 0;
+}
@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2025      Nanook Consulting  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ * Query the resource usage of a running job, e.g.:
+ *
+ *    prterun -n 8 --map-by ppr:2:node ./rusage [iterations]
+ *
+ * Every rank burns some CPU and touches some memory between queries.
+ * Rank 0 then asks for the proc and node resource usage of the job -
+ * once across the whole DVM and once restricted to its own node - and
+ * prints the returned summaries along with the time each query took.
+ * The DVM-wide proc count must match the job size.
+ */
+
+#define _GNU_SOURCE
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <pmix.h>
+
+#if !defined(PMIX_QUERY_PROC_RESOURCE_USAGE) || !defined(PMIX_QUERY_NODE_RESOURCE_USAGE)
+
+int main(int argc, char **argv)
+{
+    fprintf(stderr, "rusage requires a PMIx library that supports resource usage queries\n");
+    return 0;
+}
+
+#else
+
+static pmix_proc_t myproc;
+
+static double now(void)
+{
+    struct timeval tv;
+
+    gettimeofday(&tv, NULL);
+    return (double) tv.tv_sec + (double) tv.tv_usec / 1000000.0;
+}
+
+static void burn(char *mem, size_t len)
+{
+    double start = now();
+    size_t n;
+
+    while (now() - start < 0.5) {
+        for (n = 0; n < len; n += 4096) {
+            mem[n]++;
+        }
+    }
+}
+
+static uint64_t print_summary(const char *label, pmix_info_t *info)
+{
+    pmix_info_t *iptr;
+    size_t n, sz;
+    uint64_t count = 0;
+
+    if (PMIX_DATA_ARRAY != info->value.type) {
+        fprintf(stderr, "%s: unexpected result type\n", label);
+        return 0;
+    }
+    iptr = (pmix_info_t *) info->value.data.darray->array;
+    sz = info->value.data.darray->size;
+    fprintf(stderr, "  %s:\n", label);
+    for (n = 0; n < sz; n++) {
+        if (PMIX_CHECK_KEY(&iptr[n], "prte.rusage.count")) {
+            count = iptr[n].value.data.uint64;
+        }
+        fprintf(stderr, "    %-32s %lu\n", iptr[n].key,
+                (unsigned long) iptr[n].value.data.uint64);
+    }
+    return count;
+}
+
+static int query(bool local, uint32_t size)
+{
+    pmix_query_t query;
+    pmix_info_t *results;
+    size_t nresults, n;
+    pmix_status_t rc;
+    uint64_t nprocs = 0;
+    double start, stop;
+
+    PMIX_QUERY_CONSTRUCT(&query);
+    PMIX_ARGV_APPEND(rc, query.keys, PMIX_QUERY_PROC_RESOURCE_USAGE);
+    PMIX_ARGV_APPEND(rc, query.keys, PMIX_QUERY_NODE_RESOURCE_USAGE);
+    query.nqual = local ? 2 : 1;
+    PMIX_INFO_CREATE(query.qualifiers, query.nqual);
+    PMIX_INFO_LOAD(&query.qualifiers[0], PMIX_NSPACE, myproc.nspace, PMIX_STRING);
+    if (local) {
+        PMIX_INFO_LOAD(&query.qualifiers[1], PMIX_QUERY_LOCAL_ONLY, NULL, PMIX_BOOL);
+    }
+
+    start = now();
+    rc = PMIx_Query_info(&query, 1, &results, &nresults);
+    stop = now();
+    PMIX_QUERY_DESTRUCT(&query);
+    if (PMIX_SUCCESS != rc) {
+        fprintf(stderr, "%s query failed: %s\n", local ? "local" : "global",
+                PMIx_Error_string(rc));
+        return 1;
+    }
+
+    fprintf(stderr, "%s query answered in %.3f msec\n", local ? "local" : "global",
+            1000.0 * (stop - start));
+    for (n = 0; n < nresults; n++) {
+        if (PMIX_CHECK_KEY(&results[n], PMIX_QUERY_PROC_RESOURCE_USAGE)) {
+            nprocs = print_summary("procs", &results[n]);
+        } else if (PMIX_CHECK_KEY(&results[n], PMIX_QUERY_NODE_RESOURCE_USAGE)) {
+            print_summary("nodes", &results[n]);
+        }
+    }
+    PMIX_INFO_FREE(results, nresults);
+
+    if (!local && nprocs != size) {
+        fprintf(stderr, "expected %u procs, got %lu\n", size, (unsigned long) nprocs);
+        return 1;
+    }
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    pmix_status_t rc;
+    pmix_proc_t proc;
+    pmix_value_t *val;
+    uint32_t size;
+    size_t len = 64 * 1024 * 1024;
+    char *mem;
+    int n, iters = 3, ret = 0;
+
+    if (1 < argc) {
+        iters = strtol(argv[1], NULL, 10);
+    }
+
+    if (PMIX_SUCCESS != (rc = PMIx_Init(&myproc, NULL, 0))) {
+        fprintf(stderr, "PMIx_Init failed: %s\n", PMIx_Error_string(rc));
+        exit(1);
+    }
+    PMIX_LOAD_PROCID(&proc, myproc.nspace, PMIX_RANK_WILDCARD);
+    rc = PMIx_Get(&proc, PMIX_JOB_SIZE, NULL, 0, &val);
+    if (PMIX_SUCCESS != rc) {
+        fprintf(stderr, "[%s:%u] Get of job size failed: %s\n",
+                myproc.nspace, myproc.rank, PMIx_Error_string(rc));
+        goto done;
+    }
+    size = val->data.uint32;
+    PMIX_VALUE_RELEASE(val);
+
+    mem = (char *) calloc(1, len);
+    for (n = 0; n < iters; n++) {
+        burn(mem, len);
+        PMIx_Fence(NULL, 0, NULL, 0);
+        if (0 == myproc.rank) {
+            ret |= query(false, size);
+            ret |= query(true, size);
+        }
+        PMIx_Fence(NULL, 0, NULL, 0);
+    }
+    free(mem);
+
+done:
+    PMIx_Finalize(NULL, 0);
+    return ret;
+}
+
+#endif
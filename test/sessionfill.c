@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2025      Nanook Consulting  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ * Fill the proc-level session directory with files so the daemon
+ * has a large tree to remove when the job terminates, e.g.:
+ *
+ *    prterun -n 4 ./sessionfill [nfiles] [nbytes]
+ *
+ * See sessionturn.bash for timing back-to-back jobs.
+ */
+
+#define _GNU_SOURCE
+#include <fcntl.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <pmix.h>
+
+int main(int argc, char **argv)
+{
+    pmix_status_t rc;
+    pmix_proc_t myproc;
+    pmix_value_t *val;
+    char *dir, path[4096], *data;
+    int n, fd, nfiles = 1000;
+    size_t nbytes = 4096;
+
+    if (1 < argc) {
+        nfiles = strtol(argv[1], NULL, 10);
+    }
+    if (2 < argc) {
+        nbytes = strtoul(argv[2], NULL, 10);
+    }
+
+    if (PMIX_SUCCESS != (rc = PMIx_Init(&myproc, NULL, 0))) {
+        fprintf(stderr, "PMIx_Init failed: %s\n", PMIx_Error_string(rc));
+        exit(1);
+    }
+    rc = PMIx_Get(&myproc, PMIX_PROCDIR, NULL, 0, &val);
+    if (PMIX_SUCCESS != rc) {
+        fprintf(stderr, "[%s:%u] Get of proc session dir failed: %s\n",
+                myproc.nspace, myproc.rank, PMIx_Error_string(rc));
+        goto done;
+    }
+    dir = strdup(val->data.string);
+    PMIX_VALUE_RELEASE(val);
+
+    data = (char *) calloc(1, nbytes + 1);
+    memset(data, 'x', nbytes);
+    for (n = 0; n < nfiles; n++) {
+        snprintf(path, sizeof(path), "%s/file-%d", dir, n);
+        fd = open(path, O_CREAT | O_WRONLY | O_TRUNC, 0600);
+        if (0 > fd) {
+            fprintf(stderr, "[%s:%u] Unable to create %s\n", myproc.nspace, myproc.rank, path);
+            break;
+        }
+        if (0 < nbytes && (ssize_t) nbytes != write(fd, data, nbytes)) {
+            fprintf(stderr, "[%s:%u] Unable to write %s\n", myproc.nspace, myproc.rank, path);
+        }
+        close(fd);
+    }
+    free(data);
+    free(dir);
+
+done:
+    PMIx_Finalize(NULL, 0);
+    return 0;
+}
@@ -0,0 +1,37 @@
+#!/bin/bash
+#
+# Time back-to-back jobs on a persistent DVM when each job leaves
+# a large session directory behind. Compare with the session dirs
+# being removed in place, e.g.:
+#
+#    ./sessionturn.bash 20 4 10000
+#    PRTE_MCA_prte_session_dir_cleanup_max=0 ./sessionturn.bash 20 4 10000
+#
+
+NJOBS=${1:-20}
+NPROCS=${2:-4}
+NFILES=${3:-10000}
+URIFILE=$(mktemp)
+
+prte --daemonize --report-uri $URIFILE
+while [ ! -s $URIFILE ]; do
+    sleep 0.1
+done
+
+FAILED=0
+START=$(date +%s.%N)
+for i in $(seq 1 $NJOBS) ; do
+    prun --dvm-uri file:$URIFILE -n $NPROCS ./sessionfill $NFILES || FAILED=$(expr $FAILED + 1)
+done
+STOP=$(date +%s.%N)
+
+# the DVM must not exit until the session dirs are all gone
+pterm --dvm-uri file:$URIFILE
+rm -f $URIFILE
+
+T=$(echo "$STOP - $START" | bc)
+echo "$NJOBS jobs in $T sec ($(echo "scale=3; $T / $NJOBS" | bc) sec/job, $FAILED failed)"
+if [[ $FAILED != 0 ]] ; then
+    exit 1
+fi
+exit 0
@@ -0,0 +1,35 @@
+#!/bin/bash
+#
+# Run a job in a persistent DVM with the launch timeline enabled
+# and check that the DVM controller reported the per-phase
+# breakdown, e.g.:
+#
+#    ./timeline.bash 8
+#    ./timeline.bash 64 --hostfile myhosts
+#
+
+NPROCS=${1:-8}
+shift
+URIFILE=$(mktemp)
+LOGFILE=$(mktemp)
+
+prte --report-uri $URIFILE --prtemca state_base_timeline 1 "$@" 2> $LOGFILE &
+while [ ! -s $URIFILE ]; do
+    sleep 0.01
+done
+prun --dvm-uri file:$URIFILE -n $NPROCS --map-by :oversubscribe hostname > /dev/null
+# the records are rolled up after the job terminates
+sleep 1
+pterm --dvm-uri file:$URIFILE
+wait
+
+cat $LOGFILE
+RC=0
+for phase in allocate map launch "child list" "fork all" ; do
+    if ! grep -q "$phase" $LOGFILE ; then
+        echo "missing phase: $phase"
+        RC=1
+    fi
+done
+rm -f $URIFILE $LOGFILE
+exit $RC
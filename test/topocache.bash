@@ -0,0 +1,46 @@
+#!/bin/bash
+#
+# Time DVM startup with a cold and a warm on-node topology cache.
+# The cold runs discover the topology and populate the cache, the
+# warm runs load it from the cache instead, e.g.:
+#
+#    ./topocache.bash 5
+#    ./topocache.bash 5 --hostfile myhosts
+#
+# With a hostfile, the cache directory must be node-local on each
+# host (the default lives under /tmp).
+#
+
+NRUNS=${1:-5}
+shift
+CACHEDIR=${TOPOCACHE_DIR:-/tmp/prte-topocache.$USER}
+URIFILE=$(mktemp)
+
+startup() {
+    rm -f $URIFILE
+    START=$(date +%s.%N)
+    PRTE_MCA_hwloc_base_topo_cache_dir=$CACHEDIR prte --daemonize --report-uri $URIFILE "$@"
+    while [ ! -s $URIFILE ]; do
+        sleep 0.01
+    done
+    prun --dvm-uri file:$URIFILE -n 1 hostname > /dev/null
+    STOP=$(date +%s.%N)
+    pterm --dvm-uri file:$URIFILE
+    echo "$STOP - $START" | bc
+}
+
+COLD=0
+WARM=0
+for i in $(seq 1 $NRUNS) ; do
+    rm -rf $CACHEDIR
+    T=$(startup "$@")
+    COLD=$(echo "$COLD + $T" | bc)
+    T=$(startup "$@")
+    WARM=$(echo "$WARM + $T" | bc)
+done
+rm -f $URIFILE
+rm -rf $CACHEDIR
+
+echo "cold: $(echo "scale=3; $COLD / $NRUNS" | bc) sec/startup"
+echo "warm: $(echo "scale=3; $WARM / $NRUNS" | bc) sec/startup"
+exit 0
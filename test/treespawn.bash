@@ -0,0 +1,82 @@
+#!/bin/bash
+#
+# Measure the time for a tree-spawned DVM to bring up all of its
+# daemons without needing a cluster. Every "node" is simulated on
+# this host by a fake ssh that sleeps to mimic the cost of a
+# connection and then runs the daemon command locally. Compare
+# launching along the routing tree with a binomial launch tree, e.g.:
+#
+#    ./treespawn.bash 256 0.2
+#    ./treespawn.bash 256 0.2 --prtemca plm_ssh_launch_radix 2
+#
+# Add "--prtemca plm_ssh_launch_timeline 1" to get a timestamped trace
+# of each launch.
+#
+# Set ROUNDS to bring the DVM up repeatedly. The fake ssh honors
+# ControlPath, so with persistent agent connections only the first
+# round pays the full connection cost for each node, e.g.:
+#
+#    ROUNDS=3 ./treespawn.bash 64 0.5 --prtemca plm_ssh_persist 60
+#
+
+NNODES=${1:-64}
+DELAY=${2:-0.1}
+shift 2
+ROUNDS=${ROUNDS:-1}
+WORKDIR=$(mktemp -d)
+AGENT=$WORKDIR/ssh
+HOSTFILE=$WORKDIR/hosts
+
+# the agent is invoked as "ssh [options] <host> <command>" - a
+# session to a host that already has a master connection only
+# pays a tenth of the delay
+cat > $AGENT <<EOA
+#!/bin/bash
+CPATH=
+while [[ \$1 == -* ]] ; do
+    case \$1 in
+        -o)
+            if [[ \$2 == ControlPath=* ]] ; then
+                CPATH=\$(dirname \${2#ControlPath=})
+            fi
+            shift ;;
+        -p|-l|-i|-F)
+            shift ;;
+    esac
+    shift
+done
+HOST=\$1
+shift
+if [[ -n \$CPATH && -e \$CPATH/fake-\$HOST ]] ; then
+    sleep \$(echo "$DELAY / 10" | bc -l)
+else
+    sleep $DELAY
+    if [[ -n \$CPATH ]] ; then
+        touch \$CPATH/fake-\$HOST
+    fi
+fi
+exec /bin/sh -c "\$*"
+EOA
+chmod +x $AGENT
+
+for i in $(seq -w 1 $NNODES) ; do
+    echo "fakenode$i slots=1" >> $HOSTFILE
+done
+
+RC=0
+for r in $(seq 1 $ROUNDS) ; do
+    START=$(date +%s.%N)
+    prterun --prtemca plm ssh --prtemca plm_ssh_agent $AGENT \
+            --prtemca plm_ssh_assume_same_shell 1 \
+            --prtemca plm_ssh_control_dir $WORKDIR/control \
+            --hostfile $HOSTFILE "$@" -n 1 hostname > /dev/null
+    RC=$?
+    STOP=$(date +%s.%N)
+    echo "round $r: $NNODES daemons with ${DELAY}s launch latency: $(echo "$STOP - $START" | bc) sec"
+    if [[ $RC != 0 ]] ; then
+        break
+    fi
+done
+rm -rf $WORKDIR
+
+exit $RC
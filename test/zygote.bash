@@ -0,0 +1,42 @@
+#!/bin/bash
+#
+# Time back-to-back jobs on a persistent DVM, reporting the launch
+# rate and how long procs take to reach main. Compare with procs
+# forked from warm zygotes of their executable, e.g.:
+#
+#    ./zygote.bash 20 4
+#    PRTE_MCA_odls_pdefault_zygote=1 ./zygote.bash 20 4
+#
+
+NJOBS=${1:-20}
+NPROCS=${2:-4}
+URIFILE=$(mktemp)
+OUTFILE=$(mktemp)
+
+prte --daemonize --report-uri $URIFILE
+while [ ! -s $URIFILE ]; do
+    sleep 0.1
+done
+
+FAILED=0
+START=$(date +%s.%N)
+for i in $(seq 1 $NJOBS) ; do
+    ZYGOTE_T0=$(date +%s%N) prun --dvm-uri file:$URIFILE -x ZYGOTE_T0 -n $NPROCS \
+        ./zygotebench >> $OUTFILE || FAILED=$(expr $FAILED + 1)
+done
+STOP=$(date +%s.%N)
+
+pterm --dvm-uri file:$URIFILE
+rm -f $URIFILE
+
+T=$(echo "$STOP - $START" | bc)
+echo "$NJOBS jobs of $NPROCS procs in $T sec" \
+     "($(echo "scale=1; $NJOBS * $NPROCS / $T" | bc) procs/sec, $FAILED failed)"
+awk '{ n++; sum += $2; if ($2 > max) max = $2 }
+     END { if (n > 0) printf("time to main: avg %.1f usec, max %.1f usec over %d procs\n",
+                             sum / n, max, n) }' $OUTFILE
+rm -f $OUTFILE
+if [[ $FAILED != 0 ]] ; then
+    exit 1
+fi
+exit 0
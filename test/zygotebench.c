@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) 2025      Nanook Consulting  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ * Report how long it took each proc to reach main, measured from
+ * the time in nsec given in the ZYGOTE_T0 envar, e.g.:
+ *
+ *    prun -x ZYGOTE_T0=$(date +%s%N) -n 4 ./zygotebench
+ *
+ * Each proc prints its rank and latency in usec. See zygote.bash
+ * for comparing launches with and without the pdefault zygotes.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include <pmix.h>
+
+int main(int argc, char **argv)
+{
+    struct timespec ts;
+    long long t0, now;
+    char *ptr;
+
+    /* first thing, before anything else can add to it */
+    clock_gettime(CLOCK_REALTIME, &ts);
+    now = (long long) ts.tv_sec * 1000000000LL + ts.tv_nsec;
+
+    if (NULL == (ptr = getenv("ZYGOTE_T0"))) {
+        fprintf(stderr, "ZYGOTE_T0 is not set\n");
+        exit(1);
+    }
+    t0 = strtoll(ptr, NULL, 10);
+
+    /* keep the PMIx library linked in, as it would be for a real app */
+    (void) PMIx_Get_version();
+
+    ptr = getenv("PMIX_RANK");
+    printf("%s %.1f\n", (NULL == ptr) ? "-1" : ptr, (double) (now - t0) / 1000.0);
+    return 0;
+}